@@ -0,0 +1,91 @@
+/*
+    PURPOSE:
+        (Compiled address paths of variable references.)
+*/
+
+#ifndef ADDRESSPATHCACHE_HH
+#define ADDRESSPATHCACHE_HH
+
+#include <stddef.h>
+#include <vector>
+#include "trick/reference.h"
+
+namespace Trick {
+
+/**
+  The AddressPathCache resolves the addresses of many references that have pointers in their address paths.
+
+  Each REF2 address path is compiled once into a chain of pointer hops.  A hop reads the pointer found at a
+  fixed offset from the result of the previous hop, or from a fixed address for the first hop, and the
+  address of the reference is the last hop plus a final offset.  References that share the beginning of
+  their paths, like the members of one object reached through a pointer, share hops, so each pointer is
+  read once per resolve() no matter how many references go through it.  The result matches
+  follow_address_path() on each reference.
+
+  The cache holds REF2 pointers only to check it was compiled for them; compile it again whenever the
+  references are replaced.
+ */
+class AddressPathCache {
+
+    public:
+        AddressPathCache() : valid(false) {}
+
+        /**
+         Compiles the address paths of refs.  A reference without a pointer in its path is not compiled.
+         @param refs - the references, in the order their addresses are retrieved with get_address().
+         */
+        void compile( const std::vector< REF2 * > & refs ) ;
+
+        /** Marks the cache as out of date so it is compiled again before it is used. */
+        void invalidate() { valid = false ; }
+
+        /** @return true if the cache was compiled and not invalidated since. */
+        bool is_valid() const { return valid ; }
+
+        /** @return the number of references the cache was compiled for. */
+        size_t size() const { return paths.size() ; }
+
+        /** @return true if reference ii was compiled from ref. */
+        bool is_compiled( size_t ii , REF2 * ref ) const {
+            return ii < paths.size() && paths[ii].ref == ref && paths[ii].hop >= -1 ;
+        }
+
+        /** Reads every pointer hop in order.  Call before retrieving addresses each cycle. */
+        void resolve() ;
+
+        /** @return the address of compiled reference ii as of the last resolve(), or NULL if a pointer on its path is NULL. */
+        void * get_address( size_t ii ) const {
+            const Path & path = paths[ii] ;
+            if ( path.hop < 0 ) {
+                return (void *)path.offset ;
+            }
+            char * base = hop_values[path.hop] ;
+            return base ? (void *)(base + path.offset) : NULL ;
+        }
+
+        /** @return the number of distinct pointer hops read by resolve(). */
+        size_t num_hops() const { return hops.size() ; }
+
+    private:
+        /* A hop reads the pointer at hop_values[parent] + offset, or at offset itself when parent is -1. */
+        struct Hop {
+            long parent ;         /**< ** index of the hop read before this one, or -1 */
+            ptrdiff_t offset ;    /**< ** offset added to the parent hop, or the address read when parent is -1 */
+        } ;
+
+        /* hop is -2 if the reference was not compiled, -1 if offset is the address itself. */
+        struct Path {
+            REF2 * ref ;          /**< ** the reference compiled */
+            long hop ;            /**< ** index of the last hop of the path */
+            ptrdiff_t offset ;    /**< ** offset added to the last hop */
+        } ;
+
+        bool valid ;                      /**< ** false until compiled and after invalidate() */
+        std::vector< Hop > hops ;         /**< ** pointer hops, parents before children */
+        std::vector< char * > hop_values ; /**< ** pointer read by each hop in the last resolve() */
+        std::vector< Path > paths ;       /**< ** compiled path of each reference */
+} ;
+
+}
+
+#endif
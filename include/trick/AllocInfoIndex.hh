@@ -0,0 +1,84 @@
+/*
+    PURPOSE:
+        (Sorted address index of the Memory Manager allocations.)
+*/
+
+#ifndef ALLOCINFOINDEX_HH
+#define ALLOCINFOINDEX_HH
+
+#include <stddef.h>
+#include <vector>
+
+#include "trick/io_alloc.h"
+
+namespace Trick {
+
+/**
+  The AllocInfoIndex finds the allocation containing an address.  It is a two level sorted array:
+  allocations are kept sorted by start address in blocks of at most 2 * #block_size entries, and the
+  start address of each block is kept in a separate sorted array.  A lookup is a binary search of
+  the block starts followed by a binary search of one block, both over contiguous memory.  Inserting
+  or erasing moves at most one block of entries, so the index is kept up to date as allocations are
+  declared and deleted instead of being rebuilt.
+
+  The start and end addresses are copied into the index so a lookup only touches the ALLOC_INFO it returns.
+  The index is not thread safe; the Memory Manager protects it with the same mutex as its alloc_info_map.
+  Every change increments the index epoch after it is made, so a reader that validated an address
+  against the index only has to validate it again when the epoch has changed.
+ */
+class AllocInfoIndex {
+
+    public:
+        /** Target number of entries in a block. Blocks are split at twice this size. */
+        static const size_t block_size = 256 ;
+
+        AllocInfoIndex() : num_entries(0), epoch(1) {}
+
+        /**
+         Adds an allocation to the index, replacing an allocation with the same start address.
+         @param alloc_info - the allocation, its start and end addresses must be set.
+         */
+        void insert( ALLOC_INFO * alloc_info ) ;
+
+        /**
+         Removes the allocation starting at address.
+         @param address - start address of the allocation.
+         @return 0 if the allocation was removed, -1 if there is no allocation starting at address.
+         */
+        int erase( void * address ) ;
+
+        /**
+         Finds the allocation with the highest start address not above address, if it contains address.
+         @param address - any address.
+         @return the allocation or NULL.
+         */
+        ALLOC_INFO * find( void * address ) const ;
+
+        /** Removes all allocations from the index. */
+        void clear() ;
+
+        /** @return the number of allocations in the index. */
+        size_t size() const { return num_entries ; }
+
+        /** @return the number of changes made to the index plus one.  May be called from any thread. */
+        unsigned long long get_epoch() const { return __atomic_load_n(&epoch, __ATOMIC_ACQUIRE) ; }
+
+    private:
+        struct Entry {
+            char * start ;           /**< ** start address of the allocation */
+            char * end ;             /**< ** end address of the allocation */
+            ALLOC_INFO * alloc_info ; /**< ** the allocation */
+        } ;
+
+        /** Index of the block that holds or would hold address, or -1 if address is below every block. */
+        long find_block( char * address ) const ;
+
+        std::vector< std::vector< Entry > > blocks ; /**< ** blocks of entries sorted by start address */
+        std::vector< char * > block_starts ;        /**< ** start address of the first entry of each block */
+        size_t num_entries ;                         /**< ** number of entries in all blocks */
+        unsigned long long epoch ;                   /**< ** incremented after every change */
+} ;
+
+}
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef BINARYCHECKPOINTAGENT_HH
+#define BINARYCHECKPOINTAGENT_HH
+
+#include <stddef.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "trick/CheckPointAgent.hh"
+
+namespace Trick {
+
+    /**
+     This class writes checkpoints as a binary image of the allocations and restores them.
+
+     The image starts with a table of the allocations, each with its name, type, dimensions and
+     element size.  The contents of each allocation follow as raw bytes, then a list of fixups for
+     its pointers and strings.  A pointer into a checkpointed allocation is stored as the index of
+     that allocation in the table and the byte offset into it.  Restoring declares the local
+     allocations, copies the bytes of the checkpointable members back with memcpy, and rewrites
+     the pointers from their fixups.
+
+     Members whose io specification does not allow checkpoint input and output are neither
+     restored nor overwritten, as with the ClassicCheckPointAgent.  The image holds the memory
+     layout of the simulation that wrote it and can only be restored by the same build of the
+     simulation.
+
+     An incremental checkpoint is written against a base checkpoint written earlier by the same run.
+     The table records the address and a hash of the contents of every allocation.  The contents of
+     an allocation whose address, type, size and hash match an entry of the base are not written;
+     they are read from the base when the checkpoint is restored.
+     */
+    class BinaryCheckPointAgent: public CheckPointAgent {
+
+        public:
+
+        /** First bytes of every binary checkpoint. */
+        static const char magic[8];
+
+        /**
+         Constructor.
+         @param  MM MemoryManager.
+         */
+        BinaryCheckPointAgent( Trick::MemoryManager *MM);
+
+        ~BinaryCheckPointAgent();
+
+        /**
+         Test incoming attributes permission check.
+         @param attr Attributes with permision to check.
+         */
+        virtual bool input_perm_check(ATTRIBUTES * attr) ;
+
+        /**
+         Test incoming attributes permission check.
+         @param attr Attributes with permision to check.
+         */
+        virtual bool output_perm_check(ATTRIBUTES * attr) ;
+
+        /**
+         Write the table entry of the given allocation.
+         @param alloc_info Pointer to the allocation record.
+         */
+        void write_decl(std::ostream& chkpnt_os, ALLOC_INFO *alloc_info);
+
+        /**
+         Values are not written one at a time in a binary checkpoint.  Use write_checkpoint().
+         */
+        void assign_rvalue( std::ostream& chkpnt_os, void* address, ATTRIBUTES* attr, int curr_dim, int offset);
+
+        /**
+         Write the binary image of the given allocations.
+         @param allocations The allocations to checkpoint, every one of them named.
+         @param base_file A full binary checkpoint written earlier by this run.  If it is not empty,
+         the allocations that have not changed since the base was written are written as references
+         to it.  If the base cannot be read, a full checkpoint is written.
+         @return 0 on success, 1 if the stream failed.
+         */
+        int write_checkpoint( std::ostream& chkpnt_os, std::vector<ALLOC_INFO*>& allocations,
+                              const std::string& base_file = "");
+
+        /**
+         Restore memory allocations from a binary checkpoint stream.
+         @param checkpoint_stream Input stream from which the checkpoint is read.
+         @return 0/1 success flag
+         */
+        int restore( std::istream* checkpoint_stream);
+
+        /**
+         Test whether a stream holds a binary checkpoint, without consuming any of it.
+         @return true if the stream starts with the binary checkpoint magic.
+         */
+        static bool is_binary_checkpoint( std::istream* checkpoint_stream);
+
+        /**
+         Set the name of the file being restored.  The base of an incremental checkpoint that is not
+         found where it was written is looked for in the directory of this file.
+         @param file_name The checkpoint file, or "" when restoring from a stream.
+         */
+        void set_checkpoint_file( const std::string& file_name);
+
+    private:
+
+        /** What is copied for a range of bytes of an element. */
+        enum SegmentType {
+            SEGMENT_RAW,     /**< bytes copied as they are */
+            SEGMENT_SKIP,    /**< bytes left alone */
+            SEGMENT_POINTER, /**< pointers, restored from fixups */
+            SEGMENT_STRING   /**< std::strings, restored from fixups */
+        } ;
+
+        /** A range of bytes of an element. */
+        struct Segment {
+            size_t offset ;      /**< ** offset from the start of the element */
+            size_t size ;        /**< ** number of bytes */
+            SegmentType type ;   /**< ** how the bytes are copied */
+            bool char_pointer ;  /**< ** the pointers may point to character strings outside of managed memory */
+        } ;
+
+        /** An entry of the allocation table. */
+        struct TableEntry {
+            int stcl ;                         /**< ** storage class */
+            int type ;                         /**< ** TRICK_TYPE */
+            int size ;                         /**< ** element size */
+            int num ;                          /**< ** number of elements */
+            int num_index ;                    /**< ** number of dimensions */
+            int index[TRICK_MAX_INDEX] ;       /**< ** dimensions, 0 for a pointer */
+            std::string name ;                 /**< ** allocation name */
+            std::string user_type_name ;       /**< ** type name of a structured allocation */
+            unsigned long long address ;       /**< ** address of the allocation when it was written */
+            unsigned long long hash ;          /**< ** hash of the contents written by write_data() */
+            int base_index ;                   /**< ** entry of the base holding the contents, -1 if they follow */
+        } ;
+
+        /** The segments of one element of a type, sorted by offset. */
+        struct Layout {
+            std::vector<Segment> segments ; /**< ** */
+            bool contiguous ;               /**< ** the whole element is one raw segment */
+        } ;
+
+        Trick::MemoryManager *mem_mgr;                  /**< ** Associated MemoryManager. */
+
+        /** Layouts of the classes and structs, by their ATTRIBUTES. */
+        std::map<ATTRIBUTES*, Layout> class_layouts;     /**< ** */
+
+        /** Index in the table of each allocation being written. */
+        std::map<ALLOC_INFO*, int> table_index;          /**< ** */
+
+        /** The file being restored. */
+        std::string checkpoint_file;                     /**< ** */
+
+        /** Don't Allow the default constructor to be used. */
+        BinaryCheckPointAgent();
+
+        /**
+         @return the layout of the class or struct described by attr, building it the first time.
+         */
+        const Layout& get_class_layout( ATTRIBUTES* attr, size_t size);
+
+        /**
+         @return the layout of one element of the allocation.  Layouts that are not a class or
+         struct are built in scratch.
+         */
+        const Layout& get_allocation_layout( ALLOC_INFO* alloc_info, Layout& scratch);
+
+        /**
+         Append the segments of the members in attr_list, offset by base_offset.
+         */
+        void add_member_segments( std::vector<Segment>& segments, size_t base_offset, ATTRIBUTES* attr_list);
+
+        /** Orders segments by offset. */
+        static bool segment_offset_compare( const Segment & lhs, const Segment & rhs );
+
+        /**
+         Sort the segments into the layout and merge the neighboring raw ones.
+         */
+        void finish_layout( Layout& layout, std::vector<Segment>& segments, size_t elem_size);
+
+        /**
+         @return a hash of what write_data() writes for the allocation, with pointers hashed by value.
+         Two allocations with the same hash restore to the same contents.
+         */
+        unsigned long long hash_data( ALLOC_INFO* alloc_info);
+
+        /**
+         Write the bytes of an allocation followed by its fixups.
+         */
+        void write_data( std::ostream& chkpnt_os, ALLOC_INFO* alloc_info);
+
+        /**
+         Read the header of a binary checkpoint.
+         @return 0 on success, 1 if the stream is not a binary checkpoint this simulation can read.
+         */
+        int read_header( std::istream* chkpnt_is, unsigned int& num_allocations, unsigned long long& id,
+                         std::string& base_file, unsigned long long& base_id);
+
+        /**
+         Read one table entry.
+         @return 0 on success, 1 if the stream failed.
+         */
+        static int read_table_entry( std::istream* chkpnt_is, TableEntry& entry);
+
+        /**
+         Read the fixups of an allocation and apply them to the allocation at start.  A pointer fixup
+         to table entry n points at target_starts[n] plus its offset.
+         @param start The allocation, or NULL to skip the fixups.
+         @return 0 on success, 1 if the stream failed or held an unknown fixup.
+         */
+        int read_fixups( std::istream* chkpnt_is, char* start, unsigned long long num_bytes,
+                         std::vector<char*>& target_starts);
+
+        /**
+         Read the entries of an incremental checkpoint whose contents are in its base from the base.
+         @return 0 on success, 1 if the base could not be read.
+         */
+        int restore_from_base( const std::string& base_file, unsigned long long base_id,
+                               std::vector<TableEntry>& entries, std::vector<ALLOC_INFO*>& table);
+
+        /**
+         Read the bytes of an allocation written by write_data() into the allocation, copying
+         only the segments of its layout.
+         @return 0 on success, 1 if the stream failed.
+         */
+        int read_data( std::istream* chkpnt_is, ALLOC_INFO* alloc_info, unsigned long long num_bytes);
+
+        /**
+         Find or declare the allocation of each table entry.
+         @return 0 on success, 1 if the stream failed.
+         */
+        int read_table( std::istream* chkpnt_is, std::vector<TableEntry>& entries, std::vector<ALLOC_INFO*>& table);
+    };
+} //namespace
+#endif
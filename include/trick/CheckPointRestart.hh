@@ -9,11 +9,26 @@
 #include <string>
 #include <vector>
 #include <queue>
+#include <sys/types.h>
 
 #include "trick/Scheduler.hh"
 
 namespace Trick {
 
+    /**
+     * A checkpoint being written by a forked writer process.
+     */
+    struct CheckPointWriter {
+        pid_t pid ;                 /**< ** process id of the writer */
+        int result_fd ;             /**< ** read end of the pipe the writer reports its result on */
+        std::string file_name ;     /**< ** name the checkpoint was requested as */
+        std::string temp_file ;     /**< ** file the writer writes before renaming it to the checkpoint file */
+        std::string base_temp_file ; /**< ** file the writer writes before renaming it to the new base checkpoint file */
+        bool print_status ;         /**< ** print a message when the checkpoint is written */
+        double start_time ;         /**< trick_units(s) wall clock time the writer was forked */
+        long start_minor_faults ;   /**< trick_units(--) minor page faults of the simulation when the writer was forked */
+    } ;
+
     /**
      *
      * This class wraps the MemoryManager class for use in Trick simulations
@@ -48,9 +63,40 @@ namespace Trick {
              * Internal call the MemoryManager checkpoint method with the string argument file_name
              * @param file_name - file name to write checkpoint
              * @param print_status - print a message when checkpoint is written
+             * @param skip_if_busy - when writers are forked, skip the checkpoint instead of waiting if max_writers are in flight
              * @return always 0
              */
-            int do_checkpoint( std::string file_name , bool print_status) ;
+            int do_checkpoint( std::string file_name , bool print_status, bool skip_if_busy = false ) ;
+
+            /** Base checkpoint to write along with the current checkpoint, "" for none */
+            std::string new_base_file ;                              /* ** */
+
+            /** Base checkpoint the current checkpoint is written against, "" for a full checkpoint */
+            std::string current_base_file ;                          /* ** */
+
+            /** Checkpoints being written by forked writers */
+            std::vector<CheckPointWriter> writers ;                  /* ** */
+
+            /**
+             * Fork a writer process to write output_file.  The writer writes to a temporary file
+             * and renames it to output_file when the whole checkpoint is written.
+             * @param file_name - name the checkpoint was requested as
+             * @param print_status - print a message when checkpoint is written
+             * @return 0 if the writer was started, -1 if fork failed
+             */
+            int fork_checkpoint_writer( std::string file_name , bool print_status ) ;
+
+            /**
+             * Collect the result of a writer that has exited and report it.
+             * @param writer - the writer
+             * @param status - exit status from waitpid
+             */
+            void finish_checkpoint_writer( CheckPointWriter & writer , int status ) ;
+
+            /**
+             * Wait for the oldest forked writer to finish and report its result.
+             */
+            void wait_for_oldest_checkpoint_writer() ;
 
         public:
 
@@ -84,6 +130,49 @@ namespace Trick {
             /** CPU to use for checkpoints\n */
             int cpu_num ;                                  /**< trick_units(--) */
 
+            /** If true and checkpoints are binary, write incremental checkpoints\n */
+            bool incremental ;                                      /**< trick_units(--) */
+
+            /** Number of checkpoints written against a base checkpoint before a new base is written\n */
+            int incremental_base_interval ;                         /**< trick_units(--) */
+
+            /** Number of checkpoints written against the current base checkpoint\n */
+            int checkpoints_since_base ;                            /**< trick_units(--) */
+
+            /** Base checkpoint of the incremental checkpoints\n */
+            std::string base_file ;                                 /**< ** */
+
+            /** Maximum number of checkpoints written at the same time by forked writers\n */
+            int max_writers ;                                       /**< trick_units(--) */
+
+            /** Number of forked writers currently writing a checkpoint\n */
+            int writers_in_flight ;                                 /**< trick_units(--) */
+
+            /** Number of checkpoints written by forked writers\n */
+            int writes_completed ;                                  /**< trick_units(--) */
+
+            /** Number of checkpoints forked writers failed to write\n */
+            int writes_failed ;                                     /**< trick_units(--) */
+
+            /** Number of safestore checkpoints skipped because max_writers were in flight\n */
+            int writes_skipped ;                                    /**< trick_units(--) */
+
+            /** Result of the last forked write, 0 for success\n */
+            int last_write_status ;                                 /**< trick_units(--) */
+
+            /** Time the last forked writer took to write its checkpoint\n */
+            double last_write_time ;                                /**< trick_units(s) */
+
+            /** Time the simulation was stalled by the last fork of a writer\n */
+            double last_fork_time ;                                 /**< trick_units(s) */
+
+            /** Longest time the simulation was stalled by the fork of a writer\n */
+            double max_fork_time ;                                  /**< trick_units(s) */
+
+            /** Minor page faults taken by the simulation while the last forked writer ran.
+                Most are copy-on-write copies of pages the simulation changed during the write.\n */
+            long last_write_page_faults ;                           /**< trick_units(--) */
+
             /**
              * This is the constructor of the CheckPointRestart class.  It initializes
              * the checkpoint, pre_load_checkpoint, and the restart_queues
@@ -161,6 +250,52 @@ namespace Trick {
              */
             int set_cpu_num(int in_cpu_num) ;
 
+            /**
+             @brief @userdesc Command to set the maximum number of checkpoints written at the same time when
+             checkpoints are written by a forked process (see checkpoint_cpu).  When this many writers are
+             in flight a safestore checkpoint is skipped, and any other checkpoint waits for the oldest writer
+             to finish.  The default is 1.
+             @par Python Usage:
+             @code trick.checkpoint_max_writers(<num>) @endcode
+             @param num - maximum number of writers, at least 1
+             @return always 0
+             */
+            int set_max_writers(int num) ;
+
+            /**
+             @brief @userdesc Command to write incremental checkpoints.  Every incremental_base_interval checkpoints a full
+             base checkpoint is written to <file>.base along with the checkpoint.  The other checkpoints only hold the
+             contents of the allocations that changed since the base was written, and are restored together with
+             the base.  Incremental checkpoints are binary checkpoints, see TMM_binary_checkpoint.
+             @par Python Usage:
+             @code trick.checkpoint_incremental(<yes_no>) @endcode
+             @param yes_no - boolean yes (C integer 1) = write incremental checkpoints, no (C integer 0) = write full checkpoints
+             @return always 0
+             */
+            int set_incremental(bool yes_no) ;
+
+            /**
+             @brief @userdesc Command to set how many checkpoints are written against a base checkpoint, including the
+             one written with it, before a new base is written.  The default is 10.
+             @par Python Usage:
+             @code trick.checkpoint_incremental_base_interval(<num>) @endcode
+             @param num - number of checkpoints per base, at least 1
+             @return always 0
+             */
+            int set_incremental_base_interval(int num) ;
+
+            /**
+             * Reap the forked writers that have finished and report their results.
+             * @return always 0
+             */
+            int reap_checkpoint_writers() ;
+
+            /**
+             * Wait for all forked writers to finish and report their results.
+             * @return always 0
+             */
+            int wait_for_checkpoint_writers() ;
+
             /**
              * Get the write_checkpoint_job and safestore_checkpoint jobs.
              * @return always 0
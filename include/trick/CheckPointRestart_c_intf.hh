@@ -34,6 +34,15 @@ int checkpoint_safestore(int yes_no) ;
 /* set the cpu to use for checkpoints */
 int checkpoint_cpu( int in_cpu_num ) ;
 
+/* write incremental checkpoints against a base checkpoint */
+int checkpoint_incremental( int yes_no ) ;
+
+/* set the number of checkpoints written against each base checkpoint */
+int checkpoint_incremental_base_interval( int num ) ;
+
+/* set the maximum number of checkpoints written at the same time by forked writers */
+int checkpoint_max_writers( int num ) ;
+
 /* safestore checkpoint call accessible from C code */
 int checkpoint_safestore_period( double in_period ) ;
 
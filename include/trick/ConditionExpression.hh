@@ -0,0 +1,149 @@
+/*
+    PURPOSE:
+        (Event conditions compiled to native code.)
+*/
+
+#ifndef CONDITIONEXPRESSION_HH
+#define CONDITIONEXPRESSION_HH
+
+#include <string>
+#include <vector>
+#include "trick/reference.h"
+#include "trick/AddressPathCache.hh"
+
+namespace Trick {
+
+/**
+  The ConditionExpression compiles an event condition string that uses only arithmetic and comparisons of
+  simulation variables and numbers, and evaluates it without the input processor.
+
+  The supported subset is
+  -# numbers, True and False
+  -# simulation variables, a.b.c or x.y[2], that are a single numeric element: an integer, floating point,
+     bool or enumerated type.  Variables are bound with ref_attributes() when the expression is compiled.
+  -# unary - and +, * and /, binary + and -
+  -# one comparison between two operands: <, <=, >, >=, == and !=
+  -# not and !, and and &&, or and ||, with python precedence for the words.  ! binds as tightly as unary -,
+     as it does in C.
+  -# parentheses
+
+  and and or short circuit and return the value of the operand that decided them, as they do in python.
+  Values are doubles, so integers beyond 2^53 are approximated.  Anything else, including function calls,
+  python variables and chained comparisons, is not compiled and is left to python.
+
+  The expression is compiled into a small stack machine program.  The addresses of the variables with
+  pointers in their paths are read through an AddressPathCache each evaluation.  Evaluation takes no
+  lock and allocates no memory; an expression must not be evaluated by two threads at once.
+ */
+class ConditionExpression {
+
+    public:
+        ConditionExpression() ;
+        ~ConditionExpression() ;
+
+        /**
+         @brief Compile the given string.  A previous compilation is discarded.
+         @return 0 on success, 1 if the string is not in the supported subset or a variable was not found.
+        */
+        int compile( const std::string & in_string ) ;
+
+        /**
+         @brief Evaluate the compiled expression.
+         @param cond_return_val - set to 1 if the expression is true, 0 if false.
+         @return 0 on success, -1 if a pointer on a variable's path is NULL or a division by zero was attempted.
+        */
+        int evaluate( int & cond_return_val ) ;
+
+        /** @return the number of variables the expression reads. */
+        size_t num_variables() const { return variables.size() ; }
+
+    private:
+        /** Instructions of the stack machine. */
+        enum OpCode {
+            OP_CONSTANT ,          /**< push value */
+            OP_VARIABLE ,          /**< push variables[index] */
+            OP_NEGATE ,
+            OP_NOT ,
+            OP_ADD ,
+            OP_SUBTRACT ,
+            OP_MULTIPLY ,
+            OP_DIVIDE ,
+            OP_LESS ,
+            OP_LESS_EQUAL ,
+            OP_GREATER ,
+            OP_GREATER_EQUAL ,
+            OP_EQUAL ,
+            OP_NOT_EQUAL ,
+            OP_JUMP_IF_FALSE_OR_POP ,  /**< keep the top and jump to index if it is false, else pop it */
+            OP_JUMP_IF_TRUE_OR_POP     /**< keep the top and jump to index if it is true, else pop it */
+        } ;
+
+        /** One instruction. */
+        struct Instruction {
+            OpCode op ;        /**< ** */
+            size_t index ;     /**< ** variable or jump target */
+            double value ;     /**< ** constant */
+        } ;
+
+        /** How the value of a variable is read. */
+        enum ValueType {
+            VALUE_INT8 , VALUE_UINT8 , VALUE_INT16 , VALUE_UINT16 , VALUE_INT32 , VALUE_UINT32 ,
+            VALUE_INT64 , VALUE_UINT64 , VALUE_FLOAT , VALUE_DOUBLE , VALUE_BOOL
+        } ;
+
+        /** A simulation variable read by the expression. */
+        struct Variable {
+            std::string name ;     /**< ** name given to ref_attributes() */
+            REF2 * ref ;           /**< ** reference to the variable */
+            ValueType type ;       /**< ** how its value is read */
+        } ;
+
+        std::vector< Instruction > program ;   /**< ** compiled instructions */
+        std::vector< Variable > variables ;    /**< ** variables, in order of first use */
+        std::vector< double > stack ;          /**< ** evaluation stack, sized for the program */
+        AddressPathCache address_paths ;       /**< ** addresses of the variables with pointers in their paths */
+        bool pointer_present ;                 /**< ** true if any variable has a pointer in its path */
+
+        /* Compilation state */
+        const char * cursor ;                  /**< ** next character to parse */
+
+        /** Free the variables and the program. */
+        void clear() ;
+
+        /* Recursive descent parser, one function per precedence level.  Each returns false on a syntax error. */
+        bool parse_or() ;
+        bool parse_and() ;
+        bool parse_not() ;
+        bool parse_comparison() ;
+        bool parse_sum() ;
+        bool parse_product() ;
+        bool parse_unary() ;
+        bool parse_primary() ;
+        bool parse_variable( std::string & name ) ;
+
+        /** Skip white space. */
+        void skip_space() ;
+
+        /** Consume the operator text if it is next. */
+        bool accept( const char * text ) ;
+
+        /** Consume the word if it is next and is not the start of a longer identifier. */
+        bool accept_word( const char * word ) ;
+
+        /** Append an instruction, returning its index. */
+        size_t emit( OpCode op , size_t index = 0 , double value = 0.0 ) ;
+
+        /** Find or bind the variable with the given name.  @return false if it is not a supported variable. */
+        bool bind_variable( const std::string & name , size_t & index ) ;
+
+        /** @return the deepest the stack gets running the program. */
+        size_t stack_depth() const ;
+
+        /** Don't allow the expression to be copied. */
+        ConditionExpression( const ConditionExpression & ) ;
+        ConditionExpression & operator = ( const ConditionExpression & ) ;
+} ;
+
+}
+
+#endif
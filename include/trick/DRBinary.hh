@@ -110,6 +110,11 @@ namespace Trick {
              */
             virtual int format_specific_write_data(unsigned int writer_offset) ;
 
+            /**
+             @copybrief Trick::DataRecordGroup::format_specific_write_records
+             */
+            virtual int format_specific_write_records(unsigned int writer_offset, unsigned int num_records) ;
+
             /**
              @copybrief Trick::DataRecordGroup::shutdown
              */
@@ -119,6 +124,9 @@ namespace Trick {
             /** The log file.\n */
             int fd ;             /**< trick_io(**) trick_units(--) */
 
+            /** Records in the record major arena are written to the file as they are.\n */
+            bool direct_write ;  /**< trick_io(**) trick_units(--) */
+
     } ;
 
 } ;
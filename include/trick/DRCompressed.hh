@@ -0,0 +1,203 @@
+/*
+PURPOSE:
+    (Data Record Compressed class.)
+*/
+
+#ifndef DRCOMPRESSED_HH
+#define DRCOMPRESSED_HH
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "trick/DataRecordGroup.hh"
+
+#ifdef SWIG
+%feature("compactdefaultargs","0") ;
+%feature("shadow") Trick::DRCompressed::DRCompressed(std::string in_name) %{
+    def __init__(self, *args):
+        this = $action(*args)
+        try: self.this.append(this)
+        except: self.this = this
+        this.own(0)
+        self.this.own(0)
+%}
+#endif
+
+namespace Trick {
+
+    /**
+     * The DR_Codec enumeration represents the general purpose codecs DRCompressed applies to a chunk.
+     */
+    enum DR_Codec {
+        DR_Codec_None = 0,      /**< store the encoded columns as they are */
+        DR_Codec_LZ = 1         /**< compress the encoded columns with the LZ77 byte codec */
+    } ;
+
+    /**
+     * One entry of the DRCompressed chunk index.
+     */
+    class DRCompressedChunk {
+        public:
+            uint64_t offset ;       /* ** file offset of the chunk header */
+            unsigned int num_records ; /* ** records in the chunk */
+            double start_time ;     /* ** time of the first record */
+            double end_time ;       /* ** time of the last record */
+    } ;
+
+    /**
+      The DRCompressed recording format writes records in chunks of columns.  Files written in this format are
+      named log_<group_name>.trkz and are read by the Trick Data Products packages.
+
+      Records are collected until #chunk_records are ready.  Each column of the chunk is encoded by type:
+      doubles and floats as the Gorilla XOR of the previous value, integers as the zigzag varint of the
+      difference to the previous value, and everything else as recorded.  The encoded columns are then
+      compressed as one block with the chunk codec, or stored as they are if that is smaller.  At shutdown
+      an index of every chunk's time range is appended so readers can seek by time without decoding.
+      All integers in the file are little endian.
+
+      <center>
+      <table>
+      <tr><th>Value</th><th>Description</th><th>Type</th><th>Bytes</th></tr>
+      <tr><td colspan=4 align=center>START OF HEADER</td></tr>
+      <tr><td>Trick-Z-01</td><td>format and version</td><td>string</td><td>10</td></tr>
+      <tr><td>\<numparms\></td><td>Number of parameters recorded</td><td>int</td><td>4</td></tr>
+      <tr><td>\<namelen\> \<name\> \<unitlen\> \<unit\> \<type\> \<size\></td><td>each parameter as in
+      DRBinary, the first parameter is always sys.exec.out.time</td><td></td><td></td></tr>
+      <tr><td colspan=4 align=center>END OF HEADER, START OF CHUNKS</td></tr>
+      <tr><td>CHNK</td><td>chunk magic</td><td>int</td><td>4</td></tr>
+      <tr><td>\<numrecs\></td><td>records in the chunk</td><td>int</td><td>4</td></tr>
+      <tr><td>\<start\> \<end\></td><td>time of the first and last record</td><td>double</td><td>16</td></tr>
+      <tr><td>\<codec\></td><td>chunk codec, see Trick::DR_Codec</td><td>char</td><td>1</td></tr>
+      <tr><td>\<rawsize\> \<storedsize\></td><td>bytes of the encoded columns before and after the codec</td><td>int</td><td>8</td></tr>
+      <tr><td>\<columns\></td><td>for each parameter a varint byte count and the encoded column</td><td></td><td>\<storedsize\></td></tr>
+      <tr><td colspan=4 align=center>REPEAT FOR EACH CHUNK</td></tr>
+      <tr><td>\<offset\> \<numrecs\> \<start\> \<end\></td><td>index entry for each chunk</td><td></td><td>28</td></tr>
+      <tr><td>\<indexoffset\> \<numchunks\> TKZI</td><td>trailer</td><td></td><td>16</td></tr>
+      </table>
+      <b>Compressed Data Format</b>
+      </center>
+
+      A file without the trailer, for instance from a sim that did not shut down, is read by scanning the chunks.
+    */
+    class DRCompressed : public Trick::DataRecordGroup {
+
+        public:
+
+            #ifndef SWIG
+            /**
+             @brief DRCompressed default constructor.
+             */
+            DRCompressed() {}
+            #endif
+            ~DRCompressed() {}
+
+            /**
+             @brief @userdesc Create a new compressed data recording group.
+             @par Python Usage:
+             @code <my_drg> = trick.DRCompressed("<in_name>") @endcode
+             @copydoc Trick::DataRecordGroup::DataRecordGroup(string in_name)
+             */
+            DRCompressed( std::string in_name, bool register_group = true ) ;
+
+            /**
+             @brief @userdesc Command to set the number of records written in one chunk (default 4096).
+             Larger chunks compress better, smaller chunks let readers seek more finely.
+             @par Python Usage:
+             @code <dr_group>.set_chunk_records(<in_chunk_records>) @endcode
+             @param in_chunk_records - records per chunk
+             @return 0 if successful, -1 if in_chunk_records is 0 or the group is already initialized
+            */
+            int set_chunk_records( unsigned int in_chunk_records ) ;
+
+            /**
+             @brief @userdesc Command to set the codec applied to each chunk (default DR_Codec_LZ).
+             @par Python Usage:
+             @code <dr_group>.set_codec(trick.DR_Codec_None) @endcode
+             @param in_codec - a Trick::DR_Codec value
+             @return 0 if successful, -1 if in_codec is not a codec
+            */
+            int set_codec( int in_codec ) ;
+
+            /**
+             @copybrief Trick::DataRecordGroup::format_specific_header
+             */
+            virtual int format_specific_header(std::fstream & outstream) ;
+
+            /**
+             @copybrief Trick::DataRecordGroup::format_specific_init
+             */
+            virtual int format_specific_init() ;
+
+            /**
+             @copybrief Trick::DataRecordGroup::format_specific_write_data
+             */
+            virtual int format_specific_write_data(unsigned int writer_offset) ;
+
+            /**
+             @copybrief Trick::DataRecordGroup::format_specific_write_records
+             */
+            virtual int format_specific_write_records(unsigned int writer_offset, unsigned int num_records) ;
+
+            /**
+             @copybrief Trick::DataRecordGroup::format_specific_shutdown
+             */
+            virtual int format_specific_shutdown() ;
+
+            /** Number of records in one chunk.\n */
+            unsigned int chunk_records ;     /**< trick_io(*io) trick_units(--) */
+
+            /** Codec applied to each chunk, a Trick::DR_Codec value.\n */
+            int codec ;                      /**< trick_io(*io) trick_units(--) */
+
+            /** Number of chunks written.\n */
+            unsigned long long num_chunks ;  /**< trick_io(*o) trick_units(--) */
+
+            /** Bytes of the records written as they would be in a DRBinary file.\n */
+            unsigned long long num_raw_bytes ; /**< trick_io(*o) trick_units(--) */
+
+        protected:
+
+            /**
+             @brief Encodes and writes the records collected in the chunk buffer.
+             @return the number of bytes written
+            */
+            int write_chunk() ;
+
+        private:
+            /** The log file.\n */
+            int fd ;                         /**< trick_io(**) trick_units(--) */
+
+            /** Offset of the next write in the log file.\n */
+            uint64_t file_offset ;           /**< trick_io(**) trick_units(--) */
+
+            /** Bytes of one record in the chunk buffer.\n */
+            unsigned int row_size ;          /**< trick_io(**) trick_units(--) */
+
+            /** Records in the chunk buffer.\n */
+            unsigned int num_staged ;        /**< trick_io(**) trick_units(--) */
+
+            /** Records in the record major arena are copied to the chunk buffer as they are.\n */
+            bool direct_copy ;               /**< trick_io(**) trick_units(--) */
+
+            /** Offset of each variable in a record of the chunk buffer.\n */
+            std::vector<unsigned int> col_offset ; /**< trick_io(**) trick_units(--) */
+
+            /** Encoded columns of the chunk being written.\n */
+            std::vector<unsigned char> chunk_columns ; /**< trick_io(**) trick_units(--) */
+
+            /** Chunk header and compressed columns of the chunk being written.\n */
+            std::vector<unsigned char> chunk_out ; /**< trick_io(**) trick_units(--) */
+
+            /** Index of the chunks written.\n */
+            std::vector<Trick::DRCompressedChunk> chunk_index ; /**< trick_io(**) trick_units(--) */
+
+    } ;
+
+} ;
+
+#ifdef SWIG
+%feature("compactdefaultargs","1") ;
+#endif
+
+#endif
@@ -0,0 +1,462 @@
+/*
+PURPOSE:
+    (Column and chunk codecs of the DRCompressed data recording format.  The codecs are inline so
+     the data products readers share them without linking the simulation library.)
+*/
+
+#ifndef DRCOMPRESSEDCODEC_HH
+#define DRCOMPRESSEDCODEC_HH
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "trick/parameter_types.h"
+
+namespace Trick {
+
+    /**
+      Encoders and decoders of the DRCompressed (log_<group_name>.trkz) format.  All integers in the file
+      are little endian.  Recorded values are encoded by value, not by their bytes in memory, so files move
+      between machines of either byte order.
+    */
+    class DRCompressedCodec {
+
+        public:
+
+            /** How the values of one column are encoded */
+            enum ColumnKind {
+                Column_Raw = 0,       /**< bytes as recorded */
+                Column_Xor = 1,       /**< Gorilla XOR of the previous value, doubles and floats */
+                Column_Signed = 2,    /**< zigzag varint of the difference to the previous value */
+                Column_Unsigned = 3   /**< zigzag varint of the difference to the previous value */
+            } ;
+
+            /** General purpose codec applied to the encoded columns of a chunk */
+            enum ChunkCodec {
+                Codec_None = 0,       /**< encoded columns are stored as they are */
+                Codec_LZ = 1          /**< LZ77 byte codec */
+            } ;
+
+            /** Chunk and file layout constants */
+            static const unsigned int magic_len = 10 ;
+            static const uint32_t chunk_magic = 0x4b4e4843 ;   /* "CHNK" */
+            static const uint32_t index_magic = 0x495a4b54 ;   /* "TKZI" */
+            static const unsigned int chunk_header_size = 33 ;
+            static const unsigned int index_entry_size = 28 ;
+            static const unsigned int trailer_size = 16 ;
+
+            static const char * magic() {
+                return "Trick-Z-01" ;
+            }
+
+            /** Picks the column encoding of a recorded Trick type and size */
+            static ColumnKind column_kind( int type , int size ) {
+                switch ( type ) {
+                    case TRICK_DOUBLE:
+                        return ( size == 8 ) ? Column_Xor : Column_Raw ;
+                    case TRICK_FLOAT:
+                        return ( size == 4 ) ? Column_Xor : Column_Raw ;
+                    case TRICK_CHARACTER:
+                    case TRICK_SHORT:
+                    case TRICK_INTEGER:
+                    case TRICK_LONG:
+                    case TRICK_LONG_LONG:
+                    case TRICK_ENUMERATED:
+                    case TRICK_BITFIELD:
+                        return ( size == 1 || size == 2 || size == 4 || size == 8 ) ? Column_Signed : Column_Raw ;
+                    case TRICK_UNSIGNED_CHARACTER:
+                    case TRICK_UNSIGNED_SHORT:
+                    case TRICK_UNSIGNED_INTEGER:
+                    case TRICK_UNSIGNED_LONG:
+                    case TRICK_UNSIGNED_LONG_LONG:
+                    case TRICK_UNSIGNED_BITFIELD:
+                    case TRICK_BOOLEAN:
+                        return ( size == 1 || size == 2 || size == 4 || size == 8 ) ? Column_Unsigned : Column_Raw ;
+                    default:
+                        return Column_Raw ;
+                }
+            }
+
+            /* Little endian fixed width fields */
+
+            static void put_u32( std::vector<unsigned char> & out , uint32_t value ) {
+                for ( int ii = 0 ; ii < 4 ; ii++ ) {
+                    out.push_back((unsigned char)(value >> (8 * ii))) ;
+                }
+            }
+
+            static void put_u64( std::vector<unsigned char> & out , uint64_t value ) {
+                for ( int ii = 0 ; ii < 8 ; ii++ ) {
+                    out.push_back((unsigned char)(value >> (8 * ii))) ;
+                }
+            }
+
+            static void put_double( std::vector<unsigned char> & out , double value ) {
+                uint64_t bits ;
+                memcpy(&bits, &value, 8) ;
+                put_u64(out, bits) ;
+            }
+
+            static uint32_t get_u32( const unsigned char * in ) {
+                return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24) ;
+            }
+
+            static uint64_t get_u64( const unsigned char * in ) {
+                return (uint64_t)get_u32(in) | ((uint64_t)get_u32(in + 4) << 32) ;
+            }
+
+            static double get_double( const unsigned char * in ) {
+                uint64_t bits = get_u64(in) ;
+                double value ;
+                memcpy(&value, &bits, 8) ;
+                return value ;
+            }
+
+            /* LEB128 varints */
+
+            static void put_varint( std::vector<unsigned char> & out , uint64_t value ) {
+                while ( value >= 0x80 ) {
+                    out.push_back((unsigned char)(value | 0x80)) ;
+                    value >>= 7 ;
+                }
+                out.push_back((unsigned char)value) ;
+            }
+
+            /** @return false if the varint runs past end */
+            static bool get_varint( const unsigned char *& in , const unsigned char * end , uint64_t & value ) {
+                int shift = 0 ;
+                value = 0 ;
+                while ( in < end && shift < 64 ) {
+                    unsigned char byte = *in++ ;
+                    value |= (uint64_t)(byte & 0x7f) << shift ;
+                    if ( ! (byte & 0x80) ) {
+                        return true ;
+                    }
+                    shift += 7 ;
+                }
+                return false ;
+            }
+
+            /** Writes bit fields most significant bit first */
+            class BitWriter {
+                public:
+                    BitWriter( std::vector<unsigned char> & in_out ) : out(in_out) , acc(0) , num_bits(0) {}
+                    void write( uint64_t value , int count ) {
+                        if ( count > 32 ) {
+                            write(value >> 32, count - 32) ;
+                            count = 32 ;
+                        }
+                        acc = (acc << count) | (value & ((1ULL << count) - 1)) ;
+                        num_bits += count ;
+                        while ( num_bits >= 8 ) {
+                            num_bits -= 8 ;
+                            out.push_back((unsigned char)(acc >> num_bits)) ;
+                        }
+                        acc &= (1ULL << num_bits) - 1 ;
+                    }
+                    void flush() {
+                        if ( num_bits > 0 ) {
+                            out.push_back((unsigned char)(acc << (8 - num_bits))) ;
+                            acc = 0 ;
+                            num_bits = 0 ;
+                        }
+                    }
+                private:
+                    std::vector<unsigned char> & out ;
+                    uint64_t acc ;
+                    int num_bits ;
+            } ;
+
+            /** Reads the bit fields of a BitWriter.  Reading past the end sets overrun. */
+            class BitReader {
+                public:
+                    BitReader( const unsigned char * in_begin , const unsigned char * in_end ) :
+                     in(in_begin) , end(in_end) , acc(0) , num_bits(0) , overrun(false) {}
+                    uint64_t read( int count ) {
+                        uint64_t high = 0 ;
+                        uint64_t value ;
+                        if ( count > 32 ) {
+                            high = read(count - 32) << 32 ;
+                            count = 32 ;
+                        }
+                        while ( num_bits < count ) {
+                            if ( in < end ) {
+                                acc = (acc << 8) | *in++ ;
+                            } else {
+                                acc <<= 8 ;
+                                overrun = true ;
+                            }
+                            num_bits += 8 ;
+                        }
+                        num_bits -= count ;
+                        value = (acc >> num_bits) & ((1ULL << count) - 1) ;
+                        acc &= (1ULL << num_bits) - 1 ;
+                        return high | value ;
+                    }
+                    const unsigned char * in ;
+                    const unsigned char * end ;
+                    uint64_t acc ;
+                    int num_bits ;
+                    bool overrun ;
+            } ;
+
+            /** Loads a value of size bytes as a 64 bit pattern, sign extended if is_signed */
+            static uint64_t load_value( const unsigned char * address , int size , bool is_signed ) {
+                switch ( size ) {
+                    case 1: { int8_t v ; memcpy(&v, address, 1) ; return is_signed ? (uint64_t)(int64_t)v : (uint64_t)(uint8_t)v ; }
+                    case 2: { int16_t v ; memcpy(&v, address, 2) ; return is_signed ? (uint64_t)(int64_t)v : (uint64_t)(uint16_t)v ; }
+                    case 4: { int32_t v ; memcpy(&v, address, 4) ; return is_signed ? (uint64_t)(int64_t)v : (uint64_t)(uint32_t)v ; }
+                    default: { uint64_t v ; memcpy(&v, address, 8) ; return v ; }
+                }
+            }
+
+            /** Stores the low size bytes of value */
+            static void store_value( unsigned char * address , int size , uint64_t value ) {
+                switch ( size ) {
+                    case 1: { uint8_t v = (uint8_t)value ; memcpy(address, &v, 1) ; break ; }
+                    case 2: { uint16_t v = (uint16_t)value ; memcpy(address, &v, 2) ; break ; }
+                    case 4: { uint32_t v = (uint32_t)value ; memcpy(address, &v, 4) ; break ; }
+                    default: { memcpy(address, &value, 8) ; break ; }
+                }
+            }
+
+            /**
+              Encodes num values of size bytes found stride bytes apart starting at base.
+              XOR columns follow the Gorilla scheme: a 0 bit for a repeated value, "10" and the meaningful bits
+              when they fit the previous leading/trailing zero window, else "11", 5 bits of leading zeros,
+              6 bits of meaningful length - 1 and the meaningful bits.
+            */
+            static void encode_column( ColumnKind kind , int size , const unsigned char * base , size_t stride ,
+             size_t num , std::vector<unsigned char> & out ) {
+                size_t ii ;
+                switch ( kind ) {
+                    case Column_Xor: {
+                        BitWriter bits(out) ;
+                        int width = size * 8 ;
+                        int prev_lead = -1 , prev_trail = 0 ;
+                        uint64_t prev = 0 ;
+                        for ( ii = 0 ; ii < num ; ii++ ) {
+                            uint64_t value = load_value(base + ii * stride, size, false) ;
+                            if ( ii == 0 ) {
+                                bits.write(value, width) ;
+                            } else {
+                                uint64_t diff = value ^ prev ;
+                                if ( diff == 0 ) {
+                                    bits.write(0, 1) ;
+                                } else {
+                                    int lead = __builtin_clzll(diff) - (64 - width) ;
+                                    int trail = __builtin_ctzll(diff) ;
+                                    if ( lead > 31 ) {
+                                        lead = 31 ;
+                                    }
+                                    if ( prev_lead >= 0 && lead >= prev_lead && trail >= prev_trail ) {
+                                        bits.write(2, 2) ;
+                                        bits.write(diff >> prev_trail, width - prev_lead - prev_trail) ;
+                                    } else {
+                                        int len = width - lead - trail ;
+                                        bits.write(3, 2) ;
+                                        bits.write(lead, 5) ;
+                                        bits.write(len - 1, 6) ;
+                                        bits.write(diff >> trail, len) ;
+                                        prev_lead = lead ;
+                                        prev_trail = trail ;
+                                    }
+                                }
+                            }
+                            prev = value ;
+                        }
+                        bits.flush() ;
+                        break ;
+                    }
+                    case Column_Signed:
+                    case Column_Unsigned: {
+                        uint64_t prev = 0 ;
+                        for ( ii = 0 ; ii < num ; ii++ ) {
+                            uint64_t value = load_value(base + ii * stride, size, kind == Column_Signed) ;
+                            uint64_t delta = value - prev ;
+                            put_varint(out, (delta << 1) ^ (uint64_t)((int64_t)delta >> 63)) ;
+                            prev = value ;
+                        }
+                        break ;
+                    }
+                    default:
+                        for ( ii = 0 ; ii < num ; ii++ ) {
+                            out.insert(out.end(), base + ii * stride, base + ii * stride + size) ;
+                        }
+                        break ;
+                }
+            }
+
+            /**
+              Decodes num values of an encoded column into size bytes stride bytes apart starting at base.
+              @return false if the column is shorter than num values
+            */
+            static bool decode_column( ColumnKind kind , int size , const unsigned char * in , const unsigned char * end ,
+             size_t num , unsigned char * base , size_t stride ) {
+                size_t ii ;
+                switch ( kind ) {
+                    case Column_Xor: {
+                        BitReader bits(in, end) ;
+                        int width = size * 8 ;
+                        int lead = 0 , trail = 0 ;
+                        uint64_t value = 0 ;
+                        for ( ii = 0 ; ii < num ; ii++ ) {
+                            if ( ii == 0 ) {
+                                value = bits.read(width) ;
+                            } else if ( bits.read(1) ) {
+                                if ( bits.read(1) ) {
+                                    lead = (int)bits.read(5) ;
+                                    trail = width - lead - ((int)bits.read(6) + 1) ;
+                                    if ( trail < 0 ) {
+                                        return false ;
+                                    }
+                                }
+                                value ^= bits.read(width - lead - trail) << trail ;
+                            }
+                            store_value(base + ii * stride, size, value) ;
+                        }
+                        return ! bits.overrun ;
+                    }
+                    case Column_Signed:
+                    case Column_Unsigned: {
+                        uint64_t value = 0 , zigzag ;
+                        for ( ii = 0 ; ii < num ; ii++ ) {
+                            if ( ! get_varint(in, end, zigzag) ) {
+                                return false ;
+                            }
+                            value += (zigzag >> 1) ^ (0 - (zigzag & 1)) ;
+                            store_value(base + ii * stride, size, value) ;
+                        }
+                        return true ;
+                    }
+                    default:
+                        if ( (size_t)(end - in) < num * size ) {
+                            return false ;
+                        }
+                        for ( ii = 0 ; ii < num ; ii++ ) {
+                            memcpy(base + ii * stride, in + ii * size, size) ;
+                        }
+                        return true ;
+                }
+            }
+
+            /**
+              LZ77 byte codec.  A sequence is a token byte holding the literal count in the high nibble and the
+              match length - 4 in the low nibble, counts of 15 continued in following bytes of 255, the literals,
+              a 2 byte match offset and the match length continuation.  The last sequence has only literals.
+            */
+            static void lz_compress( const unsigned char * in , size_t num , std::vector<unsigned char> & out ) {
+
+                static const int hash_bits = 12 ;
+                uint32_t table[1 << hash_bits] ;
+                size_t ii = 0 , anchor = 0 ;
+
+                memset(table, 0, sizeof(table)) ;
+                while ( num >= 12 && ii + 12 <= num ) {
+                    uint32_t word ;
+                    memcpy(&word, in + ii, 4) ;
+                    uint32_t hash = (word * 2654435761U) >> (32 - hash_bits) ;
+                    size_t cand = table[hash] ;
+                    table[hash] = (uint32_t)ii + 1 ;
+                    if ( cand > 0 && ii + 1 - cand <= 65535 && ! memcmp(in + cand - 1, in + ii, 4) ) {
+                        cand-- ;
+                        size_t len = 4 ;
+                        while ( ii + len < num && in[cand + len] == in[ii + len] ) {
+                            len++ ;
+                        }
+                        lz_sequence(out, in + anchor, ii - anchor, ii - cand, len) ;
+                        ii += len ;
+                        anchor = ii ;
+                    } else {
+                        ii++ ;
+                    }
+                }
+                lz_sequence(out, in + anchor, num - anchor, 0, 0) ;
+            }
+
+            /** @return false if the input is corrupt or does not decompress to exactly num bytes */
+            static bool lz_decompress( const unsigned char * in , size_t in_num , unsigned char * out , size_t num ) {
+
+                const unsigned char * end = in + in_num ;
+                size_t pos = 0 ;
+
+                while ( in < end ) {
+                    unsigned char token = *in++ ;
+                    size_t lits = token >> 4 ;
+                    if ( lits == 15 && ! lz_count(in, end, lits) ) {
+                        return false ;
+                    }
+                    if ( (size_t)(end - in) < lits || num - pos < lits ) {
+                        return false ;
+                    }
+                    memcpy(out + pos, in, lits) ;
+                    in += lits ;
+                    pos += lits ;
+                    if ( in == end ) {
+                        break ;
+                    }
+                    if ( end - in < 2 ) {
+                        return false ;
+                    }
+                    size_t offset = in[0] | (in[1] << 8) ;
+                    in += 2 ;
+                    size_t len = token & 0x0f ;
+                    if ( len == 15 && ! lz_count(in, end, len) ) {
+                        return false ;
+                    }
+                    len += 4 ;
+                    if ( offset == 0 || offset > pos || num - pos < len ) {
+                        return false ;
+                    }
+                    /* Matches may overlap the bytes they produce, copy a byte at a time. */
+                    for ( size_t jj = 0 ; jj < len ; jj++ , pos++ ) {
+                        out[pos] = out[pos - offset] ;
+                    }
+                }
+                return pos == num ;
+            }
+
+        private:
+
+            static void lz_length( std::vector<unsigned char> & out , size_t count ) {
+                while ( count >= 255 ) {
+                    out.push_back(255) ;
+                    count -= 255 ;
+                }
+                out.push_back((unsigned char)count) ;
+            }
+
+            static bool lz_count( const unsigned char *& in , const unsigned char * end , size_t & count ) {
+                unsigned char byte ;
+                do {
+                    if ( in == end ) {
+                        return false ;
+                    }
+                    byte = *in++ ;
+                    count += byte ;
+                } while ( byte == 255 ) ;
+                return true ;
+            }
+
+            static void lz_sequence( std::vector<unsigned char> & out , const unsigned char * lits , size_t num_lits ,
+             size_t offset , size_t len ) {
+                size_t match = ( len > 0 ) ? len - 4 : 0 ;
+                out.push_back((unsigned char)(((num_lits < 15 ? num_lits : 15) << 4) | (match < 15 ? match : 15))) ;
+                if ( num_lits >= 15 ) {
+                    lz_length(out, num_lits - 15) ;
+                }
+                out.insert(out.end(), lits, lits + num_lits) ;
+                if ( len > 0 ) {
+                    out.push_back((unsigned char)offset) ;
+                    out.push_back((unsigned char)(offset >> 8)) ;
+                    if ( match >= 15 ) {
+                        lz_length(out, match - 15) ;
+                    }
+                }
+            }
+    } ;
+
+}
+
+#endif
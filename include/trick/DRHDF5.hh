@@ -119,6 +119,12 @@ GROUP "/" {
             */
             virtual int write_data(bool must_write = false) ;
 
+            /**
+             @brief HDF5 writes each variable from its own buffer, so record major buffers are not supported.
+             @returns always false
+            */
+            virtual bool supports_record_major() ;
+
             /**
              @copybrief Trick::DataRecordGroup::format_specific_write_data
              */
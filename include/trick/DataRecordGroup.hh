@@ -42,11 +42,23 @@ namespace Trick {
         DR_Not_Specified = 3    /**< Unknown type */
     } ;
 
+    /**
+     * The DR_Overflow_Policy enumeration represents what a DR_Buffer group does when the writer thread
+     * falls behind and the buffer is full.
+     */
+    enum DR_Overflow_Policy {
+        DR_Overflow_Block = 0,       /**< write the buffer to disk from the recording job, waiting for the writer thread */
+        DR_Overflow_Drop_Oldest = 1, /**< drop the oldest records the writer thread has not started writing */
+        DR_Overflow_Drop_Newest = 2  /**< drop the records being recorded */
+    } ;
+
     class DataRecordBuffer {
         public:
             char *buffer;       /* ** generic holding buffer for data */
             char *curr_buffer;  /* ** current position in the buffer */
             char *last_value;   /* ** holding buffer for last value, used for DR_Changes_step */
+            unsigned int stride ; /* ** bytes from one record of this variable to the next in buffer */
+            bool shared_buffer ; /* ** buffer points into the group's record arena and is not freed here */
             REF2 * ref ;        /* ** size/address/units information of variable */
             bool ref_searched ; /* ** reference information has been searched */
             std::string name ;      /* ** actual name of the variable to record */
@@ -55,6 +67,17 @@ namespace Trick {
             ~DataRecordBuffer() ;
     } ;
 
+    /**
+     * One memcpy of the record major copy plan.  Adjacent variables in memory are copied together.
+     */
+    class DataRecordCopy {
+        public:
+            char * address ;    /* ** source address, NULL if it is looked up every record */
+            DataRecordBuffer * drb ; /* ** variable whose address is looked up every record */
+            unsigned int offset ; /* ** offset of the copy in the record */
+            unsigned int size ; /* ** bytes to copy */
+    } ;
+
     class DataRecordGroup : public Trick::SimObject {
 
         public:
@@ -109,12 +132,36 @@ namespace Trick {
             /** Maximum records to hold in memory before writing.\n */
             unsigned int max_num;       /**< trick_io(*io) trick_units(--) */
 
-            /** Current buffering record number.\n */
+            /** Current buffering record number.  Written only by data_record, published with release stores.\n */
             unsigned int buffer_num;    /**< trick_io(**) trick_units(--) */
 
-            /** Current write to file record number.\n */
+            /** Current write to file record number.  Records before it are written, being written, or dropped.\n */
             unsigned int writer_num;    /**< trick_io(**) trick_units(--) */
 
+            /** Yes = store the records in one record major arena instead of one buffer per variable.\n */
+            bool record_major ;         /**< trick_io(*io) trick_units(--) */
+
+            /** Bytes in one record of the record major arena.\n */
+            unsigned int record_bytes ; /**< trick_io(**) trick_units(--) */
+
+            /** Record major arena holding max_num records.\n */
+            char * record_arena ;       /**< trick_io(**) */
+
+            /** Copies that fill one record of the record major arena.\n */
+            std::vector <Trick::DataRecordCopy> record_copies ; /**< trick_io(**) */
+
+            /** What a DR_Buffer group does when the buffer is full, typically from enum DR_Overflow_Policy.\n */
+            DR_Overflow_Policy overflow_policy ; /**< trick_io(*io) trick_units(--) */
+
+            /** Number of times the recording job wrote a full buffer to disk itself.\n */
+            unsigned long long num_blocked ;        /**< trick_io(*io) trick_units(--) */
+
+            /** Number of records dropped to make room for newer records.\n */
+            unsigned long long num_dropped_oldest ; /**< trick_io(*io) trick_units(--) */
+
+            /** Number of new records dropped because the buffer was full.\n */
+            unsigned long long num_dropped_newest ; /**< trick_io(*io) trick_units(--) */
+
             /** Maximum file size for data record file in bytes.\n */
             uint64_t max_file_size;    /**< trick_io(**) trick_units(--) */
            
@@ -219,6 +266,36 @@ namespace Trick {
             */
             virtual int set_buffer_type(int buffer_type) ;
 
+            /**
+             @brief @userdesc Command to set what a DR_Buffer group does when its buffer is full,
+             DR_Overflow_Block (the default), DR_Overflow_Drop_Oldest, or DR_Overflow_Drop_Newest.
+             The buffer fills when the writer thread cannot write to disk as fast as the group records.
+             @par Python Usage:
+             @code <dr_group>.set_overflow_policy(<policy>) @endcode
+             @param policy - the overflow policy
+             @return 0 if successful, -1 if the policy is not valid
+            */
+            virtual int set_overflow_policy(int policy) ;
+
+            /**
+             @brief @userdesc Command to store the group's records in one contiguous arena (default is false).
+             Each record holds every variable of the group.  The variables after time are recorded in the
+             order of their addresses in memory, so variables next to each other are copied together.
+             Set before the group is initialized.
+             @par Python Usage:
+             @code <dr_group>.set_record_major(<in_record_major>) @endcode
+             @param in_record_major - boolean true stores records in one arena
+             @return 0 if successful, -1 if the recording format does not support it
+            */
+            virtual int set_record_major(bool in_record_major) ;
+
+            /**
+             @brief Returns true if the recording format can write record major buffers.  init() turns
+             record_major off for formats that cannot.
+             @return always true
+            */
+            virtual bool supports_record_major() ;
+
             /**
              @brief @userdesc Command to set the max file size in bytes.
              This tells the data record group when it stops writing to the disk.
@@ -308,6 +385,13 @@ namespace Trick {
             */
             virtual int format_specific_write_data(unsigned int writer_offset) = 0 ;
 
+            /**
+             @brief Transfer num_records consecutive records in the recording buffer to disk.  The default
+             calls format_specific_write_data for each record.
+             @returns the number of bytes written
+            */
+            virtual int format_specific_write_records(unsigned int writer_offset, unsigned int num_records) ;
+
             /**
              @brief Shutdown loggroup. implemented in derived groups.
              @returns always 0
@@ -412,9 +496,42 @@ namespace Trick {
             /** Max number of digits to expect per recorded value.\n */
             static const unsigned int record_size = 25; /**< trick_io(**) trick_units(--) */
 
-            /** Data thread condition mutex.  */
+            /**
+             @brief Sorts the variables by address, lays out the record major arena, and builds the copy plan.
+            */
+            void init_record_arena() ;
+
+            /**
+             @brief Called by data_record to make room for num_records new records.  Handles a full buffer
+             according to the buffer type and overflow policy.
+             @param num_records - number of records data_record is about to add
+             @return true if the records may be added, false if they are dropped
+            */
+            bool reserve_records( unsigned int num_records ) ;
+
+            /**
+             @brief Called by the writer to claim the oldest unwritten records.  data_record will not
+             overwrite claimed records until release_records is called.
+             @param max_records - maximum number of records to claim
+             @param first - set to the record number of the first claimed record
+             @param contiguous - do not claim records past the end of the ring
+             @return the number of records claimed
+            */
+            unsigned int claim_records( unsigned int max_records , unsigned int & first , bool contiguous = false ) ;
+
+            /**
+             @brief Called by the writer when the claimed records are written.
+            */
+            void release_records() ;
+
+            /** Serializes the writers of this group.  The recording job takes it only when it writes
+                the buffer itself.  */
             pthread_mutex_t buffer_mutex;    /**< trick_io(**) */
 
+            /** Records the writer is writing.  The first record number is in the upper 32 bits and the
+                number of records in the lower 32 bits, so both are read at once.  0 records when idle.\n */
+            unsigned long long writer_claim ; /**< trick_io(**) */
+
             /** Current time saved in Trick::DataRecordGroup::data_record.\n */
             double curr_time ;          /**< trick_io(*i) trick_units(--) */
 
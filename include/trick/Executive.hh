@@ -84,6 +84,15 @@ namespace Trick {
             /** Allows the current thread to give up the cpu during multi process job completion and dependency checking.\n */
             bool rt_nap;                      /**< trick_units(--) */
 
+            /** Use the time indexed search in the thread scheduled job queues.\n */
+            bool indexed_job_queues;          /**< trick_units(--) */
+
+            /** How the main thread waits for scheduled child threads to complete.\n */
+            Trick::ThreadCompletionType thread_completion_type ; /**< trick_units(--) */
+
+            /** Barrier the main thread waits on when thread_completion_type is TC_BARRIER.\n */
+            Trick::ThreadCompletionBarrier thread_completion_barrier ; /**< trick_units(--) */
+
             /** Software frame time.  The end_of_frame jobs will be run at this frequency.\n */
             double software_frame;            /**< trick_units(s) */
 
@@ -407,6 +416,14 @@ namespace Trick {
             */
             bool get_rt_nap() ;
 
+            /**
+             @userdesc Command to get the indexed job queue toggle value.
+             @par Python Usage:
+             @code <my_int> = trick.exec_get_indexed_job_queues() @endcode
+             @return boolean (C integer 0/1) Executive::indexed_job_queues
+            */
+            bool get_indexed_job_queues() ;
+
             /**
              @userdesc Command to get starting index to first scheduled class job.
              @par Python Usage:
@@ -633,6 +650,42 @@ namespace Trick {
              */
             int set_rt_nap(bool on_off) ;
 
+            /**
+             @userdesc Command to enable the time indexed search in the thread scheduled job queues.
+             When enabled each thread keeps its scheduled jobs in a calendar ordered by next call time so that
+             each time step visits only the jobs that are due.  Jobs due at the same time run in the same
+             job class, phase, sim_object, and job order as the default linear search.
+             The default behavior (indexed_job_queues is disabled) is to test every job in the queue each time step.
+             @par Python Usage:
+             @code trick.exec_set_indexed_job_queues(<on_off>) @endcode
+             @param on_off - boolean yes (C integer 1) = enable indexed queues, no (C integer 0) = linear search
+             @return always 0
+             */
+            int set_indexed_job_queues(bool on_off) ;
+
+            /**
+             @userdesc Command to select how the main thread waits for scheduled child threads to complete.
+             With Trick.TC_SPIN (the default) the main thread spins on each child's completion flag, giving
+             up the processor only if rt_nap is set.  With Trick.TC_BARRIER the main thread waits once on a
+             counting barrier for all scheduled children.  It spins for the barrier spin count and then sleeps
+             until the last child completes, so it does not burn a core when there are more threads than cores.
+             @par Python Usage:
+             @code trick.exec_set_thread_completion_type(<type>) @endcode
+             @param type - Trick::ThreadCompletionType as an integer
+             @return 0 if successful, -1 if type does not exist
+             */
+            int set_thread_completion_type(int type) ;
+
+            /**
+             @userdesc Command to set the number of times the main thread tests for child completion before
+             sleeping when the completion type is Trick.TC_BARRIER.
+             @par Python Usage:
+             @code trick.exec_set_thread_completion_spin_count(<spin_count>) @endcode
+             @param spin_count - number of completion tests before blocking.  0 blocks immediately.
+             @return always 0
+             */
+            int set_thread_completion_spin_count(unsigned int spin_count) ;
+
             /**
              @userdesc Command to set the real-time frame for real-time synchronization.
              @par Python Usage:
@@ -1201,6 +1254,20 @@ namespace Trick {
             */
             virtual int set_thread_cpu_affinity(unsigned int thread_id , int cpu_num) ;
 
+            /**
+             @userdesc Command to call a thread's independent scheduled jobs in parallel on a pool of worker threads.
+             Jobs due in the same time step with the same job class and phase are split by sim object.  The jobs of
+             each sim object are called in order on one worker while different sim objects run in parallel.  Job
+             classes and phases still run in order.  System and instrumented jobs are called serially.
+             Jobs in different sim objects of the same class and phase must not share data they write.
+             @par Python Usage:
+             @code trick.exec_set_thread_parallel_jobs(<thread_id>, <num_workers>) @endcode
+             @param thread_id - thread id as specified in S_define file
+             @param num_workers - number of worker threads added to the thread.  0 calls jobs serially.
+             @return 0 if successful, -2 if thread does not exist, -1 if the workers are already running.
+            */
+            virtual int set_thread_parallel_jobs(unsigned int thread_id , unsigned int num_workers) ;
+
             /**
              @userdesc Command to run the simulation (after a freeze). Set exec_command to RunCmd.
              @par Python Usage:
@@ -79,7 +79,8 @@ namespace Trick {
             /** Save the name of the trick master/slave sim object.\n */
             std::string ms_sim_object_name;      /**<  trick_io(**) */
 
-            Trick::Clock & clock ;               /**<  trick_io(**) */
+            /** Clock used to time the logged jobs.\n */
+            Trick::Clock * clock ;               /**<  trick_io(**) */
 
             /**
              @brief Constructor.
@@ -156,6 +157,10 @@ namespace Trick {
             */
             int shutdown() ;
 
+            /**
+             @brief Sets the clock used to time the logged jobs.  Use a nanosecond clock together with a
+             time_tic_value of 1000000000 to log job times with nanosecond resolution.
+            */
             void set_clock(Trick::Clock & in_clock) ;
 
         private:
@@ -81,6 +81,35 @@ namespace Trick {
             */
             virtual int parse_condition(std::string in_string, int & cond_return_val) ;
 
+            /**
+             @brief Compile the given string as a condition expression, to be evaluated by eval_condition().
+             @return the compiled code, or NULL if python is not running or the string does not compile.
+            */
+            void * compile_condition(std::string in_string) ;
+
+            /**
+             @brief Compile the given string as python statements, to be run by run_action().
+             @return the compiled code, or NULL if python is not running or the string does not compile.
+            */
+            void * compile_action(std::string in_string) ;
+
+            /**
+             @brief Evaluate a condition compiled by compile_condition().
+             @return 0 on success, -1 if python raised an exception.
+            */
+            int eval_condition(void * code, int & cond_return_val) ;
+
+            /**
+             @brief Run statements compiled by compile_action().
+             @return 0 on success, -1 if python raised an exception.
+            */
+            int run_action(void * code) ;
+
+            /**
+             @brief Release code returned by compile_condition() or compile_action().
+            */
+            void release_code(void * code) ;
+
             /**
              @brief Restore variables with memory manager names to python space.
              @return always 0
@@ -92,6 +121,20 @@ namespace Trick {
             /** false = see units conversion messages, true = head in sand */
             bool units_conversion_msgs ;
 
+            /** Globals of the __main__ module, where compiled conditions and actions run.\n */
+            void * main_dict ;                            /**< trick_io(**) trick_units(--) */
+
+            /**
+             @brief Compile in_string with the given python start symbol.
+            */
+            void * compile_string(std::string in_string, int start) ;
+
+            /**
+             @brief Run compiled code in main_dict.
+             @return the result of the code, or NULL with the python error printed.
+            */
+            void * eval_code(void * code) ;
+
     } ;
 
 }
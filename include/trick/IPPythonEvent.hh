@@ -17,6 +17,7 @@ namespace Trick {
 
     class IPPython ;
     class MTV ;
+    class ConditionExpression ;
 
     /** Data associated with each event condition.\n */
     struct condition_t {
@@ -42,6 +43,10 @@ namespace Trick {
         Trick::JobData * job ;                  /**< trick_io(**) trick_units(--) */
         /** Type of condition string: 0=python, 1=variable, 2=job.\n */
         int  cond_type ;                        /**< trick_io(*io) trick_units(--) */
+        /** Compiled python condition string, NULL until it is compiled.\n */
+        void * code ;                           /**< trick_io(**) trick_units(--) */
+        /** Condition string compiled to native code, NULL if the string is left to python.\n */
+        Trick::ConditionExpression * expr ;     /**< trick_io(**) trick_units(--) */
     } ;
 
     /** Data associated with each event action.\n */
@@ -64,6 +69,8 @@ namespace Trick {
         JobData * job ;                         /**< trick_io(**) trick_units(--) */
         /** Type of action string: 0=python, 1=job ON, 2=job OFF 3=job call.\n */
         int  act_type ;                         /**< trick_io(*io) trick_units(--) */
+        /** Compiled python action string, NULL until it is compiled.\n */
+        void * code ;                           /**< trick_io(**) trick_units(--) */
     } ;
 
 /**
@@ -110,6 +117,14 @@ namespace Trick {
             int ran_count ;                         /**< trick_io(*io) trick_units(--) */
             /** @userdesc Last simulation time that this event ran an action.\n */
             double ran_time ;                       /**< trick_io(*io) trick_units(s) */
+            /** @userdesc Wall clock time of the last evaluation of the event's conditions and actions.\n */
+            double eval_time ;                      /**< trick_io(*io) trick_units(s) */
+            /** @userdesc Longest wall clock time of an evaluation of the event's conditions and actions.\n */
+            double max_eval_time ;                  /**< trick_io(*io) trick_units(s) */
+            /** @userdesc Sum of the wall clock times of all evaluations of the event's conditions and actions.\n */
+            double total_eval_time ;                /**< trick_io(*io) trick_units(s) */
+            /** @userdesc Count of how many times the event's conditions and actions were evaluated.\n */
+            int eval_count ;                        /**< trick_io(*io) trick_units(--) */
             /** Array of event's conditions.\n */
             condition_t ** condition_list ;         /**< trick_io(*io) trick_units(--) */
             /** Array of event's actions.\n */
@@ -193,6 +208,33 @@ namespace Trick {
             */
             static void terminate_on_event_parse_error(bool on_off);
 
+            /**
+             @brief @userdesc Command to set whether condition strings made only of arithmetic and comparisons
+             of simulation variables and numbers are compiled to native code instead of evaluated by python.
+             Applies to conditions set after the command.  Set to true by default.
+             @par Python Usage:
+             @code trick.native_event_conditions(True|False) @endcode
+            */
+            static void native_event_conditions(bool on_off);
+
+            /**
+             @brief @userdesc Command to set whether python actions of events fired on a child thread are queued and
+             run by the main thread at the end of its frame, so that the child thread does not wait for the input
+             processor.  Set to false by default, the actions run on the child thread when they fire.  When true
+             the actions run after the jobs of the frame, so jobs of the child thread that follow the event do not
+             see their effects.  Actions of events added before or after a job always run when they fire.
+             @par Python Usage:
+             @code trick.defer_thread_event_actions(True|False) @endcode
+            */
+            static void defer_thread_event_actions(bool on_off);
+
+            /**
+             @brief Run the python actions queued by events fired on child threads, in the order they fired.
+             Called on the main thread at the end of each frame.
+             @return always 0
+            */
+            static int run_deferred_actions() ;
+
             /**
              @brief called by the event manager when the event is loaded from a checkpoint
             */
@@ -400,6 +442,13 @@ namespace Trick {
             */
             double action_ran_time(int num) ;
 
+            /**
+             @brief @userdesc Command to zero the event's evaluation times and count.
+             @par Python Usage:
+             @code <event_object>.reset_eval_time() @endcode
+            */
+            void reset_eval_time() ;
+
             virtual int process( long long curr_time ) ;
 
             bool process_user_event( long long curr_time ) ;
@@ -414,6 +463,12 @@ namespace Trick {
   
         private:
 
+            /* Evaluate a python condition string, compiling it the first time */
+            int eval_python_condition( condition_t * cond, int & return_val ) ;
+
+            /* Run a python action string, compiling it the first time */
+            int run_python_action( action_t * act ) ;
+
             /* A static pointer to the python input processor set at the S_define level */
             static Trick::IPPython * ip ;
 
@@ -422,6 +477,15 @@ namespace Trick {
 
             /* Defaults to false */
             static bool terminate_sim_on_event_python_error;
+
+            /* Defaults to true */
+            static bool compile_native_conditions;
+
+            /* Defaults to false */
+            static bool defer_actions;
+
+            /* Set the compiled code of a condition from its string */
+            void compile_condition( condition_t * cond ) ;
     } ;
 
 }
@@ -53,7 +53,7 @@ namespace Trick {
     public:
 
         Integrator();
-        virtual ~Integrator() {};
+        virtual ~Integrator();
 
         virtual void initialize(int State_size, double Dt) = 0;
         virtual int integrate() = 0;
@@ -118,6 +118,31 @@ namespace Trick {
 #endif
         ;
 
+        /**
+         * Register size contiguous states and their size contiguous derivatives
+         * as the next elements of the state vector.  Spans are registered once;
+         * integrate_state_spans() then copies them in and out each pass with
+         * memcpy instead of an argument list of pointers per element.  The spans
+         * are checkpointed with the integrator, so a checkpoint reload restores
+         * them.  Only 1st order DiffEQ techniques accept spans.
+         * @return 0 on success, 1 if the spans exceed num_state or the
+         *         technique is 2nd order.
+         */
+        int add_state_span (double* state_p, double* deriv_p, unsigned int size);
+
+        /**
+         * Remove all of the registered spans.
+         */
+        void clear_state_spans ();
+
+        /**
+         * Load the registered states on the first intermediate step and their
+         * derivatives on every step, integrate, and store the integrated states
+         * back into the spans.
+         * @return the next intermediate step, 0 when the step is complete.
+         */
+        int integrate_state_spans ();
+
         int num_state;
 
         int intermediate_step;
@@ -149,6 +174,16 @@ namespace Trick {
         virtual void reset() {}
         virtual Integrator_type get_Integrator_type() { return (User_Defined); };
 
+    protected:
+
+        /* The registered spans, in state vector order.  The arrays are allocated
+           with room for num_state spans when the first span is added. */
+        double **span_state;           // -- first state of each span
+        double **span_deriv;           // -- first derivative of each span
+        unsigned int *span_size;       // -- number of states of each span
+        unsigned int num_spans;        // -- number of registered spans
+        unsigned int span_state_size;  // -- number of states in the spans
+
     };
 
     Integrator* getIntegrator( Integrator_type Alg, unsigned int State_size, double Dt = 0.0 );
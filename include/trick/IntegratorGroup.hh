@@ -0,0 +1,146 @@
+/*
+PURPOSE:
+    ( Integrate the states of many objects with one Integrator )
+*/
+
+#ifndef INTEGRATORGROUP_HH
+#define INTEGRATORGROUP_HH
+
+// Local includes
+#include "trick/Integrator.hh"
+
+// System includes
+#include <vector>
+
+namespace Trick {
+
+    /**
+     * An IntegratorGroup integrates the states of many objects that use the
+     * same first order integration technique with a single Integrator.
+     *
+     * Each object registers its state once with add_state(), as a block of
+     * contiguous states and the block of contiguous derivatives of those
+     * states.  getIntegrator() then creates one Integrator sized for all of
+     * the blocks.  The integrator's state, derivative and workspace arrays
+     * hold the values of every object, one array per stage of the technique,
+     * so each intermediate step is one pass over contiguous arrays instead of
+     * a call per object, and the states are copied in and out a block at a
+     * time instead of through variable argument lists.
+     *
+     * The group is integrated by one integration class job that calls
+     * integrate() and names the group's integrator as its integration object,
+     * so the integration loop sets the integrator's time and step and checks
+     * the returned intermediate step as it does for any integration job:
+     * @code
+     * ("integration", &group.integrator) trick_ret = group.integrate() ;
+     * ("restart") group.restart() ;
+     * @endcode
+     *
+     * A checkpoint reload replaces the group's integrator with the one saved
+     * in the checkpoint, so the restart class job registers the blocks on it
+     * again.
+     */
+    class IntegratorGroup {
+
+        public:
+
+            // Types
+
+            /**
+             * A block of contiguous states and their contiguous derivatives.
+             */
+            struct StateBlock {
+                double * state;     //!< trick_io(**)
+                double * deriv;     //!< trick_io(**)
+                unsigned int size;  //!< trick_io(**)
+            };
+
+
+            // Member data
+
+            /**
+             * The integrator of all of the states of the group, NULL until
+             * getIntegrator() is called.
+             */
+            Trick::Integrator* integrator;  //!< trick_units(--)
+
+
+            // Member functions
+
+            /**
+             * Default constructor.
+             */
+            IntegratorGroup ();
+
+            /**
+             * Destructor.  The integrator is not deleted, as with the
+             * integrators of an IntegLoopScheduler.
+             */
+            virtual ~IntegratorGroup () {}
+
+            /**
+             * Add a block of states to the group.
+             * States must be added before getIntegrator() is called.
+             * @param state  The first of size contiguous states.
+             * @param deriv  The first of size contiguous derivatives of the states.
+             * @param size   Number of states in the block.
+             * @return       0 on success, 1 if the integrator was already created.
+             */
+            int add_state (double * state, double * deriv, unsigned int size);
+
+            /**
+             * Create the integrator of all of the states added to the group.
+             * @param alg  The integration technique, which must be a first
+             *             order technique.
+             * @param dt   The integration step, set by the integration loop
+             *             when the group is integrated by one.
+             * @return     The integrator, or NULL if alg is a second order
+             *             technique or the integrator was already created.
+             */
+            Trick::Integrator* getIntegrator (Integrator_type alg, double dt = 0.0);
+
+            /**
+             * Integrate the states of the group through one intermediate step.
+             * The blocks are the state spans of the integrator, so this is
+             * Integrator::integrate_state_spans().
+             * @return  The next intermediate step, 0 when the step is complete.
+             */
+            int integrate ();
+
+            /**
+             * Register the blocks as the state spans of the integrator again,
+             * replacing any spans it has.  Called by a restart class job after
+             * a checkpoint reload.
+             * @return  Always 0.
+             */
+            int restart ();
+
+            /**
+             * @return  The number of states added to the group.
+             */
+            unsigned int get_num_state () const
+            {
+                return num_state;
+            }
+
+        protected:
+
+            /**
+             * Register the blocks as the state spans of the integrator.
+             */
+            void add_state_spans ();
+
+            /**
+             * The blocks of states, in the order they are packed.
+             */
+            std::vector<StateBlock> blocks;  //!< trick_io(**)
+
+            /**
+             * The number of states in all of the blocks.
+             */
+            unsigned int num_state;  //!< trick_io(**)
+
+    };
+}
+
+#endif
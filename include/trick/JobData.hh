@@ -131,6 +131,10 @@ namespace Trick {
             /** time tic value from the executive */
             static long long time_tic_value ;      /**< trick_io(**) */
 
+            /** incremented whenever job call times are changed outside of a ScheduledJobQueue.
+                Jobs on any thread change it, so it is only accessed with the __atomic builtins. */
+            static unsigned long long schedule_epoch ;      /**< trick_io(**) */
+
             /** Constructor for new blank JobData instance */
             JobData() ;
 
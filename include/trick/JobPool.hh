@@ -0,0 +1,179 @@
+/*
+    PURPOSE:
+        (Work stealing pool that calls the independent scheduled jobs of a thread in parallel)
+*/
+
+#ifndef JOBPOOL_HH
+#define JOBPOOL_HH
+
+#include <vector>
+#include <iostream>
+#include <exception>
+#include <pthread.h>
+
+#include "trick/ThreadBase.hh"
+#include "trick/ThreadTrigger.hh"
+#include "trick/ScheduledJobQueue.hh"
+#include "trick/ExecutiveException.hh"
+
+namespace Trick {
+
+    class JobPool ;
+
+    /**
+     * Worker thread owned by a Trick::JobPool.  The worker sleeps until the pool starts a level
+     * of jobs, then calls or steals chains of jobs until the level is empty.
+     */
+    class JobPoolWorker : public Trick::ThreadBase {
+        public:
+            JobPoolWorker( Trick::JobPool * in_pool , unsigned int in_participant , std::string in_name ) ;
+            virtual void * thread_body() ;
+        protected:
+            /** Pool this worker runs jobs for */
+            Trick::JobPool * pool ;         /**< trick_io(**) */
+            /** Index of this worker's task deque in the pool.  0 is the calling thread. */
+            unsigned int participant ;      /**< trick_io(**) */
+    } ;
+
+    /**
+     * Calls the scheduled jobs of one thread that are due at the current time step on a pool of
+     * worker threads.
+     *
+     * The jobs due in a time step are split into levels.  A level holds consecutive jobs with the
+     * same job class and phase.  Levels run one after another in job class order.  Inside a level
+     * the jobs of each sim object form a chain that is called in queue order.  The chains are
+     * independent tasks that the workers and the calling thread run in parallel, stealing chains from
+     * each other when their own deque is empty.  A job that depends on a job in another chain of the
+     * level starts the next level, so jobs only wait for dependencies called in earlier levels or on
+     * other threads.  System jobs and instrumented jobs are called serially by the calling thread.
+     *
+     * The order jobs are called inside one sim object and across job classes and phases is the
+     * serial order.  Jobs in different sim objects of the same class and phase must not write data
+     * the other reads in that step.
+     */
+    class JobPool {
+
+        friend class JobPoolWorker ;
+
+        public:
+
+            JobPool() ;
+            ~JobPool() ;
+
+            /**
+             * Sets the number of worker threads.  0 turns off parallel job calls.
+             * Workers are started the first time they are needed.
+             * @return 0 if successful, -1 if workers are already running
+             */
+            int set_num_workers( unsigned int in_num_workers ) ;
+
+            /**
+             * Gets the number of worker threads.
+             */
+            unsigned int get_num_workers() ;
+
+            /**
+             * Sets the number of times an idle worker tests for a new level before sleeping.
+             * @return always 0
+             */
+            int set_spin_count( unsigned int in_spin_count ) ;
+
+            /**
+             * Calls every job in the queue that is due at time_tics.  Replaces the find_next_job
+             * loop of the serial scheduler.  The caller resets the queue before calling.
+             * @param queue - scheduled job queue of the calling thread
+             * @param time_tics - current simulation time in tics
+             * @param rt_nap - release the processor while waiting on dependencies
+             * @return always 0.  Job errors are thrown as Trick::ExecutiveException in the calling thread,
+             *         other exceptions a job throws are rethrown there.
+             */
+            int call_scheduled_jobs( Trick::ScheduledJobQueue & queue , long long time_tics , bool rt_nap ) ;
+
+            /**
+             * Stops and joins the worker threads.
+             * @return always 0
+             */
+            int shutdown() ;
+
+            /**
+             * Prints pool information to the incoming stream
+             */
+            void dump( std::ostream & oss = std::cout ) ;
+
+            /** Number of levels called */
+            long long num_levels ;          /**< trick_units(--) */
+
+            /** Number of levels that were split across workers */
+            long long num_parallel_levels ; /**< trick_units(--) */
+
+            /** Number of chains a participant took from another participant's deque */
+            long long num_steals ;          /**< trick_units(--) */
+
+        protected:
+
+            /** Deque of chain indexes owned by one participant.  The owner takes from the tail,
+                thieves take from the head. */
+            struct TaskDeque {
+                pthread_mutex_t mutex ;
+                std::vector< unsigned int > tasks ;
+                unsigned int head ;
+                unsigned int tail ;
+            } ;
+
+            int start_workers() ;
+            void worker_loop( unsigned int participant ) ;
+            void call_level( bool rt_nap ) ;
+            void run_tasks( unsigned int participant ) ;
+            bool take_task( unsigned int participant , unsigned int & chain ) ;
+            void call_chain( unsigned int chain ) ;
+            bool call_job( Trick::JobData * job , unsigned int job_index ) ;
+            void wait_for_depends( Trick::JobData * job , bool rt_nap ) ;
+            bool depends_on_level( Trick::JobData * job , unsigned int num_jobs ) ;
+
+            /** Requested number of worker threads */
+            unsigned int num_workers ;      /**< trick_units(--) */
+
+            /** Number of times an idle worker tests for a new level before sleeping */
+            unsigned int spin_count ;       /**< trick_units(--) */
+
+            /** Worker threads, started on first use */
+            std::vector< Trick::JobPoolWorker * > workers ; /**< trick_io(**) */
+
+            /** Task deques.  Index 0 belongs to the calling thread. */
+            std::vector< TaskDeque * > deques ; /**< trick_io(**) */
+
+            /** Jobs of the level being called, in queue order */
+            std::vector< Trick::JobData * > level_jobs ; /**< trick_io(**) */
+
+            /** Chain i holds level_jobs[chain_start[i]] up to level_jobs[chain_start[i+1]] */
+            std::vector< unsigned int > chain_start ; /**< trick_io(**) */
+
+            /** rt_nap of the level being called */
+            bool level_rt_nap ;             /**< trick_io(**) */
+
+            /** Barrier the calling thread waits on until all chains of the level are called */
+            Trick::ThreadCompletionBarrier level_barrier ; /**< trick_io(**) */
+
+            /** Incremented to start a level or shut down */
+            volatile unsigned int generation ; /**< trick_io(**) */
+
+            /** Workers exit when this is set */
+            volatile bool stopping ;        /**< trick_io(**) */
+
+            /** Mutex and condition variable idle workers sleep on */
+            pthread_mutex_t go_mutex ;      /**< trick_io(**) */
+            pthread_cond_t go_cv ;          /**< trick_io(**) */
+
+            /** Protects the failure information */
+            pthread_mutex_t failure_mutex ; /**< trick_io(**) */
+
+            /** Level index of the first job in queue order that failed, or -1 */
+            int failure_index ;             /**< trick_io(**) */
+
+            /** Exception raised by the failed job */
+            std::exception_ptr failure ;    /**< trick_io(**) */
+    } ;
+
+}
+
+#endif
@@ -24,6 +24,7 @@
 #include "trick/var.h"
 
 #include "trick/CheckPointAgent.hh"
+#include "trick/AllocInfoIndex.hh"
 
 // forward declare the units converter types used by ref_assignment
 union cv_converter ;
@@ -31,6 +32,8 @@ struct ut_system ;
 
 namespace Trick {
 
+    class BinaryCheckPointAgent;
+
     typedef std::map<void*, ALLOC_INFO*, std::greater<void*> > ALLOC_INFO_MAP;
     typedef std::map<void*, ALLOC_INFO*, std::greater<void*> >::const_iterator ALLOC_INFO_MAP_ITER ;
     typedef std::map<std::string, ALLOC_INFO*> VARIABLE_MAP;
@@ -280,6 +283,34 @@ namespace Trick {
              */
              void set_hexfloat_checkpoint( bool flag);
 
+            /**
+             Indicate whether a checkpoint should be written as a binary image of the allocations instead of
+             as declarations and assignments.  A binary checkpoint is much faster to write and to restore, but
+             can only be restored by the same build of the simulation.  read_checkpoint() recognizes either
+             format, so the flag may be changed from one checkpoint to the next.
+             @param flag - true: Checkpoints are written by the BinaryCheckPointAgent.
+                           false: (default) Checkpoints are written as text by the current CheckPointAgent.
+             */
+             void set_binary_checkpoint( bool flag);
+
+            /**
+             @return true if checkpoints are written as a binary image.
+             */
+             bool get_binary_checkpoint() { return binary_checkpoint; }
+
+            /**
+             Make the following binary checkpoints incremental.  The contents of the allocations that have not
+             changed since the base checkpoint was written are not written again, they are restored from the base.
+             The base must be a full binary checkpoint written earlier by this simulation run.
+             @param file_name - the base checkpoint, or "" for full checkpoints (default).
+             */
+             void set_checkpoint_base( std::string file_name);
+
+            /**
+             @return the base of incremental checkpoints, or "" if checkpoints are full.
+             */
+             std::string get_checkpoint_base() { return checkpoint_base; }
+
             /**
              Set the value(s) of the variable at the given address to 0, 0.0, NULL, false or "", as appropriate for the type.
              @param address - The address of the variable to be cleared.
@@ -543,6 +574,12 @@ namespace Trick {
              */
             ALLOC_INFO* get_alloc_info_of( void* addr);
 
+            /**
+             Get the allocation epoch, which changes whenever an allocation is added, moved or removed.
+             An address found by get_alloc_info_of() stays valid while the epoch is unchanged.
+             */
+            unsigned long long get_alloc_epoch() { return alloc_info_index.get_epoch(); }
+
             /**
              Get information for the allocation starting at the specified address.
              @param addr The Address.
@@ -673,12 +710,16 @@ namespace Trick {
             const char* extern_anon_var_prefix; /**< -- Temporary-variable-name prefix. */
             CheckPointAgent* currentCheckPointAgent; /**< ** currently active Check point agent. */
             CheckPointAgent* defaultCheckPointAgent; /**< ** the classic Check point agent. */
+            BinaryCheckPointAgent* binaryCheckPointAgent; /**< ** the binary Check point agent. */
 
             bool reduced_checkpoint;    /**< -- true = Don't write zero valued variables in the checkpoint. false= Write all values. */
             bool hexfloat_checkpoint;   /**< -- true = Represent floating point values as hexidecimal to preserve precision. false= Normal. */
+            bool binary_checkpoint;     /**< -- true = Write checkpoints as a binary image. false= Write them as text. */
+            std::string checkpoint_base; /**< -- Base checkpoint of incremental binary checkpoints, "" = Write full checkpoints. */
             bool expanded_arrays;       /**< -- true = array element values are set in separate assignments. */
 
             ALLOC_INFO_MAP  alloc_info_map;  /**< ** Map of <address, ALLOC_INFO*> key-value pairs for each of the managed allocations. */
+            AllocInfoIndex  alloc_info_index; /**< ** Sorted address index of the allocations in alloc_info_map, used by get_alloc_info_of(). */
             VARIABLE_MAP    variable_map;    /**< ** Map of <name, ALLOC_INFO*> key-value pairs for each named-allocations. */
             ENUMERATION_MAP enumeration_map; /**< ** Enumeration map. */
             pthread_mutex_t mm_mutex;        /**< ** Mutex to control access to memory manager maps */
@@ -177,6 +177,18 @@ namespace Trick {
         /** Remote program name. */
         std::string S_main_name;              /**< \n trick_units(--) */
 
+        /** Forked by the master as a local worker instead of started through a shell. */
+        bool local;                      /**< \n trick_units(--) */
+
+        /** Write end of the pipe over which a local worker receives dispatches, -1 if not open. */
+        int dispatch_fd;                 /**< \n trick_units(--) */
+
+        /** Read end of the pipe over which a local worker returns results, -1 if not open. */
+        int result_fd;                   /**< \n trick_units(--) */
+
+        /** Process id of a local worker. */
+        int pid;                         /**< \n trick_units(--) */
+
         void set_S_main_name(std::string name);    /**< \n trick_units(--) */
 
         /**
@@ -193,7 +205,11 @@ namespace Trick {
             num_results(0),
             cpu_time(0),
             remote_shell(Trick::TRICK_SSH),
-            multiplier(1) {
+            multiplier(1),
+            local(false),
+            dispatch_fd(-1),
+            result_fd(-1),
+            pid(0) {
             if (name.empty()) {
                 machine_name = "localhost";
             }
@@ -274,6 +290,12 @@ namespace Trick {
             MC_ALL            /**< report all messages (error, informational & warning) */
         };
 
+        /** Point in the slave initialization where a child process is forked for each run. */
+        enum ForkPoint {
+            MC_FORK_PRE_INIT, /**< fork at the start of initialization, each run executes every initialization job */
+            MC_FORK_POST_INIT /**< fork after the initialization jobs, the runs share the slave's initialized state */
+        };
+
         /** Options to be passed to the slave sim. */
         std::string slave_sim_options;
 
@@ -301,6 +323,14 @@ namespace Trick {
 
         void default_slave_dispatch_pre_text(Trick::MonteSlave*, std::string &buffer) ;
 
+        void spawn_local_worker(Trick::MonteSlave* slave_to_init) ;
+
+        void pin_local_worker(unsigned int cpu) ;
+
+        int connect_to_master() ;
+
+        void disconnect() ;
+
         protected:
         /** Indicates whether or not this is a Monte Carlo simulation. */
         bool enabled;                                    /**< \n trick_units(--) */
@@ -347,6 +377,36 @@ namespace Trick {
         /** Highest level of messages to report. */
         Verbosity verbosity;                            /**< \n trick_units(--) */
 
+        /** Point in initialization where slaves fork each run. Defaults to MC_FORK_PRE_INIT. */
+        ForkPoint fork_point;                           /**< \n trick_units(--) */
+
+        /** Number of local workers the master forks on this machine. Defaults to zero. */
+        unsigned int num_local_workers;                 /**< \n trick_units(--) */
+
+        /** CPU the first local worker is pinned to, the others use the following CPUs. -1 does not pin them. */
+        int local_worker_first_cpu;                     /**< \n trick_units(--) */
+
+        /**
+         * Pipe read by #read and the slave protocol instead of #connection_device: in a local worker the pipe of
+         * its dispatches, in the master the result pipe of the local worker being handled. -1 otherwise.
+         */
+        int local_read_fd;                              /**< \n trick_units(--) */
+
+        /** Pipe written by #write and the slave protocol instead of #connection_device, paired with #local_read_fd. */
+        int local_write_fd;                             /**< \n trick_units(--) */
+
+        /**
+         * Data of the slave post jobs of a local worker's run.  The worker sends it after the exit status with its
+         * length, so the master can read it for the master post jobs or skip it.
+         */
+        std::string local_results;                      /**< \n trick_io(**) trick_units(--) */
+
+        /** Position of the next #read in #local_results. */
+        std::string::size_type local_results_read;      /**< \n trick_io(**) trick_units(--) */
+
+        /** While set, #write appends to #local_results in a local worker and #read reads it in the master. */
+        bool buffer_local_results;                      /**< \n trick_io(**) trick_units(--) */
+
         /** Device over which connections are accepted. */
         TCDevice listen_device;                         /**< \n trick_units(--) */
 
@@ -461,6 +521,14 @@ namespace Trick {
          */
         int execute_monte();
 
+        /**
+         * S_define level job run at the end of initialization.  When #fork_point is MC_FORK_POST_INIT, slaves wait
+         * for runs here instead of in #execute_monte, so each run is forked from the initialized slave.
+         *
+         * @return 0 on success
+         */
+        int execute_monte_post_init();
+
         /**
          * Sets #enabled.
          *
@@ -531,6 +599,45 @@ namespace Trick {
          */
         double get_timeout();
 
+        /**
+         * Sets #fork_point.  Set it in the input file so the slaves read it too.
+         *
+         * With MC_FORK_POST_INIT a slave executes the initialization jobs once, up to the data recording
+         * initialization, and forks a child process for each run from that state.  The child applies the run's
+         * variable assignments, runs the slave pre run jobs, and finishes initialization.  Only use it when the
+         * initialization jobs do not depend on the Monte Carlo variables, or recompute what does in slave pre run jobs.
+         * Files opened by the initialization jobs are in the slave's output directory.  The default sim objects open the
+         * message files again in the run's output directory in slave pre run jobs.
+         */
+        void set_fork_point(ForkPoint fork_point);
+
+        /**
+         * Gets #fork_point.
+         */
+        ForkPoint get_fork_point();
+
+        /**
+         * Sets #num_local_workers.  The master forks this many slaves itself and exchanges runs and results with
+         * them over pipes, without remote shells or sockets.  They are added to any slaves added with add_slave().
+         */
+        void set_local_workers(unsigned int num_workers);
+
+        /**
+         * Gets #num_local_workers.
+         */
+        unsigned int get_local_workers();
+
+        /**
+         * Sets #local_worker_first_cpu.  Local worker N is pinned to CPU first_cpu + N through the CPU affinity of
+         * the main thread, so its runs execute on that CPU.
+         */
+        void set_local_worker_first_cpu(int first_cpu);
+
+        /**
+         * Gets #local_worker_first_cpu.
+         */
+        int get_local_worker_first_cpu();
+
         /**
          * Sets #max_tries.
          */
@@ -774,7 +881,13 @@ namespace Trick {
          */
         int  get_connection_device_port() ;
 
+        /**
+         * Writes to the other side of the current run: the master in slave jobs, the slave in master jobs.
+         * Uses the local worker pipe when there is one, the socket connection otherwise.
+         */
         int write(char* data, int size);
+
+        /** Reads from the other side of the current run, see #write. */
         int read(char* data, int size);
 
 #if 0
@@ -809,6 +922,24 @@ namespace Trick {
         /** Receives from any slaves that are ready to return results. */
         void receive_results();
 
+        /** Receives from the local workers that are ready to return results. */
+        void receive_local_results();
+
+        /**
+         * Sends a run's exit status from a local worker to the master, followed by the length of #local_results and
+         * its data.
+         *
+         * @param exit_status the exit status of the run
+         */
+        void write_local_results(int exit_status);
+
+        /**
+         * Reads the length and the data that follow a local worker's exit status into #local_results.
+         *
+         * @return 0 on success, -1 if the pipe was closed
+         */
+        int read_local_results();
+
         void handle_initialization(MonteSlave& slave);
         void handle_run_data(MonteSlave& slave);
         void set_disconnected_state(MonteSlave& slave);
@@ -0,0 +1,37 @@
+/*
+PURPOSE:
+    ( Nanosecond resolution CLOCK_MONOTONIC_RAW Clock )
+*/
+
+#ifndef NANOSECONDCLOCK_HH
+#define NANOSECONDCLOCK_HH
+
+#include "trick/Clock.hh"
+
+namespace Trick {
+
+    /**
+     * Clock that reads CLOCK_MONOTONIC_RAW and keeps the full nanosecond resolution.
+     * The raw monotonic clock is not slewed by NTP, so frame timing is not disturbed
+     * by time corrections.  Reports 1000000000 tics per second.
+     */
+    class NanosecondClock : public Clock {
+
+        public:
+
+            NanosecondClock() ;
+            ~NanosecondClock() ;
+
+            /** @copybrief Trick::Clock::clock_init() */
+            virtual int clock_init() ;
+
+            /** @copybrief Trick::Clock::wall_clock_time() */
+            virtual long long wall_clock_time() ;
+
+            /** @copybrief Trick::Clock::clock_stop() */
+            virtual int clock_stop() ;
+    } ;
+
+}
+
+#endif
@@ -7,6 +7,9 @@
 #define SCHEDULEDJOBQUEUE_HH
 
 #include <string>
+#include <vector>
+#include <map>
+#include <utility>
 
 #include "trick/JobData.hh"
 
@@ -15,7 +18,9 @@ namespace Trick {
     /**
      * The ScheduledJobQueue is specifically for the scheduled jobs.  It does not
      * allocate memory during normal cycling through jobs and is considerably
-     * faster than the generalized priority_queue.
+     * faster than the generalized priority_queue.  The list is kept sorted and
+     * grows by doubling, so jobs are added and removed with a binary search and
+     * a shift instead of a reallocation of the whole list.
      *
      * @author Robert W. Bailey
      * @author many other Trick developers of the past who did not add their names.
@@ -43,7 +48,7 @@ namespace Trick {
              * @brief Adds a new job into list. The exact placement of job is dependent on
              * job_class, phase , sim_object order , and finally job order in sim object.
              * @param in_job - Job to add to the list
-             * @return always 0.
+             * @return 0, or -1 if the list could not be grown.
              */
             int push(JobData * in_job ) ;
 
@@ -59,7 +64,7 @@ namespace Trick {
             /**
              * @brief Removes a job from the list if present.
              * @param in_job - Job to remove to the list
-             * @return always 0.
+             * @return 0 if the job was removed, -1 if it was not found.
              */
             int remove(JobData * in_job ) ;
 
@@ -190,12 +195,95 @@ namespace Trick {
              */
             int test_next_job_call_time(Trick::JobData * curr_job, long long time_tics) ;
 
+            /**
+             * @brief Turns on/off the time indexed search used by find_next_job(long long).  When on, the
+             * non-system jobs are kept in a calendar of groups of jobs that share the same next call time and
+             * cycle so that each pass only visits the jobs that are due.  System class jobs reschedule
+             * themselves and are always checked.  Jobs are still returned in job_class, phase, sim_object,
+             * and job id order.
+             * @param yes_no - true to use the time index, false to use the linear search
+             * @return always 0
+             */
+            int set_indexed(bool yes_no) ;
+
+            /**
+             * @brief Returns whether the time indexed search is in use.
+             * @return true if find_next_job(long long) uses the time index.
+             */
+            bool get_indexed() ;
+
+            /**
+             * @brief Forces the time index to be rebuilt on the next call to find_next_job(long long).
+             * Code that moves a job's next_tics earlier without calling JobData::set_next_call_time
+             * should call this.
+             * @return always 0
+             */
+            int rebuild_index() ;
+
+            /**
+             * @brief Grows the list to hold at least min_capacity jobs.  Capacity is doubled.
+             * @param min_capacity - number of jobs the list must hold
+             * @return 0, or -1 if the list could not be grown.
+             */
+            int reserve(unsigned int min_capacity) ;
+
         private:
 
+            /**
+             * @brief Returns the list position where new_job would be inserted.
+             */
+            unsigned int insertion_index(JobData * new_job) ;
+
+            /**
+             * @brief Calculates the next call time of a job that is running at the current time.
+             * Tracks the overall next job call time.
+             */
+            void reschedule_job(Trick::JobData * curr_job) ;
+
+            /**
+             * @brief find_next_job(long long) when #indexed is on.
+             */
+            JobData * find_next_indexed_job(long long time_tics) ;
+
+            /**
+             * @brief Rebuilds the calendar and the system job list from the current list.
+             */
+            void build_index() ;
+
+            /**
+             * @brief Gathers the calendar groups due at time_tics.
+             */
+            void begin_index_pass(long long time_tics) ;
+
+            /**
+             * @brief Moves the groups run in the last pass to their next call time.
+             */
+            void finish_index_pass() ;
+
+            /**
+             * @brief Adds a job position into the calendar group matching its next call time and cycle,
+             * or parks it if its call time is earlier than min_tics.
+             */
+            void index_job(unsigned int position, long long min_tics) ;
+
+            /**
+             * @brief Adds a sorted set of job positions into the calendar under key.
+             */
+            void index_group(std::pair< long long , long long > key, std::vector< unsigned int > & positions) ;
+
+            /**
+             * @brief Removes a group from the calendar and returns its positions.
+             */
+            void unindex_group(std::map< std::pair< long long , long long > , unsigned int >::iterator it,
+             std::vector< unsigned int > & positions) ;
+
             /** number of jobs in list */
             unsigned int list_size ;
 
-            /** Simple reallocable list of JobData pointers.  */
+            /** number of jobs list can hold before it is reallocated */
+            unsigned int list_capacity ;
+
+            /** Sorted, growable list of JobData pointers.  */
             JobData ** list ; /* ** This list is allocated outside of the memory manager. */
 
             /** current index to top job in list */
@@ -203,6 +291,48 @@ namespace Trick {
 
             /** next lowest job call time as tracked by calls to find_next_job(long long) */
             long long next_job_time ;
+
+            /** use the time index in find_next_job(long long) */
+            bool indexed ;
+
+            /** the time index needs to be rebuilt before it is used again */
+            bool index_dirty ;
+
+            /** value of JobData::schedule_epoch when the time index was built */
+            unsigned long long index_epoch ;
+
+            /** time of the last indexed pass */
+            long long index_time ;
+
+            /** a pass has started that has not been finished by finish_index_pass() */
+            bool index_pass_open ;
+
+            /** calendar of groups keyed by (next_tics, cycle_tics), ordered by next_tics */
+            std::map< std::pair< long long , long long > , unsigned int > index_calendar ; /**< trick_io(**) */
+
+            /** sorted list positions of each calendar group */
+            std::vector< std::vector< unsigned int > > index_groups ; /**< trick_io(**) */
+
+            /** unused entries in index_groups */
+            std::vector< unsigned int > free_groups ; /**< trick_io(**) */
+
+            /** keys of the calendar groups due in the current pass */
+            std::vector< std::pair< long long , long long > > due_keys ; /**< trick_io(**) */
+
+            /** sorted list positions of the jobs due in the current pass */
+            std::vector< unsigned int > due_list ; /**< trick_io(**) */
+
+            /** next entry in due_list to test */
+            unsigned int due_index ;
+
+            /** sorted list positions of the system class jobs */
+            std::vector< unsigned int > system_list ; /**< trick_io(**) */
+
+            /** next entry in system_list to test */
+            unsigned int system_index ;
+
+            /** list positions of jobs whose next_tics is earlier than the time of the last pass */
+            std::vector< unsigned int > parked_list ; /**< trick_io(**) */
     } ;
 
 }
@@ -0,0 +1,52 @@
+/*
+PURPOSE:
+    ( Calibrated time stamp counter Clock )
+*/
+
+#ifndef TSCCLOCK_HH
+#define TSCCLOCK_HH
+
+#include "trick/Clock.hh"
+
+namespace Trick {
+
+    /**
+     * Clock that reads the x86 time stamp counter with rdtsc.  Reading the counter does not
+     * enter the kernel, so it is the cheapest clock to call around every job.  The counter rate
+     * is calibrated against CLOCK_MONOTONIC_RAW in clock_init() and reported as the clock's
+     * tics per second.  The processor should have an invariant TSC; clock_init() warns if it does not.
+     * On other processors clock_init() fails and the current clock is kept.
+     */
+    class TSCClock : public Clock {
+
+        public:
+
+            TSCClock() ;
+            ~TSCClock() ;
+
+            /** @copybrief Trick::Clock::clock_init() */
+            virtual int clock_init() ;
+
+            /** @copybrief Trick::Clock::wall_clock_time() */
+            virtual long long wall_clock_time() ;
+
+            /** @copybrief Trick::Clock::clock_stop() */
+            virtual int clock_stop() ;
+
+            /**
+             * Measures the counter rate against CLOCK_MONOTONIC_RAW over calibration_time and
+             * sets clock_tics_per_sec.
+             * @return 0 if successful, -1 if the processor has no time stamp counter
+             */
+            int calibrate() ;
+
+            /** Wall time to spend measuring the counter rate */
+            double calibration_time ;       /**< trick_units(s) */
+
+            /** The counter rate has been measured */
+            bool calibrated ;               /**< trick_units(--) */
+    } ;
+
+}
+
+#endif
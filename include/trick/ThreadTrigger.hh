@@ -76,6 +76,37 @@ namespace Trick {
             int futex_addr; /**< trick_io(**) */
     } ;
 
+    /** Ways the master thread can wait for scheduled children to complete a frame */
+    enum ThreadCompletionType {
+        TC_SPIN,
+        TC_BARRIER
+    } ;
+
+    /* Counting barrier the master waits on once for all scheduled children.  The master
+       tests for completion spin_count times and then sleeps on a futex until the last child
+       arrives.  Platforms without futexes fall back to spinning. */
+    class ThreadCompletionBarrier {
+        public:
+            ThreadCompletionBarrier() ;
+            void arm() ;
+            void arrive() ;
+            void wait( bool rt_nap ) ;
+            void set_spin_count( unsigned int in_spin_count ) ;
+            void dump( std::ostream & oss ) ;
+
+            /** Number of completion tests before the master blocks */
+            unsigned int spin_count ;       /**< trick_units(--) */
+            /** Number of times the master waited on the barrier */
+            long long num_waits ;           /**< trick_units(--) */
+            /** Number of times the master blocked in the kernel waiting on the barrier */
+            long long num_blocks ;          /**< trick_units(--) */
+        protected:
+            /** Number of armed children that have not arrived */
+            volatile int pending ;          /**< trick_io(**) */
+            /** The master may be blocked waiting for pending to reach 0 */
+            volatile int sleeping ;         /**< trick_io(**) */
+    } ;
+
     /* Container to hold all of the trigger types.  This avoids having to
        allocate each trigger type when changing from one type to another */
     class ThreadTriggerContainer {
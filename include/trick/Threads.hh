@@ -19,6 +19,7 @@
 #include "trick/ThreadTrigger.hh"
 #include "trick/SimObject.hh"
 #include "trick/ScheduledJobQueue.hh"
+#include "trick/JobPool.hh"
 
 namespace Trick {
 
@@ -99,6 +100,20 @@ namespace Trick {
              */
             void clear_scheduled_queues() ;
 
+            /**
+             * Called by the master before firing the thread.  The thread arrives at barrier
+             * when it completes the frame.
+             * @param barrier - barrier the master will wait on
+             */
+            void arm_completion( Trick::ThreadCompletionBarrier * barrier ) ;
+
+            /**
+             * Called by the master after waiting on the completion barrier.  Adds the time the master
+             * waited for this thread, measured from wait_start_ns, to the sync wait counters.
+             * @param wait_start_ns - CLOCK_MONOTONIC time in nanoseconds the master started waiting
+             */
+            void record_sync_wait( long long wait_start_ns ) ;
+
             /**
              * Prints thread information to the incoming file pointer
              */
@@ -131,6 +146,9 @@ namespace Trick {
             /** Queue to hold AMF end of frame jobs.\n */
             Trick::ScheduledJobQueue end_of_frame_queue ; /**< trick_io(**) */
 
+            /** Pool that calls independent scheduled jobs in parallel when it has workers. */
+            Trick::JobPool job_pool ;     /**< trick_io(**) */
+
             /** Current job that is being run on this thread. */
             Trick::JobData * curr_job ;     /**< trick_io(**) */
 
@@ -152,6 +170,26 @@ namespace Trick {
             /** Wait for asynchronous jobs to finish at shutdown */
             bool shutdown_wait_async;       /**< trick_units(--) */
 
+            /** Total time the master waited on this thread at the completion barrier */
+            double sync_wait_time ;         /**< trick_units(s) */
+
+            /** Longest time the master waited on this thread at the completion barrier */
+            double sync_wait_max ;          /**< trick_units(s) */
+
+            /** Number of frames the master waited on this thread at the completion barrier */
+            long long sync_wait_count ;     /**< trick_units(--) */
+
+        protected:
+
+            /** Barrier to arrive at when the current frame completes, NULL if the master is not waiting on one */
+            Trick::ThreadCompletionBarrier * completion_barrier ; /**< trick_io(**) */
+
+            /** CLOCK_MONOTONIC time in nanoseconds the thread last arrived at the completion barrier */
+            volatile long long complete_ns ; /**< trick_io(**) */
+
+            /** Thread is armed and has not arrived at the completion barrier */
+            volatile bool completion_armed ; /**< trick_io(**) */
+
     } ;
 
 }
@@ -18,6 +18,7 @@
 #include "trick/variable_server_sync_types.h"
 #include "trick/VariableServerThread.hh"
 #include "trick/VariableServerListenThread.hh"
+#include "trick/VariableServerSnapshot.hh"
 #include "trick/SysThread.hh"
 
 namespace Trick {
@@ -130,6 +131,11 @@ namespace Trick {
             */
             Trick::VariableServerListenThread & get_listen_thread() ;
 
+            /**
+             @brief Returns the snapshot of the variables shared by the clients.
+            */
+            Trick::VariableServerSnapshot & get_snapshot() ;
+
             /**
              @brief @userdesc Enable (default) or disable the variable server.
              @par Python Usage:
@@ -269,6 +275,9 @@ namespace Trick {
             /** Default listen port thread object */
             VariableServerListenThread listen_thread ;
 
+            /** Variables shared by the clients copying in the copy jobs.\n */
+            VariableServerSnapshot snapshot ; /**<  trick_io(**) */
+
             /** Pointer to automatic_last job that copies requested variable values to their output buffers in sync mode.\n */
             Trick::JobData * copy_data_job ; /**< trick_io(**) trick_units(--) */
 
@@ -320,6 +329,7 @@ int var_debug(int level) ;
 int var_ascii() ;
 int var_binary() ;
 int var_binary_nonames() ;
+int var_send_on_change(unsigned int keyframe_interval) ;
 int var_validate_address(int on_off) ;
 int var_set_copy_mode(int mode) ;
 int var_set_write_mode(int mode) ;
@@ -15,6 +15,8 @@ union cv_converter ;
 
 namespace Trick {
 
+    class SharedVariable ;
+
 /**
   This class provides reference information for variables requested from the variable server by the client.
   @author Alex Lin
@@ -27,6 +29,28 @@ namespace Trick {
 
             friend std::ostream& operator<< (std::ostream& s, const Trick::VariableReference& vref);
 
+            /**
+             @brief Copies the value at ref->address into buffer_in.  Strings and pointers are followed
+             and the size of strings is updated.
+            */
+            void copy_value() ;
+
+            /**
+             @brief Compares buffer_out with the value last marked sent by mark_sent().
+             @return true if the value changed or was never marked sent.
+            */
+            bool value_changed() const ;
+
+            /**
+             @brief Saves buffer_out as the value last sent, for value_changed().
+            */
+            void mark_sent() ;
+
+            /**
+             @brief Forgets the value last sent, so the value is reported as changed.
+            */
+            void clear_sent() { size_sent = -1 ; }
+
             /** Pointer to trick variable reference structure.\n */
             REF2 * ref ;
             cv_converter * conversion_factor ; // ** udunits conversion factor
@@ -36,6 +60,13 @@ namespace Trick {
             int size ;                // -- size of data copied to buffer
             TRICK_TYPE string_type ;  // -- indicate if this is a string or wstring
             bool need_deref ;         // -- inidicate this is a painter to be dereferenced
+            void * validated_address ; // -- last address found in the memory manager by validate_address
+            unsigned long long validated_epoch ; // -- memory manager allocation epoch when validated_address was found
+            SharedVariable * shared ; // ** entry of the variable server snapshot this variable is staged from, or NULL
+            bool share_tried ;        // -- subscribing to the variable server snapshot was tried
+            int buffer_size ;         // -- allocated size of buffer_in and buffer_out
+            void * buffer_sent ;      // ** copy of the value last marked sent, allocated by the first mark_sent
+            int size_sent ;           // -- size of buffer_sent, -1 if no value is marked sent
     } ;
 
 }
@@ -0,0 +1,123 @@
+/*
+    PURPOSE:
+        (VariableServerSnapshot)
+*/
+
+#ifndef VARIABLESERVERSNAPSHOT_HH
+#define VARIABLESERVERSNAPSHOT_HH
+
+#include <map>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include "trick/VariableServerReference.hh"
+#include "trick/AddressPathCache.hh"
+
+namespace Trick {
+
+/**
+  One unique variable in the VariableServerSnapshot.
+ */
+    class SharedVariable {
+        public:
+            /** Name of the variable.\n */
+            std::string name ;        /**< trick_io(**) */
+
+            /** Reference resolved for the snapshot, its buffer_in holds the value copied last.\n */
+            VariableReference * var ; /**< trick_io(**) */
+
+            /** Number of client variables sharing this entry.\n */
+            int ref_count ;           /**< trick_io(**) */
+
+            /** Number of the sharing clients that validate addresses with var_validate_address.\n */
+            int num_validating ;      /**< trick_io(**) */
+
+            /** The address path was resolved in the last copy, false if a pointer on it was NULL or, when a
+                sharing client validates addresses, if the address was not in a memory manager allocation.\n */
+            bool resolved ;           /**< trick_io(**) */
+
+            /** Result of the last VariableServerSnapshot::validate().\n */
+            bool valid ;              /**< trick_io(**) */
+    } ;
+
+/**
+  The VariableServerSnapshot copies the variables watched by the variable server clients from simulation memory once
+  per copy job, no matter how many clients watch them.
+
+  Clients that copy in the simulation jobs subscribe each of their variables to the snapshot.  Each unique variable name
+  has one entry that is shared by reference count.  The first client copied in a copy job copies every entry; the
+  entry address paths are resolved together with an AddressPathCache.  Every client then stages its values from the
+  entries instead of from simulation memory.
+
+  The snapshot is only used by the simulation thread.  Subscribing from a client thread and copying are protected
+  by the snapshot mutex; all of the calls below except expire() expect it to be held.
+ */
+
+    class VariableServerSnapshot {
+        public:
+            VariableServerSnapshot() ;
+            ~VariableServerSnapshot() ;
+
+            int lock() { return pthread_mutex_lock(&mutex) ; }
+            int trylock() { return pthread_mutex_trylock(&mutex) ; }
+            int unlock() { return pthread_mutex_unlock(&mutex) ; }
+
+            /**
+             @brief Shares the entry of a client variable, creating it if this is the first client to watch the variable.
+             @param validate - the client validates addresses, copy() checks the entry address before reading it.
+             @return the entry, or NULL if the variable cannot be shared because its size or type do not match the entry.
+            */
+            SharedVariable * subscribe( VariableReference * var , bool validate = false ) ;
+
+            /**
+             @brief Releases a client's share of an entry.  The entry is deleted when no client shares it.
+             @param validate - the value the client subscribed with.
+            */
+            void unsubscribe( SharedVariable * entry , bool validate = false ) ;
+
+            /**
+             @brief Called at the start of each copy job, the next copy() call copies the entries again.
+            */
+            void expire() { stale = true ; }
+
+            /**
+             @brief Copies every entry from simulation memory if it has not been copied since expire().
+            */
+            void copy() ;
+
+            /**
+             @brief Checks the entry address falls in an allocation of the memory manager.  The result is kept until the
+             address or the memory manager allocations change.
+             @return true if the address is valid.
+            */
+            bool validate( SharedVariable * entry ) ;
+
+            /** @return the number of unique variables in the snapshot. */
+            size_t size() const { return entry_list.size() ; }
+
+            /** @return the number of times the entries have been copied. */
+            unsigned long long get_num_copies() const { return num_copies ; }
+
+        protected:
+            /** Entries by variable name.\n */
+            std::map< std::string , SharedVariable * > entries ; /**< trick_io(**) */
+
+            /** Entries in the order they are copied.\n */
+            std::vector< SharedVariable * > entry_list ; /**< trick_io(**) */
+
+            /** Compiled address paths of entry_list.\n */
+            AddressPathCache address_paths ;            /**< trick_io(**) */
+
+            /** The entries have not been copied since the last expire().\n */
+            bool stale ;                                /**< trick_io(**) */
+
+            /** Number of times the entries have been copied.\n */
+            unsigned long long num_copies ;             /**< trick_io(**) */
+
+            /** Protects the entries.\n */
+            pthread_mutex_t mutex ;                     /**< trick_io(**) */
+    } ;
+
+}
+
+#endif
@@ -13,6 +13,7 @@
 #include "trick/tc.h"
 #include "trick/SysThread.hh"
 #include "trick/VariableServerReference.hh"
+#include "trick/AddressPathCache.hh"
 #include "trick/variable_server_sync_types.h"
 #include "trick/variable_server_message_types.h"
 
@@ -225,6 +226,19 @@ namespace Trick {
             */
             int var_binary_nonames() ;
 
+            /**
+             @brief @userdesc Command to instruct the variable server to send only the variables whose values
+             changed since they were last sent, with a full message of all the variables every keyframe_interval
+             messages.  A message of changes has the message indicator 6, and each value is preceded by the
+             index of the variable in the var_add list.  No message is sent when no value changed.
+             The full messages, and the response to var_send, are sent as usual with the message indicator 0.
+             @par Python Usage:
+             @code trick.var_send_on_change(<keyframe_interval>) @endcode
+             @param keyframe_interval - number of messages between full messages, 0 to send every value every time (the default)
+             @return always 0
+            */
+            int var_send_on_change(unsigned int keyframe_interval) ;
+
             /**
              @brief @userdesc Command to tell the server when to copy data
              - VS_COPY_ASYNC = copies data asynchronously. (default)
@@ -450,19 +464,34 @@ namespace Trick {
 
             /**
              @brief Called by write_data to write given variables to socket in var_binary format.
+             @param indices - if not NULL, the index written before each variable, for VS_VAR_CHANGES messages.
             */
-            int write_binary_data( int Start, char *buf1, const std::vector<VariableReference *>& given_vars, VS_MESSAGE_TYPE message_type);
+            int write_binary_data( int Start, char *buf1, const std::vector<VariableReference *>& given_vars, VS_MESSAGE_TYPE message_type,
+             const std::vector<unsigned int> * indices = NULL );
 
             /**
              @brief Called by write_data to write given variables to socket in var_ascii format.
+             @param indices - if not NULL, the index written before each variable, for VS_VAR_CHANGES messages.
             */
-            int write_ascii_data(char * dest_buf, size_t dest_buf_size, const std::vector<VariableReference *>& given_vars, VS_MESSAGE_TYPE message_type );
+            int write_ascii_data(char * dest_buf, size_t dest_buf_size, const std::vector<VariableReference *>& given_vars, VS_MESSAGE_TYPE message_type,
+             const std::vector<unsigned int> * indices = NULL );
+
+            /**
+             @brief Called by write_data in var_send_on_change mode to choose between a full message and a message of changes.
+             @return true if changed_vars and changed_indices hold the changes to send, false if a full message is due.
+            */
+            bool select_changed_vars() ;
 
             /**
              @brief Construct a variable reference from the string in_name and handle error checking
             */
             VariableReference* create_var_reference(std::string in_name);
 
+            /**
+             @brief Stop staging a variable from the variable server snapshot.
+             */
+            void release_shared_var(VariableReference * var);
+
             /**
              @brief Make a time reference.
              */
@@ -524,6 +553,9 @@ namespace Trick {
             /** List of client requested variables.\n */
             std::vector <VariableReference *> vars;  /**<  trick_io(**) */
 
+            /** Compiled address paths of vars with pointers in their paths.\n */
+            AddressPathCache address_paths ;  /**<  trick_io(**) */
+
             /** Toggle to set variable server copy as top_of_frame, scheduled, async \n */
             VS_COPY_MODE copy_mode ;         /**<  trick_io(**) */
 
@@ -551,6 +583,21 @@ namespace Trick {
             /** Toggle to tell variable server return data in binary format without the variable names.\n */
             bool binary_data_nonames ;       /**<  trick_io(**) */
 
+            /** Number of messages between full messages in var_send_on_change mode, 0 when the mode is off.\n */
+            unsigned int keyframe_interval ; /**<  trick_io(**) */
+
+            /** Number of messages of changes sent since the last full message.\n */
+            unsigned int messages_since_keyframe ; /**<  trick_io(**) */
+
+            /** Send a full message next because the variable list or format changed.\n */
+            bool keyframe_needed ;           /**<  trick_io(**) */
+
+            /** Variables selected by select_changed_vars, reused between messages.\n */
+            std::vector <VariableReference *> changed_vars ; /**<  trick_io(**) */
+
+            /** Indices in vars of changed_vars.\n */
+            std::vector <unsigned int> changed_indices ; /**<  trick_io(**) */
+
             /** Toggle to tell variable server to send data multicast or point to point.\n */
             bool multicast ;                 /**<  trick_io(**) */
 
@@ -24,6 +24,7 @@ extern "C" {
     SIM_MODE exec_get_mode(void) ;
     unsigned int exec_get_num_threads(void) ;
     int exec_get_old_time_tic_value( void ) ;
+    int exec_get_indexed_job_queues(void) ;
     unsigned int exec_get_process_id(void) ;
     int exec_get_rt_nap(void) ;
     int exec_get_scheduled_start_index(void) ;
@@ -48,6 +49,7 @@ extern "C" {
     int exec_set_freeze_on_frame_boundary(int on_off) ;
     int exec_set_freeze_frame(double) ;
     int exec_set_enable_freeze( int on_off ) ;
+    int exec_set_indexed_job_queues( int on_off ) ;
     int exec_set_job_cycle(const char * job_name, int instance_num, double in_cycle) ;
     int exec_set_job_onoff(const char * job_name , int instance_num, int on) ;
     int exec_set_rt_nap(int on_off) ;
@@ -56,11 +58,14 @@ extern "C" {
     int exec_set_stack_trace(int on_off) ;
     int exec_set_terminate_time(double time_value)  ;
     int exec_set_thread_enabled( unsigned int thread_id , int yes_no ) ;
+    int exec_set_thread_completion_type( int type ) ;
+    int exec_set_thread_completion_spin_count( unsigned int spin_count ) ;
     int exec_set_thread_amf_cycle_time( unsigned int thread_id , double cycle_time ) ;
     int exec_set_thread_async_cycle_time( unsigned int thread_id , double cycle_time ) ;
     int exec_set_thread_async_wait( unsigned int thread_id , int yes_no ) ;
     int exec_set_thread_rt_semaphores( unsigned int thread_id , int yes_no ) ;
     int exec_set_thread_cpu_affinity(unsigned int thread_id , int cpu_num) ;
+    int exec_set_thread_parallel_jobs(unsigned int thread_id , unsigned int num_workers) ;
     int exec_set_thread_priority(unsigned int thread_id , unsigned int req_priority) ;
     int exec_set_thread_process_type( unsigned int thread_id , int process_type ) ;
     int exec_set_time( double in_time ) ;
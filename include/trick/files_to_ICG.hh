@@ -3,6 +3,8 @@
 
 #include "trick/reference_frame.h"
 #include "trick/GetTimeOfDayClock.hh"
+#include "trick/NanosecondClock.hh"
+#include "trick/TSCClock.hh"
 #include "trick/CommandLineArguments.hh"
 #include "trick/Executive.hh"
 #include "trick/ExecutiveException.hh"
@@ -77,6 +79,7 @@
 #include "trick/DataRecordDispatcher.hh"
 #include "trick/DRAscii.hh"
 #include "trick/DRBinary.hh"
+#include "trick/DRCompressed.hh"
 #include "trick/DRHDF5.hh"
 #include "trick/DebugPause.hh"
 #include "trick/EchoJobs.hh"
@@ -0,0 +1,27 @@
+#ifndef FORMAT_NUMBER_HH
+#define FORMAT_NUMBER_HH
+
+#include <stddef.h>
+
+namespace Trick {
+
+/* Size of a buffer that holds any number written by the functions below, including the terminating null. */
+#define FORMAT_NUMBER_BUF_SIZE 32
+
+/*
+  Each function writes a number to buf, null terminates it, and returns the number of characters written,
+  not counting the null.  No memory is allocated and the locale is not consulted.
+*/
+
+/* Shortest decimal string that converts back to exactly value, formatted like printf "%.16g". */
+size_t format_double( double value, char * buf );
+
+/* Shortest decimal string that converts back to exactly value as a float, formatted like printf "%.8g". */
+size_t format_float( float value, char * buf );
+
+size_t format_long_long( long long value, char * buf );
+size_t format_unsigned_long_long( unsigned long long value, char * buf );
+
+}
+
+#endif
@@ -39,6 +39,7 @@ int   TMM_is_alloced(char *addr) ;
 void  TMM_set_debug_level(int level);
 void  TMM_reduced_checkpoint(int flag);
 void  TMM_hexfloat_checkpoint(int flag);
+void  TMM_binary_checkpoint(int flag);
 
 void  TMM_clear_var_a( void* address);
 void  TMM_clear_var_n( const char* var_name );
@@ -72,6 +73,7 @@ int   get_truncated_size(void *addr) ;
 int   io_get_fixed_truncated_size(char *ptr, ATTRIBUTES * A, char *str, int dims, ATTRIBUTES * left_type) ;
 ALLOC_INFO* get_alloc_info_of(void * addr);
 ALLOC_INFO* get_alloc_info_at(void * addr);
+unsigned long long get_alloc_epoch(void);
 int set_alloc_name_at(void * addr, const char * name );
 
 void ref_free( REF2 *R ) ;
@@ -65,6 +65,42 @@ void mc_set_custom_slave_dispatch(int custom_slave_dispatch);
  */
 int mc_get_custom_slave_dispatch(void);
 
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc set_fork_point
+ */
+void mc_set_fork_point(int fork_point);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc get_fork_point
+ */
+int mc_get_fork_point(void);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc set_local_workers
+ */
+void mc_set_local_workers(unsigned int num_workers);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc get_local_workers
+ */
+unsigned int mc_get_local_workers(void);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc set_local_worker_first_cpu
+ */
+void mc_set_local_worker_first_cpu(int first_cpu);
+
+/**
+ * @relates Trick::MonteCarlo
+ * @copydoc get_local_worker_first_cpu
+ */
+int mc_get_local_worker_first_cpu(void);
+
 /**
  * @relates Trick::MonteCarlo
  * @copydoc set_timeout
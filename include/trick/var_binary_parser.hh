@@ -74,9 +74,10 @@ const static std::map<TRICK_TYPE, unsigned int> type_size_map = {{TRICK_CHARACTE
     
 class Var {
     public:
-        Var () : _has_name(false) {};
+        Var () : _has_name(false), _index(-1) {};
         void setValue(const std::vector<unsigned char>& bytes, size_t size, TRICK_TYPE type, bool byteswap = false);
         void setName(size_t name_size, const std::vector<unsigned char>& name_data);
+        void setIndex(int index);
 
         // The closest to runtime return type polymorphism that I can think of
         // There won't be a general case
@@ -88,6 +89,9 @@ class Var {
         std::string getName() const;
         TRICK_TYPE getType() const;
 
+        // Index of the variable in the client's var_add list, only sent in VS_VAR_CHANGES messages. -1 otherwise.
+        int getIndex() const;
+
 
     private:
         std::vector<unsigned char> value_bytes;
@@ -97,6 +101,8 @@ class Var {
         unsigned int _name_length;
         std::string _name;
 
+        int _index;
+
         bool _byteswap;
 
         TRICK_TYPE _trick_type;
@@ -110,6 +116,9 @@ class ParsedBinaryMessage {
         ParsedBinaryMessage (bool byteswap, bool nonames) : _message_type(0), _message_size(0), _num_vars(0), _byteswap(byteswap), _nonames(nonames) {}
 
         void combine (const ParsedBinaryMessage& message);
+
+        // Replace the variables of this full message with the variables of a VS_VAR_CHANGES message, by index.
+        void applyChanges (const ParsedBinaryMessage& changes);
         
         int parse (const std::vector<unsigned char>& bytes);
         int parse (char * raw_bytes);
@@ -135,6 +144,7 @@ class ParsedBinaryMessage {
         const static size_t header_size;
         const static size_t message_indicator_size;
         const static size_t variable_num_size;
+        const static size_t variable_index_size;
         const static size_t message_size_size;
         const static size_t variable_name_length_size;
         const static size_t variable_type_size;
@@ -45,6 +45,8 @@ if hasattr(top.cvar, 'trick_ip'):
 set_event_info_msg_on = trick.IPPythonEvent.set_event_info_msg_on
 set_event_info_msg_off = trick.IPPythonEvent.set_event_info_msg_off
 terminate_on_event_parse_error = trick.IPPythonEvent.terminate_on_event_parse_error
+native_event_conditions = trick.IPPythonEvent.native_event_conditions
+defer_thread_event_actions = trick.IPPythonEvent.defer_thread_event_actions
 
 # bind pyton input_processor event routines to shortcut names.
 new_event = trick.ippython_new_event
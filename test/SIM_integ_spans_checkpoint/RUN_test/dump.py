@@ -0,0 +1,10 @@
+import trick
+
+def main():
+
+    trick.checkpoint(2.0)
+
+    trick.stop(3.0)
+
+if __name__ == "__main__":
+    main()
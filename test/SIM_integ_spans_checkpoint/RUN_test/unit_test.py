@@ -0,0 +1,25 @@
+import math
+import trick
+from trick.unit_test import *
+
+# Oscillators restored at 2 seconds keep following x = cos(sqrt(k) * t) only if the integrator restored from the
+# checkpoint integrates the spans registered before it was written.
+
+def main():
+
+    trick.load_checkpoint("RUN_test/chkpnt_2.000000")
+    trick.load_checkpoint_job()
+
+    trick_utest.unit_tests.enable()
+    trick_utest.unit_tests.set_file_name( os.getenv("TRICK_HOME") + "/trick_test/SIM_integ_spans_checkpoint.xml" )
+    trick_utest.unit_tests.set_test_name( "IntegSpansCheckpoint" )
+
+    trick.add_read(4.0, """
+TRICK_EXPECT_NEAR( osc.body[0][0] , math.cos(4.0) , 1.0e-6 , "IntegSpansCheckpoint" , "restored span 0" )
+TRICK_EXPECT_NEAR( osc.body[1][0] , math.cos(8.0) , 1.0e-6 , "IntegSpansCheckpoint" , "restored span 1" )
+""")
+
+    trick.stop(5.0)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,5 @@
+
+clean: checkpoint_clean
+
+checkpoint_clean:
+	rm -f RUN_test/chkpnt_2.000000
@@ -0,0 +1,9 @@
+
+trick.mc_set_enabled(1)
+trick.mc_set_local_workers(2)
+trick.mc_set_fork_point(trick.MonteCarlo.MC_FORK_PRE_INIT)
+
+gain = trick.MonteVarFile("test.gain", "RUN_test/gains", 2)
+trick_mc.mc.add_variable(gain)
+
+trick.exec_set_terminate_time(1.0)
@@ -0,0 +1,43 @@
+
+import os
+import sys
+
+# Each run writes its messages in its own run directory.  A run forked after initialization does
+# not have the initialization message, the slave wrote it before the fork, and keeps the message
+# its monte_slave_pre job published after the message file was opened again.  A run forked before
+# initialization initializes itself and opens the message file once.
+
+if len(sys.argv) != 3 or sys.argv[2] not in ( "pre" , "post" ):
+    print ("Usage: check_runs.py <MONTE_ directory> pre|post")
+    exit(1)
+
+monte_dir = sys.argv[1]
+post_init = ( sys.argv[2] == "post" )
+gains = [ 1.5 , 2.5 , 3.5 , 4.5 , 5.5 , 6.5 ]
+failed = False
+
+for run in range(len(gains)):
+    send_hs = os.path.join(monte_dir, "RUN_%05d" % run, "send_hs")
+    if not os.path.isfile(send_hs):
+        print("Missing", send_hs)
+        failed = True
+        continue
+    messages = open(send_hs).read()
+    if ("fork test run gain %g initialized 1 time(s)" % gains[run]) not in messages:
+        print("Run", run, "did not report its gain after one initialization in", send_hs)
+        failed = True
+    if post_init and "fork test slave pre run" not in messages:
+        print("Run", run, "lost the monte_slave_pre message in", send_hs)
+        failed = True
+    if post_init and "fork test initialized" in messages:
+        print("Run", run, "has the slave's initialization message in", send_hs)
+        failed = True
+    if not post_init and "fork test initialized 1 time(s)" not in messages:
+        print("Run", run, "did not initialize itself in", send_hs)
+        failed = True
+
+if failed:
+    exit(1)
+
+print("Success!")
+exit(0)
@@ -78,7 +78,8 @@ void DPC_TimeCstrDataStream::begin() {
   bix = 0;
   eos[0] = 0;
   eos[1] = 0;
-  ds->begin();
+  // skip the values before tstart without reading them when the stream can seek
+  ds->seek(tstart);
   step();
 }
 
@@ -1,9 +1,11 @@
 #define protected public
 
 #include <iostream>
+#include <stdio.h>
 #include <string.h>
 #include "Log/DataStream.hh"
 #include "Log/DataStreamFactory.hh"
+#include "Log/TrickBinary.hh"
 #include "DPC/DPC_UnitConvDataStream.hh"
 #include "DPC/DPC_TimeCstrDataStream.hh"
 #include "DPM/DPM_time_constraints.hh"
@@ -262,6 +264,118 @@ TEST_F(DSTest, DataStream_Binary) {
 	delete data_stream_factory;
 }
 
+// TRICK BINARY DATASTREAM SEEK
+TEST_F(DSTest, DataStream_BinarySeek) {
+
+	double time, value;
+
+	RUN_dir = "../TEST_DATA/RUN_BINARY";
+    VarName = "sun_predictor.sun.solar_elevation";
+
+    data_stream_factory = new DataStreamFactory();
+    testds = data_stream_factory->create(RUN_dir, VarName, NULL);
+
+	// VALUE AT A RECORDED TIME
+    EXPECT_EQ(testds->getValueAtTime(2.0, &value), 1);
+    EXPECT_NEAR(value, -36.7434, 1.0e-4);
+
+	// NO RECORD AT THIS TIME
+    EXPECT_EQ(testds->getValueAtTime(2.5, &value), 0);
+
+	// SEEK BETWEEN RECORDS STOPS AT THE NEXT RECORD
+    EXPECT_EQ(testds->seek(2.5), 1);
+    EXPECT_EQ(testds->get(&time, &value), 1);
+    EXPECT_EQ(time, 3.0);
+    EXPECT_NEAR(value, -36.7438, 1.0e-4);
+
+	// SEEK PAST THE LAST RECORD
+    EXPECT_EQ(testds->seek(1.0e9), 0);
+    EXPECT_EQ(testds->end(), 1);
+
+	delete data_stream_factory;
+	delete testds;
+}
+
+// Writes a Trick binary log of time and one double, value = 2 * time.  The times run from 0 to
+// num_before - 1, then restart at restart_time, as after a checkpoint reload, for num_after records.
+static void write_restarted_log( const char * file_name , int num_before , int restart_time , int num_after ) {
+
+    const char * names[2] = { "sys.exec.out.time" , "value" } ;
+    const char * units[2] = { "s" , "--" } ;
+    int type = 11 ;
+    int size = 8 ;
+    int num_params = 2 ;
+    int len ;
+    int ii ;
+    FILE * fp = fopen(file_name, "w") ;
+
+    fwrite("Trick-10-L", 10, 1, fp) ;
+    fwrite(&num_params, 4, 1, fp) ;
+    for ( ii = 0 ; ii < num_params ; ii++ ) {
+        len = strlen(names[ii]) ;
+        fwrite(&len, 4, 1, fp) ;
+        fwrite(names[ii], len, 1, fp) ;
+        len = strlen(units[ii]) ;
+        fwrite(&len, 4, 1, fp) ;
+        fwrite(units[ii], len, 1, fp) ;
+        fwrite(&type, 4, 1, fp) ;
+        fwrite(&size, 4, 1, fp) ;
+    }
+    for ( ii = 0 ; ii < num_before + num_after ; ii++ ) {
+        double record[2] ;
+        record[0] = ( ii < num_before ) ? ii : restart_time + ii - num_before ;
+        record[1] = 2.0 * record[0] ;
+        fwrite(record, sizeof(record), 1, fp) ;
+    }
+    fclose(fp) ;
+}
+
+// TRICK BINARY DATASTREAM SEEK IN A LOG WHOSE TIMES DECREASE
+TEST_F(DSTest, DataStream_BinaryUnsortedSeek) {
+
+	double time, value;
+	int count;
+
+	// The times drop back between two sampled index records, so the sampled times still increase
+    write_restarted_log("log_unsorted.trk", 2000, 1500, 1500);
+    TrickBinary * ds = new TrickBinary((char *)"log_unsorted.trk", (char *)"value");
+
+	// SEEK STOPS AT THE FIRST RECORD AT OR AFTER THE TIME, BEFORE THE RESTART
+    EXPECT_EQ(ds->seek(1600.0), 1);
+    count = 0;
+    while (ds->get(&time, &value)) {
+        count++;
+    }
+    EXPECT_EQ(count, 400 + 1500);
+
+    EXPECT_EQ(ds->getValueAtTime(1700.0, &value), 1);
+    EXPECT_EQ(value, 3400.0);
+	delete ds;
+
+	// THE TIME CONSTRAINED STREAM KEEPS THE RECORDS FROM BOTH SIDES OF THE RESTART
+    DPM_time_constraints time_constraints(1600.0, 1e20, 0.0);
+    testds = new DPC_TimeCstrDataStream(new TrickBinary((char *)"log_unsorted.trk", (char *)"value"), &time_constraints);
+    count = 0;
+    while (testds->peek(&time, &value)) {
+        EXPECT_GE(time, 1600.0);
+        testds->step();
+        count++;
+    }
+    EXPECT_EQ(count, 400 + 1400);
+	delete testds;
+
+	// A LOG THAT ONLY REPEATS A TIME IS STILL SEARCHED BY THE INDEX
+    write_restarted_log("log_repeated.trk", 2000, 1999, 1500);
+    ds = new TrickBinary((char *)"log_repeated.trk", (char *)"value");
+    EXPECT_EQ(ds->seek(1999.0), 1);
+    count = 0;
+    while (ds->get(&time, &value)) {
+        count++;
+    }
+    EXPECT_EQ(count, 1 + 1500);
+	delete ds;
+}
+
 // MATLAB DATASTREAM
 TEST_F(DSTest, DataStream_MatLab) {
 	//req.add_requirement("2533684432 1366633954");
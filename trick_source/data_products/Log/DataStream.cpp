@@ -25,6 +25,20 @@ int DataStream::getValueAtTime(double time , double * value ) {
 
 }
 
+int DataStream::seek(double time ) {
+
+        double value_time ;
+        double value ;
+        int ret ;
+
+        begin() ;
+        while ( (ret = peek( &value_time , &value )) && value_time < time ) {
+                step() ;
+        }
+
+        return(ret) ;
+}
+
 string DataStream::getFileName() {
         return(fileName_) ;
 }
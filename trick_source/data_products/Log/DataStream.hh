@@ -15,7 +15,11 @@ class DataStream {
                virtual int get(double * timeStamp , double * paramValue) = 0 ;
                virtual int peek(double * timeStamp , double * paramValue) = 0 ;
 
-               int getValueAtTime(double timeStamp, double *paramValue ) ;
+               virtual int getValueAtTime(double timeStamp, double *paramValue ) ;
+
+               // Positions the stream at the first value at or after timeStamp.
+               // Returns 0 if there is no such value.
+               virtual int seek(double timeStamp ) ;
 
                virtual string getFileName() ;
                virtual string getUnit() ;
@@ -93,6 +93,24 @@ DataStream* DataStreamFactory::create( const char* iRunDir,
         }
     }
 
+    // Trick compressed binary
+    rewinddir(dirp) ;
+    while ((dp = readdir(dirp)) != NULL) {
+        len = strlen(dp->d_name);
+        if ( len > 5 && !strcmp( &(dp->d_name[len - 5]) , ".trkz")) {
+            size_t full_path_len = runDir.length() + strlen(dp->d_name) + 2;
+            full_path = (char*) malloc( full_path_len) ;
+            snprintf(full_path, full_path_len, "%s/%s", runDir.c_str(), dp->d_name);
+            if ( TrickCompressedLocateParam((const char*)full_path , paramName.c_str()) ) {
+            	closedir(dirp) ;
+                stream = new TrickCompressed(full_path , (char *)paramName.c_str()) ;
+                free( full_path ) ;
+                return(stream) ;
+            }
+            free( full_path ) ;
+        }
+    }
+
     // CSV Files
     rewinddir(dirp) ;
     while ((dp = readdir(dirp)) != NULL) {
@@ -187,7 +205,16 @@ int getVariableNames( const char* pathToData,
         }
         *variableNames = TrickBinaryGetVariableNames(pathToData) ;
         return 1 ;
-}
+    }
+
+    if ( len > 5 && !strcmp( &pathToData[len - 5] , ".trkz" )) {
+        *numVariables  = TrickCompressedGetNumVariables(pathToData) ;
+        if ( *numVariables == 0 ) {
+            return 0 ;
+        }
+        *variableNames = TrickCompressedGetVariableNames(pathToData) ;
+        return 1 ;
+    }
 
     return(0);
 }
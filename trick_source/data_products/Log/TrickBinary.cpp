@@ -6,6 +6,9 @@
 #include <string.h>
 #include <math.h>
 #include <map>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "TrickBinary.hh"
 #include "trick/parameter_types.h"
 #include "trick_byte_order.h"
@@ -13,7 +16,9 @@
 #include "trick/units_conv.h"
 #include "trick/map_trick_units_to_udunits.hh"
 
-TrickBinary::TrickBinary(char * file_name , char * param_name ) {
+TrickBinary::TrickBinary(char * file_name , char * param_name ) :
+ fp_(0) , swap_(0) , time_size_(8) , num_params_(0) , record_offset_(0) , record_size_(0) , type_(0) , size_(0) ,
+ data_offset_(0) , map_(0) , map_size_(0) , num_records_(0) , curr_record_(0) , index_sorted_(true) {
 
         const int file_type_len = 10 ;
         char file_type[file_type_len + 1] ;
@@ -176,7 +181,36 @@ TrickBinary::TrickBinary(char * file_name , char * param_name ) {
                         data_offset_ = ftell(fp_) ;
                 }
 
-                record_ = new char[record_size_] ;
+                // Map the whole file.  Records are decoded from the mapping, so only the pages read are loaded.
+                struct stat file_stat ;
+                if ( record_size_ > 0 && fstat(fileno(fp_) , &file_stat) == 0 && file_stat.st_size > data_offset_ ) {
+                        map_size_ = file_stat.st_size ;
+                        map_ = (char *)mmap(0 , map_size_ , PROT_READ , MAP_PRIVATE , fileno(fp_) , 0) ;
+                        if ( map_ == MAP_FAILED ) {
+                                std::cerr << "ERROR:  Couldn't map \"" << file_name << "\": " << std::strerror(errno) << std::endl;
+                                map_ = 0 ;
+                                map_size_ = 0 ;
+                        } else {
+                                madvise(map_ , map_size_ , MADV_SEQUENTIAL) ;
+                                num_records_ = (map_size_ - data_offset_) / record_size_ ;
+                        }
+                }
+                fclose(fp_) ;
+                fp_ = 0 ;
+
+                // Sample the time of every index_stride_ record.  Every record is checked for a time
+                // that decreases, a restart may write earlier times between two samples.
+                double prev_time = 0.0 ;
+                for ( long rec = 0 ; rec < num_records_ ; rec++ ) {
+                        double time = record_time(rec) ;
+                        if ( rec > 0 && time < prev_time ) {
+                                index_sorted_ = false ;
+                        }
+                        if ( rec % index_stride_ == 0 ) {
+                                index_times_.push_back(time) ;
+                        }
+                        prev_time = time ;
+                }
         }
         else {
             std::cerr << "ERROR:  Couldn't open \"" << file_name << "\": " << std::strerror(errno) << std::endl;
@@ -188,10 +222,39 @@ TrickBinary::~TrickBinary()
         if ( fp_ ) {
                 fclose(fp_);
         }
+        if ( map_ ) {
+                munmap(map_ , map_size_) ;
+        }
 }
 
-int TrickBinary::get( double * time , double * value ) {
+double TrickBinary::record_time( long record ) {
+
+        const char * address = map_ + data_offset_ + record * record_size_ ;
+
+        if ( time_size_ == 8 ) {
+                double my_time ;
+                memcpy(&my_time , address , 8) ;
+                return swap_ ? trick_byteswap_double(my_time) : my_time ;
+        }
+        else {
+                float my_time ;
+                memcpy(&my_time , address , 4) ;
+                return swap_ ? trick_byteswap_double(my_time) : (double)my_time ;
+        }
+}
 
+/*
+ * Decodes the time and the parameter of a record.  The parameter is copied out of the
+ * mapping because records are packed and its address may not be aligned.
+ */
+void TrickBinary::decode( long record , double * time , double * value ) {
+
+        union {
+                double d ;
+                long long ll ;
+                char c[8] ;
+        } field_buf ;
+        char * field = field_buf.c ;
         char * cp ;
         unsigned char * ucp ;
         short * sp ;
@@ -205,114 +268,114 @@ int TrickBinary::get( double * time , double * value ) {
         long long * llp ;
         unsigned long long * ullp ;
 
-        if ( fread(record_ , record_size_ , 1 , fp_ )) {
+        *time = record_time(record) ;
 
-                if ( time_size_ == 8 ) {
-                        double * my_time = (double *)record_ ;
-                        *time = *my_time ;
-                        *time = swap_ ? trick_byteswap_double(*my_time) : *time ;
-                }
-                else {
-                        float *my_time = (float *)record_ ;
-                        *time = (double)*my_time ;
-                        *time = swap_ ? trick_byteswap_double(*my_time) : *time ;
-                }
+        if ( size_ > 0 ) {
+                memcpy(field , map_ + data_offset_ + record * record_size_ + record_offset_ , ( size_ < 8 ) ? size_ : 8 ) ;
+        }
 
-                switch ( type_ ) {
-                        case TRICK_CHARACTER:
-                                cp = (char *)(record_ + record_offset_) ;
-                                *value = (double)*cp ;
-                                break ;
-                        case TRICK_UNSIGNED_CHARACTER:
-                                ucp = (unsigned char *)(record_ + record_offset_) ;
-                                *value = (double)*ucp ;
-                                break ;
-                        case TRICK_SHORT:
-                                sp = (short *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? trick_byteswap_short(*sp) : *sp) ;
-                                break ;
-                        case TRICK_UNSIGNED_SHORT:
-                                usp = (unsigned short *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? trick_byteswap_short(*usp) : *usp) ;
-                                break ;
-                        case TRICK_ENUMERATED:
-                        case TRICK_INTEGER:
-                                ip = (int *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? trick_byteswap_int(*ip) : *ip) ;
-                                break ;
-                        case TRICK_UNSIGNED_INTEGER:
-                                uip = (unsigned int *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? (unsigned int)trick_byteswap_int(*uip) : *uip) ;
-                                break ;
-                        case TRICK_LONG:
-                                lp = (long *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? trick_byteswap_long(*lp) : *lp) ;
-                                break ;
-                        case TRICK_UNSIGNED_LONG:
-                                ulp = (unsigned long *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? (unsigned long)trick_byteswap_long(*ulp) : *ulp) ;
-                                break ;
-                        case TRICK_FLOAT:
-                                fp = (float *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? trick_byteswap_float(*fp) : *fp) ;
-                                break ;
-                        case TRICK_DOUBLE:
-                                dp = (double *)(record_ + record_offset_) ;
-                                *value = swap_ ? trick_byteswap_double(*dp) : *dp ;
-                                break ;
-                        case TRICK_BITFIELD:
-                                switch ( size_ ) {
-                                        case 1 :
-                                                cp = (char *)(record_ + record_offset_) ;
-                                                *value = (double)*cp ;
-                                                break ;
-                                        case 2 :
-                                                sp = (short *)(record_ + record_offset_) ;
-                                                *value = (double)(swap_ ? trick_byteswap_short(*sp) : *sp) ;
-                                                break ;
-                                        case 4 :
-                                                ip = (int *)(record_ + record_offset_) ;
-                                                *value = (double)(swap_ ? trick_byteswap_int(*ip) : *ip) ;
-                                                break ;
-                                }
-                                break ;
-                        case TRICK_UNSIGNED_BITFIELD:
-                                switch ( size_ ) {
-                                        case 1 :
-                                                ucp = (unsigned char *)(record_ + record_offset_) ;
-                                                *value = (double)*ucp ;
-                                                break ;
-                                        case 2 :
-                                                usp = (unsigned short *)(record_ + record_offset_) ;
-                                                *value = (double)(swap_ ? (unsigned short)trick_byteswap_short(*usp) : *usp) ;
-                                                break ;
-                                        case 4 :
-                                                uip = (unsigned int *)(record_ + record_offset_) ;
-                                                *value = (double)(swap_ ? (unsigned int)trick_byteswap_int(*uip) : *uip) ;
-                                                break ;
-                                }
-                                break ;
-                        case TRICK_LONG_LONG:
-                                llp = (long long *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? trick_byteswap_long_long(*llp) : *llp) ;
-                                break ;
-                        case TRICK_UNSIGNED_LONG_LONG:
-                                ullp = (unsigned long long *)(record_ + record_offset_) ;
-                                *value = (double)(swap_ ? (unsigned long long)trick_byteswap_long_long(*ullp) : *ullp) ;
-                                break ;
-                        case TRICK_BOOLEAN:
-                                switch ( size_ ) {
-                                        case 1 :
-                                                ucp = (unsigned char *)(record_ + record_offset_) ;
-                                                *value = (double)*ucp ;
-                                                break ;
-                                        case 4 :
-                                                ip = (int *)(record_ + record_offset_) ;
-                                                *value = (double)(swap_ ? trick_byteswap_int(*ip) : *ip) ;
-                                                break ;
-                                }
-                                break ;
-                }
+        switch ( type_ ) {
+                case TRICK_CHARACTER:
+                        cp = (char *)field ;
+                        *value = (double)*cp ;
+                        break ;
+                case TRICK_UNSIGNED_CHARACTER:
+                        ucp = (unsigned char *)field ;
+                        *value = (double)*ucp ;
+                        break ;
+                case TRICK_SHORT:
+                        sp = (short *)field ;
+                        *value = (double)(swap_ ? trick_byteswap_short(*sp) : *sp) ;
+                        break ;
+                case TRICK_UNSIGNED_SHORT:
+                        usp = (unsigned short *)field ;
+                        *value = (double)(swap_ ? trick_byteswap_short(*usp) : *usp) ;
+                        break ;
+                case TRICK_ENUMERATED:
+                case TRICK_INTEGER:
+                        ip = (int *)field ;
+                        *value = (double)(swap_ ? trick_byteswap_int(*ip) : *ip) ;
+                        break ;
+                case TRICK_UNSIGNED_INTEGER:
+                        uip = (unsigned int *)field ;
+                        *value = (double)(swap_ ? (unsigned int)trick_byteswap_int(*uip) : *uip) ;
+                        break ;
+                case TRICK_LONG:
+                        lp = (long *)field ;
+                        *value = (double)(swap_ ? trick_byteswap_long(*lp) : *lp) ;
+                        break ;
+                case TRICK_UNSIGNED_LONG:
+                        ulp = (unsigned long *)field ;
+                        *value = (double)(swap_ ? (unsigned long)trick_byteswap_long(*ulp) : *ulp) ;
+                        break ;
+                case TRICK_FLOAT:
+                        fp = (float *)field ;
+                        *value = (double)(swap_ ? trick_byteswap_float(*fp) : *fp) ;
+                        break ;
+                case TRICK_DOUBLE:
+                        dp = (double *)field ;
+                        *value = swap_ ? trick_byteswap_double(*dp) : *dp ;
+                        break ;
+                case TRICK_BITFIELD:
+                        switch ( size_ ) {
+                                case 1 :
+                                        cp = (char *)field ;
+                                        *value = (double)*cp ;
+                                        break ;
+                                case 2 :
+                                        sp = (short *)field ;
+                                        *value = (double)(swap_ ? trick_byteswap_short(*sp) : *sp) ;
+                                        break ;
+                                case 4 :
+                                        ip = (int *)field ;
+                                        *value = (double)(swap_ ? trick_byteswap_int(*ip) : *ip) ;
+                                        break ;
+                        }
+                        break ;
+                case TRICK_UNSIGNED_BITFIELD:
+                        switch ( size_ ) {
+                                case 1 :
+                                        ucp = (unsigned char *)field ;
+                                        *value = (double)*ucp ;
+                                        break ;
+                                case 2 :
+                                        usp = (unsigned short *)field ;
+                                        *value = (double)(swap_ ? (unsigned short)trick_byteswap_short(*usp) : *usp) ;
+                                        break ;
+                                case 4 :
+                                        uip = (unsigned int *)field ;
+                                        *value = (double)(swap_ ? (unsigned int)trick_byteswap_int(*uip) : *uip) ;
+                                        break ;
+                        }
+                        break ;
+                case TRICK_LONG_LONG:
+                        llp = (long long *)field ;
+                        *value = (double)(swap_ ? trick_byteswap_long_long(*llp) : *llp) ;
+                        break ;
+                case TRICK_UNSIGNED_LONG_LONG:
+                        ullp = (unsigned long long *)field ;
+                        *value = (double)(swap_ ? (unsigned long long)trick_byteswap_long_long(*ullp) : *ullp) ;
+                        break ;
+                case TRICK_BOOLEAN:
+                        switch ( size_ ) {
+                                case 1 :
+                                        ucp = (unsigned char *)field ;
+                                        *value = (double)*ucp ;
+                                        break ;
+                                case 4 :
+                                        ip = (int *)field ;
+                                        *value = (double)(swap_ ? trick_byteswap_int(*ip) : *ip) ;
+                                        break ;
+                        }
+                        break ;
+        }
+}
+
+int TrickBinary::get( double * time , double * value ) {
+
+        if ( curr_record_ < num_records_ ) {
+                decode(curr_record_ , time , value) ;
+                curr_record_++ ;
                 return(1) ;
         }
 
@@ -322,50 +385,69 @@ int TrickBinary::get( double * time , double * value ) {
 
 int TrickBinary::peek( double * time , double * value ) {
 
-        long offset ;
-		int ret ;
+        if ( curr_record_ < num_records_ ) {
+                decode(curr_record_ , time , value) ;
+                return(1) ;
+        }
+
+        return(0) ;
+}
+
+/*
+ * Binary search the sparse index for the last sampled record before time, then step to the
+ * first record at or after time.  If the times in the file ever decrease, search from the start.
+ */
+int TrickBinary::seek( double time ) {
 
-        offset = ftell(fp_) ;
-        ret = get( time , value ) ;
-        fseek(fp_ , offset , SEEK_SET ) ;
+        std::vector<double>::iterator it ;
+        long rec ;
 
-        return(ret) ;
+        if ( ! index_sorted_ ) {
+                return DataStream::seek(time) ;
+        }
+
+        it = std::lower_bound(index_times_.begin() , index_times_.end() , time) ;
+        rec = ( it == index_times_.begin() ) ? 0 : ((it - index_times_.begin()) - 1) * index_stride_ ;
+        while ( rec < num_records_ && record_time(rec) < time ) {
+                rec++ ;
+        }
+        curr_record_ = rec ;
+
+        return( curr_record_ < num_records_ ) ;
+}
+
+int TrickBinary::getValueAtTime( double time , double * value ) {
+
+        double value_time ;
+
+        if ( seek(time - 1e-9) && get( &value_time , value ) ) {
+                return( fabs( value_time - time ) <= 1e-9 ) ;
+        }
+        return(0) ;
 }
 
 void TrickBinary::begin() {
-        fseek(fp_, data_offset_ , SEEK_SET) ;
+        curr_record_ = 0 ;
         return ;
 }
 
 int TrickBinary::end() {
 
-        long offset ;
-        long endOffset ;
-
-        offset = ftell(fp_) ;
-        fseek(fp_, 0, SEEK_END) ;
-        endOffset = ftell(fp_) ;
-        fseek(fp_ , offset , SEEK_SET ) ;
-
-        if ( endOffset - offset == 0 ) {
+        if ( curr_record_ >= num_records_ ) {
                 // Sitting past the last data point
                 return(1);
         }
 
-        return(feof(fp_)) ;
+        return(0) ;
 }
 
 int TrickBinary::step() {
 
-        char * record ;
-        record = new char[record_size_] ;
-
-        if ( fread(record , record_size_ , 1 , fp_ )) {
-                delete[]record ;
+        if ( curr_record_ < num_records_ ) {
+                curr_record_++ ;
                 return(1) ;
         }
 
-        delete[]record ;
         return(0) ;
 }
 
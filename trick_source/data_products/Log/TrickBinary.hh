@@ -3,8 +3,14 @@
 #define TRICKBINARY_HH
 
 #include <stdio.h>
+#include <vector>
 #include "DataStream.hh"
 
+/**
+ * Reads one parameter of a Trick binary (.trk) log file.  The file is memory mapped and values are
+ * decoded straight from the mapping.  Every index_stride_ records the time is sampled into a sparse
+ * index, so seek and getValueAtTime binary search the index instead of reading the file from the start.
+ */
 class TrickBinary : public DataStream {
 
        public:
@@ -14,23 +20,39 @@ class TrickBinary : public DataStream {
                int get(double * time , double * value ) ;
                int peek(double * time , double * value ) ;
 
+               int getValueAtTime(double time, double * value ) ;
+               int seek(double time ) ;
+
                void begin() ;
                int end() ;
                int step() ;
 
        private:
+               void decode(long record , double * time , double * value ) ;
+               double record_time(long record ) ;
+
                FILE *fp_ ;
                int swap_ ;
                int time_size_ ;
                int num_params_ ;
                int record_offset_ ;
                int record_size_ ;
-               char * record_ ;
                int type_ ;
                int size_ ;
 
                int data_offset_ ;
 
+               /* The mapped file, its size, the number of complete records and the current record */
+               char * map_ ;
+               size_t map_size_ ;
+               long num_records_ ;
+               long curr_record_ ;
+
+               /* Time of every index_stride_ record.  The index is only searched if no record time decreases. */
+               static const long index_stride_ = 1024 ;
+               std::vector<double> index_times_ ;
+               bool index_sorted_ ;
+
 } ;
 
 int TrickBinaryLocateParam( const char * file_name , const char * param_name ) ;
@@ -0,0 +1,462 @@
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "TrickCompressed.hh"
+#include "trick/parameter_types.h"
+#include "trick/DRCompressedCodec.hh"
+#include "trick/map_trick_units_to_udunits.hh"
+
+typedef Trick::DRCompressedCodec Codec ;
+
+/* Reads the header of a .trkz file.  Returns the number of parameters, or -1 if the file is not a .trkz file. */
+static int TrickCompressedReadHeader( FILE * fp , std::vector<std::string> & names , std::vector<std::string> & units ,
+ std::vector<int> & types , std::vector<int> & sizes ) {
+
+        char magic[Codec::magic_len] ;
+        unsigned char word[4] ;
+        int num_params ;
+        int ii ;
+
+        if ( fread(magic , Codec::magic_len , 1 , fp ) != 1 ||
+             strncmp( magic , Codec::magic() , Codec::magic_len ) ||
+             fread(word , 4 , 1 , fp ) != 1 ) {
+                return -1 ;
+        }
+        num_params = Codec::get_u32(word) ;
+
+        for ( ii = 0 ; ii < num_params ; ii++ ) {
+                std::string strings[2] ;
+                for ( int jj = 0 ; jj < 2 ; jj++ ) {
+                        if ( fread(word , 4 , 1 , fp ) != 1 ) {
+                                return -1 ;
+                        }
+                        strings[jj].resize(Codec::get_u32(word)) ;
+                        if ( ! strings[jj].empty() && fread(&strings[jj][0] , strings[jj].size() , 1 , fp ) != 1 ) {
+                                return -1 ;
+                        }
+                }
+                names.push_back(strings[0]) ;
+                units.push_back(strings[1]) ;
+                if ( fread(word , 4 , 1 , fp ) != 1 ) {
+                        return -1 ;
+                }
+                types.push_back(Codec::get_u32(word)) ;
+                if ( fread(word , 4 , 1 , fp ) != 1 ) {
+                        return -1 ;
+                }
+                sizes.push_back(Codec::get_u32(word)) ;
+        }
+
+        return num_params ;
+}
+
+static double TrickCompressedToDouble( const unsigned char * address , int type , int size ) {
+
+        uint64_t bits = Codec::load_value(address , size , false) ;
+
+        switch ( type ) {
+                case TRICK_DOUBLE: {
+                        double d ;
+                        memcpy(&d , &bits , 8) ;
+                        return d ;
+                }
+                case TRICK_FLOAT: {
+                        float f ;
+                        uint32_t bits32 = (uint32_t)bits ;
+                        memcpy(&f , &bits32 , 4) ;
+                        return (double)f ;
+                }
+                default:
+                        break ;
+        }
+
+        switch ( Codec::column_kind(type , size) ) {
+                case Codec::Column_Signed:
+                        return (double)(int64_t)Codec::load_value(address , size , true) ;
+                case Codec::Column_Unsigned:
+                        return (double)bits ;
+                default:
+                        return 0.0 ;
+        }
+}
+
+TrickCompressed::TrickCompressed(char * file_name , char * param_name ) :
+ fp_(0) , time_index_(-1) , time_type_(TRICK_DOUBLE) , time_size_(8) , param_index_(-1) , type_(0) , size_(0) ,
+ num_params_(0) , sorted_(-1) , loaded_chunk_(-1) , curr_chunk_(0) , curr_record_(0) {
+
+        std::vector<std::string> names ;
+        std::vector<std::string> units ;
+        unsigned char buf[Codec::chunk_header_size] ;
+        long data_offset ;
+        long file_size ;
+        int ii ;
+
+        fileName_ = file_name ;
+
+        if ((fp_ = fopen(file_name , "r")) == 0 ) {
+                std::cerr << "ERROR:  Couldn't open \"" << file_name << "\": " << std::strerror(errno) << std::endl;
+                return ;
+        }
+
+        if ( (num_params_ = TrickCompressedReadHeader(fp_ , names , units , types_ , sizes_)) < 0 ) {
+                num_params_ = 0 ;
+                return ;
+        }
+        data_offset = ftell(fp_) ;
+
+        for ( ii = 0 ; ii < num_params_ ; ii++ ) {
+                if ( names[ii] == "sys.exec.out.time" ) {
+                        time_index_ = ii ;
+                        time_type_ = types_[ii] ;
+                        time_size_ = sizes_[ii] ;
+                        unitTimeStr_ = units[ii] ;
+                }
+                if ( names[ii] == param_name ) {
+                        if ( units[ii] == "--" ) {
+                            unitStr_ = units[ii] ;
+                        } else {
+                            unitStr_ = map_trick_units_to_udunits(units[ii]) ;
+                        }
+                        param_index_ = ii ;
+                        type_ = types_[ii] ;
+                        size_ = sizes_[ii] ;
+                }
+        }
+
+        // Use the chunk index if the file has a trailer.
+        fseek(fp_ , 0 , SEEK_END) ;
+        file_size = ftell(fp_) ;
+        if ( file_size - data_offset >= (long)Codec::trailer_size ) {
+                fseek(fp_ , file_size - Codec::trailer_size , SEEK_SET) ;
+                if ( fread(buf , Codec::trailer_size , 1 , fp_ ) == 1 &&
+                     Codec::get_u32(buf + 12) == Codec::index_magic ) {
+                        long index_offset = (long)Codec::get_u64(buf) ;
+                        unsigned int num_chunks = Codec::get_u32(buf + 8) ;
+                        std::vector<unsigned char> index((size_t)num_chunks * Codec::index_entry_size) ;
+                        fseek(fp_ , index_offset , SEEK_SET) ;
+                        if ( index.empty() || fread(&index[0] , index.size() , 1 , fp_ ) == 1 ) {
+                                for ( unsigned int jj = 0 ; jj < num_chunks ; jj++ ) {
+                                        const unsigned char * entry = &index[(size_t)jj * Codec::index_entry_size] ;
+                                        Chunk chunk ;
+                                        chunk.offset = (long)Codec::get_u64(entry) ;
+                                        chunk.num_records = Codec::get_u32(entry + 8) ;
+                                        chunk.start_time = Codec::get_double(entry + 12) ;
+                                        chunk.end_time = Codec::get_double(entry + 20) ;
+                                        chunks_.push_back(chunk) ;
+                                }
+                                begin() ;
+                                return ;
+                        }
+                }
+        }
+
+        // No trailer, the sim did not shut down.  Find the chunks that were written completely.
+        long offset = data_offset ;
+        fseek(fp_ , offset , SEEK_SET) ;
+        while ( fread(buf , Codec::chunk_header_size , 1 , fp_ ) == 1 &&
+                Codec::get_u32(buf) == Codec::chunk_magic ) {
+                Chunk chunk ;
+                long stored_size = Codec::get_u32(buf + 29) ;
+                if ( offset + (long)Codec::chunk_header_size + stored_size > file_size ) {
+                        break ;
+                }
+                chunk.offset = offset ;
+                chunk.num_records = Codec::get_u32(buf + 4) ;
+                chunk.start_time = Codec::get_double(buf + 8) ;
+                chunk.end_time = Codec::get_double(buf + 16) ;
+                chunks_.push_back(chunk) ;
+                offset += Codec::chunk_header_size + stored_size ;
+                fseek(fp_ , offset , SEEK_SET) ;
+        }
+        begin() ;
+}
+
+TrickCompressed::~TrickCompressed()
+{
+        if ( fp_ ) {
+                fclose(fp_);
+        }
+}
+
+/*
+ * Reads chunk into times_ and values_.  Only the time and parameter columns are decoded.
+ */
+int TrickCompressed::load_chunk( unsigned int chunk ) {
+
+        unsigned char header[Codec::chunk_header_size] ;
+        const unsigned char * in ;
+        const unsigned char * end ;
+        unsigned int num_records ;
+        size_t raw_size ;
+        int last_index ;
+        int ii ;
+
+        if ( loaded_chunk_ == (int)chunk ) {
+                return 1 ;
+        }
+        loaded_chunk_ = -1 ;
+        times_.clear() ;
+        values_.clear() ;
+        if ( chunk >= chunks_.size() || param_index_ < 0 || time_index_ < 0 ) {
+                return 0 ;
+        }
+
+        fseek(fp_ , chunks_[chunk].offset , SEEK_SET) ;
+        if ( fread(header , Codec::chunk_header_size , 1 , fp_ ) != 1 ||
+             Codec::get_u32(header) != Codec::chunk_magic ) {
+                return 0 ;
+        }
+        num_records = Codec::get_u32(header + 4) ;
+        raw_size = Codec::get_u32(header + 25) ;
+        stored_.resize(Codec::get_u32(header + 29)) ;
+        if ( ! stored_.empty() && fread(&stored_[0] , stored_.size() , 1 , fp_ ) != 1 ) {
+                return 0 ;
+        }
+
+        switch ( header[24] ) {
+                case Codec::Codec_None:
+                        columns_.swap(stored_) ;
+                        break ;
+                case Codec::Codec_LZ:
+                        columns_.resize(raw_size) ;
+                        if ( ! Codec::lz_decompress(stored_.empty() ? 0 : &stored_[0] , stored_.size() ,
+                              columns_.empty() ? 0 : &columns_[0] , raw_size) ) {
+                                return 0 ;
+                        }
+                        break ;
+                default:
+                        return 0 ;
+        }
+
+        in = columns_.empty() ? 0 : &columns_[0] ;
+        end = in + columns_.size() ;
+        last_index = ( param_index_ > time_index_ ) ? param_index_ : time_index_ ;
+        for ( ii = 0 ; ii <= last_index ; ii++ ) {
+                uint64_t column_size ;
+                if ( ! Codec::get_varint(in , end , column_size) || column_size > (uint64_t)(end - in) ) {
+                        return 0 ;
+                }
+                if ( ii == time_index_ || ii == param_index_ ) {
+                        std::vector<double> & out = ( ii == time_index_ ) ? times_ : values_ ;
+                        decoded_.resize((size_t)num_records * sizes_[ii]) ;
+                        if ( ! Codec::decode_column(Codec::column_kind(types_[ii] , sizes_[ii]) , sizes_[ii] ,
+                              in , in + column_size , num_records , &decoded_[0] , sizes_[ii]) ) {
+                                return 0 ;
+                        }
+                        out.resize(num_records) ;
+                        for ( unsigned int jj = 0 ; jj < num_records ; jj++ ) {
+                                out[jj] = TrickCompressedToDouble(&decoded_[(size_t)jj * sizes_[ii]] , types_[ii] , sizes_[ii]) ;
+                        }
+                        // The time and the parameter may be the same column.
+                        if ( time_index_ == param_index_ ) {
+                                values_ = times_ ;
+                        }
+                }
+                in += column_size ;
+        }
+
+        loaded_chunk_ = chunk ;
+        return 1 ;
+}
+
+/* Moves to the chunk holding the current record.  Returns 0 past the last record. */
+int TrickCompressed::next_record() {
+
+        while ( curr_chunk_ < chunks_.size() ) {
+                if ( ! load_chunk(curr_chunk_) ) {
+                        return 0 ;
+                }
+                if ( curr_record_ < times_.size() ) {
+                        return 1 ;
+                }
+                curr_chunk_++ ;
+                curr_record_ = 0 ;
+        }
+        return 0 ;
+}
+
+int TrickCompressed::get( double * time , double * value ) {
+
+        if ( ! next_record() ) {
+                return 0 ;
+        }
+        *time = times_[curr_record_] ;
+        *value = values_[curr_record_] ;
+        curr_record_++ ;
+        return 1 ;
+}
+
+int TrickCompressed::peek( double * time , double * value ) {
+
+        if ( ! next_record() ) {
+                return 0 ;
+        }
+        *time = times_[curr_record_] ;
+        *value = values_[curr_record_] ;
+        return 1 ;
+}
+
+/*
+ * Checks whether any record time decreases, within a chunk or from one chunk to the next.
+ * The chunk index only holds the first and last time of each chunk, so the time column of
+ * every chunk is decoded.  This is done once, the first time the stream seeks.
+ */
+bool TrickCompressed::times_sorted() {
+
+        if ( sorted_ < 0 ) {
+                sorted_ = 1 ;
+                for ( unsigned int ii = 0 ; ii < chunks_.size() && sorted_ ; ii++ ) {
+                        if ( chunks_[ii].end_time < chunks_[ii].start_time ||
+                             ( ii > 0 && chunks_[ii].start_time < chunks_[ii - 1].end_time ) ) {
+                                sorted_ = 0 ;
+                        } else if ( load_chunk(ii) ) {
+                                for ( unsigned int jj = 1 ; jj < times_.size() ; jj++ ) {
+                                        if ( times_[jj] < times_[jj - 1] ) {
+                                                sorted_ = 0 ;
+                                                break ;
+                                        }
+                                }
+                        }
+                }
+        }
+        return sorted_ == 1 ;
+}
+
+/*
+ * Binary search the chunk index for the first chunk that ends at or after time,
+ * then the chunk for the first record at or after time.  If the times in the file
+ * ever decrease, search from the start.
+ */
+int TrickCompressed::seek( double time ) {
+
+        unsigned int low = 0 ;
+        unsigned int high = chunks_.size() ;
+
+        if ( ! times_sorted() ) {
+                return DataStream::seek(time) ;
+        }
+
+        while ( low < high ) {
+                unsigned int mid = (low + high) / 2 ;
+                if ( chunks_[mid].end_time < time ) {
+                        low = mid + 1 ;
+                } else {
+                        high = mid ;
+                }
+        }
+        curr_chunk_ = low ;
+        curr_record_ = 0 ;
+        if ( ! next_record() ) {
+                return 0 ;
+        }
+        while ( curr_record_ < times_.size() && times_[curr_record_] < time ) {
+                curr_record_++ ;
+        }
+        return next_record() ;
+}
+
+int TrickCompressed::getValueAtTime( double time , double * value ) {
+
+        double value_time ;
+
+        if ( seek(time - 1e-9) && get( &value_time , value ) ) {
+                return( fabs( value_time - time ) <= 1e-9 ) ;
+        }
+        return(0) ;
+}
+
+void TrickCompressed::begin() {
+        curr_chunk_ = 0 ;
+        curr_record_ = 0 ;
+        return ;
+}
+
+int TrickCompressed::end() {
+        return( ! next_record() ) ;
+}
+
+int TrickCompressed::step() {
+
+        if ( ! next_record() ) {
+                return 0 ;
+        }
+        curr_record_++ ;
+        return 1 ;
+}
+
+int TrickCompressedGetNumVariables(const char* file_name) {
+
+        std::vector<std::string> names , units ;
+        std::vector<int> types , sizes ;
+        int num_params ;
+        FILE *fp ;
+
+        if ((fp = fopen(file_name , "r")) == 0 ) {
+                std::cerr << "ERROR:  Couldn't open \"" << file_name << "\": " << std::strerror(errno) << std::endl;
+                return(0) ;
+        }
+        num_params = TrickCompressedReadHeader(fp , names , units , types , sizes) ;
+        fclose(fp) ;
+
+        return ( num_params < 0 ) ? 0 : num_params ;
+}
+
+static char** TrickCompressedGetStrings(const char* file_name , bool get_units) {
+
+        std::vector<std::string> names , units ;
+        std::vector<int> types , sizes ;
+        std::vector<std::string> * strings = get_units ? &units : &names ;
+        char** list ;
+        FILE *fp ;
+
+        if ((fp = fopen(file_name , "r")) == 0 ) {
+                std::cerr << "ERROR:  Couldn't open \"" << file_name << "\": " << std::strerror(errno) << std::endl;
+                return(0) ;
+        }
+        if ( TrickCompressedReadHeader(fp , names , units , types , sizes) < 0 ) {
+                fclose(fp) ;
+                return(0) ;
+        }
+        fclose(fp) ;
+
+        list = new char*[strings->size()] ;
+        for ( unsigned int ii = 0 ; ii < strings->size() ; ii++ ) {
+                list[ii] = new char[(*strings)[ii].size() + 1] ;
+                strcpy(list[ii] , (*strings)[ii].c_str()) ;
+        }
+        return list ;
+}
+
+char** TrickCompressedGetVariableNames(const char* file_name) {
+        return TrickCompressedGetStrings(file_name , false) ;
+}
+
+char** TrickCompressedGetVariableUnits(const char* file_name) {
+        return TrickCompressedGetStrings(file_name , true) ;
+}
+
+int TrickCompressedLocateParam( const char * file_name , const char * param_name ) {
+
+        std::vector<std::string> names , units ;
+        std::vector<int> types , sizes ;
+        FILE *fp ;
+        int found = 0 ;
+
+        if ((fp = fopen(file_name , "r")) == 0 ) {
+                return 0 ;
+        }
+        if ( TrickCompressedReadHeader(fp , names , units , types , sizes) > 0 ) {
+                for ( unsigned int ii = 0 ; ii < names.size() ; ii++ ) {
+                        if ( names[ii] == param_name ) {
+                                found = 1 ;
+                                break ;
+                        }
+                }
+        }
+        fclose(fp) ;
+        return(found) ;
+}
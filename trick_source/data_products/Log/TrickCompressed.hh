@@ -0,0 +1,74 @@
+#ifndef TRICKCOMPRESSED_HH
+#define TRICKCOMPRESSED_HH
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "DataStream.hh"
+
+/**
+ * Reads one parameter of a DRCompressed (.trkz) log file.  Chunks are decoded one at a time, and only
+ * the time and parameter columns of a chunk are decoded.  The chunk index lets getValueAtTime start
+ * at the chunk holding the time instead of reading the file from the beginning.
+ */
+class TrickCompressed : public DataStream {
+
+       public:
+               TrickCompressed(char * file, char * param ) ;
+               ~TrickCompressed() ;
+
+               int get(double * time , double * value ) ;
+               int peek(double * time , double * value ) ;
+
+               int getValueAtTime(double time, double * value ) ;
+
+               int seek(double time ) ;
+
+               void begin() ;
+               int end() ;
+               int step() ;
+
+       private:
+               struct Chunk {
+                       long offset ;
+                       unsigned int num_records ;
+                       double start_time ;
+                       double end_time ;
+               } ;
+
+               int load_chunk( unsigned int chunk ) ;
+               int next_record() ;
+               bool times_sorted() ;
+
+               FILE *fp_ ;
+               int time_index_ ;
+               int time_type_ ;
+               int time_size_ ;
+               int param_index_ ;
+               int type_ ;
+               int size_ ;
+               int num_params_ ;
+               std::vector<int> types_ ;
+               std::vector<int> sizes_ ;
+               std::vector<Chunk> chunks_ ;
+
+               /* 1 if no record time decreases, 0 if one does, -1 until the first seek checks */
+               int sorted_ ;
+
+               /* Chunk loaded into times_ and values_, or -1 */
+               int loaded_chunk_ ;
+               unsigned int curr_chunk_ ;
+               unsigned int curr_record_ ;
+               std::vector<double> times_ ;
+               std::vector<double> values_ ;
+               std::vector<unsigned char> stored_ ;
+               std::vector<unsigned char> columns_ ;
+               std::vector<unsigned char> decoded_ ;
+} ;
+
+int TrickCompressedLocateParam( const char * file_name , const char * param_name ) ;
+char** TrickCompressedGetVariableNames(const char* file_name) ;
+int    TrickCompressedGetNumVariables(const char* file_name) ;
+char** TrickCompressedGetVariableUnits(const char* file_name) ;
+
+#endif
@@ -0,0 +1,965 @@
+#include "trick/MemoryManager.hh"
+#include "trick/parameter_types.h"
+#include "trick/io_alloc.h"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+#include "trick/BinaryCheckPointAgent.hh"
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+const char Trick::BinaryCheckPointAgent::magic[8] = { 'T', 'R', 'I', 'C', 'K', 'B', 'I', 'N' } ;
+
+// Version of the binary checkpoint format.
+static const uint32_t binary_checkpoint_version = 2 ;
+
+// Fixups that follow the bytes of an allocation.  Each one is the fixup type,
+// the byte offset of the pointer or string in the allocation, then:
+typedef enum {
+    FIXUP_END = 0,          // nothing, this ends the list of fixups.
+    FIXUP_POINTER = 1,      // the table index of the allocation pointed to and the byte offset into it.
+    FIXUP_CHAR_STRING = 2,  // the length and characters of a string the char pointer points to.
+    FIXUP_STD_STRING = 3    // the length and characters of the std::string.
+} FixupType ;
+
+// Raw values are written in the byte order of the host.
+template <class T> static void write_value( std::ostream& os, T value ) {
+    os.write((const char *)&value, sizeof(T)) ;
+}
+
+template <class T> static bool read_value( std::istream* is, T& value ) {
+    is->read((char *)&value, sizeof(T)) ;
+    return is->good() ;
+}
+
+static void write_string( std::ostream& os, const char * str, size_t length ) {
+    write_value<uint64_t>(os, length) ;
+    os.write(str, length) ;
+}
+
+static bool read_string( std::istream* is, std::string& str ) ;
+
+// Mix a run of bytes into a 64 bit hash, a word at a time.
+static uint64_t hash_bytes( uint64_t hash, const char * data, size_t length ) {
+    const uint64_t mult = 0x9e3779b97f4a7c15ULL ;
+    size_t ii ;
+    for ( ii = 0 ; ii + sizeof(uint64_t) <= length ; ii += sizeof(uint64_t) ) {
+        uint64_t word ;
+        memcpy(&word, data + ii, sizeof(word)) ;
+        hash = (hash ^ word) * mult ;
+        hash ^= hash >> 32 ;
+    }
+    if ( ii < length ) {
+        uint64_t word = (uint64_t)(length - ii) << 56 ;
+        memcpy(&word, data + ii, length - ii) ;
+        hash = (hash ^ word) * mult ;
+        hash ^= hash >> 32 ;
+    }
+    return hash ;
+}
+
+// An identifier for a checkpoint, so that an incremental checkpoint can tell
+// whether its base was replaced by a later one of the same name.
+static uint64_t new_checkpoint_id() {
+    static uint64_t count = 0 ;
+    struct timespec tp ;
+    clock_gettime(CLOCK_REALTIME, &tp) ;
+    uint64_t id = (uint64_t)tp.tv_sec * 1000000000ULL + tp.tv_nsec ;
+    return hash_bytes(id ^ ((uint64_t)getpid() << 40), (const char *)&(++count), sizeof(count)) ;
+}
+
+static bool read_string( std::istream* is, std::string& str ) {
+    uint64_t length ;
+    if ( ! read_value(is, length) ) {
+        return false ;
+    }
+    str.resize(length) ;
+    if ( length > 0 ) {
+        is->read(&str[0], length) ;
+    }
+    return is->good() ;
+}
+
+// MEMBER FUNCTION
+Trick::BinaryCheckPointAgent::BinaryCheckPointAgent( Trick::MemoryManager *MM) {
+
+   mem_mgr = MM;
+   reduced_checkpoint = 0;
+   hexfloat_checkpoint = 0;
+   debug_level = 0;
+}
+
+// MEMBER FUNCTION
+Trick::BinaryCheckPointAgent::~BinaryCheckPointAgent() { }
+
+// MEMBER FUNCTION
+bool Trick::BinaryCheckPointAgent::input_perm_check(ATTRIBUTES * attr) {
+    return (attr->io & TRICK_CHKPNT_INPUT) ;
+}
+
+bool Trick::BinaryCheckPointAgent::output_perm_check(ATTRIBUTES * attr) {
+    return (attr->io & TRICK_CHKPNT_OUTPUT) ;
+}
+
+// MEMBER FUNCTION
+void Trick::BinaryCheckPointAgent::write_decl(std::ostream& chkpnt_os, ALLOC_INFO *info) {
+
+    write_value<int32_t>(chkpnt_os, info->stcl) ;
+    write_value<int32_t>(chkpnt_os, info->type) ;
+    write_value<int32_t>(chkpnt_os, info->size) ;
+    write_value<int32_t>(chkpnt_os, info->num) ;
+    write_value<int32_t>(chkpnt_os, info->num_index) ;
+    for ( int ii = 0 ; ii < info->num_index ; ii++ ) {
+        write_value<int32_t>(chkpnt_os, info->index[ii]) ;
+    }
+    write_string(chkpnt_os, info->name, strlen(info->name)) ;
+    if ( info->user_type_name != NULL ) {
+        write_string(chkpnt_os, info->user_type_name, strlen(info->user_type_name)) ;
+    } else {
+        write_string(chkpnt_os, "", 0) ;
+    }
+}
+
+// MEMBER FUNCTION
+void Trick::BinaryCheckPointAgent::assign_rvalue(std::ostream& chkpnt_os __attribute__((unused)),
+                                                 void* address __attribute__((unused)),
+                                                 ATTRIBUTES* attr __attribute__((unused)),
+                                                 int curr_dim __attribute__((unused)),
+                                                 int offset __attribute__((unused))) {
+    message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint agent does not write single values.\n"
+                               "   Use write_checkpoint() to write whole allocations.\n") ;
+}
+
+/**
+@details
+-# Skip static and reference members, they are not stored in the object.
+-# Members not allowed checkpoint output and input are skipped.
+-# Pointers, including arrays of pointers, are pointer segments.  A pointer to char may point to a string
+   outside of managed memory.
+-# The members of a struct or class member are added at the offset of each element, unless its own layout
+   is one contiguous raw segment.
+-# std::strings are string segments.  STLs are restored from their own allocations and are skipped along
+   with FILE pointers and opaque types.
+-# All other types are copied raw.
+*/
+void Trick::BinaryCheckPointAgent::add_member_segments( std::vector<Segment>& segments, size_t base_offset,
+                                                        ATTRIBUTES* attr_list) {
+
+    for ( int ii = 0 ; attr_list[ii].name[0] != '\0' ; ii++ ) {
+        ATTRIBUTES * attr = &attr_list[ii] ;
+
+        if ( attr->mods & 3 ) {
+            continue ;
+        }
+
+        // The number of elements up to the first pointer dimension.
+        size_t num_elems = 1 ;
+        int ptr_dim = 0 ;
+        while ( ptr_dim < attr->num_index && attr->index[ptr_dim].size != 0 ) {
+            num_elems *= attr->index[ptr_dim].size ;
+            ptr_dim++ ;
+        }
+
+        Segment segment ;
+        segment.offset = base_offset + attr->offset ;
+        segment.char_pointer = false ;
+
+        if ( ptr_dim < attr->num_index ) {
+            segment.size = num_elems * sizeof(void*) ;
+            segment.type = SEGMENT_POINTER ;
+            segment.char_pointer = ( attr->type == TRICK_CHARACTER && ptr_dim == attr->num_index - 1 ) ;
+        } else {
+            segment.size = num_elems * attr->size ;
+            switch ( attr->type ) {
+                case TRICK_STRUCTURED:
+                    segment.type = SEGMENT_RAW ;
+                    break ;
+                case TRICK_VOID_PTR:
+                    segment.type = SEGMENT_POINTER ;
+                    break ;
+                case TRICK_STRING:
+                    segment.type = SEGMENT_STRING ;
+                    break ;
+                case TRICK_STL:
+                case TRICK_FILE_PTR:
+                case TRICK_WSTRING:
+                case TRICK_OPAQUE_TYPE:
+                    segment.type = SEGMENT_SKIP ;
+                    break ;
+                default:
+                    segment.type = SEGMENT_RAW ;
+                    break ;
+            }
+        }
+
+        if ( !output_perm_check(attr) || !input_perm_check(attr) ) {
+            segment.type = SEGMENT_SKIP ;
+        }
+
+        if ( segment.type == SEGMENT_RAW && attr->type == TRICK_STRUCTURED && attr->attr != NULL ) {
+            const Layout & sub_layout = get_class_layout((ATTRIBUTES *)attr->attr, attr->size) ;
+            if ( ! sub_layout.contiguous ) {
+                for ( size_t jj = 0 ; jj < num_elems ; jj++ ) {
+                    for ( size_t kk = 0 ; kk < sub_layout.segments.size() ; kk++ ) {
+                        Segment sub_segment = sub_layout.segments[kk] ;
+                        sub_segment.offset += segment.offset + jj * attr->size ;
+                        segments.push_back(sub_segment) ;
+                    }
+                }
+                continue ;
+            }
+        }
+        segments.push_back(segment) ;
+    }
+}
+
+// MEMBER FUNCTION
+bool Trick::BinaryCheckPointAgent::segment_offset_compare( const Segment & lhs, const Segment & rhs ) {
+    return lhs.offset < rhs.offset ;
+}
+
+/**
+@details
+-# Sort the segments by offset.
+-# Merge raw segments that overlap, as bitfields do, or that are separated by less than a pointer's size.
+   A smaller gap can only be padding, never a virtual table pointer.  A skipped segment between two raw
+   segments keeps them apart.
+-# The skipped segments are kept so that they also keep apart the raw segments of a class that contains
+   this one.
+-# The layout is contiguous if one raw segment covers the element, up to its trailing padding.
+*/
+void Trick::BinaryCheckPointAgent::finish_layout( Layout& layout, std::vector<Segment>& segments, size_t elem_size) {
+
+    std::stable_sort(segments.begin(), segments.end(), segment_offset_compare) ;
+
+    layout.segments.clear() ;
+    for ( size_t ii = 0 ; ii < segments.size() ; ii++ ) {
+        Segment & segment = segments[ii] ;
+        if ( segment.type == SEGMENT_RAW && !layout.segments.empty() && layout.segments.back().type == SEGMENT_RAW ) {
+            Segment & last = layout.segments.back() ;
+            size_t last_end = last.offset + last.size ;
+            if ( segment.offset < last_end + sizeof(void*) ) {
+                last.size = std::max(last_end, segment.offset + segment.size) - last.offset ;
+                continue ;
+            }
+        }
+        layout.segments.push_back(segment) ;
+    }
+
+    layout.contiguous = false ;
+    if ( layout.segments.size() == 1 && layout.segments[0].type == SEGMENT_RAW &&
+         layout.segments[0].offset == 0 && layout.segments[0].size + sizeof(void*) > elem_size ) {
+        layout.segments[0].size = elem_size ;
+        layout.contiguous = true ;
+    }
+}
+
+// MEMBER FUNCTION
+const Trick::BinaryCheckPointAgent::Layout& Trick::BinaryCheckPointAgent::get_class_layout( ATTRIBUTES* attr,
+                                                                                            size_t size) {
+
+    std::map<ATTRIBUTES*, Layout>::iterator it = class_layouts.find(attr) ;
+    if ( it != class_layouts.end() ) {
+        return it->second ;
+    }
+
+    std::vector<Segment> segments ;
+    add_member_segments(segments, 0, attr) ;
+    Layout & layout = class_layouts[attr] ;
+    finish_layout(layout, segments, size) ;
+    return layout ;
+}
+
+// MEMBER FUNCTION
+const Trick::BinaryCheckPointAgent::Layout& Trick::BinaryCheckPointAgent::get_allocation_layout( ALLOC_INFO* alloc_info,
+                                                                                                 Layout& scratch) {
+
+    Segment segment ;
+    segment.offset = 0 ;
+    segment.size = alloc_info->size ;
+    segment.char_pointer = false ;
+
+    int num_ptrs = 0 ;
+    for ( int ii = 0 ; ii < alloc_info->num_index ; ii++ ) {
+        if ( alloc_info->index[ii] == 0 ) {
+            num_ptrs++ ;
+        }
+    }
+
+    if ( num_ptrs > 0 ) {
+        segment.type = SEGMENT_POINTER ;
+        segment.char_pointer = ( alloc_info->type == TRICK_CHARACTER && num_ptrs == 1 ) ;
+    } else {
+        switch ( alloc_info->type ) {
+            case TRICK_STRUCTURED:
+                if ( alloc_info->attr != NULL ) {
+                    return get_class_layout(alloc_info->attr, alloc_info->size) ;
+                }
+                segment.type = SEGMENT_SKIP ;
+                break ;
+            case TRICK_VOID_PTR:
+                segment.type = SEGMENT_POINTER ;
+                break ;
+            case TRICK_STRING:
+                segment.type = SEGMENT_STRING ;
+                break ;
+            case TRICK_STL:
+            case TRICK_FILE_PTR:
+            case TRICK_WSTRING:
+            case TRICK_OPAQUE_TYPE:
+                segment.type = SEGMENT_SKIP ;
+                break ;
+            default:
+                segment.type = SEGMENT_RAW ;
+                break ;
+        }
+    }
+
+    std::vector<Segment> segments(1, segment) ;
+    finish_layout(scratch, segments, alloc_info->size) ;
+    return scratch ;
+}
+
+/**
+@details
+-# A contiguous allocation is hashed as it is.
+-# Otherwise the raw segments, the values of the pointers, the strings pointed to by char pointers
+   outside of managed memory and the contents of the std::strings of every element are hashed.  Skipped
+   segments are not, as they are not restored.
+*/
+unsigned long long Trick::BinaryCheckPointAgent::hash_data( ALLOC_INFO* alloc_info) {
+
+    char * start = (char *)alloc_info->start ;
+    uint64_t num_bytes = (uint64_t)alloc_info->size * alloc_info->num ;
+    uint64_t hash = 0xcbf29ce484222325ULL ^ num_bytes ;
+
+    Layout scratch ;
+    const Layout & layout = get_allocation_layout(alloc_info, scratch) ;
+
+    if ( layout.contiguous ) {
+        return hash_bytes(hash, start, num_bytes) ;
+    }
+
+    for ( int ii = 0 ; ii < alloc_info->num ; ii++ ) {
+        char * elem = start + (size_t)ii * alloc_info->size ;
+        for ( size_t jj = 0 ; jj < layout.segments.size() ; jj++ ) {
+            const Segment & segment = layout.segments[jj] ;
+            switch ( segment.type ) {
+                case SEGMENT_RAW:
+                    hash = hash_bytes(hash, elem + segment.offset, segment.size) ;
+                    break ;
+                case SEGMENT_POINTER:
+                    hash = hash_bytes(hash, elem + segment.offset, segment.size) ;
+                    if ( segment.char_pointer ) {
+                        for ( size_t kk = 0 ; kk < segment.size ; kk += sizeof(void*) ) {
+                            const char * str = *(const char **)(elem + segment.offset + kk) ;
+                            if ( str != NULL && mem_mgr->get_alloc_info_of((void *)str) == NULL ) {
+                                hash = hash_bytes(hash, str, strlen(str) + 1) ;
+                            }
+                        }
+                    }
+                    break ;
+                case SEGMENT_STRING:
+                    for ( size_t kk = 0 ; kk < segment.size ; kk += sizeof(std::string) ) {
+                        std::string * str = (std::string *)(elem + segment.offset + kk) ;
+                        uint64_t length = str->size() ;
+                        hash = hash_bytes(hash, (const char *)&length, sizeof(length)) ;
+                        hash = hash_bytes(hash, str->data(), str->size()) ;
+                    }
+                    break ;
+                default:
+                    break ;
+            }
+        }
+    }
+    return hash ;
+}
+
+/**
+@details
+-# Write the number of bytes and the bytes of the allocation as they are.
+-# Write a fixup for each non-NULL pointer and each non-empty std::string of the pointer and string
+   segments of every element.  A pointer into an allocation of the checkpoint is written as the table
+   index of the allocation and the offset into it.  A char pointer outside of managed memory is written
+   as the string it points to.  Any other pointer is restored as NULL.
+-# End the fixups.
+*/
+void Trick::BinaryCheckPointAgent::write_data( std::ostream& chkpnt_os, ALLOC_INFO* alloc_info) {
+
+    char * start = (char *)alloc_info->start ;
+    uint64_t num_bytes = (uint64_t)alloc_info->size * alloc_info->num ;
+
+    write_value<uint64_t>(chkpnt_os, num_bytes) ;
+    chkpnt_os.write(start, num_bytes) ;
+
+    Layout scratch ;
+    const Layout & layout = get_allocation_layout(alloc_info, scratch) ;
+
+    if ( ! layout.contiguous ) {
+        for ( int ii = 0 ; ii < alloc_info->num ; ii++ ) {
+            char * elem = start + (size_t)ii * alloc_info->size ;
+            for ( size_t jj = 0 ; jj < layout.segments.size() ; jj++ ) {
+                const Segment & segment = layout.segments[jj] ;
+                if ( segment.type == SEGMENT_POINTER ) {
+                    for ( size_t kk = 0 ; kk < segment.size ; kk += sizeof(void*) ) {
+                        char * addr = elem + segment.offset + kk ;
+                        void * pointer = *(void **)addr ;
+                        if ( pointer == NULL ) {
+                            continue ;
+                        }
+                        ALLOC_INFO * target = mem_mgr->get_alloc_info_of(pointer) ;
+                        std::map<ALLOC_INFO*, int>::iterator it ;
+                        if ( target != NULL && (it = table_index.find(target)) != table_index.end() ) {
+                            write_value<int32_t>(chkpnt_os, FIXUP_POINTER) ;
+                            write_value<uint64_t>(chkpnt_os, addr - start) ;
+                            write_value<int32_t>(chkpnt_os, it->second) ;
+                            write_value<uint64_t>(chkpnt_os, (char *)pointer - (char *)target->start) ;
+                        } else if ( target == NULL && segment.char_pointer ) {
+                            write_value<int32_t>(chkpnt_os, FIXUP_CHAR_STRING) ;
+                            write_value<uint64_t>(chkpnt_os, addr - start) ;
+                            write_string(chkpnt_os, (const char *)pointer, strlen((const char *)pointer)) ;
+                        } else {
+                            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: Pointer <%p> in \"%s\" is not in the checkpoint\n"
+                                                       "nor is it a character pointer.  It will be restored as NULL.\n",
+                                            pointer, alloc_info->name) ;
+                        }
+                    }
+                } else if ( segment.type == SEGMENT_STRING ) {
+                    for ( size_t kk = 0 ; kk < segment.size ; kk += sizeof(std::string) ) {
+                        char * addr = elem + segment.offset + kk ;
+                        std::string * str = (std::string *)addr ;
+                        if ( ! str->empty() ) {
+                            write_value<int32_t>(chkpnt_os, FIXUP_STD_STRING) ;
+                            write_value<uint64_t>(chkpnt_os, addr - start) ;
+                            write_string(chkpnt_os, str->data(), str->size()) ;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    write_value<int32_t>(chkpnt_os, FIXUP_END) ;
+}
+
+/**
+@details
+-# If a base checkpoint is given, read its table.  The base must be a full binary checkpoint.
+-# Write the magic, the format version, the size of a pointer, the number of allocations, the identifier of
+   this checkpoint, then the name and identifier of the base, if any.
+-# Write the table entry of each allocation, followed by its address, the hash of its contents and the
+   index of the base entry that holds the same contents, or -1.  An allocation matches a base entry if it
+   has the same address, type, element size, number of elements and hash.
+-# Write the bytes and fixups of each allocation not found in the base.
+*/
+int Trick::BinaryCheckPointAgent::write_checkpoint( std::ostream& chkpnt_os, std::vector<ALLOC_INFO*>& allocations,
+                                                    const std::string& base_file) {
+
+    std::vector<TableEntry> base_entries ;
+    std::string written_base ;
+    unsigned long long base_id = 0 ;
+
+    if ( ! base_file.empty() ) {
+        std::ifstream base_is(base_file.c_str(), std::ios::in | std::ios::binary) ;
+        unsigned int num_base_allocations ;
+        unsigned long long base_of_base_id ;
+        std::string base_of_base ;
+        if ( base_is.is_open() &&
+             read_header(&base_is, num_base_allocations, base_id, base_of_base, base_of_base_id) == 0 &&
+             base_of_base.empty() ) {
+            base_entries.resize(num_base_allocations) ;
+            written_base = base_file ;
+            for ( size_t ii = 0 ; ii < base_entries.size() ; ii++ ) {
+                if ( read_table_entry(&base_is, base_entries[ii]) != 0 ) {
+                    base_entries.clear() ;
+                    written_base.clear() ;
+                    break ;
+                }
+            }
+        }
+        if ( written_base.empty() ) {
+            message_publish(MSG_WARNING, "Checkpoint Agent WARNING: Could not read the base checkpoint \"%s\".  "
+                                         "Writing a full checkpoint.\n", base_file.c_str()) ;
+            base_id = 0 ;
+        }
+    }
+
+    std::map<unsigned long long, int> base_by_address ;
+    for ( size_t ii = 0 ; ii < base_entries.size() ; ii++ ) {
+        base_by_address[base_entries[ii].address] = ii ;
+    }
+
+    table_index.clear() ;
+    for ( size_t ii = 0 ; ii < allocations.size() ; ii++ ) {
+        table_index[allocations[ii]] = ii ;
+    }
+
+    chkpnt_os.write(magic, sizeof(magic)) ;
+    write_value<uint32_t>(chkpnt_os, binary_checkpoint_version) ;
+    write_value<uint32_t>(chkpnt_os, sizeof(void*)) ;
+    write_value<uint32_t>(chkpnt_os, allocations.size()) ;
+    write_value<uint64_t>(chkpnt_os, new_checkpoint_id()) ;
+    write_string(chkpnt_os, written_base.c_str(), written_base.size()) ;
+    write_value<uint64_t>(chkpnt_os, base_id) ;
+
+    std::vector<int32_t> base_index(allocations.size(), -1) ;
+    uint64_t num_from_base = 0 ;
+    for ( size_t ii = 0 ; ii < allocations.size() ; ii++ ) {
+        ALLOC_INFO * alloc_info = allocations[ii] ;
+        uint64_t address = (uint64_t)(uintptr_t)alloc_info->start ;
+        uint64_t hash = hash_data(alloc_info) ;
+        std::map<unsigned long long, int>::iterator it = base_by_address.find(address) ;
+        if ( it != base_by_address.end() ) {
+            const TableEntry & base_entry = base_entries[it->second] ;
+            if ( base_entry.type == alloc_info->type && base_entry.size == alloc_info->size &&
+                 base_entry.num == alloc_info->num && base_entry.hash == hash ) {
+                base_index[ii] = it->second ;
+                num_from_base++ ;
+            }
+        }
+        write_decl(chkpnt_os, alloc_info) ;
+        write_value<uint64_t>(chkpnt_os, address) ;
+        write_value<uint64_t>(chkpnt_os, hash) ;
+        write_value<int32_t>(chkpnt_os, base_index[ii]) ;
+    }
+
+    for ( size_t ii = 0 ; ii < allocations.size() ; ii++ ) {
+        if ( base_index[ii] >= 0 ) {
+            continue ;
+        }
+        if (debug_level) {
+            message_publish(MSG_DEBUG, "Checkpoint Agent INFO: Writing %llu bytes of \"%s\".\n",
+                            (unsigned long long)allocations[ii]->size * allocations[ii]->num, allocations[ii]->name) ;
+        }
+        write_data(chkpnt_os, allocations[ii]) ;
+    }
+    chkpnt_os.flush() ;
+
+    if (debug_level && !written_base.empty()) {
+        message_publish(MSG_DEBUG, "Checkpoint Agent INFO: %llu of %llu allocations are unchanged since \"%s\".\n",
+                        (unsigned long long)num_from_base, (unsigned long long)allocations.size(),
+                        written_base.c_str()) ;
+    }
+
+    table_index.clear() ;
+    return chkpnt_os.good() ? 0 : 1 ;
+}
+
+// MEMBER FUNCTION
+bool Trick::BinaryCheckPointAgent::is_binary_checkpoint( std::istream* checkpoint_stream) {
+
+    char buf[sizeof(magic)] ;
+    std::streampos start = checkpoint_stream->tellg() ;
+
+    if ( start == std::streampos(-1) ) {
+        return false ;
+    }
+    checkpoint_stream->read(buf, sizeof(buf)) ;
+    bool found = ( checkpoint_stream->gcount() == sizeof(buf) && memcmp(buf, magic, sizeof(buf)) == 0 ) ;
+    checkpoint_stream->clear() ;
+    checkpoint_stream->seekg(start) ;
+    return found ;
+}
+
+// MEMBER FUNCTION
+void Trick::BinaryCheckPointAgent::set_checkpoint_file( const std::string& file_name) {
+    checkpoint_file = file_name ;
+}
+
+// MEMBER FUNCTION
+int Trick::BinaryCheckPointAgent::read_header( std::istream* chkpnt_is, unsigned int& num_allocations,
+                                               unsigned long long& id, std::string& base_file,
+                                               unsigned long long& base_id) {
+
+    char buf[sizeof(magic)] ;
+    uint32_t version, pointer_size, num ;
+    uint64_t id_value, base_id_value ;
+
+    chkpnt_is->read(buf, sizeof(buf)) ;
+    if ( !chkpnt_is->good() || memcmp(buf, magic, sizeof(buf)) != 0 ) {
+        message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The stream is not a binary checkpoint.\n") ;
+        return 1 ;
+    }
+    if ( !read_value(chkpnt_is, version) || !read_value(chkpnt_is, pointer_size) ) {
+        message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint is truncated.\n") ;
+        return 1 ;
+    }
+    if ( version != binary_checkpoint_version || pointer_size != sizeof(void*) ) {
+        message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint was written by an incompatible "
+                                   "simulation (format version %u, %u byte pointers).\n", version, pointer_size) ;
+        return 1 ;
+    }
+    if ( !read_value(chkpnt_is, num) || !read_value(chkpnt_is, id_value) || !read_string(chkpnt_is, base_file) ||
+         !read_value(chkpnt_is, base_id_value) ) {
+        message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint is truncated.\n") ;
+        return 1 ;
+    }
+    num_allocations = num ;
+    id = id_value ;
+    base_id = base_id_value ;
+    return 0 ;
+}
+
+// MEMBER FUNCTION
+int Trick::BinaryCheckPointAgent::read_table_entry( std::istream* chkpnt_is, TableEntry& entry) {
+
+    int32_t stcl, type, size, num, num_index, base_index ;
+    uint64_t address, hash ;
+
+    if ( !read_value(chkpnt_is, stcl) || !read_value(chkpnt_is, type) || !read_value(chkpnt_is, size) ||
+         !read_value(chkpnt_is, num) || !read_value(chkpnt_is, num_index) ||
+         num_index < 0 || num_index > TRICK_MAX_INDEX ) {
+        return 1 ;
+    }
+    for ( int jj = 0 ; jj < num_index ; jj++ ) {
+        int32_t dim ;
+        if ( !read_value(chkpnt_is, dim) ) {
+            return 1 ;
+        }
+        entry.index[jj] = dim ;
+    }
+    if ( !read_string(chkpnt_is, entry.name) || !read_string(chkpnt_is, entry.user_type_name) ||
+         !read_value(chkpnt_is, address) || !read_value(chkpnt_is, hash) || !read_value(chkpnt_is, base_index) ) {
+        return 1 ;
+    }
+    entry.stcl = stcl ;
+    entry.type = type ;
+    entry.size = size ;
+    entry.num = num ;
+    entry.num_index = num_index ;
+    entry.address = address ;
+    entry.hash = hash ;
+    entry.base_index = base_index ;
+    return 0 ;
+}
+
+/**
+@details
+-# Read each table entry.
+-# Local allocations already declared under the same name are reused.  Others are declared.
+-# External allocations are found by name.  Anonymous external allocations cannot be found and are not
+   restored, as in a text checkpoint.
+-# An allocation whose type, element size or number of elements changed since the checkpoint was written
+   is not restored.
+*/
+int Trick::BinaryCheckPointAgent::read_table( std::istream* chkpnt_is, std::vector<TableEntry>& entries,
+                                              std::vector<ALLOC_INFO*>& table) {
+
+    std::map<std::string, ALLOC_INFO*> named_allocations ;
+    for ( VARIABLE_MAP_ITER it = mem_mgr->variable_map_begin() ; it != mem_mgr->variable_map_end() ; it++ ) {
+        named_allocations[it->first] = it->second ;
+    }
+
+    for ( size_t ii = 0 ; ii < table.size() ; ii++ ) {
+        TableEntry & entry = entries[ii] ;
+
+        if ( read_table_entry(chkpnt_is, entry) != 0 ) {
+            return 1 ;
+        }
+
+        ALLOC_INFO * alloc_info = NULL ;
+        std::map<std::string, ALLOC_INFO*>::iterator it = named_allocations.find(entry.name) ;
+        if ( it != named_allocations.end() ) {
+            alloc_info = it->second ;
+        } else if ( entry.stcl == TRICK_LOCAL ) {
+            int n_stars = 0 ;
+            int n_cdims = 0 ;
+            int cdims[TRICK_MAX_INDEX] ;
+            for ( int jj = 0 ; jj < entry.num_index ; jj++ ) {
+                if ( entry.index[jj] == 0 ) {
+                    n_stars++ ;
+                } else {
+                    cdims[n_cdims++] = entry.index[jj] ;
+                }
+            }
+            void * address = mem_mgr->declare_var((TRICK_TYPE)entry.type, entry.user_type_name, n_stars, entry.name,
+                                                  n_cdims, cdims) ;
+            if ( address != NULL ) {
+                alloc_info = mem_mgr->get_alloc_info_at(address) ;
+            }
+        } else if (debug_level) {
+            message_publish(MSG_DEBUG, "Checkpoint Agent INFO: External allocation \"%s\" is not restored "
+                                       "because it is not declared.\n", entry.name.c_str()) ;
+        }
+
+        if ( alloc_info != NULL &&
+             ( alloc_info->type != entry.type || alloc_info->size != entry.size || alloc_info->num != entry.num ) ) {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: \"%s\" is not restored because its type or size "
+                                       "differs from the checkpoint.\n", entry.name.c_str()) ;
+            alloc_info = NULL ;
+        }
+        table[ii] = alloc_info ;
+    }
+    return 0 ;
+}
+/**
+@details
+-# A contiguous layout is read straight into the allocation.
+-# Otherwise the bytes are read in chunks of whole elements.  The raw segments of each element are copied
+   into the allocation, its pointers are set to NULL and its std::strings are cleared.  The fixups that
+   follow set the pointers and strings that had values.
+*/
+int Trick::BinaryCheckPointAgent::read_data( std::istream* chkpnt_is, ALLOC_INFO* alloc_info,
+                                             unsigned long long num_bytes) {
+
+    char * start = (char *)alloc_info->start ;
+    Layout scratch ;
+    const Layout & layout = get_allocation_layout(alloc_info, scratch) ;
+
+    if ( layout.contiguous ) {
+        chkpnt_is->read(start, num_bytes) ;
+        return chkpnt_is->good() ? 0 : 1 ;
+    }
+
+    const size_t chunk_bytes = 1 << 20 ;
+    size_t elems_per_chunk = std::max((size_t)1, chunk_bytes / alloc_info->size) ;
+    std::vector<char> buffer(std::min((size_t)alloc_info->num, elems_per_chunk) * alloc_info->size) ;
+
+    for ( int ii = 0 ; ii < alloc_info->num ; ii += elems_per_chunk ) {
+        size_t num_elems = std::min((size_t)(alloc_info->num - ii), elems_per_chunk) ;
+        chkpnt_is->read(&buffer[0], num_elems * alloc_info->size) ;
+        if ( ! chkpnt_is->good() ) {
+            return 1 ;
+        }
+        for ( size_t jj = 0 ; jj < num_elems ; jj++ ) {
+            char * elem = start + (ii + jj) * alloc_info->size ;
+            char * saved_elem = &buffer[jj * alloc_info->size] ;
+            for ( size_t kk = 0 ; kk < layout.segments.size() ; kk++ ) {
+                const Segment & segment = layout.segments[kk] ;
+                switch ( segment.type ) {
+                    case SEGMENT_RAW:
+                        memcpy(elem + segment.offset, saved_elem + segment.offset, segment.size) ;
+                        break ;
+                    case SEGMENT_POINTER:
+                        memset(elem + segment.offset, 0, segment.size) ;
+                        break ;
+                    case SEGMENT_STRING:
+                        for ( size_t ll = 0 ; ll < segment.size ; ll += sizeof(std::string) ) {
+                            ((std::string *)(elem + segment.offset + ll))->clear() ;
+                        }
+                        break ;
+                    default:
+                        break ;
+                }
+            }
+        }
+    }
+    return 0 ;
+}
+
+// MEMBER FUNCTION
+int Trick::BinaryCheckPointAgent::read_fixups( std::istream* chkpnt_is, char* start, unsigned long long num_bytes,
+                                               std::vector<char*>& target_starts) {
+
+    int32_t fixup_type ;
+    uint64_t offset ;
+
+    while ( read_value(chkpnt_is, fixup_type) && fixup_type != FIXUP_END ) {
+        if ( !read_value(chkpnt_is, offset) ) {
+            break ;
+        }
+        bool in_bounds = ( start != NULL && offset < num_bytes ) ;
+        if ( fixup_type == FIXUP_POINTER ) {
+            int32_t target ;
+            uint64_t target_offset ;
+            if ( !read_value(chkpnt_is, target) || !read_value(chkpnt_is, target_offset) ) {
+                break ;
+            }
+            if ( in_bounds ) {
+                void * pointer = NULL ;
+                if ( target >= 0 && (size_t)target < target_starts.size() && target_starts[target] != NULL ) {
+                    pointer = target_starts[target] + target_offset ;
+                }
+                *(void **)(start + offset) = pointer ;
+            }
+        } else if ( fixup_type == FIXUP_CHAR_STRING || fixup_type == FIXUP_STD_STRING ) {
+            std::string str ;
+            if ( !read_string(chkpnt_is, str) ) {
+                break ;
+            }
+            if ( in_bounds && fixup_type == FIXUP_CHAR_STRING ) {
+                *(char **)(start + offset) = mem_mgr->mm_strdup(str.c_str()) ;
+            } else if ( in_bounds ) {
+                *(std::string *)(start + offset) = str ;
+            }
+        } else {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: Unknown fixup type (%d) in the binary checkpoint.\n",
+                            fixup_type) ;
+            return 1 ;
+        }
+    }
+    return chkpnt_is->good() ? 0 : 1 ;
+}
+
+/**
+@details
+-# Open the base where it was written.  If it is not there, look for it in the directory of the
+   checkpoint being restored.
+-# Check that the base is the one the checkpoint was written against and not a later checkpoint written
+   to the same file.
+-# A pointer in the base was written as an address in one of its allocations.  Those contents did not
+   change, so the pointer still held that address when the incremental checkpoint was written.  Find the
+   allocation of the incremental checkpoint that held the address and point into it.
+-# Read the contents of each base allocation the incremental checkpoint refers to.  Skip the others.
+*/
+int Trick::BinaryCheckPointAgent::restore_from_base( const std::string& base_file, unsigned long long base_id,
+                                                     std::vector<TableEntry>& entries,
+                                                     std::vector<ALLOC_INFO*>& table) {
+
+    std::ifstream base_is(base_file.c_str(), std::ios::in | std::ios::binary) ;
+    std::string base_path = base_file ;
+
+    if ( ! base_is.is_open() && ! checkpoint_file.empty() ) {
+        size_t dir_end = checkpoint_file.rfind('/') ;
+        size_t base_name_start = base_file.rfind('/') ;
+        base_path = ( dir_end == std::string::npos ? std::string("") : checkpoint_file.substr(0, dir_end + 1) ) +
+                    ( base_name_start == std::string::npos ? base_file : base_file.substr(base_name_start + 1) ) ;
+        base_is.open(base_path.c_str(), std::ios::in | std::ios::binary) ;
+    }
+    if ( ! base_is.is_open() ) {
+        message_publish(MSG_ERROR, "Checkpoint Agent ERROR: Could not open \"%s\", the base of the incremental "
+                                   "checkpoint.\n", base_file.c_str()) ;
+        return 1 ;
+    }
+
+    unsigned int num_base_allocations ;
+    unsigned long long id, base_of_base_id ;
+    std::string base_of_base ;
+    if ( read_header(&base_is, num_base_allocations, id, base_of_base, base_of_base_id) != 0 ) {
+        return 1 ;
+    }
+    if ( id != base_id || ! base_of_base.empty() ) {
+        message_publish(MSG_ERROR, "Checkpoint Agent ERROR: \"%s\" is not the base the incremental checkpoint "
+                                   "was written against.  It was replaced by a later checkpoint.\n",
+                                   base_path.c_str()) ;
+        return 1 ;
+    }
+
+    std::vector<TableEntry> base_entries(num_base_allocations) ;
+    for ( size_t ii = 0 ; ii < base_entries.size() ; ii++ ) {
+        if ( read_table_entry(&base_is, base_entries[ii]) != 0 ) {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint \"%s\" is truncated.\n",
+                            base_path.c_str()) ;
+            return 1 ;
+        }
+    }
+
+    std::vector<int> wanted(base_entries.size(), -1) ;
+    std::map<unsigned long long, int> by_address ;
+    for ( size_t ii = 0 ; ii < entries.size() ; ii++ ) {
+        if ( entries[ii].base_index >= 0 && (size_t)entries[ii].base_index < wanted.size() ) {
+            wanted[entries[ii].base_index] = ii ;
+        }
+        if ( table[ii] != NULL ) {
+            by_address[entries[ii].address] = ii ;
+        }
+    }
+
+    std::vector<char*> target_starts(base_entries.size(), (char *)NULL) ;
+    for ( size_t ii = 0 ; ii < base_entries.size() ; ii++ ) {
+        unsigned long long address = base_entries[ii].address ;
+        std::map<unsigned long long, int>::iterator it = by_address.upper_bound(address) ;
+        if ( it != by_address.begin() ) {
+            --it ;
+            const TableEntry & entry = entries[it->second] ;
+            if ( address < entry.address + (unsigned long long)entry.size * entry.num ) {
+                target_starts[ii] = (char *)table[it->second]->start + (address - entry.address) ;
+            }
+        }
+    }
+
+    for ( size_t ii = 0 ; ii < base_entries.size() ; ii++ ) {
+        ALLOC_INFO * alloc_info = wanted[ii] >= 0 ? table[wanted[ii]] : NULL ;
+        uint64_t num_bytes ;
+
+        if ( !read_value(&base_is, num_bytes) ) {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint \"%s\" is truncated.\n",
+                            base_path.c_str()) ;
+            return 1 ;
+        }
+        if ( alloc_info != NULL && num_bytes != (uint64_t)alloc_info->size * alloc_info->num ) {
+            alloc_info = NULL ;
+        }
+        if ( alloc_info == NULL ) {
+            base_is.ignore(num_bytes) ;
+        } else if ( read_data(&base_is, alloc_info, num_bytes) != 0 ) {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint \"%s\" is truncated.\n",
+                            base_path.c_str()) ;
+            return 1 ;
+        }
+        if ( read_fixups(&base_is, alloc_info ? (char *)alloc_info->start : NULL, num_bytes, target_starts) != 0 ) {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint \"%s\" is truncated.\n",
+                            base_path.c_str()) ;
+            return 1 ;
+        }
+    }
+    return 0 ;
+}
+
+/**
+@details
+-# Read the header and check the format version and the size of a pointer.
+-# Find or declare the allocation of each table entry.
+-# If the checkpoint is incremental, restore the allocations whose contents are in the base from the base.
+-# Restore the bytes of each of the other allocations, then apply its fixups.  The bytes of allocations
+   that could not be found are skipped, as are fixups that point to them.
+*/
+int Trick::BinaryCheckPointAgent::restore( std::istream* checkpoint_stream) {
+
+    unsigned int num_allocations ;
+    unsigned long long id, base_id ;
+    std::string base_file ;
+
+    if ( read_header(checkpoint_stream, num_allocations, id, base_file, base_id) != 0 ) {
+        return 1 ;
+    }
+
+    std::vector<TableEntry> entries(num_allocations) ;
+    std::vector<ALLOC_INFO*> table(num_allocations, (ALLOC_INFO*)NULL) ;
+    if ( read_table(checkpoint_stream, entries, table) != 0 ) {
+        message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint is truncated.\n") ;
+        return 1 ;
+    }
+
+    if ( ! base_file.empty() && restore_from_base(base_file, base_id, entries, table) != 0 ) {
+        return 1 ;
+    }
+
+    std::vector<char*> target_starts(table.size(), (char *)NULL) ;
+    for ( size_t ii = 0 ; ii < table.size() ; ii++ ) {
+        if ( table[ii] != NULL ) {
+            target_starts[ii] = (char *)table[ii]->start ;
+        }
+    }
+
+    for ( size_t ii = 0 ; ii < table.size() ; ii++ ) {
+        ALLOC_INFO * alloc_info = table[ii] ;
+        uint64_t num_bytes ;
+
+        if ( entries[ii].base_index >= 0 ) {
+            continue ;
+        }
+        if ( !read_value(checkpoint_stream, num_bytes) ) {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint is truncated.\n") ;
+            return 1 ;
+        }
+        if ( alloc_info == NULL ) {
+            checkpoint_stream->ignore(num_bytes) ;
+        } else if ( read_data(checkpoint_stream, alloc_info, num_bytes) != 0 ) {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint is truncated.\n") ;
+            return 1 ;
+        }
+        if ( read_fixups(checkpoint_stream, alloc_info ? (char *)alloc_info->start : NULL, num_bytes,
+                         target_starts) != 0 ) {
+            message_publish(MSG_ERROR, "Checkpoint Agent ERROR: The binary checkpoint is truncated.\n") ;
+            return 1 ;
+        }
+    }
+    return 0 ;
+}
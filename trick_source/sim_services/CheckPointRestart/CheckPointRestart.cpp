@@ -31,6 +31,19 @@ Trick::CheckPointRestart::CheckPointRestart() {
     end_checkpoint = false ;
     safestore_enabled = false ;
     cpu_num = -1 ;
+    incremental = false ;
+    incremental_base_interval = 10 ;
+    checkpoints_since_base = 0 ;
+    max_writers = 1 ;
+    writers_in_flight = 0 ;
+    writes_completed = 0 ;
+    writes_failed = 0 ;
+    writes_skipped = 0 ;
+    last_write_status = 0 ;
+    last_write_time = 0.0 ;
+    last_fork_time = 0.0 ;
+    max_fork_time = 0.0 ;
+    last_write_page_faults = 0 ;
     safestore_time = TRICK_MAX_LONG_LONG ;
     load_checkpoint_file_name.clear() ;
 
@@ -72,6 +85,29 @@ int Trick::CheckPointRestart::set_safestore_enabled(bool yes_no) {
     return(0) ;
 }
 
+int Trick::CheckPointRestart::set_incremental(bool yes_no) {
+    incremental = yes_no ;
+    return(0) ;
+}
+
+int Trick::CheckPointRestart::set_incremental_base_interval(int num) {
+    if ( num < 1 ) {
+        incremental_base_interval = 1 ;
+    } else {
+        incremental_base_interval = num ;
+    }
+    return(0) ;
+}
+
+int Trick::CheckPointRestart::set_max_writers(int num) {
+    if ( num < 1 ) {
+        max_writers = 1 ;
+    } else {
+        max_writers = num ;
+    }
+    return(0) ;
+}
+
 int Trick::CheckPointRestart::set_cpu_num(int in_cpu_num) {
     if ( in_cpu_num <= 0 ) {
         cpu_num = -1 ;
@@ -167,16 +203,33 @@ int Trick::CheckPointRestart::checkpoint(std::string file_name, bool print_statu
     return(0) ;
 }
 
-int Trick::CheckPointRestart::do_checkpoint(std::string file_name, bool print_status) {
+int Trick::CheckPointRestart::do_checkpoint(std::string file_name, bool print_status, bool skip_if_busy) {
 
     JobData * curr_job ;
-    pid_t pid;
 
     if ( ! file_name.compare("") ) {
         std::stringstream file_name_stream ;
         file_name_stream << "chkpnt_" << std::fixed << std::setprecision(6) << exec_get_sim_time() ;
         file_name = file_name_stream.str() ;
     }
+
+    if ( cpu_num != -1 ) {
+    // if the user specified a cpu number for the checkpoint, the checkpoint is written by a forked process.
+    // Make room for it before running any checkpoint jobs.
+        reap_checkpoint_writers() ;
+        if ( (int)writers.size() >= max_writers ) {
+            if ( skip_if_busy ) {
+                writes_skipped++ ;
+                message_publish(MSG_WARNING, "Skipped checkpoint %s, %d checkpoint writers are still writing.\n",
+                                file_name.c_str(), (int)writers.size()) ;
+                return 0 ;
+            }
+            while ( (int)writers.size() >= max_writers ) {
+                wait_for_oldest_checkpoint_writer() ;
+            }
+        }
+    }
+
     output_file = std::string(command_line_args_get_output_dir()) + "/" + file_name ;
 
     checkpoint_queue.reset_curr_index() ;
@@ -184,35 +237,39 @@ int Trick::CheckPointRestart::do_checkpoint(std::string file_name, bool print_st
         curr_job->parent_object->call_function(curr_job) ;
     }
 
-    if ( cpu_num != -1 ) {
-    // if the user specified a cpu number for the checkpoint, fork a process to write the checkpoint
-        if ((pid = fork()) == 0) {
-#if __linux
-            if ( cpu_num >= 0 ) {
-                unsigned long mask;
-                mask = 1 << cpu_num ;
-                syscall((long) __NR_sched_setaffinity, 0, sizeof(mask), &mask);
-            }
-#endif
-#if __APPLE__
-            if ( cpu_num >= 0 ) {
-            }
-#endif
+    // An incremental checkpoint is written against the last base.  Every incremental_base_interval
+    // checkpoints a new base is written next to the checkpoint.
+    new_base_file.clear() ;
+    current_base_file.clear() ;
+    if ( incremental and trick_MM->get_binary_checkpoint() ) {
+        if ( base_file.empty() or checkpoints_since_base >= incremental_base_interval ) {
+            base_file = output_file + ".base" ;
+            new_base_file = base_file ;
+            checkpoints_since_base = 0 ;
+        }
+        current_base_file = base_file ;
+        checkpoints_since_base++ ;
+    }
+
+    if ( cpu_num != -1 and fork_checkpoint_writer(file_name, print_status) == 0 ) {
+        // the writer reports the checkpoint when it has finished writing it
+        print_status = false ;
+    } else {
+    // no fork, or the fork failed
+        if ( ! new_base_file.empty() ) {
             if (obj_list.empty()) {
-                trick_MM->write_checkpoint(output_file.c_str()) ;
+                trick_MM->write_checkpoint(new_base_file.c_str()) ;
             } else {
-                trick_MM->write_checkpoint(output_file.c_str(), obj_list);
+                trick_MM->write_checkpoint(new_base_file.c_str(), obj_list);
             }
-            _Exit(0) ;
         }
-    }
-    else {
-    // no fork
+        trick_MM->set_checkpoint_base(current_base_file) ;
         if (obj_list.empty()) {
             trick_MM->write_checkpoint(output_file.c_str()) ;
         } else {
             trick_MM->write_checkpoint(output_file.c_str(), obj_list);
         }
+        trick_MM->set_checkpoint_base("") ;
     }
 
     post_checkpoint_queue.reset_curr_index() ;
@@ -221,7 +278,8 @@ int Trick::CheckPointRestart::do_checkpoint(std::string file_name, bool print_st
     }
 
     if ( print_status ) {
-        message_publish(MSG_INFO, "Dumped ASCII Checkpoint %s.\n", file_name.c_str()) ;
+        message_publish(MSG_INFO, "Dumped %s Checkpoint %s.\n",
+                        trick_MM->get_binary_checkpoint() ? "Binary" : "ASCII", file_name.c_str()) ;
     }
 
     return 0 ;
@@ -281,7 +339,9 @@ int Trick::CheckPointRestart::write_end_checkpoint() {
 int Trick::CheckPointRestart::safestore_checkpoint() {
 
     if ( safestore_enabled) {
-        checkpoint(std::string("chkpnt_safestore"), false) ;
+        // a safestore checkpoint is skipped rather than stall the simulation waiting for a writer
+        obj_list.clear() ;
+        do_checkpoint(std::string("chkpnt_safestore"), false, true) ;
         safestore_time += safestore_period ;
     }
 
@@ -323,6 +383,9 @@ int Trick::CheckPointRestart::load_checkpoint_job() {
             message_publish(MSG_INFO, "Load checkpoint file %s.\n", load_checkpoint_file_name.c_str()) ;
             trick_MM->init_from_checkpoint(load_checkpoint_file_name.c_str()) ;
 
+            // The allocations moved, so the next incremental checkpoint starts a new base.
+            base_file.clear() ;
+
             message_publish(MSG_INFO, "Finished loading checkpoint file.  Calling restart jobs.\n") ;
 
             // bootstrap the sim_objects back into the executive!
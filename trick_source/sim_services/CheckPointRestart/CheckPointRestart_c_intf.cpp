@@ -91,6 +91,33 @@ extern "C" int checkpoint_cpu( int in_cpu_num ) {
     return(0) ;
 }
 
+/**
+ * @relates Trick::CheckPointRestart
+ * @copydoc Trick::CheckPointRestart::set_incremental
+ */
+extern "C" int checkpoint_incremental( int yes_no ) {
+    the_cpr->set_incremental(bool(yes_no)) ;
+    return(0) ;
+}
+
+/**
+ * @relates Trick::CheckPointRestart
+ * @copydoc Trick::CheckPointRestart::set_incremental_base_interval
+ */
+extern "C" int checkpoint_incremental_base_interval( int num ) {
+    the_cpr->set_incremental_base_interval(num) ;
+    return(0) ;
+}
+
+/**
+ * @relates Trick::CheckPointRestart
+ * @copydoc Trick::CheckPointRestart::set_max_writers
+ */
+extern "C" int checkpoint_max_writers( int num ) {
+    the_cpr->set_max_writers(num) ;
+    return(0) ;
+}
+
 
 /**
  * @relates Trick::CheckPointRestart
@@ -0,0 +1,255 @@
+
+#include <fstream>
+#include <sstream>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "trick/CheckPointRestart.hh"
+#include "trick/MemoryManager.hh"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+/* What a writer sends back to the simulation through its pipe before it exits. */
+struct CheckPointWriterResult {
+    int status ;        /* 0 for success, else the step that failed */
+    int error ;         /* errno of the failure */
+    double write_time ; /* seconds spent writing and renaming the checkpoint */
+} ;
+
+enum {
+    WRITER_SUCCESS = 0 ,
+    WRITER_OPEN_FAILED ,
+    WRITER_WRITE_FAILED ,
+    WRITER_RENAME_FAILED
+} ;
+
+static double writer_clock() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return tp.tv_sec + tp.tv_nsec / 1.0e9 ;
+}
+
+static std::string partial_file_name( const std::string & file_name, pid_t pid ) {
+    std::stringstream temp_file_stream ;
+    temp_file_stream << file_name << ".partial." << pid ;
+    return temp_file_stream.str() ;
+}
+
+/*
+  Write a checkpoint to a temporary file and rename it when it is complete, so a partial
+  checkpoint is never found under the checkpoint's name.  Returns a WRITER_ status.
+*/
+static int write_file( const std::string & file_name, std::vector<const char*> & obj_list, int & error ) {
+
+    std::string temp_file = partial_file_name(file_name, getpid()) ;
+    int status = WRITER_SUCCESS ;
+
+    std::ofstream out_s( temp_file.c_str(), std::ios::out | std::ios::binary ) ;
+    if ( ! out_s.is_open() ) {
+        error = errno ;
+        return WRITER_OPEN_FAILED ;
+    }
+    if (obj_list.empty()) {
+        trick_MM->write_checkpoint(out_s) ;
+    } else {
+        trick_MM->write_checkpoint(out_s, obj_list);
+    }
+    out_s.close() ;
+    if ( out_s.fail() ) {
+        status = WRITER_WRITE_FAILED ;
+        error = errno ;
+    } else if ( rename(temp_file.c_str(), file_name.c_str()) != 0 ) {
+        status = WRITER_RENAME_FAILED ;
+        error = errno ;
+    }
+    if ( status != WRITER_SUCCESS ) {
+        unlink(temp_file.c_str()) ;
+    }
+    return status ;
+}
+
+static long minor_page_faults() {
+    struct rusage usage ;
+    getrusage(RUSAGE_SELF, &usage) ;
+    return usage.ru_minflt ;
+}
+
+int Trick::CheckPointRestart::fork_checkpoint_writer(std::string file_name, bool print_status) {
+
+    int fds[2] ;
+    pid_t pid ;
+    double start_time ;
+    long start_minor_faults ;
+
+    if ( pipe(fds) == -1 ) {
+        message_publish(MSG_WARNING, "Could not create a pipe for a checkpoint writer: %s.  Writing checkpoint %s in the simulation.\n",
+                        strerror(errno), file_name.c_str()) ;
+        return -1 ;
+    }
+
+    start_minor_faults = minor_page_faults() ;
+    start_time = writer_clock() ;
+
+    if ((pid = fork()) == 0) {
+        CheckPointWriterResult result ;
+        double write_start ;
+
+        close(fds[0]) ;
+#if __linux
+        if ( cpu_num >= 0 ) {
+            unsigned long mask;
+            mask = 1 << cpu_num ;
+            syscall((long) __NR_sched_setaffinity, 0, sizeof(mask), &mask);
+        }
+#endif
+        write_start = writer_clock() ;
+
+        result.status = WRITER_SUCCESS ;
+        result.error = 0 ;
+        if ( ! new_base_file.empty() ) {
+            trick_MM->set_checkpoint_base("") ;
+            result.status = write_file(new_base_file, obj_list, result.error) ;
+        }
+        if ( result.status == WRITER_SUCCESS ) {
+            trick_MM->set_checkpoint_base(current_base_file) ;
+            result.status = write_file(output_file, obj_list, result.error) ;
+        }
+        result.write_time = writer_clock() - write_start ;
+
+        if ( write(fds[1], &result, sizeof(result)) != (ssize_t)sizeof(result) ) {
+            result.status = WRITER_WRITE_FAILED ;
+        }
+        _Exit(result.status) ;
+    }
+
+    // The simulation is stalled while the fork copies its page tables.
+    last_fork_time = writer_clock() - start_time ;
+    close(fds[1]) ;
+
+    if ( pid == -1 ) {
+        message_publish(MSG_WARNING, "Could not fork a checkpoint writer: %s.  Writing checkpoint %s in the simulation.\n",
+                        strerror(errno), file_name.c_str()) ;
+        close(fds[0]) ;
+        return -1 ;
+    }
+
+    if ( last_fork_time > max_fork_time ) {
+        max_fork_time = last_fork_time ;
+    }
+
+    CheckPointWriter writer ;
+    writer.pid = pid ;
+    writer.result_fd = fds[0] ;
+    writer.file_name = file_name ;
+    writer.temp_file = partial_file_name(output_file, pid) ;
+    if ( ! new_base_file.empty() ) {
+        writer.base_temp_file = partial_file_name(new_base_file, pid) ;
+    }
+    writer.print_status = print_status ;
+    writer.start_time = start_time ;
+    writer.start_minor_faults = start_minor_faults ;
+    writers.push_back(writer) ;
+    writers_in_flight = (int)writers.size() ;
+
+    return 0 ;
+}
+
+void Trick::CheckPointRestart::finish_checkpoint_writer( CheckPointWriter & writer , int status ) {
+
+    CheckPointWriterResult result ;
+    ssize_t num_read ;
+
+    // Every page the simulation changed while the writer ran was copied on write.
+    last_write_page_faults = minor_page_faults() - writer.start_minor_faults ;
+
+    do {
+        num_read = read(writer.result_fd, &result, sizeof(result)) ;
+    } while ( num_read == -1 and errno == EINTR ) ;
+    close(writer.result_fd) ;
+
+    if ( num_read != (ssize_t)sizeof(result) ) {
+        // the writer died before it could report
+        result.status = WRITER_WRITE_FAILED ;
+        result.error = 0 ;
+        result.write_time = writer_clock() - writer.start_time ;
+        unlink(writer.temp_file.c_str()) ;
+        if ( ! writer.base_temp_file.empty() ) {
+            unlink(writer.base_temp_file.c_str()) ;
+        }
+    }
+
+    if ( result.status == WRITER_SUCCESS and ( status == -1 or !WIFEXITED(status) or WEXITSTATUS(status) != 0 ) ) {
+        result.status = WRITER_WRITE_FAILED ;
+    }
+
+    last_write_status = result.status ;
+    last_write_time = result.write_time ;
+
+    if ( result.status == WRITER_SUCCESS ) {
+        writes_completed++ ;
+        if ( writer.print_status ) {
+            message_publish(MSG_INFO, "Dumped %s Checkpoint %s in %.3f seconds.\n",
+                            trick_MM->get_binary_checkpoint() ? "Binary" : "ASCII", writer.file_name.c_str(),
+                            result.write_time) ;
+        }
+    } else {
+        writes_failed++ ;
+        if ( num_read != (ssize_t)sizeof(result) ) {
+            message_publish(MSG_ERROR, "Checkpoint writer for %s exited without writing the checkpoint.\n",
+                            writer.file_name.c_str()) ;
+        } else {
+            message_publish(MSG_ERROR, "Could not %s checkpoint %s: %s\n",
+                            result.status == WRITER_OPEN_FAILED ? "open" :
+                            result.status == WRITER_RENAME_FAILED ? "rename" : "write",
+                            writer.file_name.c_str(), strerror(result.error)) ;
+        }
+    }
+}
+
+int Trick::CheckPointRestart::reap_checkpoint_writers() {
+
+    std::vector<CheckPointWriter>::iterator it = writers.begin() ;
+    int status ;
+
+    while ( it != writers.end() ) {
+        pid_t ret = waitpid(it->pid, &status, WNOHANG) ;
+        if ( ret == 0 ) {
+            ++it ;
+        } else {
+            finish_checkpoint_writer(*it, ret == -1 ? -1 : status) ;
+            it = writers.erase(it) ;
+        }
+    }
+    writers_in_flight = (int)writers.size() ;
+
+    return 0 ;
+}
+
+void Trick::CheckPointRestart::wait_for_oldest_checkpoint_writer() {
+
+    int status ;
+    pid_t ret ;
+
+    do {
+        ret = waitpid(writers.front().pid, &status, 0) ;
+    } while ( ret == -1 and errno == EINTR ) ;
+    finish_checkpoint_writer(writers.front(), ret == -1 ? -1 : status) ;
+    writers.erase(writers.begin()) ;
+    writers_in_flight = (int)writers.size() ;
+}
+
+int Trick::CheckPointRestart::wait_for_checkpoint_writers() {
+
+    while ( ! writers.empty() ) {
+        wait_for_oldest_checkpoint_writer() ;
+    }
+
+    return 0 ;
+}
@@ -0,0 +1,187 @@
+
+#include <string>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include "gtest/gtest.h"
+
+#define protected public
+#include "trick/CheckPointRestart.hh"
+#include "trick/CommandLineArguments.hh"
+#include "trick/MemoryManager.hh"
+
+namespace Trick {
+
+class CheckPointRestartTest : public ::testing::Test {
+    protected:
+        Trick::CommandLineArguments cmd_args ;
+        Trick::MemoryManager * memmgr ;
+        Trick::CheckPointRestart cpr ;
+
+        CheckPointRestartTest() {}
+        ~CheckPointRestartTest() {}
+        virtual void SetUp() {
+            memmgr = new Trick::MemoryManager ;
+            double * values = (double *)memmgr->declare_var("double values[3]") ;
+            values[0] = 1.0 ;
+            values[1] = 2.0 ;
+            values[2] = 3.0 ;
+            /* Checkpoints are written by forked writers that are not pinned to a CPU */
+            cpr.cpu_num = -2 ;
+            cpr.safestore_period = 1 ;
+            cpr.safestore_time = 0 ;
+        }
+        virtual void TearDown() {
+            cpr.wait_for_checkpoint_writers() ;
+            delete memmgr ;
+        }
+
+        std::string path( std::string file_name ) {
+            return cmd_args.get_output_dir() + "/" + file_name ;
+        }
+
+        static bool exists( std::string file ) {
+            struct stat st ;
+            return stat(file.c_str(), &st) == 0 ;
+        }
+
+        /* Number of partial checkpoint files left in the output directory */
+        int num_partial_files() {
+            int count = 0 ;
+            DIR * dir = opendir(cmd_args.get_output_dir().c_str()) ;
+            struct dirent * entry ;
+            while ( dir != NULL and (entry = readdir(dir)) != NULL ) {
+                if ( strstr(entry->d_name, ".partial.") != NULL ) {
+                    count++ ;
+                }
+            }
+            if ( dir != NULL ) {
+                closedir(dir) ;
+            }
+            return count ;
+        }
+
+        /* A writer that runs for usec microseconds and exits without reporting, as if it died */
+        void add_silent_writer( std::string file_name , int usec ) {
+            int fds[2] ;
+            ASSERT_EQ( pipe(fds) , 0 ) ;
+            pid_t pid = fork() ;
+            if ( pid == 0 ) {
+                close(fds[0]) ;
+                usleep(usec) ;
+                _Exit(0) ;
+            }
+            close(fds[1]) ;
+            CheckPointWriter writer ;
+            writer.pid = pid ;
+            writer.result_fd = fds[0] ;
+            writer.file_name = file_name ;
+            writer.temp_file = path(file_name) + ".partial.test" ;
+            writer.print_status = false ;
+            writer.start_time = 0.0 ;
+            writer.start_minor_faults = 0 ;
+            FILE * fp = fopen(writer.temp_file.c_str(), "w") ;
+            ASSERT_TRUE( fp != NULL ) ;
+            fclose(fp) ;
+            cpr.writers.push_back(writer) ;
+            cpr.writers_in_flight = (int)cpr.writers.size() ;
+        }
+} ;
+
+TEST_F(CheckPointRestartTest , WaitForWriter) {
+    unlink(path("chkpnt_wait").c_str()) ;
+    cpr.do_checkpoint("chkpnt_wait", false) ;
+    ASSERT_EQ( cpr.writers.size() , 1u ) ;
+    EXPECT_EQ( cpr.writers_in_flight , 1 ) ;
+    EXPECT_EQ( cpr.writers[0].temp_file , path("chkpnt_wait") + ".partial." + std::to_string(cpr.writers[0].pid) ) ;
+    EXPECT_GE( cpr.last_fork_time , 0.0 ) ;
+    EXPECT_GE( cpr.max_fork_time , cpr.last_fork_time ) ;
+
+    cpr.wait_for_checkpoint_writers() ;
+    EXPECT_TRUE( cpr.writers.empty() ) ;
+    EXPECT_EQ( cpr.writers_in_flight , 0 ) ;
+    EXPECT_EQ( cpr.writes_completed , 1 ) ;
+    EXPECT_EQ( cpr.writes_failed , 0 ) ;
+    EXPECT_EQ( cpr.last_write_status , 0 ) ;
+    EXPECT_GE( cpr.last_write_time , 0.0 ) ;
+
+    /* The complete checkpoint was renamed to its name */
+    EXPECT_TRUE( exists(path("chkpnt_wait")) ) ;
+    EXPECT_EQ( num_partial_files() , 0 ) ;
+}
+
+TEST_F(CheckPointRestartTest , ReapWriters) {
+    pid_t pid ;
+    int ii ;
+
+    cpr.set_max_writers(2) ;
+    cpr.do_checkpoint("chkpnt_reap1", false) ;
+    cpr.do_checkpoint("chkpnt_reap2", false) ;
+    ASSERT_EQ( cpr.writers.size() , 2u ) ;
+    pid = cpr.writers[0].pid ;
+
+    /* The end of frame job collects the writers as they finish without blocking */
+    for ( ii = 0 ; ii < 1000 and ! cpr.writers.empty() ; ii++ ) {
+        cpr.reap_checkpoint_writers() ;
+        usleep(10000) ;
+    }
+    EXPECT_TRUE( cpr.writers.empty() ) ;
+    EXPECT_EQ( cpr.writers_in_flight , 0 ) ;
+    EXPECT_EQ( cpr.writes_completed , 2 ) ;
+    EXPECT_TRUE( exists(path("chkpnt_reap1")) ) ;
+    EXPECT_TRUE( exists(path("chkpnt_reap2")) ) ;
+    EXPECT_EQ( num_partial_files() , 0 ) ;
+
+    /* No zombie is left behind */
+    EXPECT_EQ( waitpid(pid, NULL, WNOHANG) , -1 ) ;
+    EXPECT_EQ( errno , ECHILD ) ;
+}
+
+TEST_F(CheckPointRestartTest , RenameFailureRemovesPartialFile) {
+    /* A directory is in the way of the checkpoint */
+    mkdir(path("chkpnt_blocked").c_str(), 0775) ;
+    cpr.do_checkpoint("chkpnt_blocked", false) ;
+    cpr.wait_for_checkpoint_writers() ;
+
+    EXPECT_EQ( cpr.writes_completed , 0 ) ;
+    EXPECT_EQ( cpr.writes_failed , 1 ) ;
+    EXPECT_NE( cpr.last_write_status , 0 ) ;
+    EXPECT_EQ( num_partial_files() , 0 ) ;
+    rmdir(path("chkpnt_blocked").c_str()) ;
+}
+
+TEST_F(CheckPointRestartTest , SkipSafestoreWhileBusy) {
+    unlink(path("chkpnt_safestore").c_str()) ;
+    add_silent_writer("chkpnt_busy", 200000) ;
+
+    /* The only writer is busy, the safestore checkpoint is skipped instead of waiting */
+    cpr.safestore_enabled = true ;
+    cpr.safestore_checkpoint() ;
+    EXPECT_EQ( cpr.writes_skipped , 1 ) ;
+    EXPECT_EQ( cpr.writers.size() , 1u ) ;
+    EXPECT_FALSE( exists(path("chkpnt_safestore")) ) ;
+
+    /* Another checkpoint waits for the busy writer, which died without reporting */
+    cpr.do_checkpoint("chkpnt_after_busy", false) ;
+    EXPECT_EQ( cpr.writes_failed , 1 ) ;
+    EXPECT_FALSE( exists(path("chkpnt_busy") + ".partial.test") ) ;
+    ASSERT_EQ( cpr.writers.size() , 1u ) ;
+    EXPECT_EQ( cpr.writers[0].file_name , "chkpnt_after_busy" ) ;
+
+    cpr.wait_for_checkpoint_writers() ;
+    EXPECT_EQ( cpr.writes_completed , 1 ) ;
+    EXPECT_EQ( cpr.writes_skipped , 1 ) ;
+
+    /* With a free writer the safestore checkpoint is written */
+    cpr.safestore_checkpoint() ;
+    cpr.wait_for_checkpoint_writers() ;
+    EXPECT_EQ( cpr.writes_skipped , 1 ) ;
+    EXPECT_EQ( cpr.writes_completed , 2 ) ;
+    EXPECT_TRUE( exists(path("chkpnt_safestore")) ) ;
+}
+
+}
@@ -55,10 +55,11 @@ int Trick::Clock::sync_to_wall_clock(double align_tic_mult, int tics_per_sec) {
 
     long long curr_time ;
     long long sync_time ;
+    /* Nanosecond clocks overflow an int after about 2 seconds of clock tics */
+    long long align_tics = (long long)(align_tic_mult * tics_per_sec / (rt_clock_ratio * sim_tic_ratio)) ;
 
     curr_time = wall_clock_time() ;
-    sync_time = curr_time - ( curr_time % int(align_tic_mult * tics_per_sec / (rt_clock_ratio * sim_tic_ratio) ) ) +
-     int(align_tic_mult * tics_per_sec / (rt_clock_ratio * sim_tic_ratio) ) ;
+    sync_time = curr_time - ( curr_time % align_tics ) + align_tics ;
     set_reference(sync_time) ;
     return 0 ;
 }
@@ -0,0 +1,57 @@
+/*
+PURPOSE:
+    ( Nanosecond resolution CLOCK_MONOTONIC_RAW clock )
+*/
+
+#ifdef __APPLE__
+#include <sys/time.h>
+#endif
+#include <time.h>
+
+#include "trick/NanosecondClock.hh"
+
+/**
+@details
+-# Calls the base Clock constructor with 1000000000 tics per second
+*/
+Trick::NanosecondClock::NanosecondClock() : Clock(1000000000, "Nanosecond - CLOCK_MONOTONIC_RAW") { }
+
+/**
+@details
+-# This function is empty
+*/
+Trick::NanosecondClock::~NanosecondClock() { }
+
+/**
+@details
+-# Set the global "the_clock" pointer to this instance
+*/
+int Trick::NanosecondClock::clock_init() {
+    set_global_clock() ;
+    return 0 ;
+}
+
+/**
+@details
+-# Call the system clock_gettime with CLOCK_MONOTONIC_RAW to get the current time.
+-# Return the current time as a count of nanoseconds
+*/
+long long Trick::NanosecondClock::wall_clock_time() {
+#ifdef CLOCK_MONOTONIC_RAW
+    struct timespec tp ;
+    clock_gettime( CLOCK_MONOTONIC_RAW, &tp ) ;
+    return (long long)tp.tv_sec * 1000000000LL + (long long)tp.tv_nsec ;
+#else
+    struct timeval tp ;
+    gettimeofday(&tp,(struct timezone *)NULL) ;
+    return (long long)tp.tv_sec * 1000000000LL + (long long)tp.tv_usec * 1000LL ;
+#endif
+}
+
+/**
+@details
+-# This function is empty
+*/
+int Trick::NanosecondClock::clock_stop() {
+    return 0 ;
+}
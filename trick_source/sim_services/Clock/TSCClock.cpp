@@ -0,0 +1,106 @@
+/*
+PURPOSE:
+    ( Calibrated time stamp counter clock )
+*/
+
+#include <time.h>
+#if ( __x86_64__ || __i386__ )
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
+
+#include "trick/TSCClock.hh"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+static long long raw_ns() {
+#ifdef CLOCK_MONOTONIC_RAW
+    struct timespec tp ;
+    clock_gettime( CLOCK_MONOTONIC_RAW, &tp ) ;
+#else
+    struct timespec tp ;
+    clock_gettime( CLOCK_MONOTONIC, &tp ) ;
+#endif
+    return (long long)tp.tv_sec * 1000000000LL + (long long)tp.tv_nsec ;
+}
+
+/**
+@details
+-# Calls the base Clock constructor.  The tics per second are set when the clock is calibrated.
+*/
+Trick::TSCClock::TSCClock() : Clock(1000000000, "TSC - rdtsc") ,
+ calibration_time(0.1) ,
+ calibrated(false) { }
+
+/**
+@details
+-# This function is empty
+*/
+Trick::TSCClock::~TSCClock() { }
+
+/**
+@details
+-# Calibrate the counter if it has not been calibrated.  Return an error if it cannot be.
+-# Set the global "the_clock" pointer to this instance
+*/
+int Trick::TSCClock::clock_init() {
+    if ( ! calibrated and calibrate() != 0 ) {
+        return -1 ;
+    }
+    set_global_clock() ;
+    return 0 ;
+}
+
+/**
+@details
+-# Warn if the processor does not report an invariant TSC.  The counter rate may then change with
+   the processor frequency.
+-# Read CLOCK_MONOTONIC_RAW and the counter, spin for calibration_time, read both again.
+-# Set clock_tics_per_sec to the counter tics per second of raw clock time.
+*/
+int Trick::TSCClock::calibrate() {
+#if ( __x86_64__ || __i386__ )
+    unsigned int eax , ebx , ecx , edx ;
+    long long ns_start , ns_end ;
+    unsigned long long tsc_start , tsc_end ;
+
+    if ( ! __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) or ! (edx & (1 << 8)) ) {
+        message_publish(MSG_WARNING, "TSCClock: processor does not report an invariant TSC\n") ;
+    }
+
+    ns_start = raw_ns() ;
+    tsc_start = __rdtsc() ;
+    do {
+        ns_end = raw_ns() ;
+    } while ( ns_end - ns_start < (long long)(calibration_time * 1.0e9) ) ;
+    tsc_end = __rdtsc() ;
+
+    clock_tics_per_sec = (unsigned long long)((tsc_end - tsc_start) * 1.0e9 / (ns_end - ns_start) + 0.5) ;
+    calibrated = true ;
+    message_publish(MSG_INFO, "TSCClock: calibrated to %llu tics per second\n", clock_tics_per_sec) ;
+    return 0 ;
+#else
+    message_publish(MSG_ERROR, "TSCClock: no time stamp counter on this processor\n") ;
+    return -1 ;
+#endif
+}
+
+/**
+@details
+-# Return the time stamp counter
+*/
+long long Trick::TSCClock::wall_clock_time() {
+#if ( __x86_64__ || __i386__ )
+    return (long long)__rdtsc() ;
+#else
+    return 0 ;
+#endif
+}
+
+/**
+@details
+-# This function is empty
+*/
+int Trick::TSCClock::clock_stop() {
+    return 0 ;
+}
@@ -0,0 +1,111 @@
+
+#include <iostream>
+#include <time.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "trick/NanosecondClock.hh"
+#include "trick/TSCClock.hh"
+
+#define NS_TICS_PER_SEC 1000000000LL
+
+// Stub for message_publish
+extern "C" int message_publish(int level, const char * format_msg, ...) { (void)level; (void)format_msg; return 0; }
+
+class NanosecondClockTest : public ::testing::Test {
+
+    protected:
+        NanosecondClockTest() {}
+        ~NanosecondClockTest() {}
+        virtual void SetUp() {}
+        virtual void TearDown() {}
+} ;
+
+TEST_F(NanosecondClockTest, Initialize) {
+
+    Trick::NanosecondClock nsclk ;
+    struct timespec tp ;
+
+    EXPECT_EQ(nsclk.clock_init(), 0) ;
+    EXPECT_EQ(nsclk.clock_tics_per_sec, (unsigned long long)NS_TICS_PER_SEC) ;
+    EXPECT_STREQ(nsclk.get_name() , "Nanosecond - CLOCK_MONOTONIC_RAW");
+
+#ifdef CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC_RAW, &tp) ;
+    EXPECT_NEAR(nsclk.wall_clock_time(), tp.tv_sec * NS_TICS_PER_SEC + tp.tv_nsec, 1.0e7) ;
+#else
+    (void)tp ;
+#endif
+}
+
+/* With a nanosecond time tic value clock_time counts nanoseconds */
+TEST_F(NanosecondClockTest, NanosecondTics) {
+
+    Trick::NanosecondClock nsclk ;
+    long long start , elapsed ;
+
+    nsclk.calc_sim_time_ratio(NS_TICS_PER_SEC) ;
+    EXPECT_EQ(nsclk.sim_tic_ratio, 1.0) ;
+
+    nsclk.set_reference(nsclk.wall_clock_time()) ;
+    start = nsclk.clock_time() ;
+    usleep(100000) ;
+    elapsed = nsclk.clock_time() - start ;
+
+    EXPECT_GE(elapsed, 100000000LL) ;
+    EXPECT_LT(elapsed, 1000000000LL) ;
+}
+
+/* Microsecond time tics scale the nanosecond clock down by 1000 */
+TEST_F(NanosecondClockTest, MicrosecondTics) {
+
+    Trick::NanosecondClock nsclk ;
+    long long elapsed ;
+
+    nsclk.calc_sim_time_ratio(1000000) ;
+    EXPECT_NEAR(nsclk.sim_tic_ratio, 0.001, 1e-12) ;
+
+    nsclk.set_reference(nsclk.wall_clock_time()) ;
+    usleep(100000) ;
+    elapsed = nsclk.clock_time() ;
+
+    EXPECT_GE(elapsed, 100000LL) ;
+    EXPECT_LT(elapsed, 1000000LL) ;
+}
+
+/* Syncing to the wall clock must not overflow with nanosecond tics */
+TEST_F(NanosecondClockTest, ClockSync) {
+
+    Trick::NanosecondClock nsclk ;
+
+    nsclk.calc_sim_time_ratio(NS_TICS_PER_SEC) ;
+    nsclk.sync_to_wall_clock(5.0, NS_TICS_PER_SEC) ;
+
+    EXPECT_EQ(nsclk.ref_time_tics % (5 * NS_TICS_PER_SEC), 0) ;
+    EXPECT_GT(nsclk.ref_time_tics, nsclk.wall_clock_time()) ;
+}
+
+#if ( __x86_64__ || __i386__ )
+TEST_F(NanosecondClockTest, TSCCalibrate) {
+
+    Trick::TSCClock tscclk ;
+    Trick::NanosecondClock nsclk ;
+    long long ns_start , tsc_start ;
+    double ratio ;
+
+    tscclk.calibration_time = 0.05 ;
+    EXPECT_EQ(tscclk.clock_init(), 0) ;
+    EXPECT_TRUE(tscclk.calibrated) ;
+    EXPECT_GT(tscclk.clock_tics_per_sec, 0ULL) ;
+
+    /* Both clocks count nanoseconds of elapsed time once scaled */
+    tscclk.calc_sim_time_ratio(NS_TICS_PER_SEC) ;
+    nsclk.calc_sim_time_ratio(NS_TICS_PER_SEC) ;
+    ns_start = nsclk.clock_time() ;
+    tsc_start = tscclk.clock_time() ;
+    usleep(100000) ;
+    ratio = (double)(tscclk.clock_time() - tsc_start) / (double)(nsclk.clock_time() - ns_start) ;
+
+    EXPECT_NEAR(ratio, 1.0, 0.01) ;
+}
+#endif
@@ -181,7 +181,7 @@ int Trick::DRAscii::copy_data_ascii_item( Trick::DataRecordBuffer * DI, int item
     unsigned long bf;
     int sbf;
 
-    address = DI->buffer + (item_num * DI->ref->attr->size) ;
+    address = DI->buffer + (item_num * DI->stride) ;
 
     size_t writer_buf_spare = writer_buff + writer_buff_size - buf;
 
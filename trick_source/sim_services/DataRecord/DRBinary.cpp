@@ -63,6 +63,15 @@ int Trick::DRBinary::format_specific_init() {
 
     file_name.append(".trk");
 
+    /* Bitfields are unpacked as they are written, other values are written as they are recorded. */
+    direct_write = record_major ;
+    for ( jj = 0 ; jj < rec_buffer.size() ; jj++ ) {
+        if ( rec_buffer[jj]->ref->attr->type == TRICK_BITFIELD or
+             rec_buffer[jj]->ref->attr->type == TRICK_UNSIGNED_BITFIELD ) {
+            direct_write = false ;
+        }
+    }
+
     /* Calculate a "worst case" for space used for 1 record. */
     writer_buff = (char *)calloc(1 , record_size * rec_buffer.size()) ;
 
@@ -137,7 +146,7 @@ int Trick::DRBinary::format_specific_write_data(unsigned int writer_offset) {
     /* Write out all parameters */
     for (ii = 0; ii < rec_buffer.size() ; ii++) {
 
-        address = rec_buffer[ii]->buffer + ( writer_offset * rec_buffer[ii]->ref->attr->size ) ;
+        address = rec_buffer[ii]->buffer + ( writer_offset * rec_buffer[ii]->stride ) ;
 
         switch (rec_buffer[ii]->ref->attr->type) {
             case TRICK_CHARACTER:
@@ -180,6 +189,20 @@ int Trick::DRBinary::format_specific_write_data(unsigned int writer_offset) {
     return write( fd , writer_buff , len) ;
 }
 
+/**
+@details
+-# If the records are in the record major arena and no variable is a bitfield, the arena holds the
+   records exactly as they are written to the file.  Write the block of records with one write.
+-# Else write the records one at a time
+-# return the number of bytes written
+*/
+int Trick::DRBinary::format_specific_write_records(unsigned int writer_offset, unsigned int num_records) {
+    if ( direct_write ) {
+        return write( fd , record_arena + (size_t)writer_offset * record_bytes , (size_t)num_records * record_bytes) ;
+    }
+    return Trick::DataRecordGroup::format_specific_write_records(writer_offset, num_records) ;
+}
+
 /**
 @details
 -# Close the output file stream
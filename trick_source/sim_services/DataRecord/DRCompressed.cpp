@@ -0,0 +1,324 @@
+/*
+PURPOSE:
+    (Data record to disk in chunked, compressed columns.)
+*/
+
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "trick/DRCompressed.hh"
+#include "trick/DRCompressedCodec.hh"
+#include "trick/command_line_protos.h"
+#include "trick/memorymanager_c_intf.h"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+#include "trick/bitfield_proto.h"
+
+Trick::DRCompressed::DRCompressed( std::string in_name , bool register_group ) :
+ Trick::DataRecordGroup(in_name) ,
+ chunk_records(4096) ,
+ codec(DR_Codec_LZ) ,
+ num_chunks(0) ,
+ num_raw_bytes(0) ,
+ fd(-1) ,
+ file_offset(0) ,
+ row_size(0) ,
+ num_staged(0) ,
+ direct_copy(false) {
+    if ( register_group ) {
+        register_group_with_mm(this, "Trick::DRCompressed") ;
+    }
+}
+
+int Trick::DRCompressed::set_chunk_records( unsigned int in_chunk_records ) {
+    if ( in_chunk_records == 0 or inited ) {
+        return -1 ;
+    }
+    chunk_records = in_chunk_records ;
+    return 0 ;
+}
+
+int Trick::DRCompressed::set_codec( int in_codec ) {
+    switch ( in_codec ) {
+        case DR_Codec_None:
+        case DR_Codec_LZ:
+            codec = in_codec ;
+            return 0 ;
+        default:
+            message_publish(MSG_ERROR, "Data Record group %s: %d is not a codec\n", group_name.c_str(), in_codec) ;
+            return -1 ;
+    }
+}
+
+int Trick::DRCompressed::format_specific_header( std::fstream & out_stream ) {
+    out_stream << " is compressed in chunks of " << chunk_records << " records" << std::endl ;
+    return(0) ;
+}
+
+/**
+@details
+-# Set the file extension to ".trkz"
+-# Lay out one record of the chunk buffer as DRBinary lays out a record, and allocate
+   #chunk_records of them.  If the records are in the record major arena and no variable
+   is a bitfield, records are copied from the arena as they are.
+-# Open the log file
+   -# Return an error if the open failed
+-# Write out the magic Trick-Z-01 keyword and the number of variables recorded
+-# For each variable to be recorded write out the name, units, type and size
+*/
+int Trick::DRCompressed::format_specific_init() {
+
+    unsigned int jj ;
+    std::vector<unsigned char> header ;
+    ssize_t bytes ;
+
+    file_name.append(".trkz");
+
+    direct_copy = record_major ;
+    row_size = 0 ;
+    col_offset.clear() ;
+    for ( jj = 0 ; jj < rec_buffer.size() ; jj++ ) {
+        col_offset.push_back(row_size) ;
+        row_size += rec_buffer[jj]->ref->attr->size ;
+        if ( rec_buffer[jj]->ref->attr->type == TRICK_BITFIELD or
+             rec_buffer[jj]->ref->attr->type == TRICK_UNSIGNED_BITFIELD ) {
+            direct_copy = false ;
+        }
+    }
+
+    writer_buff_size = (size_t)row_size * chunk_records ;
+    writer_buff = (char *)calloc(1 , writer_buff_size) ;
+    num_staged = 0 ;
+    chunk_index.clear() ;
+
+    if ((fd = creat(file_name.c_str(), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH)) == -1) {
+        record = false ;
+        return (-1) ;
+    }
+
+    header.insert(header.end(), Trick::DRCompressedCodec::magic(),
+     Trick::DRCompressedCodec::magic() + Trick::DRCompressedCodec::magic_len) ;
+    Trick::DRCompressedCodec::put_u32(header, rec_buffer.size()) ;
+
+    for (jj = 0; jj < rec_buffer.size(); jj++) {
+        const char * units ;
+
+        /* name */
+        Trick::DRCompressedCodec::put_u32(header, strlen(rec_buffer[jj]->ref->reference)) ;
+        header.insert(header.end(), rec_buffer[jj]->ref->reference,
+         rec_buffer[jj]->ref->reference + strlen(rec_buffer[jj]->ref->reference)) ;
+
+        /* units */
+        if ( rec_buffer[jj]->ref->attr->mods & TRICK_MODS_UNITSDASHDASH ) {
+            units = "--" ;
+        } else {
+            units = rec_buffer[jj]->ref->attr->units ;
+        }
+        Trick::DRCompressedCodec::put_u32(header, strlen(units)) ;
+        header.insert(header.end(), units, units + strlen(units)) ;
+
+        Trick::DRCompressedCodec::put_u32(header, rec_buffer[jj]->ref->attr->type) ;
+        Trick::DRCompressedCodec::put_u32(header, rec_buffer[jj]->ref->attr->size) ;
+    }
+
+    bytes = write( fd , &header[0] , header.size() ) ;
+    if ( bytes > 0 ) {
+        file_offset = bytes ;
+        total_bytes_written += bytes ;
+    }
+    return(0) ;
+}
+
+/**
+@details
+-# Copy each parameter value of the record to the next record of the chunk buffer, unpacking bitfields
+-# If the chunk buffer is full, write the chunk
+-# return the number of bytes written
+*/
+int Trick::DRCompressed::format_specific_write_data(unsigned int writer_offset) {
+
+    unsigned long bf;
+    int sbf;
+    unsigned int ii ;
+    char * row = writer_buff + (size_t)num_staged * row_size ;
+    char * address ;
+
+    for (ii = 0; ii < rec_buffer.size() ; ii++) {
+
+        address = rec_buffer[ii]->buffer + ( writer_offset * rec_buffer[ii]->stride ) ;
+
+        switch (rec_buffer[ii]->ref->attr->type) {
+            case TRICK_BITFIELD:
+                sbf = GET_BITFIELD(address, rec_buffer[ii]->ref->attr->size,
+                 rec_buffer[ii]->ref->attr->index[0].start, rec_buffer[ii]->ref->attr->index[0].size);
+                memcpy(row + col_offset[ii], &sbf, (size_t)rec_buffer[ii]->ref->attr->size);
+                break;
+
+            case TRICK_UNSIGNED_BITFIELD:
+                bf = GET_UNSIGNED_BITFIELD(address, rec_buffer[ii]->ref->attr->size,
+                 rec_buffer[ii]->ref->attr->index[0].start, rec_buffer[ii]->ref->attr->index[0].size);
+                memcpy(row + col_offset[ii], &bf, (size_t)rec_buffer[ii]->ref->attr->size);
+                break;
+
+            default:
+                memcpy(row + col_offset[ii], address, (size_t)rec_buffer[ii]->ref->attr->size);
+                break;
+        }
+    }
+
+    if ( ++num_staged == chunk_records ) {
+        return write_chunk() ;
+    }
+    return 0 ;
+}
+
+/**
+@details
+-# If the records are in the record major arena and no variable is a bitfield, copy the records
+   to the chunk buffer in blocks, writing each chunk as it fills
+-# Else copy the records one at a time
+-# return the number of bytes written
+*/
+int Trick::DRCompressed::format_specific_write_records(unsigned int writer_offset, unsigned int num_records) {
+
+    unsigned int num_copy ;
+    int bytes = 0 ;
+
+    if ( ! direct_copy ) {
+        return Trick::DataRecordGroup::format_specific_write_records(writer_offset, num_records) ;
+    }
+
+    while ( num_records > 0 ) {
+        num_copy = chunk_records - num_staged ;
+        if ( num_copy > num_records ) {
+            num_copy = num_records ;
+        }
+        memcpy(writer_buff + (size_t)num_staged * row_size, record_arena + (size_t)writer_offset * record_bytes,
+         (size_t)num_copy * row_size) ;
+        num_staged += num_copy ;
+        writer_offset += num_copy ;
+        num_records -= num_copy ;
+        if ( num_staged == chunk_records ) {
+            bytes += write_chunk() ;
+        }
+    }
+    return bytes ;
+}
+
+/**
+@details
+-# Encode each column of the chunk buffer, prefixed with its encoded size
+-# If the codec is DR_Codec_LZ, compress the encoded columns.  Keep the compressed columns if they are smaller.
+-# Write the chunk header and columns with one write and add the chunk to the index
+-# return the number of bytes written
+*/
+int Trick::DRCompressed::write_chunk() {
+
+    unsigned int ii ;
+    size_t column_start ;
+    uint32_t stored_size ;
+    std::vector<unsigned char> column ;
+    unsigned char chunk_codec = DR_Codec_None ;
+    Trick::DRCompressedChunk entry ;
+    ssize_t bytes ;
+
+    if ( num_staged == 0 ) {
+        return 0 ;
+    }
+
+    chunk_columns.clear() ;
+    for ( ii = 0 ; ii < rec_buffer.size() ; ii++ ) {
+        column.clear() ;
+        Trick::DRCompressedCodec::encode_column(
+         Trick::DRCompressedCodec::column_kind(rec_buffer[ii]->ref->attr->type, rec_buffer[ii]->ref->attr->size),
+         rec_buffer[ii]->ref->attr->size, (unsigned char *)writer_buff + col_offset[ii], row_size, num_staged, column) ;
+        Trick::DRCompressedCodec::put_varint(chunk_columns, column.size()) ;
+        chunk_columns.insert(chunk_columns.end(), column.begin(), column.end()) ;
+    }
+
+    /* The time is always the first variable of the record. */
+    memcpy(&entry.start_time, writer_buff, sizeof(double)) ;
+    memcpy(&entry.end_time, writer_buff + (size_t)(num_staged - 1) * row_size, sizeof(double)) ;
+    entry.num_records = num_staged ;
+    entry.offset = file_offset ;
+
+    chunk_out.clear() ;
+    Trick::DRCompressedCodec::put_u32(chunk_out, Trick::DRCompressedCodec::chunk_magic) ;
+    Trick::DRCompressedCodec::put_u32(chunk_out, num_staged) ;
+    Trick::DRCompressedCodec::put_double(chunk_out, entry.start_time) ;
+    Trick::DRCompressedCodec::put_double(chunk_out, entry.end_time) ;
+    chunk_out.push_back(0) ;
+    Trick::DRCompressedCodec::put_u32(chunk_out, chunk_columns.size()) ;
+    Trick::DRCompressedCodec::put_u32(chunk_out, 0) ;
+
+    column_start = chunk_out.size() ;
+    if ( codec == DR_Codec_LZ ) {
+        Trick::DRCompressedCodec::lz_compress(&chunk_columns[0], chunk_columns.size(), chunk_out) ;
+        if ( chunk_out.size() - column_start < chunk_columns.size() ) {
+            chunk_codec = DR_Codec_LZ ;
+        } else {
+            chunk_out.resize(column_start) ;
+        }
+    }
+    if ( chunk_codec == DR_Codec_None ) {
+        chunk_out.insert(chunk_out.end(), chunk_columns.begin(), chunk_columns.end()) ;
+    }
+
+    /* Fill in the codec and stored size now that they are known. */
+    chunk_out[24] = chunk_codec ;
+    stored_size = chunk_out.size() - column_start ;
+    for ( ii = 0 ; ii < 4 ; ii++ ) {
+        chunk_out[column_start - 4 + ii] = (unsigned char)(stored_size >> (8 * ii)) ;
+    }
+
+    num_raw_bytes += (unsigned long long)num_staged * row_size ;
+    num_staged = 0 ;
+
+    bytes = write( fd , &chunk_out[0] , chunk_out.size() ) ;
+    if ( bytes != (ssize_t)chunk_out.size() ) {
+        message_publish(MSG_ERROR, "Data Record group %s: error writing chunk to %s\n", group_name.c_str(), file_name.c_str()) ;
+        return ( bytes > 0 ) ? bytes : 0 ;
+    }
+    file_offset += bytes ;
+    chunk_index.push_back(entry) ;
+    num_chunks++ ;
+
+    return bytes ;
+}
+
+/**
+@details
+-# Write the records left in the chunk buffer
+-# Write the chunk index and the trailer
+-# Close the output file
+*/
+int Trick::DRCompressed::format_specific_shutdown() {
+
+    unsigned int ii ;
+    std::vector<unsigned char> index ;
+
+    if ( inited and fd >= 0 ) {
+        total_bytes_written += write_chunk() ;
+
+        for ( ii = 0 ; ii < chunk_index.size() ; ii++ ) {
+            Trick::DRCompressedCodec::put_u64(index, chunk_index[ii].offset) ;
+            Trick::DRCompressedCodec::put_u32(index, chunk_index[ii].num_records) ;
+            Trick::DRCompressedCodec::put_double(index, chunk_index[ii].start_time) ;
+            Trick::DRCompressedCodec::put_double(index, chunk_index[ii].end_time) ;
+        }
+        Trick::DRCompressedCodec::put_u64(index, file_offset) ;
+        Trick::DRCompressedCodec::put_u32(index, chunk_index.size()) ;
+        Trick::DRCompressedCodec::put_u32(index, Trick::DRCompressedCodec::index_magic) ;
+        if ( write( fd , &index[0] , index.size() ) != (ssize_t)index.size() ) {
+            message_publish(MSG_ERROR, "Data Record group %s: error writing chunk index to %s\n", group_name.c_str(), file_name.c_str()) ;
+        }
+
+        close(fd) ;
+        fd = -1 ;
+    }
+    return(0) ;
+}
@@ -18,6 +18,10 @@ Trick::DRHDF5::DRHDF5( std::string in_name ) : Trick::DataRecordGroup(in_name) {
     register_group_with_mm(this, "Trick::DRHDF5") ;
 }
 
+bool Trick::DRHDF5::supports_record_major() {
+    return false ;
+}
+
 int Trick::DRHDF5::format_specific_header( std::fstream & out_stream ) {
     out_stream << " byte_order is HDF5" << std::endl ;
     return(0) ;
@@ -219,8 +223,9 @@ int Trick::DRHDF5::format_specific_init() {
 int Trick::DRHDF5::write_data(bool must_write) {
 
 #ifdef HDF5
-    unsigned int local_buffer_num ;
     unsigned int num_to_write ;
+    unsigned int writer_record ;
+    unsigned int writer_offset ;
     unsigned int ii;
     char *buf = 0;
 
@@ -229,21 +234,15 @@ int Trick::DRHDF5::write_data(bool must_write) {
         // buffer_mutex is used in this one place to prevent forced calls of write_data
         // to not overwrite data being written by the asynchronous thread.
         pthread_mutex_lock(&buffer_mutex) ;
-        local_buffer_num = buffer_num ;
-        if ( (local_buffer_num - writer_num) > max_num ) {
-            num_to_write = max_num ;
-        } else {
-            num_to_write = (local_buffer_num - writer_num) ;
-        }
-        writer_num = local_buffer_num - num_to_write ;
+        num_to_write = claim_records(max_num, writer_record) ;
 
-        if ( writer_num != local_buffer_num ) {
-            // Test if the writer pointer to the right of the buffer pointer in the ring
-            if ( (writer_num % max_num) > (local_buffer_num % max_num) ) {
+        if ( num_to_write > 0 ) {
+            writer_offset = writer_record % max_num ;
+            // Test if the records wrap around the end of the ring
+            if ( writer_offset + num_to_write > max_num ) {
                // we have 2 segments to write per variable
                for (ii = 0; ii < parameters.size(); ii++) {
                    HDF5_INFO * hi = parameters[ii] ;
-                   unsigned int writer_offset = writer_num % max_num ;
                    buf = hi->drb->buffer + (writer_offset * hi->drb->ref->attr->size) ;
 
                    /* Append all of the data on the end of the buffer to the packet table. */
@@ -251,21 +250,20 @@ int Trick::DRHDF5::write_data(bool must_write) {
 
                    buf = hi->drb->buffer ;
                    /* Append all of the data at the beginning of the buffer to the packet table. */
-                   H5PTappend( hi->dataset, local_buffer_num % max_num , buf );
+                   H5PTappend( hi->dataset, num_to_write - (max_num - writer_offset) , buf );
                }
             }  else {
                // we have 1 continous segment to write per variable
                for (ii = 0; ii < parameters.size(); ii++) {
                    HDF5_INFO * hi = parameters[ii] ;
-                   unsigned int writer_offset = writer_num % max_num ;
                    buf = hi->drb->buffer + (writer_offset * hi->drb->ref->attr->size) ;
 
                    /* Append all of the data to the packet table. */
-                   H5PTappend( hi->dataset, local_buffer_num - writer_num , buf );
+                   H5PTappend( hi->dataset, num_to_write , buf );
 
                }
             }
-            writer_num = local_buffer_num ;
+            release_records() ;
         }
         pthread_mutex_unlock(&buffer_mutex) ;
 
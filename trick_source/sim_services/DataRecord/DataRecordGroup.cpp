@@ -38,12 +38,14 @@ recorded data to disk. The job's name is <tt> data_record_group<n>.<in_name></tt
 */
 Trick::DataRecordBuffer::DataRecordBuffer() {
     buffer = last_value = NULL ;
+    stride = 0 ;
+    shared_buffer = false ;
     ref = NULL ;
     ref_searched = false ;
 }
 
 Trick::DataRecordBuffer::~DataRecordBuffer() {
-    if ( buffer ) {
+    if ( buffer and ! shared_buffer ) {
         free(buffer) ;
     }
     if ( last_value ) {
@@ -71,6 +73,13 @@ Trick::DataRecordGroup::DataRecordGroup( std::string in_name ) :
  max_num(100000),
  buffer_num(0),
  writer_num(0),
+ record_major(false),
+ record_bytes(0),
+ record_arena(NULL),
+ overflow_policy(DR_Overflow_Block),
+ num_blocked(0),
+ num_dropped_oldest(0),
+ num_dropped_newest(0),
  max_file_size(1<<30), // 1 GB
  total_bytes_written(0),
  max_size_warning(false),
@@ -78,6 +87,7 @@ Trick::DataRecordGroup::DataRecordGroup( std::string in_name ) :
  single_prec_only(false),
  buffer_type(DR_Buffer),
  job_class("data_record"),
+ writer_claim(0),
  curr_time(0.0)
 {
 
@@ -193,6 +203,27 @@ int Trick::DataRecordGroup::set_buffer_type( int in_buffer_type ) {
     return(0) ;
 }
 
+int Trick::DataRecordGroup::set_overflow_policy( int in_policy ) {
+    if ( in_policy < DR_Overflow_Block or in_policy > DR_Overflow_Drop_Newest ) {
+        return -1 ;
+    }
+    overflow_policy = (DR_Overflow_Policy)in_policy ;
+    return(0) ;
+}
+
+int Trick::DataRecordGroup::set_record_major( bool in_record_major ) {
+    if ( in_record_major and ! supports_record_major() ) {
+        message_publish(MSG_WARNING, "Data record group %s does not support record major buffers.\n", group_name.c_str()) ;
+        return -1 ;
+    }
+    record_major = in_record_major ;
+    return(0) ;
+}
+
+bool Trick::DataRecordGroup::supports_record_major() {
+    return true ;
+}
+
 int Trick::DataRecordGroup::set_max_file_size( uint64_t bytes ) {
     if(bytes == 0) {
         max_file_size = UINT64_MAX ;
@@ -356,6 +387,8 @@ bool Trick::DataRecordGroup::isSupportedType(REF2 * ref2, std::string& message)
 
 /**
 @details
+-# record_major is turned off if the recording format does not support it.  The flag may have been set
+   directly or restored from a checkpoint.
 -# The simulation output directory is retrieved from the CommandLineArguments
 -# The log header file is created
    -# The endianness of the log file is written to the log header.
@@ -368,8 +401,16 @@ int Trick::DataRecordGroup::init() {
     unsigned int jj ;
     int ret ;
 
+    if ( record_major and ! supports_record_major() ) {
+        message_publish(MSG_ERROR, "Data record group %s does not support record major buffers, recording variable major.\n",
+         group_name.c_str()) ;
+        record_major = false ;
+    }
+
     // reset counter here so we can "re-init" our recording
     buffer_num = writer_num = total_bytes_written = 0 ;
+    num_blocked = num_dropped_oldest = num_dropped_newest = 0 ;
+    writer_claim = 0 ;
 
     output_dir = command_line_args_get_output_dir() ;
     /* this is the common part of the record file name, the format specific will add the correct suffix */
@@ -377,8 +418,16 @@ int Trick::DataRecordGroup::init() {
 
     pthread_mutex_init(&buffer_mutex, NULL);
 
+    if ( record_arena ) {
+        free(record_arena) ;
+        record_arena = NULL ;
+    }
+
     // Allocate recording space for time.
-    rec_buffer[0]->buffer = (char *)calloc(max_num , rec_buffer[0]->ref->attr->size) ;
+    if ( ! record_major ) {
+        rec_buffer[0]->buffer = (char *)calloc(max_num , rec_buffer[0]->ref->attr->size) ;
+        rec_buffer[0]->stride = rec_buffer[0]->ref->attr->size ;
+    }
     rec_buffer[0]->last_value = (char *)calloc(1 , rec_buffer[0]->ref->attr->size) ;
 
     /* Loop through all variables looking up names.  Allocate recording space
@@ -410,10 +459,18 @@ int Trick::DataRecordGroup::init() {
             drb->ref->reference = strdup(drb->alias.c_str()) ;
         }
         drb->last_value = (char *)calloc(1 , drb->ref->attr->size) ;
-        drb->buffer = (char *)calloc(max_num , drb->ref->attr->size) ;
+        if ( ! record_major ) {
+            drb->buffer = (char *)calloc(max_num , drb->ref->attr->size) ;
+            drb->stride = drb->ref->attr->size ;
+        }
         drb->ref_searched = true ;
     }
 
+    // Record major groups share one arena.  The variables are sorted before the header is written.
+    if ( record_major ) {
+        init_record_arena() ;
+    }
+
     write_header() ;
 
     // call format specific initialization to open destination and write header
@@ -428,6 +485,70 @@ int Trick::DataRecordGroup::init() {
 
 }
 
+/* Variables with fixed addresses go first, in address order.  Variables found through pointers keep their order. */
+static bool record_address_order( Trick::DataRecordBuffer * a , Trick::DataRecordBuffer * b ) {
+    if ( a->ref->pointer_present != b->ref->pointer_present ) {
+        return ( b->ref->pointer_present == 1 ) ;
+    }
+    if ( a->ref->pointer_present == 1 ) {
+        return false ;
+    }
+    return ( (char *)a->ref->address < (char *)b->ref->address ) ;
+}
+
+/**
+@details
+-# Sort the variables after time by address.  Time stays the first variable in the record.
+-# Lay out one record as the variables in sorted order with no padding.  This is the record DRBinary writes.
+-# Allocate the arena of max_num records and point each variable's buffer at its field in the first record.
+-# Build the copy plan.  A variable that starts where the previous one ends in memory is added to
+   the previous copy.  Variables found through pointers are looked up and copied every record.
+*/
+void Trick::DataRecordGroup::init_record_arena() {
+
+    unsigned int jj ;
+    unsigned int offset ;
+    Trick::DataRecordCopy copy ;
+
+    std::stable_sort(rec_buffer.begin() + 1, rec_buffer.end(), record_address_order) ;
+
+    record_bytes = 0 ;
+    for (jj = 0; jj < rec_buffer.size() ; jj++) {
+        record_bytes += rec_buffer[jj]->ref->attr->size ;
+    }
+    record_arena = (char *)calloc(max_num , record_bytes) ;
+
+    record_copies.clear() ;
+    offset = 0 ;
+    for (jj = 0; jj < rec_buffer.size() ; jj++) {
+        Trick::DataRecordBuffer * drb = rec_buffer[jj] ;
+        REF2 * ref = drb->ref ;
+        unsigned int size = ref->attr->size ;
+
+        drb->buffer = record_arena + offset ;
+        drb->stride = record_bytes ;
+        drb->shared_buffer = true ;
+
+        if ( ref->pointer_present == 1 ) {
+            copy.address = NULL ;
+            copy.drb = drb ;
+            copy.offset = offset ;
+            copy.size = size ;
+            record_copies.push_back(copy) ;
+        } else if ( ! record_copies.empty() and record_copies.back().address != NULL and
+                    record_copies.back().address + record_copies.back().size == (char *)ref->address ) {
+            record_copies.back().size += size ;
+        } else {
+            copy.address = (char *)ref->address ;
+            copy.drb = NULL ;
+            copy.offset = offset ;
+            copy.size = size ;
+            record_copies.push_back(copy) ;
+        }
+        offset += size ;
+    }
+}
+
 int Trick::DataRecordGroup::checkpoint() {
     unsigned int jj ;
 
@@ -598,6 +719,7 @@ int Trick::DataRecordGroup::data_record(double in_time) {
 
     unsigned int jj ;
     unsigned int buffer_offset ;
+    unsigned int local_buffer_num ;
     Trick::DataRecordBuffer * drb ;
     bool change_detected = false ;
 
@@ -620,22 +742,74 @@ int Trick::DataRecordGroup::data_record(double in_time) {
 
         if ( freq == DR_Always || change_detected == true ) {
 
-            // If this is not the ring buffer and
-            // we are going to have trouble fitting 2 data sets then write the data now.
-            if ( buffer_type != DR_Ring_Buffer ) {
-                if ( buffer_num - writer_num >= (max_num - 2) ) {
-                    write_data(true) ;
-                }
+            // Make room for the records, DR_Changes_Step records 2 data sets.
+            if ( ! reserve_records(( freq == DR_Changes_Step ) ? 2 : 1) ) {
+                return(0) ;
             }
 
             curr_time = in_time ;
+            local_buffer_num = buffer_num ;
 
             if ( freq == DR_Changes_Step ) {
-                buffer_offset = buffer_num % max_num ;
+                buffer_offset = local_buffer_num % max_num ;
                 *((double *)(rec_buffer[0]->last_value)) = in_time ;
+                if ( record_major ) {
+                    for (jj = 0; jj < rec_buffer.size() ; jj++) {
+                        drb = rec_buffer[jj] ;
+                        memcpy( drb->buffer + buffer_offset * record_bytes , drb->last_value , drb->ref->attr->size ) ;
+                    }
+                } else {
+                    for (jj = 0; jj < rec_buffer.size() ; jj++) {
+                        drb = rec_buffer[jj] ;
+                        REF2 * ref = drb->ref ;
+                        int param_size = ref->attr->size ;
+                        if ( buffer_offset == 0 ) {
+                           drb->curr_buffer = drb->buffer ;
+                        } else {
+                           drb->curr_buffer += param_size ;
+                        }
+                        switch ( param_size ) {
+                            case 8:
+                                *(int64_t *)drb->curr_buffer = *(int64_t *)drb->last_value ;
+                                break ;
+                            case 4:
+                                *(int32_t *)drb->curr_buffer = *(int32_t *)drb->last_value ;
+                                break ;
+                            case 2:
+                                *(int16_t *)drb->curr_buffer = *(int16_t *)drb->last_value ;
+                                break ;
+                            case 1:
+                                *(int8_t *)drb->curr_buffer = *(int8_t *)drb->last_value ;
+                                break ;
+                            default:
+                                memcpy( drb->curr_buffer , drb->last_value , param_size ) ;
+                                break ;
+                        }
+                    }
+                }
+                local_buffer_num++ ;
+            }
+
+            buffer_offset = local_buffer_num % max_num ;
+            if ( record_major ) {
+                // Record major groups fill the whole record with a few large copies.
+                char * record_address = record_arena + buffer_offset * record_bytes ;
+                for (jj = 0; jj < record_copies.size() ; jj++) {
+                    Trick::DataRecordCopy & copy = record_copies[jj] ;
+                    if ( copy.address == NULL ) {
+                        copy.drb->ref->address = follow_address_path(copy.drb->ref) ;
+                        memcpy( record_address + copy.offset , copy.drb->ref->address , copy.size ) ;
+                    } else {
+                        memcpy( record_address + copy.offset , copy.address , copy.size ) ;
+                    }
+                }
+            } else {
                 for (jj = 0; jj < rec_buffer.size() ; jj++) {
                     drb = rec_buffer[jj] ;
                     REF2 * ref = drb->ref ;
+                    if ( ref->pointer_present == 1 ) {
+                        ref->address = follow_address_path(ref) ;
+                    }
                     int param_size = ref->attr->size ;
                     if ( buffer_offset == 0 ) {
                        drb->curr_buffer = drb->buffer ;
@@ -644,91 +818,167 @@ int Trick::DataRecordGroup::data_record(double in_time) {
                     }
                     switch ( param_size ) {
                         case 8:
-                            *(int64_t *)drb->curr_buffer = *(int64_t *)drb->last_value ;
+                            *(int64_t *)drb->curr_buffer = *(int64_t *)ref->address ;
                             break ;
                         case 4:
-                            *(int32_t *)drb->curr_buffer = *(int32_t *)drb->last_value ;
+                            *(int32_t *)drb->curr_buffer = *(int32_t *)ref->address ;
                             break ;
                         case 2:
-                            *(int16_t *)drb->curr_buffer = *(int16_t *)drb->last_value ;
+                            *(int16_t *)drb->curr_buffer = *(int16_t *)ref->address ;
                             break ;
                         case 1:
-                            *(int8_t *)drb->curr_buffer = *(int8_t *)drb->last_value ;
+                            *(int8_t *)drb->curr_buffer = *(int8_t *)ref->address ;
                             break ;
                         default:
-                            memcpy( drb->curr_buffer , drb->last_value , param_size ) ;
+                            memcpy( drb->curr_buffer , ref->address , param_size ) ;
                             break ;
                     }
                 }
-                buffer_num++ ;
             }
+            local_buffer_num++ ;
+            // Publish the new records to the writer after they are copied.
+            __atomic_store_n(&buffer_num, local_buffer_num, __ATOMIC_RELEASE) ;
+        }
+    }
 
-            buffer_offset = buffer_num % max_num ;
-            for (jj = 0; jj < rec_buffer.size() ; jj++) {
-                drb = rec_buffer[jj] ;
-                REF2 * ref = drb->ref ;
-                if ( ref->pointer_present == 1 ) {
-                    ref->address = follow_address_path(ref) ;
-                }
-                int param_size = ref->attr->size ;
-                if ( buffer_offset == 0 ) {
-                   drb->curr_buffer = drb->buffer ;
-                } else {
-                   drb->curr_buffer += param_size ;
-                }
-                switch ( param_size ) {
-                    case 8:
-                        *(int64_t *)drb->curr_buffer = *(int64_t *)ref->address ;
-                        break ;
-                    case 4:
-                        *(int32_t *)drb->curr_buffer = *(int32_t *)ref->address ;
-                        break ;
-                    case 2:
-                        *(int16_t *)drb->curr_buffer = *(int16_t *)ref->address ;
-                        break ;
-                    case 1:
-                        *(int8_t *)drb->curr_buffer = *(int8_t *)ref->address ;
-                        break ;
-                    default:
-                        memcpy( drb->curr_buffer , ref->address , param_size ) ;
-                        break ;
+    return(0) ;
+
+}
+
+/**
+@details
+-# Ring buffers overwrite the oldest records and never run out of room.
+-# If the buffer cannot fit 2 more data sets it is full.
+   -# If the group does not use the writer thread, or the overflow policy is DR_Overflow_Block,
+      write the buffer to disk now.  This waits for the writer thread to finish its current write.
+   -# If the overflow policy is DR_Overflow_Drop_Newest, drop the new records.
+   -# If the overflow policy is DR_Overflow_Drop_Oldest, move writer_num past the oldest records.
+      The writer may claim records at the same time, so move it with compare and swap.
+-# If the writer is still writing a record whose slot the new records reuse, drop the new records.
+*/
+bool Trick::DataRecordGroup::reserve_records( unsigned int num_records ) {
+
+    unsigned int local_writer_num ;
+    unsigned int new_writer_num ;
+    unsigned int reuse_first ;
+    unsigned long long claim ;
+    unsigned int claim_first ;
+    unsigned int claim_num ;
+
+    if ( buffer_type == DR_Ring_Buffer ) {
+        return true ;
+    }
+
+    local_writer_num = __atomic_load_n(&writer_num, __ATOMIC_SEQ_CST) ;
+    if ( buffer_num - local_writer_num >= (max_num - 2) ) {
+        if ( buffer_type != DR_Buffer or overflow_policy == DR_Overflow_Block ) {
+            if ( buffer_type == DR_Buffer ) {
+                num_blocked++ ;
+            }
+            write_data(true) ;
+        } else if ( overflow_policy == DR_Overflow_Drop_Newest ) {
+            num_dropped_newest++ ;
+            return false ;
+        } else {
+            new_writer_num = buffer_num - (max_num - 3) ;
+            while ( buffer_num - local_writer_num >= (max_num - 2) ) {
+                if ( __atomic_compare_exchange_n(&writer_num, &local_writer_num, new_writer_num, false,
+                      __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ) {
+                    num_dropped_oldest += new_writer_num - local_writer_num ;
+                    break ;
                 }
             }
-            buffer_num++ ;
         }
     }
 
-    return(0) ;
+    // The new records overwrite records buffer_num - max_num and on.
+    reuse_first = buffer_num - max_num ;
+    claim = __atomic_load_n(&writer_claim, __ATOMIC_SEQ_CST) ;
+    claim_first = (unsigned int)(claim >> 32) ;
+    claim_num = (unsigned int)claim ;
+    if ( claim_num > 0 and
+         ( reuse_first - claim_first < claim_num or claim_first - reuse_first < num_records ) ) {
+        num_dropped_newest++ ;
+        return false ;
+    }
+    return true ;
+}
+
+/**
+@details
+-# Read writer_num, then the published buffer_num.  Records between them are waiting to be written.
+   A ring buffer that wrapped only holds the last max_num records.
+-# Mark the records busy before moving writer_num past them, so reserve_records either sees them
+   busy or fails to move writer_num over them.
+-# If contiguous is set, stop at the end of the ring.
+-# If writer_num changed, the recording job dropped records.  Start over.
+*/
+unsigned int Trick::DataRecordGroup::claim_records( unsigned int max_records , unsigned int & first , bool contiguous ) {
+
+    unsigned int local_writer_num ;
+    unsigned int local_buffer_num ;
+    unsigned int num ;
+
+    local_writer_num = __atomic_load_n(&writer_num, __ATOMIC_SEQ_CST) ;
+    do {
+        local_buffer_num = __atomic_load_n(&buffer_num, __ATOMIC_ACQUIRE) ;
+        first = local_writer_num ;
+        if ( (local_buffer_num - first) > max_num ) {
+            first = local_buffer_num - max_num ;
+        }
+        num = local_buffer_num - first ;
+        if ( num > max_records ) {
+            num = max_records ;
+        }
+        if ( contiguous and (first % max_num) + num > max_num ) {
+            num = max_num - (first % max_num) ;
+        }
+        if ( num == 0 ) {
+            return 0 ;
+        }
+        __atomic_store_n(&writer_claim, ((unsigned long long)first << 32) | num, __ATOMIC_SEQ_CST) ;
+    } while ( ! __atomic_compare_exchange_n(&writer_num, &local_writer_num, first + num, false,
+                 __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ) ;
+
+    return num ;
+}
 
+void Trick::DataRecordGroup::release_records() {
+    __atomic_store_n(&writer_claim, 0ULL, __ATOMIC_RELEASE) ;
+}
+
+int Trick::DataRecordGroup::format_specific_write_records(unsigned int writer_offset, unsigned int num_records) {
+    unsigned int ii ;
+    int bytes = 0 ;
+    for ( ii = 0 ; ii < num_records ; ii++ ) {
+        bytes += format_specific_write_data((writer_offset + ii) % max_num) ;
+    }
+    return bytes ;
 }
 
 int Trick::DataRecordGroup::write_data(bool must_write) {
 
-    unsigned int local_buffer_num ;
     unsigned int num_to_write ;
-    unsigned int writer_offset ;
+    unsigned int num_claimed ;
+    unsigned int writer_record ;
 
     if ( record and inited and (buffer_type == DR_No_Buffer or must_write) and (total_bytes_written <= max_file_size)) {
 
-        // buffer_mutex is used in this one place to prevent forced calls of write_data
-        // to not overwrite data being written by the asynchronous thread.
+        // buffer_mutex keeps forced calls of write_data from writing the same records as the
+        // asynchronous thread.  The recording job does not take it unless it writes the buffer itself.
         pthread_mutex_lock(&buffer_mutex) ;
 
-        local_buffer_num = buffer_num ;
-        if ( (local_buffer_num - writer_num) > max_num ) {
-            num_to_write = max_num ;
-        } else {
-            num_to_write = (local_buffer_num - writer_num) ;
-        }
-        writer_num = local_buffer_num - num_to_write ;
-
-        //! This loop pulls a "row" of time homogeneous data and writes it to the file
-        while ( writer_num != local_buffer_num ) {
+        //! This loop pulls "rows" of time homogeneous data and writes them to the file.
+        //! Rows are claimed one at a time so DR_Overflow_Drop_Oldest can drop the rows behind it.
+        //! Record major groups claim every row up to the end of the ring and write them as a block.
+        num_to_write = max_num ;
+        while ( num_to_write > 0 and
+                (num_claimed = claim_records(record_major ? num_to_write : 1, writer_record, true)) > 0 ) {
 
-            writer_offset = writer_num % max_num ;
             //! keep record of bytes written to file. Default max is 1GB
-            total_bytes_written += format_specific_write_data(writer_offset) ;
-            writer_num++ ;
+            total_bytes_written += format_specific_write_records(writer_record % max_num, num_claimed) ;
+            release_records() ;
+            num_to_write -= num_claimed ;
 
         }
 
@@ -771,6 +1021,12 @@ int Trick::DataRecordGroup::shutdown() {
         rec_buffer.clear();
     }
 
+    if ( record_arena ) {
+        free(record_arena) ;
+        record_arena = NULL ;
+    }
+    record_copies.clear() ;
+
     if ( writer_buff ) {
         free(writer_buff) ;
         writer_buff = NULL ;
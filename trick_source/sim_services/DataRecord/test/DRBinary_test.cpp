@@ -0,0 +1,203 @@
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include "gtest/gtest.h"
+
+#define protected public
+#include "trick/DRBinary.hh"
+#include "trick/CommandLineArguments.hh"
+#include "trick/attributes.h"
+
+namespace Trick {
+
+/* Recorded variables.  The members of the structure are next to each other in memory, so a record
+   major group copies them with one memcpy. */
+struct RecordedState {
+    double pos[3] ;
+    double vel[3] ;
+    int mode ;
+    int count ;
+} ;
+
+class DRBinaryTest : public ::testing::Test {
+    protected:
+        Trick::CommandLineArguments cmd_args ;
+        RecordedState state ;
+        int not_recorded ;
+        double gain ;
+        short flags ;
+        ATTRIBUTES double_attr ;
+        ATTRIBUTES int_attr ;
+        ATTRIBUTES short_attr ;
+
+        DRBinaryTest() {}
+        ~DRBinaryTest() {}
+        virtual void SetUp() {
+            memset(&state, 0, sizeof(state)) ;
+            gain = 0.0 ;
+            flags = 0 ;
+            init_attr(double_attr, TRICK_DOUBLE, sizeof(double)) ;
+            init_attr(int_attr, TRICK_INTEGER, sizeof(int)) ;
+            init_attr(short_attr, TRICK_SHORT, sizeof(short)) ;
+        }
+        virtual void TearDown() {}
+
+        void init_attr( ATTRIBUTES & attr , TRICK_TYPE type , int size ) {
+            memset(&attr, 0, sizeof(ATTRIBUTES)) ;
+            attr.type = type ;
+            attr.size = size ;
+            attr.units = (char *)"--" ;
+        }
+
+        void add( DRBinary & group , const char * name , void * address , ATTRIBUTES * attr ) {
+            REF2 * ref = (REF2 *)calloc(1, sizeof(REF2)) ;
+            ref->reference = strdup(name) ;
+            ref->address = address ;
+            ref->attr = attr ;
+            group.add_variable(ref) ;
+        }
+
+        /* Add the variables in address order, so both layouts write the same variable order.  The
+           fixture's members are laid out in declaration order. */
+        void add_variables( DRBinary & group ) {
+            const char * pos_names[3] = { "state.pos[0]" , "state.pos[1]" , "state.pos[2]" } ;
+            const char * vel_names[3] = { "state.vel[0]" , "state.vel[1]" , "state.vel[2]" } ;
+            int ii ;
+            for ( ii = 0 ; ii < 3 ; ii++ ) {
+                add(group, pos_names[ii], &state.pos[ii], &double_attr) ;
+            }
+            for ( ii = 0 ; ii < 3 ; ii++ ) {
+                add(group, vel_names[ii], &state.vel[ii], &double_attr) ;
+            }
+            add(group, "state.mode", &state.mode, &int_attr) ;
+            add(group, "state.count", &state.count, &int_attr) ;
+            add(group, "gain", &gain, &double_attr) ;
+            add(group, "flags", &flags, &short_attr) ;
+        }
+
+        /* Record num_records records, forcing a write every write_every records */
+        void record( DRBinary & group , int num_records , int write_every ) {
+            int ii , jj ;
+            for ( ii = 0 ; ii < num_records ; ii++ ) {
+                for ( jj = 0 ; jj < 3 ; jj++ ) {
+                    state.pos[jj] = ii * 0.5 + jj ;
+                    state.vel[jj] = -ii * 0.25 - jj ;
+                }
+                state.mode = ii % 3 ;
+                state.count = ii ;
+                gain = ii * 1.0e-3 ;
+                flags = (short)(ii & 0x7fff) ;
+                group.data_record(ii * 0.1) ;
+                if ( write_every > 0 and ii % write_every == 0 ) {
+                    group.write_data(true) ;
+                }
+            }
+        }
+
+        std::string read_file( std::string file_name ) {
+            std::ifstream in(file_name.c_str(), std::ios::binary) ;
+            std::stringstream contents ;
+            contents << in.rdbuf() ;
+            return contents.str() ;
+        }
+} ;
+
+TEST_F(DRBinaryTest , RecordMajorCopyPlan) {
+    DRBinary group("copy_plan", false) ;
+    add_variables(group) ;
+    EXPECT_EQ( group.set_record_major(true) , 0 ) ;
+    group.set_max_buffer_size(16) ;
+    group.init() ;
+
+    /* Time, the structure, and gain and flags, which are next to each other, are one copy each */
+    ASSERT_EQ( group.record_copies.size() , 3u ) ;
+    EXPECT_EQ( group.record_copies[0].address , (char *)&group.curr_time ) ;
+    EXPECT_EQ( group.record_copies[0].size , sizeof(double) ) ;
+    EXPECT_EQ( group.record_copies[1].address , (char *)&state ) ;
+    EXPECT_EQ( group.record_copies[1].size , 6 * sizeof(double) + 2 * sizeof(int) ) ;
+    EXPECT_EQ( group.record_copies[2].address , (char *)&gain ) ;
+    EXPECT_EQ( group.record_copies[2].size , sizeof(double) + sizeof(short) ) ;
+    EXPECT_EQ( group.record_bytes , 8 * sizeof(double) + 2 * sizeof(int) + sizeof(short) ) ;
+
+    /* Each variable's buffer is its field in the first record of the arena */
+    EXPECT_EQ( group.rec_buffer[0]->buffer , group.record_arena ) ;
+    EXPECT_EQ( group.rec_buffer[1]->buffer , group.record_arena + sizeof(double) ) ;
+    EXPECT_EQ( group.rec_buffer[1]->stride , group.record_bytes ) ;
+    group.shutdown() ;
+}
+
+TEST_F(DRBinaryTest , RecordMajorSortsByAddress) {
+    DRBinary group("sort_by_address", false) ;
+    unsigned int ii ;
+
+    /* Added in reverse order of their addresses */
+    add(group, "state.count", &state.count, &int_attr) ;
+    add(group, "state.mode", &state.mode, &int_attr) ;
+    add(group, "state.vel[0]", &state.vel[0], &double_attr) ;
+    add(group, "state.pos[0]", &state.pos[0], &double_attr) ;
+    group.set_record_major(true) ;
+    group.set_max_buffer_size(16) ;
+    group.init() ;
+
+    ASSERT_EQ( group.rec_buffer.size() , 5u ) ;
+    EXPECT_EQ( group.rec_buffer[0]->name , std::string("sys.exec.out.time") ) ;
+    for ( ii = 2 ; ii < group.rec_buffer.size() ; ii++ ) {
+        EXPECT_LT( (char *)group.rec_buffer[ii - 1]->ref->address , (char *)group.rec_buffer[ii]->ref->address ) ;
+    }
+    group.shutdown() ;
+}
+
+TEST_F(DRBinaryTest , RecordMajorFileMatchesVariableMajor) {
+    DRBinary variable_major("variable_major", false) ;
+    DRBinary record_major("record_major", false) ;
+    std::string variable_major_file , record_major_file ;
+
+    add_variables(variable_major) ;
+    add_variables(record_major) ;
+    record_major.set_record_major(true) ;
+    /* A small buffer that wraps at different records than the forced writes */
+    variable_major.set_max_buffer_size(37) ;
+    record_major.set_max_buffer_size(37) ;
+    variable_major.init() ;
+    record_major.init() ;
+
+    record(variable_major, 1000, 13) ;
+    record(record_major, 1000, 13) ;
+    variable_major.shutdown() ;
+    record_major.shutdown() ;
+
+    variable_major_file = read_file(cmd_args.get_output_dir() + "/log_variable_major.trk") ;
+    record_major_file = read_file(cmd_args.get_output_dir() + "/log_record_major.trk") ;
+    ASSERT_FALSE( variable_major_file.empty() ) ;
+    EXPECT_TRUE( variable_major_file == record_major_file ) ;
+}
+
+TEST_F(DRBinaryTest , RecordMajorFullBufferMatchesVariableMajor) {
+    DRBinary variable_major("variable_major_full", false) ;
+    DRBinary record_major("record_major_full", false) ;
+    std::string variable_major_file , record_major_file ;
+
+    add_variables(variable_major) ;
+    add_variables(record_major) ;
+    record_major.set_record_major(true) ;
+    /* Never forced, the recording job writes each full buffer itself */
+    variable_major.set_max_buffer_size(20) ;
+    record_major.set_max_buffer_size(20) ;
+    variable_major.init() ;
+    record_major.init() ;
+
+    record(variable_major, 500, 0) ;
+    record(record_major, 500, 0) ;
+    variable_major.shutdown() ;
+    record_major.shutdown() ;
+
+    variable_major_file = read_file(cmd_args.get_output_dir() + "/log_variable_major_full.trk") ;
+    record_major_file = read_file(cmd_args.get_output_dir() + "/log_record_major_full.trk") ;
+    ASSERT_FALSE( variable_major_file.empty() ) ;
+    EXPECT_TRUE( variable_major_file == record_major_file ) ;
+}
+
+}
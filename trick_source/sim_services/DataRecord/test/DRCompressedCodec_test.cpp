@@ -0,0 +1,341 @@
+
+#include <vector>
+#include <limits>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gtest/gtest.h"
+
+#include "trick/DRCompressedCodec.hh"
+
+namespace Trick {
+
+typedef DRCompressedCodec Codec ;
+
+class DRCompressedCodecTest : public ::testing::Test {
+    protected:
+        DRCompressedCodecTest() {}
+        ~DRCompressedCodecTest() {}
+        virtual void SetUp() { srand(12345) ; }
+        virtual void TearDown() {}
+
+        /* Encodes the values as a column and checks they decode to the same bytes */
+        template< class T > void round_trip( Codec::ColumnKind kind , const std::vector< T > & values ) {
+            std::vector< unsigned char > encoded ;
+            std::vector< T > decoded(values.size()) ;
+            Codec::encode_column(kind, sizeof(T), (const unsigned char *)&values[0], sizeof(T), values.size(), encoded) ;
+            ASSERT_TRUE( Codec::decode_column(kind, sizeof(T), &encoded[0], &encoded[0] + encoded.size(),
+             values.size(), (unsigned char *)&decoded[0], sizeof(T)) ) ;
+            EXPECT_EQ( memcmp(&values[0], &decoded[0], values.size() * sizeof(T)) , 0 ) ;
+        }
+
+        /* Compresses the bytes and checks they decompress to the same bytes */
+        void lz_round_trip( const std::vector< unsigned char > & in ) {
+            std::vector< unsigned char > compressed ;
+            std::vector< unsigned char > out(in.size() + 1) ;
+            Codec::lz_compress(in.empty() ? NULL : &in[0], in.size(), compressed) ;
+            ASSERT_FALSE( compressed.empty() ) ;
+            ASSERT_TRUE( Codec::lz_decompress(&compressed[0], compressed.size(), &out[0], in.size()) ) ;
+            EXPECT_TRUE( std::equal(in.begin(), in.end(), out.begin()) ) ;
+            /* The decompressed size must match exactly */
+            if ( ! in.empty() ) {
+                EXPECT_FALSE( Codec::lz_decompress(&compressed[0], compressed.size(), &out[0], in.size() - 1) ) ;
+            }
+            EXPECT_FALSE( Codec::lz_decompress(&compressed[0], compressed.size(), &out[0], in.size() + 1) ) ;
+        }
+} ;
+
+TEST_F(DRCompressedCodecTest , ColumnKind) {
+    EXPECT_EQ( Codec::column_kind(TRICK_DOUBLE, 8) , Codec::Column_Xor ) ;
+    EXPECT_EQ( Codec::column_kind(TRICK_FLOAT, 4) , Codec::Column_Xor ) ;
+    EXPECT_EQ( Codec::column_kind(TRICK_INTEGER, 4) , Codec::Column_Signed ) ;
+    EXPECT_EQ( Codec::column_kind(TRICK_LONG_LONG, 8) , Codec::Column_Signed ) ;
+    EXPECT_EQ( Codec::column_kind(TRICK_UNSIGNED_SHORT, 2) , Codec::Column_Unsigned ) ;
+    EXPECT_EQ( Codec::column_kind(TRICK_BOOLEAN, 1) , Codec::Column_Unsigned ) ;
+    EXPECT_EQ( Codec::column_kind(TRICK_INTEGER, 3) , Codec::Column_Raw ) ;
+    EXPECT_EQ( Codec::column_kind(TRICK_STRUCTURED, 16) , Codec::Column_Raw ) ;
+}
+
+TEST_F(DRCompressedCodecTest , Varint) {
+    const uint64_t values[] = { 0 , 1 , 127 , 128 , 16383 , 16384 , 0xffffffffULL , 0x8000000000000000ULL ,
+     std::numeric_limits<uint64_t>::max() } ;
+    std::vector< unsigned char > out ;
+    unsigned int ii ;
+    for ( ii = 0 ; ii < sizeof(values) / sizeof(values[0]) ; ii++ ) {
+        Codec::put_varint(out, values[ii]) ;
+    }
+    const unsigned char * in = &out[0] ;
+    for ( ii = 0 ; ii < sizeof(values) / sizeof(values[0]) ; ii++ ) {
+        uint64_t value ;
+        ASSERT_TRUE( Codec::get_varint(in, &out[0] + out.size(), value) ) ;
+        EXPECT_EQ( value , values[ii] ) ;
+    }
+    EXPECT_EQ( in , &out[0] + out.size() ) ;
+
+    /* A varint cut short is an error */
+    out.clear() ;
+    Codec::put_varint(out, 0xffffffffULL) ;
+    in = &out[0] ;
+    uint64_t value ;
+    EXPECT_FALSE( Codec::get_varint(in, &out[0] + out.size() - 1, value) ) ;
+}
+
+TEST_F(DRCompressedCodecTest , XorDoubleEdgeValues) {
+    std::vector< double > values ;
+    double quiet_nan = std::numeric_limits<double>::quiet_NaN() ;
+    double payload_nan ;
+    uint64_t bits = 0x7ff8000000000123ULL ;
+    memcpy(&payload_nan, &bits, 8) ;
+
+    values.push_back(0.0) ;
+    values.push_back(-0.0) ;
+    values.push_back(0.0) ;
+    values.push_back(quiet_nan) ;
+    values.push_back(-quiet_nan) ;
+    values.push_back(payload_nan) ;
+    values.push_back(std::numeric_limits<double>::infinity()) ;
+    values.push_back(-std::numeric_limits<double>::infinity()) ;
+    values.push_back(std::numeric_limits<double>::max()) ;
+    values.push_back(std::numeric_limits<double>::min()) ;
+    values.push_back(std::numeric_limits<double>::denorm_min()) ;
+    values.push_back(-std::numeric_limits<double>::denorm_min()) ;
+    values.push_back(1.0) ;
+    values.push_back(1.0 + std::numeric_limits<double>::epsilon()) ;
+    round_trip(Codec::Column_Xor, values) ;
+}
+
+TEST_F(DRCompressedCodecTest , XorDoubleRepeatsAndWindows) {
+    std::vector< double > values ;
+    unsigned int ii ;
+    /* Runs of repeated values, slowly changing values that reuse the leading/trailing zero window,
+       and random values that do not */
+    for ( ii = 0 ; ii < 100 ; ii++ ) {
+        values.push_back(42.0) ;
+    }
+    for ( ii = 0 ; ii < 1000 ; ii++ ) {
+        values.push_back(ii * 0.01) ;
+        values.push_back(sin(ii * 0.001)) ;
+    }
+    for ( ii = 0 ; ii < 1000 ; ii++ ) {
+        uint64_t bits = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand() ;
+        double value ;
+        memcpy(&value, &bits, 8) ;
+        values.push_back(value) ;
+    }
+    round_trip(Codec::Column_Xor, values) ;
+}
+
+TEST_F(DRCompressedCodecTest , XorFloat) {
+    std::vector< float > values ;
+    unsigned int ii ;
+    values.push_back(0.0f) ;
+    values.push_back(-0.0f) ;
+    values.push_back(std::numeric_limits<float>::quiet_NaN()) ;
+    values.push_back(std::numeric_limits<float>::infinity()) ;
+    values.push_back(std::numeric_limits<float>::denorm_min()) ;
+    values.push_back(std::numeric_limits<float>::max()) ;
+    for ( ii = 0 ; ii < 500 ; ii++ ) {
+        values.push_back((float)cos(ii * 0.3)) ;
+        values.push_back((float)cos(ii * 0.3)) ;
+    }
+    round_trip(Codec::Column_Xor, values) ;
+}
+
+TEST_F(DRCompressedCodecTest , ZigzagSigned) {
+    std::vector< int64_t > longs ;
+    std::vector< int32_t > ints ;
+    std::vector< int16_t > shorts ;
+    std::vector< int8_t > chars ;
+    int ii ;
+
+    /* Extremes back to back make deltas that overflow the type */
+    longs.push_back(0) ;
+    longs.push_back(std::numeric_limits<int64_t>::max()) ;
+    longs.push_back(std::numeric_limits<int64_t>::min()) ;
+    longs.push_back(std::numeric_limits<int64_t>::max()) ;
+    longs.push_back(-1) ;
+    longs.push_back(-1) ;
+    ints.push_back(std::numeric_limits<int32_t>::min()) ;
+    ints.push_back(std::numeric_limits<int32_t>::max()) ;
+    shorts.push_back(std::numeric_limits<int16_t>::min()) ;
+    shorts.push_back(std::numeric_limits<int16_t>::max()) ;
+    chars.push_back(-128) ;
+    chars.push_back(127) ;
+    for ( ii = -300 ; ii < 300 ; ii++ ) {
+        longs.push_back((int64_t)ii * ii * ii * 1000003) ;
+        ints.push_back(ii * 7) ;
+        shorts.push_back((int16_t)(ii * 101)) ;
+        chars.push_back((int8_t)ii) ;
+    }
+    round_trip(Codec::Column_Signed, longs) ;
+    round_trip(Codec::Column_Signed, ints) ;
+    round_trip(Codec::Column_Signed, shorts) ;
+    round_trip(Codec::Column_Signed, chars) ;
+}
+
+TEST_F(DRCompressedCodecTest , ZigzagUnsigned) {
+    std::vector< uint64_t > longs ;
+    std::vector< uint32_t > ints ;
+    std::vector< uint8_t > chars ;
+    unsigned int ii ;
+
+    longs.push_back(std::numeric_limits<uint64_t>::max()) ;
+    longs.push_back(0) ;
+    longs.push_back(std::numeric_limits<uint64_t>::max()) ;
+    ints.push_back(std::numeric_limits<uint32_t>::max()) ;
+    ints.push_back(0) ;
+    chars.push_back(255) ;
+    chars.push_back(0) ;
+    for ( ii = 0 ; ii < 600 ; ii++ ) {
+        longs.push_back((uint64_t)ii << (ii % 60)) ;
+        ints.push_back(ii * 2654435761U) ;
+        chars.push_back((uint8_t)(ii * 7)) ;
+    }
+    round_trip(Codec::Column_Unsigned, longs) ;
+    round_trip(Codec::Column_Unsigned, ints) ;
+    round_trip(Codec::Column_Unsigned, chars) ;
+
+    /* Consecutive repeats encode to one byte each */
+    std::vector< unsigned char > encoded ;
+    std::vector< uint32_t > repeats(100, 7) ;
+    Codec::encode_column(Codec::Column_Unsigned, 4, (const unsigned char *)&repeats[0], 4, repeats.size(), encoded) ;
+    EXPECT_EQ( encoded.size() , 100u ) ;
+}
+
+TEST_F(DRCompressedCodecTest , StridedColumns) {
+    /* Columns are read from and written to records of several variables */
+    struct Record {
+        double d ;
+        int32_t i ;
+        uint16_t u ;
+    } ;
+    std::vector< Record > records(257) , decoded(257) ;
+    std::vector< unsigned char > d_col , i_col , u_col ;
+    unsigned int ii ;
+
+    memset(&records[0], 0, records.size() * sizeof(Record)) ;
+    memset(&decoded[0], 0, decoded.size() * sizeof(Record)) ;
+    for ( ii = 0 ; ii < records.size() ; ii++ ) {
+        records[ii].d = ii * 0.5 - 10.0 ;
+        records[ii].i = (int32_t)ii * -3 ;
+        records[ii].u = (uint16_t)(ii * 300) ;
+    }
+    Codec::encode_column(Codec::Column_Xor, 8, (const unsigned char *)&records[0].d, sizeof(Record), records.size(), d_col) ;
+    Codec::encode_column(Codec::Column_Signed, 4, (const unsigned char *)&records[0].i, sizeof(Record), records.size(), i_col) ;
+    Codec::encode_column(Codec::Column_Unsigned, 2, (const unsigned char *)&records[0].u, sizeof(Record), records.size(), u_col) ;
+    ASSERT_TRUE( Codec::decode_column(Codec::Column_Xor, 8, &d_col[0], &d_col[0] + d_col.size(), records.size(),
+     (unsigned char *)&decoded[0].d, sizeof(Record)) ) ;
+    ASSERT_TRUE( Codec::decode_column(Codec::Column_Signed, 4, &i_col[0], &i_col[0] + i_col.size(), records.size(),
+     (unsigned char *)&decoded[0].i, sizeof(Record)) ) ;
+    ASSERT_TRUE( Codec::decode_column(Codec::Column_Unsigned, 2, &u_col[0], &u_col[0] + u_col.size(), records.size(),
+     (unsigned char *)&decoded[0].u, sizeof(Record)) ) ;
+    EXPECT_EQ( memcmp(&records[0], &decoded[0], records.size() * sizeof(Record)) , 0 ) ;
+}
+
+TEST_F(DRCompressedCodecTest , RawColumn) {
+    std::vector< unsigned char > values , encoded , decoded(30) ;
+    unsigned int ii ;
+    for ( ii = 0 ; ii < 30 ; ii++ ) {
+        values.push_back((unsigned char)(ii * 37)) ;
+    }
+    /* 10 values of 3 bytes */
+    Codec::encode_column(Codec::Column_Raw, 3, &values[0], 3, 10, encoded) ;
+    ASSERT_EQ( encoded.size() , 30u ) ;
+    ASSERT_TRUE( Codec::decode_column(Codec::Column_Raw, 3, &encoded[0], &encoded[0] + 30, 10, &decoded[0], 3) ) ;
+    EXPECT_TRUE( values == decoded ) ;
+    EXPECT_FALSE( Codec::decode_column(Codec::Column_Raw, 3, &encoded[0], &encoded[0] + 29, 10, &decoded[0], 3) ) ;
+}
+
+TEST_F(DRCompressedCodecTest , ShortColumnsAreErrors) {
+    std::vector< double > values(100) ;
+    std::vector< double > decoded(100) ;
+    std::vector< unsigned char > encoded ;
+    unsigned int ii ;
+    for ( ii = 0 ; ii < values.size() ; ii++ ) {
+        values[ii] = ii * 1.5 ;
+    }
+    Codec::encode_column(Codec::Column_Xor, 8, (const unsigned char *)&values[0], 8, values.size(), encoded) ;
+    EXPECT_FALSE( Codec::decode_column(Codec::Column_Xor, 8, &encoded[0], &encoded[0] + encoded.size() / 2,
+     values.size(), (unsigned char *)&decoded[0], 8) ) ;
+
+    std::vector< int32_t > ints(100, 1000000) ;
+    encoded.clear() ;
+    Codec::encode_column(Codec::Column_Signed, 4, (const unsigned char *)&ints[0], 4, ints.size(), encoded) ;
+    EXPECT_FALSE( Codec::decode_column(Codec::Column_Signed, 4, &encoded[0], &encoded[0] + encoded.size() - 1,
+     ints.size(), (unsigned char *)&decoded[0], 4) ) ;
+}
+
+TEST_F(DRCompressedCodecTest , LZEdgeCases) {
+    std::vector< unsigned char > in ;
+    unsigned int ii ;
+
+    /* Empty and shorter than the minimum match search */
+    lz_round_trip(in) ;
+    for ( ii = 0 ; ii < 11 ; ii++ ) {
+        in.push_back((unsigned char)ii) ;
+        lz_round_trip(in) ;
+    }
+
+    /* One long run, matches that overlap the bytes they produce and a match length continuation */
+    in.assign(100000, 0xab) ;
+    lz_round_trip(in) ;
+
+    /* Incompressible bytes, literal runs with length continuations */
+    in.clear() ;
+    for ( ii = 0 ; ii < 70000 ; ii++ ) {
+        in.push_back((unsigned char)rand()) ;
+    }
+    lz_round_trip(in) ;
+
+    /* A block repeated just inside and just outside the 65535 byte match window */
+    std::vector< unsigned char > block(1000) ;
+    for ( ii = 0 ; ii < block.size() ; ii++ ) {
+        block[ii] = (unsigned char)rand() ;
+    }
+    in.clear() ;
+    in.insert(in.end(), block.begin(), block.end()) ;
+    for ( ii = 0 ; ii < 64535 ; ii++ ) {
+        in.push_back((unsigned char)rand()) ;
+    }
+    in.insert(in.end(), block.begin(), block.end()) ;
+    in.insert(in.end(), block.begin(), block.end()) ;
+    lz_round_trip(in) ;
+
+    /* Literal and match counts of exactly 15 and 15 + 255 */
+    in.clear() ;
+    for ( ii = 0 ; ii < 15 + 255 ; ii++ ) {
+        in.push_back((unsigned char)rand()) ;
+    }
+    in.insert(in.end(), in.begin(), in.begin() + 19) ;
+    in.insert(in.end(), in.begin(), in.begin() + 4 + 15 + 255) ;
+    lz_round_trip(in) ;
+}
+
+TEST_F(DRCompressedCodecTest , LZCorruptInput) {
+    std::vector< unsigned char > in(5000) , compressed , out(5000) ;
+    unsigned int ii ;
+    for ( ii = 0 ; ii < in.size() ; ii++ ) {
+        in[ii] = (unsigned char)(ii % 97) ;
+    }
+    Codec::lz_compress(&in[0], in.size(), compressed) ;
+    ASSERT_TRUE( Codec::lz_decompress(&compressed[0], compressed.size(), &out[0], out.size()) ) ;
+
+    /* Cut short */
+    EXPECT_FALSE( Codec::lz_decompress(&compressed[0], compressed.size() / 2, &out[0], out.size()) ) ;
+
+    /* A match offset before the start of the output */
+    std::vector< unsigned char > bad ;
+    bad.push_back(0x10) ;
+    bad.push_back('a') ;
+    bad.push_back(2) ;
+    bad.push_back(0) ;
+    bad.push_back(0x00) ;
+    EXPECT_FALSE( Codec::lz_decompress(&bad[0], bad.size(), &out[0], 5) ) ;
+
+    /* A zero match offset */
+    bad[2] = 0 ;
+    EXPECT_FALSE( Codec::lz_decompress(&bad[0], bad.size(), &out[0], 5) ) ;
+}
+
+}
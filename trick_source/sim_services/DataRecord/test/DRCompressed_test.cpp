@@ -0,0 +1,290 @@
+
+#include <string>
+#include <limits>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "gtest/gtest.h"
+
+#define protected public
+#include "trick/DRCompressed.hh"
+#include "trick/CommandLineArguments.hh"
+#include "trick/attributes.h"
+#include "Log/TrickCompressed.hh"
+
+namespace Trick {
+
+/* Recorded variables of several types */
+struct CompressedState {
+    double smooth ;
+    double steps ;
+    int count ;
+    float wave ;
+    unsigned char flags ;
+    long long big ;
+} ;
+
+static const char * state_names[] = { "state.smooth" , "state.steps" , "state.count" , "state.wave" ,
+ "state.flags" , "state.big" } ;
+static const unsigned int num_state_names = 6 ;
+
+class DRCompressedTest : public ::testing::Test {
+    protected:
+        Trick::CommandLineArguments cmd_args ;
+        CompressedState state ;
+        ATTRIBUTES double_attr ;
+        ATTRIBUTES int_attr ;
+        ATTRIBUTES float_attr ;
+        ATTRIBUTES uchar_attr ;
+        ATTRIBUTES long_long_attr ;
+
+        DRCompressedTest() {}
+        ~DRCompressedTest() {}
+        virtual void SetUp() {
+            memset(&state, 0, sizeof(state)) ;
+            init_attr(double_attr, TRICK_DOUBLE, sizeof(double)) ;
+            init_attr(int_attr, TRICK_INTEGER, sizeof(int)) ;
+            init_attr(float_attr, TRICK_FLOAT, sizeof(float)) ;
+            init_attr(uchar_attr, TRICK_UNSIGNED_CHARACTER, sizeof(unsigned char)) ;
+            init_attr(long_long_attr, TRICK_LONG_LONG, sizeof(long long)) ;
+        }
+        virtual void TearDown() {}
+
+        void init_attr( ATTRIBUTES & attr , TRICK_TYPE type , int size ) {
+            memset(&attr, 0, sizeof(ATTRIBUTES)) ;
+            attr.type = type ;
+            attr.size = size ;
+            attr.units = (char *)"--" ;
+        }
+
+        void add( DRCompressed & group , const char * name , void * address , ATTRIBUTES * attr ) {
+            REF2 * ref = (REF2 *)calloc(1, sizeof(REF2)) ;
+            ref->reference = strdup(name) ;
+            ref->address = address ;
+            ref->attr = attr ;
+            group.add_variable(ref) ;
+        }
+
+        void add_variables( DRCompressed & group ) {
+            add(group, state_names[0], &state.smooth, &double_attr) ;
+            add(group, state_names[1], &state.steps, &double_attr) ;
+            add(group, state_names[2], &state.count, &int_attr) ;
+            add(group, state_names[3], &state.wave, &float_attr) ;
+            add(group, state_names[4], &state.flags, &uchar_attr) ;
+            add(group, state_names[5], &state.big, &long_long_attr) ;
+        }
+
+        /* The value of variable kk in record ii, as the reader returns it */
+        static double value( unsigned int kk , int ii ) {
+            switch ( kk ) {
+                case 0: return sin(ii * 0.01) * 1000.0 ;
+                case 1: return (ii / 10) * 0.5 ;
+                case 2: return ii * 3 - 500 ;
+                case 3: return (float)cos(ii * 0.3) ;
+                case 4: return (unsigned char)(ii * 7) ;
+                default: return (double)(-1000000000000LL + (long long)ii * ii) ;
+            }
+        }
+
+        /* Record num_records records, forcing a write every write_every records */
+        void record( DRCompressed & group , int num_records , int write_every ) {
+            int ii ;
+            for ( ii = 0 ; ii < num_records ; ii++ ) {
+                state.smooth = value(0, ii) ;
+                state.steps = value(1, ii) ;
+                state.count = (int)value(2, ii) ;
+                state.wave = (float)value(3, ii) ;
+                state.flags = (unsigned char)value(4, ii) ;
+                state.big = (long long)value(5, ii) ;
+                group.data_record(ii * 0.01) ;
+                if ( write_every > 0 and ii % write_every == 0 ) {
+                    group.write_data(true) ;
+                }
+            }
+        }
+
+        std::string file_name( const char * group_name ) {
+            return cmd_args.get_output_dir() + "/log_" + group_name + ".trkz" ;
+        }
+
+        /* Read every variable back with the data products reader */
+        void check( std::string file , int num_records ) {
+            unsigned int kk ;
+            int ii ;
+
+            ASSERT_EQ( TrickCompressedGetNumVariables(file.c_str()) , (int)num_state_names + 1 ) ;
+            for ( kk = 0 ; kk < num_state_names ; kk++ ) {
+                TrickCompressed reader((char *)file.c_str(), (char *)state_names[kk]) ;
+                double time , val ;
+                int num_bad = 0 ;
+                ii = 0 ;
+                while ( reader.get(&time, &val) ) {
+                    if ( time != ii * 0.01 or val != value(kk, ii) ) {
+                        num_bad++ ;
+                    }
+                    ii++ ;
+                }
+                EXPECT_EQ( num_bad , 0 ) << state_names[kk] ;
+                EXPECT_EQ( ii , num_records ) << state_names[kk] ;
+
+                /* Seeking through the chunk index, including the first record of a chunk */
+                for ( ii = 0 ; ii < num_records ; ii += 997 ) {
+                    ASSERT_TRUE( reader.getValueAtTime(ii * 0.01, &val) ) ;
+                    EXPECT_EQ( val , value(kk, ii) ) << state_names[kk] << " at " << ii ;
+                }
+                reader.begin() ;
+                ASSERT_TRUE( reader.peek(&time, &val) ) ;
+                EXPECT_EQ( time , 0.0 ) ;
+                EXPECT_EQ( val , value(kk, 0) ) ;
+            }
+        }
+} ;
+
+TEST_F(DRCompressedTest , SetChunkRecordsAndCodec) {
+    DRCompressed group("settings", false) ;
+    EXPECT_EQ( group.chunk_records , 4096u ) ;
+    EXPECT_EQ( group.codec , DR_Codec_LZ ) ;
+    EXPECT_EQ( group.set_chunk_records(0) , -1 ) ;
+    EXPECT_EQ( group.set_chunk_records(100) , 0 ) ;
+    EXPECT_EQ( group.chunk_records , 100u ) ;
+    EXPECT_EQ( group.set_codec(DR_Codec_None) , 0 ) ;
+    EXPECT_EQ( group.set_codec(2) , -1 ) ;
+    EXPECT_EQ( group.codec , DR_Codec_None ) ;
+}
+
+TEST_F(DRCompressedTest , VariableMajorLZRoundTrip) {
+    DRCompressed group("variable_major_lz", false) ;
+    add_variables(group) ;
+    group.set_chunk_records(1000) ;
+    group.set_max_buffer_size(64) ;
+    group.init() ;
+    /* The records do not fill the last chunk */
+    record(group, 10007, 7) ;
+    group.shutdown() ;
+    EXPECT_EQ( group.num_chunks , 11u ) ;
+    EXPECT_LT( group.total_bytes_written , group.num_raw_bytes ) ;
+    check(file_name("variable_major_lz"), 10007) ;
+}
+
+TEST_F(DRCompressedTest , RecordMajorNoCodecRoundTrip) {
+    DRCompressed group("record_major_none", false) ;
+    add_variables(group) ;
+    group.set_record_major(true) ;
+    group.set_codec(DR_Codec_None) ;
+    group.set_chunk_records(333) ;
+    group.set_max_buffer_size(64) ;
+    group.init() ;
+    record(group, 10007, 7) ;
+    group.shutdown() ;
+    EXPECT_EQ( group.num_chunks , 31u ) ;
+    check(file_name("record_major_none"), 10007) ;
+}
+
+TEST_F(DRCompressedTest , RecordMajorLZOneChunk) {
+    DRCompressed group("record_major_lz", false) ;
+    add_variables(group) ;
+    group.set_record_major(true) ;
+    group.init() ;
+    record(group, 3000, 0) ;
+    group.shutdown() ;
+    EXPECT_EQ( group.num_chunks , 1u ) ;
+    check(file_name("record_major_lz"), 3000) ;
+}
+
+TEST_F(DRCompressedTest , EdgeValues) {
+    DRCompressed group("edge_values", false) ;
+    double values[] = { 0.0 , -0.0 , -0.0 , std::numeric_limits<double>::quiet_NaN() ,
+     std::numeric_limits<double>::infinity() , -std::numeric_limits<double>::infinity() ,
+     std::numeric_limits<double>::denorm_min() , std::numeric_limits<double>::max() , 1.0 , 1.0 } ;
+    unsigned int num_values = sizeof(values) / sizeof(values[0]) ;
+    unsigned int ii ;
+
+    add(group, "state.smooth", &state.smooth, &double_attr) ;
+    group.set_chunk_records(4) ;
+    group.init() ;
+    for ( ii = 0 ; ii < num_values ; ii++ ) {
+        state.smooth = values[ii] ;
+        group.data_record(ii * 0.01) ;
+    }
+    group.shutdown() ;
+
+    std::string file = file_name("edge_values") ;
+    TrickCompressed reader((char *)file.c_str(), (char *)"state.smooth") ;
+    double time , val ;
+    ii = 0 ;
+    while ( reader.get(&time, &val) ) {
+        ASSERT_LT( ii , num_values ) ;
+        if ( isnan(values[ii]) ) {
+            EXPECT_TRUE( isnan(val) ) ;
+        } else {
+            EXPECT_EQ( val , values[ii] ) ;
+            EXPECT_EQ( signbit(val) , signbit(values[ii]) ) ;
+        }
+        ii++ ;
+    }
+    EXPECT_EQ( ii , num_values ) ;
+}
+
+TEST_F(DRCompressedTest , SeekWhenTimesDecrease) {
+    DRCompressed group("restarted", false) ;
+    std::string file = file_name("restarted") ;
+    double time , val ;
+    int ii , count ;
+
+    /* The times drop back inside the first chunk, as after a checkpoint reload.  The chunk index
+       alone shows a chunk from 0 to 1599 followed by a chunk from 1600 to 2999. */
+    add(group, "state.smooth", &state.smooth, &double_attr) ;
+    group.set_chunk_records(2100) ;
+    group.init() ;
+    for ( ii = 0 ; ii < 3500 ; ii++ ) {
+        time = ( ii < 2000 ) ? ii : ii - 500 ;
+        state.smooth = 2.0 * time ;
+        group.data_record(time) ;
+    }
+    group.shutdown() ;
+    ASSERT_EQ( group.num_chunks , 2u ) ;
+
+    /* The seek stops at the first record at or after the time, before the restart */
+    TrickCompressed reader((char *)file.c_str(), (char *)"state.smooth") ;
+    EXPECT_EQ( reader.seek(1600.0) , 1 ) ;
+    count = 0 ;
+    while ( reader.get(&time, &val) ) {
+        count++ ;
+    }
+    EXPECT_EQ( count , 400 + 1500 ) ;
+    EXPECT_EQ( reader.getValueAtTime(1700.0, &val) , 1 ) ;
+    EXPECT_EQ( val , 3400.0 ) ;
+}
+
+TEST_F(DRCompressedTest , TrailerlessFileIsScanned) {
+    DRCompressed group("trailerless", false) ;
+    std::string file = file_name("trailerless") ;
+    std::string truncated = file_name("trailerless_truncated") ;
+    struct stat st ;
+
+    add_variables(group) ;
+    group.set_record_major(true) ;
+    group.set_chunk_records(1000) ;
+    group.set_max_buffer_size(64) ;
+    group.init() ;
+    record(group, 10007, 7) ;
+    group.write_data(true) ;
+
+    /* The sim died before shutdown wrote the partial chunk and the chunk index.  The full chunks
+       are found by scanning the file. */
+    check(file, 10000) ;
+
+    /* The sim died while writing the last chunk */
+    ASSERT_EQ( stat(file.c_str(), &st) , 0 ) ;
+    std::string copy_cmd = "cp " + file + " " + truncated ;
+    ASSERT_EQ( system(copy_cmd.c_str()) , 0 ) ;
+    ASSERT_EQ( truncate(truncated.c_str(), st.st_size - 10) , 0 ) ;
+    check(truncated, 9000) ;
+
+    group.shutdown() ;
+    check(file, 10007) ;
+}
+
+}
@@ -0,0 +1,308 @@
+
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gtest/gtest.h"
+
+#define protected public
+#include "trick/DataRecordGroup.hh"
+#include "trick/CommandLineArguments.hh"
+#include "trick/attributes.h"
+
+namespace Trick {
+
+/* A data record group that keeps the records it writes.  The group records time and one double
+   that is always twice the time, so a record that was overwritten while it was written shows up
+   as a value that does not match its time. */
+class TestRecordGroup : public Trick::DataRecordGroup {
+    public:
+        double value ;
+        ATTRIBUTES value_attr ;
+        std::vector< double > times ;
+        unsigned int num_torn ;
+        volatile unsigned int write_delay ;
+        volatile bool writer_running ;
+        bool record_major_supported ;
+
+        TestRecordGroup( std::string in_name ) :
+         DataRecordGroup(in_name) , value(0.0) , num_torn(0) , write_delay(0) , writer_running(false) ,
+         record_major_supported(true) {
+            REF2 * ref ;
+            memset(&value_attr, 0, sizeof(ATTRIBUTES)) ;
+            value_attr.type = TRICK_DOUBLE ;
+            value_attr.size = sizeof(double) ;
+            value_attr.units = (char *)"--" ;
+            ref = (REF2 *)calloc(1, sizeof(REF2)) ;
+            ref->reference = strdup("value") ;
+            ref->address = &value ;
+            ref->attr = &value_attr ;
+            add_variable(ref) ;
+        }
+
+        ~TestRecordGroup() {
+            shutdown() ;
+        }
+
+        /* Record one record at in_time */
+        void record_at( double in_time ) {
+            value = 2.0 * in_time ;
+            data_record(in_time) ;
+        }
+
+        virtual bool supports_record_major() { return record_major_supported ; }
+        virtual int format_specific_header( std::fstream & ) { return 0 ; }
+        virtual int format_specific_init() { return 0 ; }
+        virtual int format_specific_shutdown() { return 0 ; }
+        virtual int format_specific_write_data( unsigned int writer_offset ) {
+            unsigned int ii ;
+            double time = *(double *)(rec_buffer[0]->buffer + writer_offset * rec_buffer[0]->stride) ;
+            for ( ii = 0 ; ii < write_delay ; ii++ ) {
+                __asm__ __volatile__("" ::: "memory") ;
+            }
+            if ( *(double *)(rec_buffer[1]->buffer + writer_offset * rec_buffer[1]->stride) != 2.0 * time ) {
+                num_torn++ ;
+            }
+            times.push_back(time) ;
+            return sizeof(double) * 2 ;
+        }
+} ;
+
+class DataRecordGroupTest : public ::testing::Test {
+    protected:
+        Trick::CommandLineArguments cmd_args ;
+        DataRecordGroupTest() {}
+        ~DataRecordGroupTest() {}
+        virtual void SetUp() {}
+        virtual void TearDown() {}
+} ;
+
+static void * writer_thread( void * arg ) {
+    TestRecordGroup * group = (TestRecordGroup *)arg ;
+    while ( __atomic_load_n(&group->writer_running, __ATOMIC_ACQUIRE) ) {
+        group->write_data(true) ;
+        usleep(100) ;
+    }
+    return NULL ;
+}
+
+/* Record num_records records with a writer thread writing the buffer, then check that every
+   record was written once or counted as dropped, in order, and never overwritten while written */
+static void record_with_writer( TestRecordGroup & group , unsigned int num_records ) {
+    pthread_t writer ;
+    unsigned int ii ;
+
+    group.writer_running = true ;
+    pthread_create(&writer, NULL, writer_thread, &group) ;
+    for ( ii = 1 ; ii <= num_records ; ii++ ) {
+        group.record_at((double)ii) ;
+    }
+    __atomic_store_n(&group.writer_running, false, __ATOMIC_RELEASE) ;
+    pthread_join(writer, NULL) ;
+    group.write_data(true) ;
+
+    EXPECT_EQ( group.num_torn , 0u ) ;
+    EXPECT_EQ( group.times.size() + group.num_dropped_oldest + group.num_dropped_newest , num_records ) ;
+    for ( ii = 1 ; ii < group.times.size() ; ii++ ) {
+        EXPECT_LT( group.times[ii - 1] , group.times[ii] ) ;
+    }
+}
+
+TEST_F(DataRecordGroupTest , SetOverflowPolicy) {
+    TestRecordGroup group("overflow_policy") ;
+    EXPECT_EQ( group.overflow_policy , DR_Overflow_Block ) ;
+    EXPECT_EQ( group.set_overflow_policy(DR_Overflow_Drop_Oldest) , 0 ) ;
+    EXPECT_EQ( group.overflow_policy , DR_Overflow_Drop_Oldest ) ;
+    EXPECT_EQ( group.set_overflow_policy(DR_Overflow_Drop_Newest) , 0 ) ;
+    EXPECT_EQ( group.overflow_policy , DR_Overflow_Drop_Newest ) ;
+    EXPECT_EQ( group.set_overflow_policy(-1) , -1 ) ;
+    EXPECT_EQ( group.set_overflow_policy(3) , -1 ) ;
+    EXPECT_EQ( group.overflow_policy , DR_Overflow_Drop_Newest ) ;
+}
+
+TEST_F(DataRecordGroupTest , RecordMajorNotSupported) {
+    TestRecordGroup group("record_major_not_supported") ;
+    unsigned int ii ;
+
+    group.record_major_supported = false ;
+    EXPECT_EQ( group.set_record_major(true) , -1 ) ;
+    EXPECT_FALSE( group.record_major ) ;
+    EXPECT_EQ( group.set_record_major(false) , 0 ) ;
+
+    /* The flag can be set without the command, init turns it off and the group records variable major */
+    group.record_major = true ;
+    group.set_max_buffer_size(10) ;
+    group.init() ;
+    EXPECT_FALSE( group.record_major ) ;
+    EXPECT_TRUE( group.record_arena == NULL ) ;
+    for ( ii = 1 ; ii <= 5 ; ii++ ) {
+        group.record_at((double)ii) ;
+    }
+    group.write_data(true) ;
+    ASSERT_EQ( group.times.size() , 5u ) ;
+    EXPECT_EQ( group.num_torn , 0u ) ;
+}
+
+TEST_F(DataRecordGroupTest , RingBufferWraps) {
+    TestRecordGroup group("ring_wraps") ;
+    unsigned int ii ;
+
+    group.set_max_buffer_size(10) ;
+    group.init() ;
+    /* Write every 5 records so the buffer wraps many times without filling */
+    for ( ii = 1 ; ii <= 103 ; ii++ ) {
+        group.record_at((double)ii) ;
+        if ( ii % 5 == 0 ) {
+            group.write_data(true) ;
+        }
+    }
+    group.write_data(true) ;
+    ASSERT_EQ( group.times.size() , 103u ) ;
+    for ( ii = 0 ; ii < 103 ; ii++ ) {
+        EXPECT_EQ( group.times[ii] , (double)(ii + 1) ) ;
+    }
+    EXPECT_EQ( group.num_torn , 0u ) ;
+    EXPECT_EQ( group.num_blocked , 0u ) ;
+    EXPECT_EQ( group.buffer_num , 103u ) ;
+    EXPECT_EQ( group.writer_num , 103u ) ;
+}
+
+TEST_F(DataRecordGroupTest , OverflowBlock) {
+    TestRecordGroup group("overflow_block") ;
+    unsigned int ii ;
+
+    group.set_max_buffer_size(10) ;
+    group.init() ;
+    /* Without a writer the recording job writes the full buffer itself and nothing is lost */
+    for ( ii = 1 ; ii <= 25 ; ii++ ) {
+        group.record_at((double)ii) ;
+    }
+    EXPECT_GT( group.num_blocked , 0u ) ;
+    group.write_data(true) ;
+    ASSERT_EQ( group.times.size() , 25u ) ;
+    for ( ii = 0 ; ii < 25 ; ii++ ) {
+        EXPECT_EQ( group.times[ii] , (double)(ii + 1) ) ;
+    }
+    EXPECT_EQ( group.num_dropped_oldest , 0u ) ;
+    EXPECT_EQ( group.num_dropped_newest , 0u ) ;
+}
+
+TEST_F(DataRecordGroupTest , OverflowDropOldest) {
+    TestRecordGroup group("overflow_drop_oldest") ;
+    unsigned int ii ;
+
+    group.set_max_buffer_size(10) ;
+    group.set_overflow_policy(DR_Overflow_Drop_Oldest) ;
+    group.init() ;
+    for ( ii = 1 ; ii <= 25 ; ii++ ) {
+        group.record_at((double)ii) ;
+    }
+    EXPECT_EQ( group.num_blocked , 0u ) ;
+    EXPECT_EQ( group.num_dropped_newest , 0u ) ;
+    group.write_data(true) ;
+    /* The newest records are kept */
+    ASSERT_EQ( group.times.size() + group.num_dropped_oldest , 25u ) ;
+    ASSERT_FALSE( group.times.empty() ) ;
+    EXPECT_EQ( group.times.back() , 25.0 ) ;
+    for ( ii = 0 ; ii < group.times.size() ; ii++ ) {
+        EXPECT_EQ( group.times[ii] , (double)(group.num_dropped_oldest + ii + 1) ) ;
+    }
+    EXPECT_EQ( group.num_torn , 0u ) ;
+}
+
+TEST_F(DataRecordGroupTest , OverflowDropNewest) {
+    TestRecordGroup group("overflow_drop_newest") ;
+    unsigned int ii ;
+
+    group.set_max_buffer_size(10) ;
+    group.set_overflow_policy(DR_Overflow_Drop_Newest) ;
+    group.init() ;
+    for ( ii = 1 ; ii <= 25 ; ii++ ) {
+        group.record_at((double)ii) ;
+    }
+    EXPECT_EQ( group.num_blocked , 0u ) ;
+    EXPECT_EQ( group.num_dropped_oldest , 0u ) ;
+    group.write_data(true) ;
+    /* The oldest records are kept */
+    ASSERT_EQ( group.times.size() + group.num_dropped_newest , 25u ) ;
+    for ( ii = 0 ; ii < group.times.size() ; ii++ ) {
+        EXPECT_EQ( group.times[ii] , (double)(ii + 1) ) ;
+    }
+    EXPECT_EQ( group.num_torn , 0u ) ;
+}
+
+TEST_F(DataRecordGroupTest , ClaimedRecordsAreNotOverwritten) {
+    TestRecordGroup group("claimed") ;
+    unsigned int ii ;
+    unsigned int first ;
+
+    group.set_max_buffer_size(10) ;
+    group.set_overflow_policy(DR_Overflow_Drop_Oldest) ;
+    group.init() ;
+    for ( ii = 1 ; ii <= 5 ; ii++ ) {
+        group.record_at((double)ii) ;
+    }
+
+    /* The writer claims the first two records and is slow writing them */
+    EXPECT_EQ( group.claim_records(2, first) , 2u ) ;
+    EXPECT_EQ( first , 0u ) ;
+    EXPECT_EQ( group.writer_claim , 2ULL ) ;
+    EXPECT_EQ( group.writer_num , 2u ) ;
+
+    /* Dropping the oldest records cannot drop the claimed records, and the slots of the claimed
+       records cannot be reused.  The records that would reuse them are dropped instead. */
+    for ( ii = 6 ; ii <= 12 ; ii++ ) {
+        group.record_at((double)ii) ;
+    }
+    EXPECT_EQ( group.num_dropped_newest , 2u ) ;
+    EXPECT_EQ( *(double *)(group.rec_buffer[0]->buffer) , 1.0 ) ;
+    EXPECT_EQ( *(double *)(group.rec_buffer[0]->buffer + group.rec_buffer[0]->stride) , 2.0 ) ;
+
+    /* Once the claim is released the slots are reused */
+    group.format_specific_write_records(first, 2) ;
+    group.release_records() ;
+    EXPECT_EQ( group.writer_claim , 0ULL ) ;
+    group.record_at(13.0) ;
+    EXPECT_EQ( group.num_dropped_newest , 2u ) ;
+    EXPECT_EQ( *(double *)(group.rec_buffer[0]->buffer) , 13.0 ) ;
+
+    /* The claim packs the first record number above the count */
+    EXPECT_GT( group.claim_records(1, first) , 0u ) ;
+    EXPECT_EQ( group.writer_claim , ((unsigned long long)first << 32) | 1ULL ) ;
+    group.release_records() ;
+}
+
+TEST_F(DataRecordGroupTest , WriterThreadBlock) {
+    TestRecordGroup group("writer_block") ;
+    group.set_max_buffer_size(64) ;
+    group.write_delay = 200 ;
+    group.init() ;
+    record_with_writer(group, 200000) ;
+    EXPECT_EQ( group.times.size() , 200000u ) ;
+}
+
+TEST_F(DataRecordGroupTest , WriterThreadDropOldest) {
+    TestRecordGroup group("writer_drop_oldest") ;
+    group.set_max_buffer_size(64) ;
+    group.set_overflow_policy(DR_Overflow_Drop_Oldest) ;
+    group.write_delay = 200 ;
+    group.init() ;
+    record_with_writer(group, 200000) ;
+    EXPECT_EQ( group.num_blocked , 0u ) ;
+    EXPECT_GT( group.num_dropped_oldest , 0u ) ;
+}
+
+TEST_F(DataRecordGroupTest , WriterThreadDropNewest) {
+    TestRecordGroup group("writer_drop_newest") ;
+    group.set_max_buffer_size(64) ;
+    group.set_overflow_policy(DR_Overflow_Drop_Newest) ;
+    group.write_delay = 200 ;
+    group.init() ;
+    record_with_writer(group, 200000) ;
+    EXPECT_EQ( group.num_blocked , 0u ) ;
+    EXPECT_EQ( group.num_dropped_oldest , 0u ) ;
+    EXPECT_GT( group.num_dropped_newest , 0u ) ;
+}
+
+}
@@ -0,0 +1,531 @@
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "trick/ConditionExpression.hh"
+#include "trick/memorymanager_c_intf.h"
+#include "trick/parameter_types.h"
+
+// ref_free() leaves the attributes made for a reference to a whole allocation.
+static void free_ref( REF2 * ref ) {
+    free(ref->ref_attr) ;
+    ref_free(ref) ;
+    free(ref) ;
+}
+
+Trick::ConditionExpression::ConditionExpression() : pointer_present(false) , cursor(NULL) {}
+
+Trick::ConditionExpression::~ConditionExpression() {
+    clear() ;
+}
+
+void Trick::ConditionExpression::clear() {
+    for ( size_t ii = 0 ; ii < variables.size() ; ii++ ) {
+        free_ref(variables[ii].ref) ;
+    }
+    variables.clear() ;
+    program.clear() ;
+    stack.clear() ;
+    address_paths.invalidate() ;
+    pointer_present = false ;
+}
+
+/**
+@details
+-# Discard the previous compilation.
+-# Parse the whole string.  Variables are bound as they are parsed; a name that is not a simulation
+   variable ends the compilation.
+-# Anything left over after the expression is a syntax error.
+-# Compile the address paths of the variables that have pointers in them and size the stack.
+*/
+int Trick::ConditionExpression::compile( const std::string & in_string ) {
+
+    clear() ;
+    cursor = in_string.c_str() ;
+    bool ok = parse_or() ;
+    skip_space() ;
+    ok = ok and *cursor == '\0' ;
+    cursor = NULL ;
+    if ( ! ok ) {
+        clear() ;
+        return 1 ;
+    }
+
+    std::vector< REF2 * > refs ;
+    for ( size_t ii = 0 ; ii < variables.size() ; ii++ ) {
+        refs.push_back(variables[ii].ref) ;
+        pointer_present |= (variables[ii].ref->pointer_present == 1) ;
+    }
+    address_paths.compile(refs) ;
+    stack.resize(stack_depth()) ;
+    return 0 ;
+}
+
+/**
+@details
+-# Read the pointer hops of the variables if any of them have pointers in their paths.
+-# Run the program on the stack.  A variable behind a NULL pointer or a division by zero stops the
+   evaluation with an error, as the same condition would raise an exception in python.
+-# The condition is the truth of the value left on the stack.
+*/
+int Trick::ConditionExpression::evaluate( int & cond_return_val ) {
+
+    if ( program.empty() ) {
+        return -1 ;
+    }
+    if ( pointer_present ) {
+        address_paths.resolve() ;
+    }
+
+    double * sp = &stack[0] ;    // next free slot
+    size_t pc = 0 ;
+    const size_t end = program.size() ;
+    while ( pc < end ) {
+        const Instruction & ins = program[pc++] ;
+        switch ( ins.op ) {
+            case OP_CONSTANT:
+                *sp++ = ins.value ;
+                break ;
+            case OP_VARIABLE: {
+                const Variable & var = variables[ins.index] ;
+                void * address = address_paths.is_compiled(ins.index, var.ref) ?
+                                  address_paths.get_address(ins.index) : var.ref->address ;
+                if ( address == NULL ) {
+                    return -1 ;
+                }
+                double value ;
+                switch ( var.type ) {
+                    case VALUE_INT8:   value = *(int8_t *)address ; break ;
+                    case VALUE_UINT8:  value = *(uint8_t *)address ; break ;
+                    case VALUE_INT16:  value = *(int16_t *)address ; break ;
+                    case VALUE_UINT16: value = *(uint16_t *)address ; break ;
+                    case VALUE_INT32:  value = *(int32_t *)address ; break ;
+                    case VALUE_UINT32: value = *(uint32_t *)address ; break ;
+                    case VALUE_INT64:  value = (double)*(int64_t *)address ; break ;
+                    case VALUE_UINT64: value = (double)*(uint64_t *)address ; break ;
+                    case VALUE_FLOAT:  value = *(float *)address ; break ;
+                    case VALUE_BOOL:   value = *(bool *)address ? 1.0 : 0.0 ; break ;
+                    default:           value = *(double *)address ; break ;
+                }
+                *sp++ = value ;
+                break ;
+            }
+            case OP_NEGATE:
+                sp[-1] = -sp[-1] ;
+                break ;
+            case OP_NOT:
+                sp[-1] = ( sp[-1] == 0.0 ) ? 1.0 : 0.0 ;
+                break ;
+            case OP_ADD:
+                sp-- ; sp[-1] += sp[0] ;
+                break ;
+            case OP_SUBTRACT:
+                sp-- ; sp[-1] -= sp[0] ;
+                break ;
+            case OP_MULTIPLY:
+                sp-- ; sp[-1] *= sp[0] ;
+                break ;
+            case OP_DIVIDE:
+                sp-- ;
+                if ( sp[0] == 0.0 ) {
+                    return -1 ;
+                }
+                sp[-1] /= sp[0] ;
+                break ;
+            case OP_LESS:
+                sp-- ; sp[-1] = ( sp[-1] < sp[0] ) ? 1.0 : 0.0 ;
+                break ;
+            case OP_LESS_EQUAL:
+                sp-- ; sp[-1] = ( sp[-1] <= sp[0] ) ? 1.0 : 0.0 ;
+                break ;
+            case OP_GREATER:
+                sp-- ; sp[-1] = ( sp[-1] > sp[0] ) ? 1.0 : 0.0 ;
+                break ;
+            case OP_GREATER_EQUAL:
+                sp-- ; sp[-1] = ( sp[-1] >= sp[0] ) ? 1.0 : 0.0 ;
+                break ;
+            case OP_EQUAL:
+                sp-- ; sp[-1] = ( sp[-1] == sp[0] ) ? 1.0 : 0.0 ;
+                break ;
+            case OP_NOT_EQUAL:
+                sp-- ; sp[-1] = ( sp[-1] != sp[0] ) ? 1.0 : 0.0 ;
+                break ;
+            case OP_JUMP_IF_FALSE_OR_POP:
+                if ( sp[-1] == 0.0 ) {
+                    pc = ins.index ;
+                } else {
+                    sp-- ;
+                }
+                break ;
+            case OP_JUMP_IF_TRUE_OR_POP:
+                if ( sp[-1] != 0.0 ) {
+                    pc = ins.index ;
+                } else {
+                    sp-- ;
+                }
+                break ;
+        }
+    }
+
+    cond_return_val = ( sp[-1] != 0.0 ) ;
+    return 0 ;
+}
+
+void Trick::ConditionExpression::skip_space() {
+    while ( isspace((unsigned char)*cursor) ) {
+        cursor++ ;
+    }
+}
+
+bool Trick::ConditionExpression::accept( const char * text ) {
+    skip_space() ;
+    size_t len = strlen(text) ;
+    if ( strncmp(cursor, text, len) == 0 ) {
+        cursor += len ;
+        return true ;
+    }
+    return false ;
+}
+
+bool Trick::ConditionExpression::accept_word( const char * word ) {
+    skip_space() ;
+    size_t len = strlen(word) ;
+    if ( strncmp(cursor, word, len) == 0 and ! isalnum((unsigned char)cursor[len]) and cursor[len] != '_' ) {
+        cursor += len ;
+        return true ;
+    }
+    return false ;
+}
+
+size_t Trick::ConditionExpression::emit( OpCode op , size_t index , double value ) {
+    Instruction ins ;
+    ins.op = op ;
+    ins.index = index ;
+    ins.value = value ;
+    program.push_back(ins) ;
+    return program.size() - 1 ;
+}
+
+// or_expr : and_expr ( ( "or" | "||" ) and_expr )*
+bool Trick::ConditionExpression::parse_or() {
+    if ( ! parse_and() ) {
+        return false ;
+    }
+    while ( accept_word("or") or accept("||") ) {
+        size_t jump = emit(OP_JUMP_IF_TRUE_OR_POP) ;
+        if ( ! parse_and() ) {
+            return false ;
+        }
+        program[jump].index = program.size() ;
+    }
+    return true ;
+}
+
+// and_expr : not_expr ( ( "and" | "&&" ) not_expr )*
+bool Trick::ConditionExpression::parse_and() {
+    if ( ! parse_not() ) {
+        return false ;
+    }
+    while ( accept_word("and") or accept("&&") ) {
+        size_t jump = emit(OP_JUMP_IF_FALSE_OR_POP) ;
+        if ( ! parse_not() ) {
+            return false ;
+        }
+        program[jump].index = program.size() ;
+    }
+    return true ;
+}
+
+// not_expr : "not" not_expr | comparison
+bool Trick::ConditionExpression::parse_not() {
+    if ( accept_word("not") ) {
+        if ( ! parse_not() ) {
+            return false ;
+        }
+        emit(OP_NOT) ;
+        return true ;
+    }
+    return parse_comparison() ;
+}
+
+// comparison : sum [ compare_op sum ].  Chained comparisons are left to python.
+bool Trick::ConditionExpression::parse_comparison() {
+    static const struct {
+        const char * text ;
+        OpCode op ;
+    } compare_ops[] = {
+        // two character operators first so "<=" is not taken as "<"
+        { "<=" , OP_LESS_EQUAL } , { ">=" , OP_GREATER_EQUAL } ,
+        { "==" , OP_EQUAL } , { "!=" , OP_NOT_EQUAL } ,
+        { "<" , OP_LESS } , { ">" , OP_GREATER }
+    } ;
+
+    if ( ! parse_sum() ) {
+        return false ;
+    }
+    for ( size_t ii = 0 ; ii < sizeof(compare_ops) / sizeof(compare_ops[0]) ; ii++ ) {
+        if ( accept(compare_ops[ii].text) ) {
+            if ( ! parse_sum() ) {
+                return false ;
+            }
+            emit(compare_ops[ii].op) ;
+            skip_space() ;
+            return ! ( cursor[0] == '<' or cursor[0] == '>' or cursor[0] == '=' or
+                       ( cursor[0] == '!' and cursor[1] == '=' ) ) ;
+        }
+    }
+    return true ;
+}
+
+// sum : product ( ( "+" | "-" ) product )*
+bool Trick::ConditionExpression::parse_sum() {
+    if ( ! parse_product() ) {
+        return false ;
+    }
+    while ( true ) {
+        OpCode op ;
+        if ( accept("+") ) {
+            op = OP_ADD ;
+        } else if ( accept("-") ) {
+            op = OP_SUBTRACT ;
+        } else {
+            return true ;
+        }
+        if ( ! parse_product() ) {
+            return false ;
+        }
+        emit(op) ;
+    }
+}
+
+// product : unary ( ( "*" | "/" ) unary )*.  "**" and "//" are left to python.
+bool Trick::ConditionExpression::parse_product() {
+    if ( ! parse_unary() ) {
+        return false ;
+    }
+    while ( true ) {
+        OpCode op ;
+        skip_space() ;
+        if ( ( cursor[0] == '*' or cursor[0] == '/' ) and cursor[1] == cursor[0] ) {
+            return false ;
+        }
+        if ( accept("*") ) {
+            op = OP_MULTIPLY ;
+        } else if ( accept("/") ) {
+            op = OP_DIVIDE ;
+        } else {
+            return true ;
+        }
+        if ( ! parse_unary() ) {
+            return false ;
+        }
+        emit(op) ;
+    }
+}
+
+// unary : ( "-" | "+" | "!" ) unary | primary
+bool Trick::ConditionExpression::parse_unary() {
+    skip_space() ;
+    if ( cursor[0] == '!' and cursor[1] != '=' ) {
+        cursor++ ;
+        if ( ! parse_unary() ) {
+            return false ;
+        }
+        emit(OP_NOT) ;
+        return true ;
+    }
+    if ( accept("-") ) {
+        if ( ! parse_unary() ) {
+            return false ;
+        }
+        emit(OP_NEGATE) ;
+        return true ;
+    }
+    if ( accept("+") ) {
+        return parse_unary() ;
+    }
+    return parse_primary() ;
+}
+
+// primary : number | "True" | "False" | variable | "(" or_expr ")"
+bool Trick::ConditionExpression::parse_primary() {
+    skip_space() ;
+    if ( accept("(") ) {
+        return parse_or() and accept(")") ;
+    }
+    if ( isdigit((unsigned char)cursor[0]) or ( cursor[0] == '.' and isdigit((unsigned char)cursor[1]) ) ) {
+        // Python integers with a base prefix or a leading zero are left to python.
+        if ( cursor[0] == '0' and ( isalnum((unsigned char)cursor[1]) or cursor[1] == '_' ) ) {
+            return false ;
+        }
+        char * end ;
+        double value = strtod(cursor, &end) ;
+        // A number run into a name, like 1j or 1_000, is left to python.
+        if ( isalpha((unsigned char)*end) or *end == '_' or *end == '.' ) {
+            return false ;
+        }
+        cursor = end ;
+        emit(OP_CONSTANT, 0, value) ;
+        return true ;
+    }
+    if ( accept_word("True") ) {
+        emit(OP_CONSTANT, 0, 1.0) ;
+        return true ;
+    }
+    if ( accept_word("False") ) {
+        emit(OP_CONSTANT, 0, 0.0) ;
+        return true ;
+    }
+
+    std::string name ;
+    size_t index ;
+    if ( ! parse_variable(name) or ! bind_variable(name, index) ) {
+        return false ;
+    }
+    emit(OP_VARIABLE, index) ;
+    return true ;
+}
+
+// variable : identifier ( "." identifier | "[" digits "]" )*
+bool Trick::ConditionExpression::parse_variable( std::string & name ) {
+    bool expect_identifier = true ;
+    while ( true ) {
+        if ( expect_identifier ) {
+            skip_space() ;
+            if ( ! isalpha((unsigned char)*cursor) and *cursor != '_' ) {
+                return false ;
+            }
+            const char * start = cursor ;
+            while ( isalnum((unsigned char)*cursor) or *cursor == '_' ) {
+                cursor++ ;
+            }
+            name.append(start, cursor - start) ;
+            expect_identifier = false ;
+        } else if ( accept(".") ) {
+            name += '.' ;
+            expect_identifier = true ;
+        } else if ( accept("[") ) {
+            skip_space() ;
+            const char * start = cursor ;
+            while ( isdigit((unsigned char)*cursor) ) {
+                cursor++ ;
+            }
+            if ( cursor == start ) {
+                return false ;
+            }
+            name += '[' ;
+            name.append(start, cursor - start) ;
+            name += ']' ;
+            if ( ! accept("]") ) {
+                return false ;
+            }
+        } else {
+            return true ;
+        }
+    }
+}
+
+/**
+@details
+-# Reuse the variable if the expression already reads it.
+-# Names whose first part is not a memory manager variable are python names.  They are not looked up with
+   ref_attributes(), which reports the names it does not find as errors.
+-# The reference must be a single element of a numeric type.  Characters are strings in python and are
+   not compiled.
+*/
+bool Trick::ConditionExpression::bind_variable( const std::string & name , size_t & index ) {
+
+    for ( index = 0 ; index < variables.size() ; index++ ) {
+        if ( variables[index].name == name ) {
+            return true ;
+        }
+    }
+
+    size_t top_end = name.find_first_of(".[") ;
+    if ( ! TMM_var_exists(name.substr(0, top_end).c_str()) ) {
+        return false ;
+    }
+    REF2 * ref = ref_attributes(name.c_str()) ;
+    if ( ref == NULL ) {
+        return false ;
+    }
+
+    Variable var ;
+    var.name = name ;
+    var.ref = ref ;
+    bool supported = ( ref->attr != NULL and ref->num_index == ref->attr->num_index ) ;
+    if ( supported ) {
+        int size = ref->attr->size ;
+        switch ( ref->attr->type ) {
+            case TRICK_SHORT:
+            case TRICK_INTEGER:
+            case TRICK_LONG:
+            case TRICK_LONG_LONG:
+            case TRICK_ENUMERATED:
+                var.type = ( size == 1 ) ? VALUE_INT8 : ( size == 2 ) ? VALUE_INT16 :
+                           ( size == 4 ) ? VALUE_INT32 : VALUE_INT64 ;
+                supported = ( size == 1 or size == 2 or size == 4 or size == 8 ) ;
+                break ;
+            case TRICK_UNSIGNED_SHORT:
+            case TRICK_UNSIGNED_INTEGER:
+            case TRICK_UNSIGNED_LONG:
+            case TRICK_UNSIGNED_LONG_LONG:
+                var.type = ( size == 1 ) ? VALUE_UINT8 : ( size == 2 ) ? VALUE_UINT16 :
+                           ( size == 4 ) ? VALUE_UINT32 : VALUE_UINT64 ;
+                supported = ( size == 1 or size == 2 or size == 4 or size == 8 ) ;
+                break ;
+            case TRICK_FLOAT:
+                var.type = VALUE_FLOAT ;
+                break ;
+            case TRICK_DOUBLE:
+                var.type = VALUE_DOUBLE ;
+                break ;
+            case TRICK_BOOLEAN:
+                var.type = VALUE_BOOL ;
+                supported = ( size == sizeof(bool) ) ;
+                break ;
+            default:
+                supported = false ;
+                break ;
+        }
+    }
+    if ( ! supported ) {
+        free_ref(ref) ;
+        return false ;
+    }
+
+    variables.push_back(var) ;
+    index = variables.size() - 1 ;
+    return true ;
+}
+
+/**
+@details
+-# Walk the program keeping the depth after each instruction.  A jump leaves the top on the stack at its
+   target, the same depth the skipped operand would have left, so the straight line walk is the maximum.
+*/
+size_t Trick::ConditionExpression::stack_depth() const {
+    size_t depth = 0 ;
+    size_t max_depth = 0 ;
+    for ( size_t ii = 0 ; ii < program.size() ; ii++ ) {
+        switch ( program[ii].op ) {
+            case OP_CONSTANT:
+            case OP_VARIABLE:
+                depth++ ;
+                break ;
+            case OP_NEGATE:
+            case OP_NOT:
+                break ;
+            default:
+                // binary operators, and the pop when a jump is not taken
+                depth-- ;
+                break ;
+        }
+        if ( depth > max_depth ) {
+            max_depth = depth ;
+        }
+    }
+    return max_depth ;
+}
@@ -0,0 +1,126 @@
+
+#include <gtest/gtest.h>
+#include "trick/MemoryManager.hh"
+#include "trick/ConditionExpression.hh"
+
+namespace Trick {
+
+class ConditionExpressionTest : public ::testing::Test {
+    protected:
+        Trick::MemoryManager * memmgr ;
+        double * dbl ;
+        int * ints ;
+        bool * flag ;
+        unsigned short * ushort ;
+        double ** dbl_p ;
+
+        ConditionExpressionTest() {
+            memmgr = new Trick::MemoryManager ;
+            dbl = (double *)memmgr->declare_var("double dbl") ;
+            ints = (int *)memmgr->declare_var("int ints[4]") ;
+            flag = (bool *)memmgr->declare_var("bool flag") ;
+            ushort = (unsigned short *)memmgr->declare_var("unsigned short ushort") ;
+            dbl_p = (double **)memmgr->declare_var("double * dbl_p") ;
+        }
+        ~ConditionExpressionTest() { delete memmgr ; }
+        void SetUp() {}
+        void TearDown() {}
+
+        // Compile and evaluate in_string, returning the condition or -1 on an error.
+        int eval( const char * in_string ) {
+            ConditionExpression expr ;
+            int ret = -1 ;
+            if ( expr.compile(in_string) != 0 or expr.evaluate(ret) != 0 ) {
+                return -1 ;
+            }
+            return ret ;
+        }
+} ;
+
+TEST_F(ConditionExpressionTest, Numbers) {
+    EXPECT_EQ(1, eval("1 + 2 * 3 == 7")) ;
+    EXPECT_EQ(1, eval("(1 + 2) * 3 == 9")) ;
+    EXPECT_EQ(1, eval("7 / 2 == 3.5")) ;
+    EXPECT_EQ(1, eval("-2.5e1 < -+24")) ;
+    EXPECT_EQ(0, eval("1 - 1")) ;
+    EXPECT_EQ(1, eval("True != False")) ;
+}
+
+TEST_F(ConditionExpressionTest, Variables) {
+    ConditionExpression expr ;
+    int ret = -1 ;
+
+    ASSERT_EQ(0, expr.compile("dbl > 3.0 && ints[2] == 0")) ;
+    EXPECT_EQ(2, (int)expr.num_variables()) ;
+
+    *dbl = 4.0 ;
+    ints[2] = 0 ;
+    EXPECT_EQ(0, expr.evaluate(ret)) ;
+    EXPECT_EQ(1, ret) ;
+
+    ints[2] = 5 ;
+    EXPECT_EQ(0, expr.evaluate(ret)) ;
+    EXPECT_EQ(0, ret) ;
+
+    *flag = true ;
+    *ushort = 65535 ;
+    EXPECT_EQ(1, eval("flag and ushort == 65535")) ;
+    EXPECT_EQ(1, eval("dbl * 2 == ints [ 2 ] + 3")) ;
+}
+
+TEST_F(ConditionExpressionTest, LogicalOperators) {
+    *dbl = 1.0 ;
+    *flag = true ;
+    // not binds looser than a comparison, ! binds tighter.
+    EXPECT_EQ(1, eval("not dbl > 3.0")) ;
+    EXPECT_EQ(0, eval("!dbl > 3.0 or not flag")) ;
+    EXPECT_EQ(1, eval("dbl > 3.0 or flag and dbl == 1")) ;
+    // and and or short circuit.
+    EXPECT_EQ(0, eval("0 and 1 / 0")) ;
+    EXPECT_EQ(1, eval("1 || 1 / 0")) ;
+}
+
+TEST_F(ConditionExpressionTest, PointerPath) {
+    ConditionExpression expr ;
+    int ret = -1 ;
+
+    double values[2] = { 0.0 , 1.0 } ;
+    double other_values[2] = { 0.0 , -1.0 } ;
+    *dbl_p = values ;
+    ASSERT_EQ(0, expr.compile("dbl_p[1] > 0")) ;
+    EXPECT_EQ(0, expr.evaluate(ret)) ;
+    EXPECT_EQ(1, ret) ;
+
+    // The pointer is followed each evaluation.
+    *dbl_p = other_values ;
+    EXPECT_EQ(0, expr.evaluate(ret)) ;
+    EXPECT_EQ(0, ret) ;
+
+    *dbl_p = NULL ;
+    EXPECT_EQ(-1, expr.evaluate(ret)) ;
+}
+
+TEST_F(ConditionExpressionTest, LeftToPython) {
+    ConditionExpression expr ;
+    EXPECT_EQ(1, expr.compile("trick.exec_get_sim_time() > 1.0")) ;
+    EXPECT_EQ(1, expr.compile("python_var > 0")) ;
+    EXPECT_EQ(1, expr.compile("0 < dbl < 1")) ;
+    EXPECT_EQ(1, expr.compile("dbl ** 2 > 1")) ;
+    EXPECT_EQ(1, expr.compile("ints > 0")) ;
+    EXPECT_EQ(1, expr.compile("dbl_p > 0")) ;
+    EXPECT_EQ(1, expr.compile("1_000 > 0")) ;
+    EXPECT_EQ(1, expr.compile("0x10 > 0")) ;
+    EXPECT_EQ(1, expr.compile("dbl >")) ;
+    EXPECT_EQ(1, expr.compile("")) ;
+    EXPECT_EQ(0, expr.num_variables()) ;
+
+    int ret = -1 ;
+    EXPECT_EQ(-1, expr.evaluate(ret)) ;
+}
+
+TEST_F(ConditionExpressionTest, DivisionByZero) {
+    *dbl = 0.0 ;
+    EXPECT_EQ(-1, eval("1 / dbl > 0")) ;
+}
+
+}
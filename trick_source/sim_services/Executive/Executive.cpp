@@ -43,6 +43,8 @@ Trick::Executive::Executive() {
     num_classes = 0 ;
     num_sim_objects = 0 ;
     rt_nap = true ;
+    indexed_job_queues = false ;
+    thread_completion_type = TC_SPIN ;
     scheduled_start_index = 1000 ;
     num_scheduled_job_classes = 0 ;
     signal_caused_term = false ;
@@ -207,6 +209,10 @@ bool Trick::Executive::get_rt_nap() {
     return(rt_nap) ;
 }
 
+bool Trick::Executive::get_indexed_job_queues() {
+    return(indexed_job_queues) ;
+}
+
 int Trick::Executive::get_scheduled_start_index() {
     return(scheduled_start_index) ;
 }
@@ -367,6 +373,31 @@ int Trick::Executive::set_rt_nap(bool on_off) {
     return(0) ;
 }
 
+int Trick::Executive::set_thread_completion_type(int type) {
+    switch ( type ) {
+        case TC_SPIN:
+        case TC_BARRIER:
+            thread_completion_type = (Trick::ThreadCompletionType)type ;
+            return(0) ;
+        default:
+            return(-1) ;
+    }
+}
+
+int Trick::Executive::set_thread_completion_spin_count(unsigned int spin_count) {
+    thread_completion_barrier.set_spin_count(spin_count) ;
+    return(0) ;
+}
+
+int Trick::Executive::set_indexed_job_queues(bool on_off) {
+    unsigned int ii ;
+    indexed_job_queues = on_off ;
+    for ( ii = 0 ; ii < threads.size() ; ii++ ) {
+        threads[ii]->job_queue.set_indexed(on_off) ;
+    }
+    return(0) ;
+}
+
 int Trick::Executive::set_software_frame(double in_frame) {
     software_frame = in_frame ;
     software_frame_tics = (long long)(software_frame * time_tic_value) ;
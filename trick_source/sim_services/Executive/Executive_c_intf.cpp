@@ -204,6 +204,18 @@ extern "C" unsigned int exec_get_process_id() {
     return -1 ;
 }
 
+/**
+ * @relates Trick::Executive
+ * @copydoc Trick::Executive::get_indexed_job_queues
+ * C wrapper for Trick::Executive::get_indexed_job_queues
+ */
+extern "C" int exec_get_indexed_job_queues() {
+    if ( the_exec != NULL ) {
+        return (int)the_exec->get_indexed_job_queues() ;
+    }
+    return -1 ;
+}
+
 /**
  * @relates Trick::Executive
  * @copydoc Trick::Executive::get_rt_nap
@@ -497,6 +509,42 @@ extern "C" int exec_set_freeze_frame(double in_frame) {
     return -1 ;
 }
 
+/**
+ * @relates Trick::Executive
+ * @copydoc Trick::Executive::set_indexed_job_queues
+ * C wrapper for Trick::Executive::set_indexed_job_queues
+ */
+extern "C" int exec_set_indexed_job_queues( int on_off ) {
+    if ( the_exec != NULL ) {
+        return the_exec->set_indexed_job_queues((bool)on_off) ;
+    }
+    return -1 ;
+}
+
+/**
+ * @relates Trick::Executive
+ * @copydoc Trick::Executive::set_thread_completion_type
+ * C wrapper for Trick::Executive::set_thread_completion_type
+ */
+extern "C" int exec_set_thread_completion_type( int type ) {
+    if ( the_exec != NULL ) {
+        return the_exec->set_thread_completion_type(type) ;
+    }
+    return -1 ;
+}
+
+/**
+ * @relates Trick::Executive
+ * @copydoc Trick::Executive::set_thread_completion_spin_count
+ * C wrapper for Trick::Executive::set_thread_completion_spin_count
+ */
+extern "C" int exec_set_thread_completion_spin_count( unsigned int spin_count ) {
+    if ( the_exec != NULL ) {
+        return the_exec->set_thread_completion_spin_count(spin_count) ;
+    }
+    return -1 ;
+}
+
 /**
  * @relates Trick::Executive
  * @copydoc Trick::Executive::set_rt_nap
@@ -902,6 +950,18 @@ extern "C" int exec_set_thread_rt_semaphores( unsigned int thread_id , int yes_n
     return -1 ;
 }
 
+/**
+ * @relates Trick::Executive
+ * @copydoc Trick::Executive::set_thread_parallel_jobs
+ * C wrapper for Trick::Executive::set_thread_parallel_jobs
+ */
+extern "C" int exec_set_thread_parallel_jobs(unsigned int thread_id , unsigned int num_workers) {
+    if ( the_exec != NULL ) {
+        return the_exec->set_thread_parallel_jobs(thread_id, num_workers) ;
+    }
+    return -1 ;
+}
+
 /**
  * @relates Trick::Executive
  * @copydoc Trick::Executive::set_thread_cpu_affinity
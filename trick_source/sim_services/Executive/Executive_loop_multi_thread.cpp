@@ -131,6 +131,10 @@ int Trick::Executive::loop_multi_thread() {
 
                 curr_thread->curr_time_tics = time_tics ;
                 curr_thread->child_complete = false ;
+                if ( thread_completion_type == TC_BARRIER and
+                     curr_thread->process_type == PROCESS_TYPE_SCHEDULED ) {
+                    curr_thread->arm_completion(&thread_completion_barrier) ;
+                }
                 curr_thread->amf_next_tics += curr_thread->amf_cycle_tics ;
                 curr_thread->trigger_container.getThreadTrigger()->fire() ;
 
@@ -139,29 +143,34 @@ int Trick::Executive::loop_multi_thread() {
 
         /* Get next job scheduled to run at the current simulation time step. */
         main_sched_queue->reset_curr_index() ;
-        while ( (curr_job = main_sched_queue->find_next_job( time_tics )) != NULL ) {
-
-            /* Wait for all jobs that the current job depends on to complete. */
-            for ( ii = 0 ; ii < curr_job->depends.size() ; ii++ ) {
-                depend_job = curr_job->depends[ii] ;
-                while (! depend_job->complete) {
-                    if (rt_nap == true) {
-                        RELEASE();
+        if ( threads[0]->job_pool.get_num_workers() > 0 ) {
+            /* Call independent jobs in parallel on the main thread's job pool. */
+            threads[0]->job_pool.call_scheduled_jobs(*main_sched_queue , time_tics , rt_nap) ;
+        } else {
+            while ( (curr_job = main_sched_queue->find_next_job( time_tics )) != NULL ) {
+
+                /* Wait for all jobs that the current job depends on to complete. */
+                for ( ii = 0 ; ii < curr_job->depends.size() ; ii++ ) {
+                    depend_job = curr_job->depends[ii] ;
+                    while (! depend_job->complete) {
+                        if (rt_nap == true) {
+                            RELEASE();
+                        }
                     }
                 }
-            }
 
-            /* Call the current job scheduled to run at the current simulation time step. */
-            ret = curr_job->call() ;
-            if ( ret != 0 ) {
-                exec_terminate_with_return(ret , curr_job->name.c_str() , 0 , "scheduled job did not return 0") ;
-            }
-            /* System jobs next call time are not set until after they run.
-               Test their next job call time after they have been called */
-            if ( curr_job->system_job_class ) {
-                main_sched_queue->test_next_job_call_time(curr_job , time_tics) ;
+                /* Call the current job scheduled to run at the current simulation time step. */
+                ret = curr_job->call() ;
+                if ( ret != 0 ) {
+                    exec_terminate_with_return(ret , curr_job->name.c_str() , 0 , "scheduled job did not return 0") ;
+                }
+                /* System jobs next call time are not set until after they run.
+                   Test their next job call time after they have been called */
+                if ( curr_job->system_job_class ) {
+                    main_sched_queue->test_next_job_call_time(curr_job , time_tics) ;
+                }
+                curr_job->complete = true ;
             }
-            curr_job->complete = true ;
         }
 
         /* Call Executive::exec_terminate_with_return(int , const char * , int , const char *)
@@ -66,16 +66,21 @@ int Trick::Executive::loop_single_thread() {
 
         /* Call all scheduled jobs that are scheduled to run at the current simulation time step. */
         main_sched_queue->reset_curr_index() ;
-        while ( (curr_job = main_sched_queue->find_next_job( time_tics )) != NULL ) {
-            //std::cout << "[33mtime = " << time_tics << " " << curr_job->name << " job next = " << curr_job->next_tics << "[00m" << std::endl ;
-            ret = curr_job->call() ;
-            if ( ret != 0 ) {
-                exec_terminate_with_return(ret , curr_job->name.c_str() , 0 , "scheduled job did not return 0") ;
-            }
-            /* System jobs next call time are not set until after they run.
-               Test their next job call time after they have been called */
-            if ( curr_job->system_job_class ) {
-                main_sched_queue->test_next_job_call_time(curr_job , time_tics) ;
+        if ( threads[0]->job_pool.get_num_workers() > 0 ) {
+            /* Call independent jobs in parallel on the main thread's job pool. */
+            threads[0]->job_pool.call_scheduled_jobs(*main_sched_queue , time_tics , rt_nap) ;
+        } else {
+            while ( (curr_job = main_sched_queue->find_next_job( time_tics )) != NULL ) {
+                //std::cout << "[33mtime = " << time_tics << " " << curr_job->name << " job next = " << curr_job->next_tics << "[00m" << std::endl ;
+                ret = curr_job->call() ;
+                if ( ret != 0 ) {
+                    exec_terminate_with_return(ret , curr_job->name.c_str() , 0 , "scheduled job did not return 0") ;
+                }
+                /* System jobs next call time are not set until after they run.
+                   Test their next job call time after they have been called */
+                if ( curr_job->system_job_class ) {
+                    main_sched_queue->test_next_job_call_time(curr_job , time_tics) ;
+                }
             }
         }
 
@@ -1,18 +1,38 @@
 
 #include <iostream>
+#include <time.h>
 
 #include "trick/Executive.hh"
 #include "trick/release.h"
 
 /**
 @design
--# Loop through all threads.
+-# If the thread completion type is TC_BARRIER
+   -# Wait once on the completion barrier for all scheduled threads started this frame
+   -# Add the time waited on each scheduled thread to the thread's sync wait counters
+-# Else loop through all threads.
    -# Wait for thread to finish if the thread is PROCESS_TYPE_SCHEDULED
 */
 int Trick::Executive::scheduled_thread_sync() {
 
     unsigned int ii ;
 
+    if ( thread_completion_type == TC_BARRIER ) {
+        struct timespec tp ;
+        clock_gettime(CLOCK_MONOTONIC, &tp) ;
+        long long wait_start_ns = tp.tv_sec * 1000000000LL + tp.tv_nsec ;
+
+        thread_completion_barrier.wait(rt_nap) ;
+
+        for (ii = 1; ii < threads.size() ; ii++) {
+            Threads * curr_thread = threads[ii] ;
+            if ( curr_thread->enabled and curr_thread->process_type == PROCESS_TYPE_SCHEDULED) {
+                curr_thread->record_sync_wait(wait_start_ns) ;
+            }
+        }
+        return 0 ;
+    }
+
     /* Wait for synchronous threads to finish before testing for adjusting time_tics */
     for (ii = 1; ii < threads.size() ; ii++) {
         Threads * curr_thread = threads[ii] ;
@@ -27,4 +47,3 @@ int Trick::Executive::scheduled_thread_sync() {
 
     return 0 ;
 }
-
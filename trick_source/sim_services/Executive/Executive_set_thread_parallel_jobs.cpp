@@ -0,0 +1,19 @@
+
+#include "trick/Executive.hh"
+
+int Trick::Executive::set_thread_parallel_jobs(unsigned int thread_id , unsigned int num_workers) {
+
+    int ret ;
+
+    /** @par Detailed Design */
+    if ( (thread_id +1) > threads.size() ) {
+        /** @li If the thread_id does not exist, return an error */
+        ret = -2 ;
+    } else {
+        /** @li Set the number of workers in the thread's job pool.  Fails if the pool is already running */
+        ret = threads[thread_id]->job_pool.set_num_workers(num_workers) ;
+    }
+
+    return(ret) ;
+
+}
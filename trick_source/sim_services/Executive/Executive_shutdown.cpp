@@ -29,6 +29,7 @@
 -# If an exception is caught during calling the shutdown jobs the exception is ignored as we are already terminating.
 -# The scheduler prints a simulation shutdown message
 -# The scheduler kills all child threads
+-# The scheduler stops the parallel job workers of all threads
 -# Return the exception_return value.  (Set to 0 if no exception thrown.)
 */
 int Trick::Executive::shutdown() {
@@ -116,6 +117,11 @@ int Trick::Executive::shutdown() {
 #endif
     }
 
+    /* Stop the parallel job workers of all threads. */
+    for (ii = 0; ii < threads.size() ; ii++) {
+        threads[ii]->job_pool.shutdown() ;
+    }
+
     /* Return the exception_return value.  This defaults to 0 if no exceptions were thrown. */
     return(except_return) ;
 
@@ -0,0 +1,388 @@
+
+#include <iostream>
+#include <sstream>
+
+#include "trick/JobPool.hh"
+#include "trick/exec_proto.h"
+#include "trick/release.h"
+
+Trick::JobPoolWorker::JobPoolWorker( Trick::JobPool * in_pool , unsigned int in_participant , std::string in_name ) :
+ Trick::ThreadBase(in_name) ,
+ pool(in_pool) ,
+ participant(in_participant) {}
+
+void * Trick::JobPoolWorker::thread_body() {
+    pool->worker_loop(participant) ;
+    return NULL ;
+}
+
+Trick::JobPool::JobPool() :
+ num_levels(0) ,
+ num_parallel_levels(0) ,
+ num_steals(0) ,
+ num_workers(0) ,
+ spin_count(10000) ,
+ level_rt_nap(false) ,
+ generation(0) ,
+ stopping(false) ,
+ failure_index(-1) {
+    pthread_mutex_init(&go_mutex, NULL) ;
+    pthread_cond_init(&go_cv, NULL) ;
+    pthread_mutex_init(&failure_mutex, NULL) ;
+}
+
+Trick::JobPool::~JobPool() {
+    shutdown() ;
+    pthread_mutex_destroy(&go_mutex) ;
+    pthread_cond_destroy(&go_cv) ;
+    pthread_mutex_destroy(&failure_mutex) ;
+}
+
+int Trick::JobPool::set_num_workers( unsigned int in_num_workers ) {
+    if ( ! workers.empty() ) {
+        return -1 ;
+    }
+    num_workers = in_num_workers ;
+    return 0 ;
+}
+
+unsigned int Trick::JobPool::get_num_workers() {
+    return num_workers ;
+}
+
+int Trick::JobPool::set_spin_count( unsigned int in_spin_count ) {
+    spin_count = in_spin_count ;
+    level_barrier.set_spin_count(in_spin_count) ;
+    return 0 ;
+}
+
+/**
+@design
+-# Create a task deque for the calling thread and each worker
+-# Create and start the worker threads.  Workers inherit nothing from the calling thread;
+   they run with the default priority and CPU affinity.
+*/
+int Trick::JobPool::start_workers() {
+
+    unsigned int ii ;
+
+    for ( ii = 0 ; ii <= num_workers ; ii++ ) {
+        TaskDeque * deque = new TaskDeque ;
+        pthread_mutex_init(&deque->mutex, NULL) ;
+        deque->head = deque->tail = 0 ;
+        deques.push_back(deque) ;
+    }
+    stopping = false ;
+    for ( ii = 1 ; ii <= num_workers ; ii++ ) {
+        std::ostringstream oss ;
+        oss << "JobPool_" << ii ;
+        Trick::JobPoolWorker * worker = new Trick::JobPoolWorker(this, ii, oss.str()) ;
+        workers.push_back(worker) ;
+        worker->create_thread() ;
+    }
+    return 0 ;
+}
+
+/**
+@design
+-# Set the stopping flag and wake all sleeping workers
+-# Join and delete the workers and their deques
+*/
+int Trick::JobPool::shutdown() {
+
+    unsigned int ii ;
+
+    if ( workers.empty() ) {
+        return 0 ;
+    }
+
+    pthread_mutex_lock(&go_mutex) ;
+    stopping = true ;
+    __sync_add_and_fetch(&generation, 1) ;
+    pthread_cond_broadcast(&go_cv) ;
+    pthread_mutex_unlock(&go_mutex) ;
+
+    for ( ii = 0 ; ii < workers.size() ; ii++ ) {
+        workers[ii]->join_thread() ;
+        delete workers[ii] ;
+    }
+    workers.clear() ;
+
+    for ( ii = 0 ; ii < deques.size() ; ii++ ) {
+        pthread_mutex_destroy(&deques[ii]->mutex) ;
+        delete deques[ii] ;
+    }
+    deques.clear() ;
+
+    return 0 ;
+}
+
+/**
+@design
+-# Wait for the generation to change.  Spin spin_count times, then sleep on the go condition variable.
+-# Exit if the pool is stopping
+-# Call and steal chains until the level is empty
+*/
+void Trick::JobPool::worker_loop( unsigned int participant ) {
+
+    unsigned int seen = generation ;
+    unsigned int spins ;
+
+    while (1) {
+        spins = 0 ;
+        while ( generation == seen and spins < spin_count ) {
+            spins++ ;
+        }
+        if ( generation == seen ) {
+            pthread_mutex_lock(&go_mutex) ;
+            /* A worker that starts after shutdown() has nothing to wait for */
+            while ( generation == seen and ! stopping ) {
+                pthread_cond_wait(&go_cv, &go_mutex) ;
+            }
+            pthread_mutex_unlock(&go_mutex) ;
+        }
+        __sync_synchronize() ;
+        seen = generation ;
+        if ( stopping ) {
+            break ;
+        }
+        run_tasks(participant) ;
+    }
+}
+
+/**
+@design
+-# Take a chain from the tail of this participant's deque
+-# If the deque is empty, steal a chain from the head of the other deques, starting with the next participant
+-# Return false if every deque is empty
+*/
+bool Trick::JobPool::take_task( unsigned int participant , unsigned int & chain ) {
+
+    unsigned int ii ;
+    TaskDeque * deque = deques[participant] ;
+    bool found = false ;
+
+    pthread_mutex_lock(&deque->mutex) ;
+    if ( deque->head < deque->tail ) {
+        chain = deque->tasks[--deque->tail] ;
+        found = true ;
+    }
+    pthread_mutex_unlock(&deque->mutex) ;
+
+    for ( ii = 1 ; ii < deques.size() and ! found ; ii++ ) {
+        deque = deques[(participant + ii) % deques.size()] ;
+        pthread_mutex_lock(&deque->mutex) ;
+        if ( deque->head < deque->tail ) {
+            chain = deque->tasks[deque->head++] ;
+            found = true ;
+            __sync_add_and_fetch(&num_steals, 1) ;
+        }
+        pthread_mutex_unlock(&deque->mutex) ;
+    }
+    return found ;
+}
+
+void Trick::JobPool::run_tasks( unsigned int participant ) {
+    unsigned int chain ;
+    while ( take_task(participant, chain) ) {
+        call_chain(chain) ;
+        level_barrier.arrive() ;
+    }
+}
+
+/**
+@design
+-# Wait for all jobs the current job depends on to complete.  Requirement  [@ref r_exec_thread_6]
+   The levels are built so these jobs were called in an earlier level, earlier in the job's own chain,
+   or on another thread.
+*/
+void Trick::JobPool::wait_for_depends( Trick::JobData * job , bool rt_nap ) {
+    unsigned int ii ;
+    for ( ii = 0 ; ii < job->depends.size() ; ii++ ) {
+        Trick::JobData * depend_job = job->depends[ii] ;
+        while (! depend_job->complete) {
+            if (rt_nap == true) {
+                RELEASE();
+            }
+        }
+    }
+}
+
+/**
+@design
+-# Call the job.  Requirement  [@ref r_exec_periodic_0]
+-# If the job returns an error, terminates the sim, or throws any other exception, save the exception
+   if the job is ahead of any other failed job in queue order.  The calling thread rethrows it after
+   the level completes.
+-# Set the job complete flag
+-# Return false if the job failed
+*/
+bool Trick::JobPool::call_job( Trick::JobData * job , unsigned int job_index ) {
+    bool ok = true ;
+    try {
+        int ret = job->call() ;
+        if ( ret != 0 ) {
+            exec_terminate_with_return(ret , job->name.c_str() , 0 , "scheduled job did not return 0") ;
+        }
+    } catch (...) {
+        /* Exceptions cannot leave a worker thread, carry them to the calling thread. */
+        pthread_mutex_lock(&failure_mutex) ;
+        if ( failure_index < 0 or (int)job_index < failure_index ) {
+            failure_index = job_index ;
+            failure = std::current_exception() ;
+        }
+        pthread_mutex_unlock(&failure_mutex) ;
+        ok = false ;
+    }
+    job->complete = true ;
+    return ok ;
+}
+
+void Trick::JobPool::call_chain( unsigned int chain ) {
+    unsigned int ii ;
+    for ( ii = chain_start[chain] ; ii < chain_start[chain + 1] ; ii++ ) {
+        wait_for_depends(level_jobs[ii], level_rt_nap) ;
+        /* Like the serial scheduler, stop calling this sim object's jobs after one fails. */
+        if ( ! call_job(level_jobs[ii], ii) ) {
+            break ;
+        }
+    }
+}
+
+/**
+@design
+-# If the level has one chain, call it on the calling thread
+-# Else deal the chains round robin to the deques, arm the level barrier once per chain,
+   and wake the workers
+   -# The calling thread calls and steals chains with the workers
+   -# Wait on the level barrier until every chain has been called
+-# If a job failed, rethrow its exception on the calling thread
+*/
+void Trick::JobPool::call_level( bool rt_nap ) {
+
+    unsigned int ii ;
+    unsigned int num_chains = chain_start.size() - 1 ;
+
+    num_levels++ ;
+    level_rt_nap = rt_nap ;
+    failure_index = -1 ;
+    failure = std::exception_ptr() ;
+
+    if ( num_chains == 1 ) {
+        call_chain(0) ;
+    } else {
+        num_parallel_levels++ ;
+        for ( ii = 0 ; ii < num_chains ; ii++ ) {
+            level_barrier.arm() ;
+        }
+        /* A worker still leaving the previous level may look at the deques, so fill them under their locks. */
+        for ( ii = 0 ; ii < deques.size() ; ii++ ) {
+            unsigned int jj ;
+            TaskDeque * deque = deques[ii] ;
+            pthread_mutex_lock(&deque->mutex) ;
+            deque->tasks.clear() ;
+            for ( jj = ii ; jj < num_chains ; jj += deques.size() ) {
+                deque->tasks.push_back(jj) ;
+            }
+            deque->head = 0 ;
+            deque->tail = deque->tasks.size() ;
+            pthread_mutex_unlock(&deque->mutex) ;
+        }
+
+        pthread_mutex_lock(&go_mutex) ;
+        __sync_add_and_fetch(&generation, 1) ;
+        pthread_cond_broadcast(&go_cv) ;
+        pthread_mutex_unlock(&go_mutex) ;
+
+        run_tasks(0) ;
+        level_barrier.wait(rt_nap) ;
+    }
+
+    if ( failure_index >= 0 ) {
+        std::rethrow_exception(failure) ;
+    }
+}
+
+/**
+@design
+-# Return true if the job depends on one of the first num_jobs jobs of the level being gathered
+*/
+bool Trick::JobPool::depends_on_level( Trick::JobData * job , unsigned int num_jobs ) {
+    unsigned int ii , jj ;
+    for ( ii = 0 ; ii < job->depends.size() ; ii++ ) {
+        for ( jj = 0 ; jj < num_jobs ; jj++ ) {
+            if ( job->depends[ii] == level_jobs[jj] ) {
+                return true ;
+            }
+        }
+    }
+    return false ;
+}
+
+/**
+@design
+-# Start the workers if they are not running
+-# For each scheduled job whose next call time is equal to the current simulation time [@ref ScheduledJobQueue]
+    -# If the job is a system job or is instrumented, call it serially.  If the job is a system job,
+       check to see if the next job call time is the lowest next time by calling
+       Trick::ScheduledJobQueue::test_next_job_call_time(Trick::JobData *, long long)
+    -# Else gather the following jobs with the same job class and phase into a level.
+       Start a new chain whenever the sim object changes.  Stop gathering at a job that depends on
+       a job in another chain of the level, the chains run in any order and a worker waiting on a
+       chain no one has taken would deadlock.  That job starts the next level.  Call the level.
+*/
+int Trick::JobPool::call_scheduled_jobs( Trick::ScheduledJobQueue & queue , long long time_tics , bool rt_nap ) {
+
+    Trick::JobData * curr_job ;
+    bool new_chain ;
+
+    if ( workers.empty() and num_workers > 0 ) {
+        start_workers() ;
+    }
+
+    curr_job = queue.find_next_job( time_tics ) ;
+    while ( curr_job != NULL ) {
+
+        if ( curr_job->system_job_class or ! curr_job->inst_before.empty() or ! curr_job->inst_after.empty() ) {
+            level_jobs.clear() ;
+            level_jobs.push_back(curr_job) ;
+            chain_start.clear() ;
+            chain_start.push_back(0) ;
+            chain_start.push_back(1) ;
+            call_level(rt_nap) ;
+            if ( curr_job->system_job_class ) {
+                queue.test_next_job_call_time(curr_job , time_tics) ;
+            }
+            curr_job = queue.find_next_job( time_tics ) ;
+            continue ;
+        }
+
+        level_jobs.clear() ;
+        chain_start.clear() ;
+        chain_start.push_back(0) ;
+        level_jobs.push_back(curr_job) ;
+        while ( (curr_job = queue.find_next_job( time_tics )) != NULL and
+                curr_job->job_class == level_jobs[0]->job_class and
+                curr_job->phase == level_jobs[0]->phase and
+                ! curr_job->system_job_class and
+                curr_job->inst_before.empty() and curr_job->inst_after.empty() ) {
+            new_chain = ( curr_job->sim_object_id != level_jobs.back()->sim_object_id ) ;
+            if ( depends_on_level(curr_job , new_chain ? level_jobs.size() : chain_start.back()) ) {
+                break ;
+            }
+            if ( new_chain ) {
+                chain_start.push_back(level_jobs.size()) ;
+            }
+            level_jobs.push_back(curr_job) ;
+        }
+        chain_start.push_back(level_jobs.size()) ;
+        call_level(rt_nap) ;
+    }
+
+    return 0 ;
+}
+
+void Trick::JobPool::dump( std::ostream & oss ) {
+    oss << "    job pool workers = " << num_workers << " levels = " << num_levels
+        << " parallel levels = " << num_parallel_levels << " steals = " << num_steals << std::endl ;
+}
@@ -109,6 +109,77 @@ void Trick::ThreadTriggerFutex::dump(std::ostream & oss) {
 
 #endif
 
+/* ThreadCompletionBarrier */
+#if __linux
+#include <linux/futex.h>
+#include <syscall.h>
+#include <unistd.h>
+#endif
+#include "trick/release.h"
+
+Trick::ThreadCompletionBarrier::ThreadCompletionBarrier() :
+ spin_count(10000) ,
+ num_waits(0) ,
+ num_blocks(0) ,
+ pending(0) ,
+ sleeping(0) {}
+
+/* Called by the master before firing a child that the master will wait for. */
+void Trick::ThreadCompletionBarrier::arm() {
+    __sync_fetch_and_add(&pending, 1) ;
+}
+
+/* Called by a child when it completes its frame.  The last child wakes the master. */
+void Trick::ThreadCompletionBarrier::arrive() {
+    if ( __sync_sub_and_fetch(&pending, 1) == 0 and sleeping ) {
+#if __linux
+        syscall(SYS_futex, &pending, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+    }
+}
+
+/* Called by the master.  Spin for spin_count tests, then sleep until all armed children arrive.
+   The futex only sleeps if pending still holds the value read, so a child arriving between
+   the test and the sleep cannot be missed.  rt_nap is only used where there is no futex to
+   sleep on. */
+void Trick::ThreadCompletionBarrier::wait( bool rt_nap __attribute__((unused)) ) {
+    unsigned int spins = 0 ;
+    num_waits++ ;
+    while ( pending != 0 ) {
+        if ( spins < spin_count ) {
+            spins++ ;
+            continue ;
+        }
+#if __linux
+        int value = pending ;
+        if ( value == 0 ) {
+            break ;
+        }
+        sleeping = 1 ;
+        __sync_synchronize() ;
+        if ( pending == value ) {
+            num_blocks++ ;
+            syscall(SYS_futex, &pending, FUTEX_WAIT, value, NULL, NULL, 0);
+        }
+        sleeping = 0 ;
+#else
+        if ( rt_nap == true ) {
+            RELEASE() ;
+        }
+#endif
+    }
+    __sync_synchronize() ;
+}
+
+void Trick::ThreadCompletionBarrier::set_spin_count( unsigned int in_spin_count ) {
+    spin_count = in_spin_count ;
+}
+
+void Trick::ThreadCompletionBarrier::dump(std::ostream & oss) {
+    oss << "    completion barrier spin_count = " << spin_count << " waits = " << num_waits
+        << " blocks = " << num_blocks << std::endl ;
+}
+
 /* ThreadTriggerContainer */
 Trick::ThreadTriggerContainer::ThreadTriggerContainer() : ttBase(&ttMutex) {}
 
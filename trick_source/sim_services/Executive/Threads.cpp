@@ -17,7 +17,13 @@ Trick::Threads::Threads(int in_id , bool in_rt_nap) :
  process_type(PROCESS_TYPE_SCHEDULED) ,
  child_complete(false) ,
  running(false) ,
- shutdown_wait_async(false) {
+ shutdown_wait_async(false) ,
+ sync_wait_time(0.0) ,
+ sync_wait_max(0.0) ,
+ sync_wait_count(0) ,
+ completion_barrier(NULL) ,
+ complete_ns(0) ,
+ completion_armed(false) {
     std::stringstream oss ;
     oss << "Child_" << in_id ;
     name = oss.str() ;
@@ -37,6 +43,23 @@ void Trick::Threads::clear_scheduled_queues() {
     end_of_frame_queue.clear() ;
 }
 
+void Trick::Threads::arm_completion( Trick::ThreadCompletionBarrier * barrier ) {
+    completion_barrier = barrier ;
+    completion_armed = true ;
+    barrier->arm() ;
+}
+
+void Trick::Threads::record_sync_wait( long long wait_start_ns ) {
+    if ( complete_ns > wait_start_ns ) {
+        double wait_time = (complete_ns - wait_start_ns) / 1.0e9 ;
+        sync_wait_time += wait_time ;
+        sync_wait_count++ ;
+        if ( wait_time > sync_wait_max ) {
+            sync_wait_max = wait_time ;
+        }
+    }
+}
+
 void Trick::Threads::dump( std::ostream & oss ) {
     oss << "Trick::Threads (" << name << ")" << std::endl ;
     oss << "    process_type = " ;
@@ -47,5 +70,12 @@ void Trick::Threads::dump( std::ostream & oss ) {
     }
     trigger_container.getThreadTrigger()->dump(oss) ;
     oss << "    number of scheduled jobs = " << job_queue.size() << std::endl ;
+    if ( job_pool.get_num_workers() > 0 ) {
+        job_pool.dump(oss) ;
+    }
+    if ( sync_wait_count > 0 ) {
+        oss << "    master sync wait total = " << sync_wait_time << " max = " << sync_wait_max
+            << " count = " << sync_wait_count << std::endl ;
+    }
     Trick::ThreadBase::dump(oss) ;
 }
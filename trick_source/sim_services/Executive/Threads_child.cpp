@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <signal.h>
+#include <time.h>
 #include <sys/syscall.h>
 
 #ifdef __linux
@@ -114,8 +115,13 @@ void * Trick::Threads::thread_body() {
                     /* Loop through all jobs currently scheduled to run at this simulation time step. */
                     job_queue.reset_curr_index() ;
                     job_queue.set_next_job_call_time(TRICK_MAX_LONG_LONG) ;
-                    while ( (curr_job = job_queue.find_next_job( curr_time_tics )) != NULL ) {
-                        call_next_job(curr_job, job_queue, rt_nap, curr_time_tics) ;
+                    if ( job_pool.get_num_workers() > 0 ) {
+                        /* Call independent jobs in parallel on this thread's job pool. */
+                        job_pool.call_scheduled_jobs(job_queue, curr_time_tics, rt_nap) ;
+                    } else {
+                        while ( (curr_job = job_queue.find_next_job( curr_time_tics )) != NULL ) {
+                            call_next_job(curr_job, job_queue, rt_nap, curr_time_tics) ;
+                        }
                     }
                     break ;
 
@@ -209,8 +215,18 @@ void * Trick::Threads::thread_body() {
                 }
             }
 
-            /* After all jobs have completed, set the child_complete flag to true. */
-            child_complete = true;
+            /* After all jobs have completed, set the child_complete flag to true.  If the master
+               is waiting on the completion barrier for this thread, arrive at the barrier. */
+            if ( completion_armed ) {
+                struct timespec tp ;
+                clock_gettime(CLOCK_MONOTONIC, &tp) ;
+                complete_ns = tp.tv_sec * 1000000000LL + tp.tv_nsec ;
+                completion_armed = false ;
+                child_complete = true;
+                completion_barrier->arrive() ;
+            } else {
+                child_complete = true;
+            }
 
         } while (1);
     } catch (Trick::ExecutiveException & ex ) {
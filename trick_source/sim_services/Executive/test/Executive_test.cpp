@@ -1,7 +1,10 @@
 
 #include <iostream>
+#include <stdexcept>
 #include <sys/types.h>
 #include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "gtest/gtest.h"
 
 #define protected public
@@ -16,6 +19,8 @@
 #include "trick/memorymanager_c_intf.h"
 #include "trick/CommandLineArguments.hh"
 #include "trick/GetTimeOfDayClock.hh"
+#include "trick/JobPool.hh"
+#include "trick/TrickConstant.hh"
 
 void sig_hand(int sig) ;
 void ctrl_c_hand(int sig) ;
@@ -124,6 +129,10 @@ class testSimObject : public Trick::SimObject {
             return exec_terminate_with_return(-1, "throw_exception", 1 , "exec_terminate called") ;
         }
 
+        int throw_std_exception() {
+            throw std::runtime_error("throw_std_exception") ;
+        }
+
         testSimObject() :
          default_data_ran(0) ,
          input_processor_ran(0) ,
@@ -210,6 +219,9 @@ int testSimObject::call_function( Trick::JobData * curr_job ) {
         case 102:
             trick_ret = throw_exception() ;
             break ;
+        case 103:
+            trick_ret = throw_std_exception() ;
+            break ;
         default:
             trick_ret = -1 ;
             break ;
@@ -932,6 +944,167 @@ TEST_F(ExecutiveTest , SetThreadParameters) {
     EXPECT_EQ( exec.set_thread_priority(0 , 1) , 0 ) ;
     EXPECT_EQ( exec.set_thread_priority(1 , 2) , 0 ) ;
     EXPECT_EQ( exec.set_thread_priority(2 , 1) , -2 ) ;
+
+    EXPECT_EQ( exec.set_thread_parallel_jobs(0 , 2) , 0 ) ;
+    EXPECT_EQ( exec.set_thread_parallel_jobs(1 , 2) , 0 ) ;
+    EXPECT_EQ( exec.set_thread_parallel_jobs(2 , 2) , -2 ) ;
+}
+
+TEST_F(ExecutiveTest , ParallelJobs) {
+    testSimObject so2 ;
+    Trick::ScheduledJobQueue queue ;
+    Trick::JobPool pool ;
+    Trick::JobData * jobs[5] ;
+    Trick::JobData * curr_job ;
+    long long ii ;
+
+    /* Two sim objects with two scheduled jobs each, and one later job class */
+    jobs[0] = so1.add_job(0, 4, "scheduled", NULL, 1, "scheduled_1", "TRK") ;
+    jobs[1] = so1.add_job(0, 5, "scheduled", NULL, 1, "scheduled_1", "TRK") ;
+    jobs[2] = so2.add_job(0, 6, "scheduled", NULL, 1, "scheduled_1", "TRK") ;
+    jobs[3] = so2.add_job(0, 7, "scheduled", NULL, 1, "scheduled_1", "TRK") ;
+    jobs[4] = so2.add_job(0, 8, "effector", NULL, 1, "scheduled_1", "TRK") ;
+    for ( ii = 0 ; ii < 5 ; ii++ ) {
+        curr_job = jobs[ii] ;
+        curr_job->parent_object = ( ii < 2 ) ? (Trick::SimObject *)&so1 : (Trick::SimObject *)&so2 ;
+        curr_job->sim_object_id = ( ii < 2 ) ? 1 : 2 ;
+        curr_job->job_class = ( ii < 4 ) ? 1000 : 1001 ;
+        curr_job->cycle_tics = 1 ;
+        curr_job->next_tics = 0 ;
+        curr_job->stop_tics = TRICK_MAX_LONG_LONG ;
+        queue.push(curr_job) ;
+    }
+
+    EXPECT_EQ( pool.set_num_workers(2) , 0 ) ;
+    for ( ii = 0 ; ii < 100 ; ii++ ) {
+        queue.reset_curr_index() ;
+        pool.call_scheduled_jobs(queue , ii , false) ;
+    }
+    EXPECT_EQ( pool.set_num_workers(1) , -1 ) ;
+    EXPECT_EQ( so1.scheduled_ran , 200 ) ;
+    EXPECT_EQ( so2.scheduled_ran , 300 ) ;
+    EXPECT_EQ( pool.num_levels , 200 ) ;
+    EXPECT_EQ( pool.num_parallel_levels , 100 ) ;
+    pool.shutdown() ;
+}
+
+TEST_F(ExecutiveTest , ParallelJobsCrossChainDepends) {
+    testSimObject so2 , so3 , so4 ;
+    testSimObject * objects[4] = { &so1 , &so2 , &so3 , &so4 } ;
+    Trick::ScheduledJobQueue queue ;
+    Trick::JobPool pool ;
+    Trick::JobData * jobs[4] ;
+    long long ii ;
+    int jj ;
+
+    /* Four sim objects of the same class and phase.  The third depends on the first and the fourth on
+       the second.  One worker means more chains than participants, the caller and the worker would
+       each wait on a chain the other has not taken if the level was not split. */
+    for ( jj = 0 ; jj < 4 ; jj++ ) {
+        jobs[jj] = objects[jj]->add_job(0, 4, "scheduled", NULL, 1, "scheduled_1", "TRK") ;
+        jobs[jj]->parent_object = objects[jj] ;
+        jobs[jj]->sim_object_id = jj + 1 ;
+        jobs[jj]->job_class = 1000 ;
+        jobs[jj]->cycle_tics = 1 ;
+        jobs[jj]->next_tics = 0 ;
+        jobs[jj]->stop_tics = TRICK_MAX_LONG_LONG ;
+        queue.push(jobs[jj]) ;
+    }
+    jobs[2]->depends.push_back(jobs[0]) ;
+    jobs[3]->depends.push_back(jobs[1]) ;
+
+    EXPECT_EQ( pool.set_num_workers(1) , 0 ) ;
+    for ( ii = 0 ; ii < 100 ; ii++ ) {
+        /* The threads clear the complete flags at the start of each frame */
+        for ( jj = 0 ; jj < 4 ; jj++ ) {
+            jobs[jj]->complete = false ;
+        }
+        queue.reset_curr_index() ;
+        pool.call_scheduled_jobs(queue , ii , false) ;
+    }
+    for ( jj = 0 ; jj < 4 ; jj++ ) {
+        EXPECT_EQ( objects[jj]->scheduled_ran , 100 ) ;
+    }
+    /* The dependent jobs start a second level each frame */
+    EXPECT_EQ( pool.num_levels , 200 ) ;
+    EXPECT_EQ( pool.num_parallel_levels , 200 ) ;
+    pool.shutdown() ;
+}
+
+TEST_F(ExecutiveTest , ParallelJobsRethrowException) {
+    testSimObject so2 ;
+    Trick::ScheduledJobQueue queue ;
+    Trick::JobPool pool ;
+    Trick::JobData * jobs[2] ;
+    int jj ;
+
+    /* The second sim object's job throws an exception that is not a Trick::ExecutiveException */
+    jobs[0] = so1.add_job(0, 4, "scheduled", NULL, 1, "scheduled_1", "TRK") ;
+    jobs[1] = so2.add_job(0, 103, "scheduled", NULL, 1, "throw_std_exception", "TRK") ;
+    for ( jj = 0 ; jj < 2 ; jj++ ) {
+        jobs[jj]->parent_object = ( jj == 0 ) ? (Trick::SimObject *)&so1 : (Trick::SimObject *)&so2 ;
+        jobs[jj]->sim_object_id = jj + 1 ;
+        jobs[jj]->job_class = 1000 ;
+        jobs[jj]->cycle_tics = 1 ;
+        jobs[jj]->next_tics = 0 ;
+        jobs[jj]->stop_tics = TRICK_MAX_LONG_LONG ;
+        queue.push(jobs[jj]) ;
+    }
+
+    EXPECT_EQ( pool.set_num_workers(1) , 0 ) ;
+    queue.reset_curr_index() ;
+    EXPECT_THROW( pool.call_scheduled_jobs(queue , 0 , false) , std::runtime_error ) ;
+    EXPECT_EQ( so1.scheduled_ran , 1 ) ;
+    EXPECT_TRUE( jobs[1]->complete ) ;
+    pool.shutdown() ;
+}
+
+static void * barrier_child( void * arg ) {
+    Trick::ThreadCompletionBarrier * barrier = (Trick::ThreadCompletionBarrier *)arg ;
+    usleep(10000) ;
+    barrier->arrive() ;
+    return NULL ;
+}
+
+TEST_F(ExecutiveTest , CompletionBarrier) {
+    Trick::ThreadCompletionBarrier barrier ;
+    pthread_t children[4] ;
+    int ii , round ;
+
+    /* Nothing armed, the master does not wait */
+    barrier.wait(false) ;
+    EXPECT_EQ( barrier.pending , 0 ) ;
+    EXPECT_EQ( barrier.num_waits , 1 ) ;
+    EXPECT_EQ( barrier.num_blocks , 0 ) ;
+
+    /* With no spinning the master blocks until the last of the children arrives */
+    barrier.set_spin_count(0) ;
+    for ( round = 0 ; round < 3 ; round++ ) {
+        for ( ii = 0 ; ii < 4 ; ii++ ) {
+            barrier.arm() ;
+        }
+        for ( ii = 0 ; ii < 4 ; ii++ ) {
+            pthread_create(&children[ii], NULL, barrier_child, &barrier) ;
+        }
+        barrier.wait(false) ;
+        EXPECT_EQ( barrier.pending , 0 ) ;
+        EXPECT_EQ( barrier.sleeping , 0 ) ;
+        for ( ii = 0 ; ii < 4 ; ii++ ) {
+            pthread_join(children[ii], NULL) ;
+        }
+    }
+    EXPECT_EQ( barrier.num_waits , 4 ) ;
+#if __linux
+    EXPECT_GE( barrier.num_blocks , 3 ) ;
+#endif
+
+    /* Children that arrived before the master waits do not block it */
+    long long num_blocks = barrier.num_blocks ;
+    barrier.arm() ;
+    barrier.arrive() ;
+    barrier.wait(true) ;
+    EXPECT_EQ( barrier.num_waits , 5 ) ;
+    EXPECT_EQ( barrier.num_blocks , num_blocks ) ;
 }
 
 }
@@ -34,7 +34,7 @@ Trick::FrameLog::FrameLog(Trick::Clock & in_clock) :
  log_init_end(false),
  fp_time_main(NULL),
  fp_time_other(NULL),
- clock(in_clock) {
+ clock(&in_clock) {
 
     time_value_attr.type = TRICK_LONG_LONG ;
     time_value_attr.size = sizeof(long long) ;
@@ -348,7 +348,7 @@ int Trick::FrameLog::frame_clock_start(Trick::JobData * curr_job ) {
     /** @par Detailed Design: */
     if ( target_job != NULL ) {
         /** @li Set target job's start time. */
-        target_job->rt_start_time = clock.clock_time() ;
+        target_job->rt_start_time = clock->clock_time() ;
     }
 
     return(0) ;
@@ -365,7 +365,7 @@ int Trick::FrameLog::frame_clock_stop(Trick::JobData * curr_job) {
     if ( target_job != NULL ) {
         if ( target_job->rt_start_time >= 0 ) {
             /** @li Set current job's stop time and frame time. */
-            target_job->rt_stop_time = clock.clock_time() ;
+            target_job->rt_stop_time = clock->clock_time() ;
             target_job->frame_time += (target_job->rt_stop_time - target_job->rt_start_time);
             thread = target_job->thread;
 
@@ -686,7 +686,10 @@ int Trick::FrameLog::shutdown() {
 }
 
 void Trick::FrameLog::set_clock(Trick::Clock & in_clock) {
-    clock = in_clock ;
+    clock = &in_clock ;
+    if ( exec_get_time_tic_value() > 0 ) {
+        clock->calc_sim_time_ratio(exec_get_time_tic_value()) ;
+    }
 }
 
 //Call all the Create routines for the DP directory and all DP files.
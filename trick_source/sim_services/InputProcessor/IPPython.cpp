@@ -26,7 +26,7 @@
 Trick::IPPython * the_pip ;
 
 //Constructor
-Trick::IPPython::IPPython() : Trick::InputProcessor::InputProcessor() , units_conversion_msgs(true) {
+Trick::IPPython::IPPython() : Trick::InputProcessor::InputProcessor() , units_conversion_msgs(true) , main_dict(NULL) {
     the_pip = this ;
     return ;
 }
@@ -117,6 +117,9 @@ int Trick::IPPython::init() {
      "sys.path.append(os.getcwd() + \"/Modified_data\")\n"
     ) ;
 
+    /* Compiled event conditions and actions run in the same globals as PyRun_SimpleString. */
+    main_dict = PyModule_GetDict(PyImport_AddModule("__main__")) ;
+
     /* Make shortcut names for all known sim_objects. */
     get_TMM_named_variables() ;
 
@@ -187,6 +190,102 @@ int Trick::IPPython::parse_condition(std::string in_string, int & cond_return_va
 
 }
 
+/**
+ @details
+-# Return NULL if python is not running.  Events added before the input processor is initialized
+   are compiled the first time they are evaluated.
+-# Lock the input processor mutex
+-# Compile the string.  A string that does not compile is not reported here, the event falls back to
+   parsing the string each time it is evaluated, which reports the error.
+-# Unlock the input processor mutex
+*/
+void * Trick::IPPython::compile_string(std::string in_string, int start) {
+
+    if ( main_dict == NULL or ! Py_IsInitialized() ) {
+        return NULL ;
+    }
+    pthread_mutex_lock(&ip_mutex);
+    in_string += "\n" ;
+    PyObject * code = Py_CompileString(in_string.c_str(), "<string>", start) ;
+    if ( code == NULL ) {
+        PyErr_Clear() ;
+    }
+    pthread_mutex_unlock(&ip_mutex);
+
+    return code ;
+}
+
+void * Trick::IPPython::compile_condition(std::string in_string) {
+    return compile_string(in_string, Py_eval_input) ;
+}
+
+void * Trick::IPPython::compile_action(std::string in_string) {
+    return compile_string(in_string, Py_file_input) ;
+}
+
+void * Trick::IPPython::eval_code(void * code) {
+
+#if PY_VERSION_HEX >= 0x03000000
+    PyObject * result = PyEval_EvalCode((PyObject *)code, (PyObject *)main_dict, (PyObject *)main_dict) ;
+#else
+    PyObject * result = PyEval_EvalCode((PyCodeObject *)code, (PyObject *)main_dict, (PyObject *)main_dict) ;
+#endif
+    if ( result == NULL ) {
+        PyErr_Print() ;
+    }
+    return result ;
+}
+
+/**
+ @details
+-# Lock the input processor mutex
+-# Evaluate the compiled expression and copy its truth value to return_val and the incoming cond_return_value
+-# Unlock the input processor mutex
+*/
+int Trick::IPPython::eval_condition(void * code, int & cond_return_val) {
+
+    int py_ret = -1 ;
+    pthread_mutex_lock(&ip_mutex);
+    PyObject * result = (PyObject *)eval_code(code) ;
+    if ( result != NULL ) {
+        int truth = PyObject_IsTrue(result) ;
+        Py_DECREF(result) ;
+        if ( truth >= 0 ) {
+            return_val = truth ;
+            cond_return_val = truth ;
+            py_ret = 0 ;
+        } else {
+            PyErr_Print() ;
+        }
+    }
+    pthread_mutex_unlock(&ip_mutex);
+
+    return py_ret ;
+}
+
+int Trick::IPPython::run_action(void * code) {
+
+    int py_ret = -1 ;
+    pthread_mutex_lock(&ip_mutex);
+    PyObject * result = (PyObject *)eval_code(code) ;
+    if ( result != NULL ) {
+        Py_DECREF(result) ;
+        py_ret = 0 ;
+    }
+    pthread_mutex_unlock(&ip_mutex);
+
+    return py_ret ;
+}
+
+void Trick::IPPython::release_code(void * code) {
+    // Code objects are gone with the interpreter after shutdown.
+    if ( code != NULL and Py_IsInitialized() ) {
+        pthread_mutex_lock(&ip_mutex);
+        Py_DECREF((PyObject *)code) ;
+        pthread_mutex_unlock(&ip_mutex);
+    }
+}
+
 //Restart job that reloads event_list from checkpointable structures
 int Trick::IPPython::restart() {
     /* Make shortcut names for all known sim_objects. */
@@ -196,6 +295,7 @@ int Trick::IPPython::restart() {
 
 int Trick::IPPython::shutdown() {
     if ( Py_IsInitialized() ) {
+        main_dict = NULL ;
         Py_Finalize();
     }
     return(0) ;
@@ -11,9 +11,14 @@
 #include <string>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <vector>
+#include <map>
 
 #include "trick/IPPythonEvent.hh"
 #include "trick/IPPython.hh"
+#include "trick/ConditionExpression.hh"
 #include "trick/MemoryManager.hh"
 #include "trick/exec_proto.h"
 #include "trick/message_proto.h"
@@ -30,6 +35,16 @@ Trick::IPPython * Trick::IPPythonEvent::ip ;
 Trick::MTV * Trick::IPPythonEvent::mtv ;
 bool Trick::IPPythonEvent::info_msg = false ;
 bool Trick::IPPythonEvent::terminate_sim_on_event_python_error = false;
+bool Trick::IPPythonEvent::compile_native_conditions = true ;
+bool Trick::IPPythonEvent::defer_actions = false ;
+
+/* Python actions of events fired on child threads, waiting for the main thread.  The mutex is held only to
+   add or take the strings, never while python runs.  The child thread does not touch python; the main thread
+   compiles each action string the first time it runs and keeps the code in compiled_actions. */
+static std::vector< std::string > deferred_actions ;
+static std::vector< std::string > running_actions ;
+static std::map< std::string , void * > compiled_actions ;
+static pthread_mutex_t deferred_mutex = PTHREAD_MUTEX_INITIALIZER ;
 
 Trick::condition_t::condition_t() {
     enabled = 0 ;
@@ -39,6 +54,8 @@ Trick::condition_t::condition_t() {
     fired_time = -1.0 ;
     ref = NULL ;
     job = NULL ;
+    code = NULL ;
+    expr = NULL ;
 }
 
 Trick::action_t::action_t() {
@@ -48,6 +65,13 @@ Trick::action_t::action_t() {
     ran_time = -1.0 ;
     job = NULL ;
     act_type = 0 ;
+    code = NULL ;
+}
+
+static double event_clock() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return tp.tv_sec + tp.tv_nsec / 1.0e9 ;
 }
 
 //Constructor
@@ -64,6 +88,10 @@ Trick::IPPythonEvent::IPPythonEvent() {
     fired_time = -1.0 ;
     ran_count = 0 ;
     ran_time = -1.0 ;
+    eval_time = 0.0 ;
+    max_eval_time = 0.0 ;
+    total_eval_time = 0.0 ;
+    eval_count = 0 ;
     fired = false ;
     hold = false ;
     ran = false ;
@@ -78,6 +106,10 @@ Trick::IPPythonEvent::~IPPythonEvent() {
        for (int ii=0; ii<condition_count; ii++) {
            if (TMM_is_alloced((char *)condition_list[ii]))
            {
+              if (ip != NULL) {
+                 ip->release_code(condition_list[ii]->code);
+              }
+              delete condition_list[ii]->expr ;
               TMM_delete_var_a(condition_list[ii]);
            }
            condition_list[ii] = 0x0;
@@ -91,6 +123,9 @@ Trick::IPPythonEvent::~IPPythonEvent() {
        for (int ii=0; ii<action_count; ii++) {
            if (TMM_is_alloced((char *)action_list[ii]))
            {
+              if (ip != NULL) {
+                 ip->release_code(action_list[ii]->code);
+              }
               TMM_delete_var_a(action_list[ii]);
            }
            action_list[ii] = 0x0;
@@ -174,10 +209,63 @@ void Trick::IPPythonEvent::terminate_on_event_parse_error(bool on_off) {
     terminate_sim_on_event_python_error = on_off;
 }
 
+void Trick::IPPythonEvent::native_event_conditions(bool on_off) {
+    compile_native_conditions = on_off;
+}
+
+void Trick::IPPythonEvent::defer_thread_event_actions(bool on_off) {
+    defer_actions = on_off;
+}
+
+/**
+ @details
+-# Take the queued actions, holding the queue mutex only for the swap.  The two vectors keep their
+   capacity from frame to frame.
+-# Run each action string as it was when the event fired.  The event that queued it may have been changed
+   or deleted since.  The string is compiled the first time it is run and the code is kept for the next
+   time the string is queued.  A string that does not compile is parsed, which reports the python error.
+-# Terminate the sim on a python error if terminate_on_event_parse_error is set.
+*/
+int Trick::IPPythonEvent::run_deferred_actions() {
+    unsigned int ii ;
+
+    pthread_mutex_lock(&deferred_mutex) ;
+    running_actions.swap(deferred_actions) ;
+    pthread_mutex_unlock(&deferred_mutex) ;
+
+    for (ii = 0 ; ii < running_actions.size() ; ii++) {
+        int ret ;
+        void *& code = compiled_actions[running_actions[ii]] ;
+        if ( code == NULL ) {
+            code = ip->compile_action(running_actions[ii]) ;
+        }
+        if ( code != NULL ) {
+            ret = ip->run_action(code) ;
+        } else {
+            ret = ip->parse(running_actions[ii]) ;
+        }
+        if (ret != 0 && terminate_sim_on_event_python_error) {
+            running_actions.clear() ;
+            exec_terminate_with_return( ret , __FILE__ , __LINE__ , "Python error in event action processing" ) ;
+        }
+    }
+    running_actions.clear() ;
+    return 0 ;
+}
+
+void Trick::IPPythonEvent::reset_eval_time() {
+    eval_time = 0.0 ;
+    max_eval_time = 0.0 ;
+    total_eval_time = 0.0 ;
+    eval_count = 0 ;
+}
+
 void Trick::IPPythonEvent::restart() {
     int jj ;
 
     for (jj=0; jj<condition_count; jj++) {
+        // compiled conditions refer to the allocations replaced by the checkpoint
+        compile_condition(condition_list[jj]) ;
         if (condition_list[jj]->cond_type==1) { // condition variable
             condition_list[jj]->ref = ref_attributes(condition_list[jj]->str.c_str());
         }
@@ -186,6 +274,8 @@ void Trick::IPPythonEvent::restart() {
         }
     }
     for (jj=0; jj<action_count; jj++) {
+        ip->release_code(action_list[jj]->code) ;
+        action_list[jj]->code = NULL ;
         if (action_list[jj]->act_type!=0) { // action job
             action_list[jj]->job = exec_get_job(action_list[jj]->str.c_str(),1);
         }
@@ -261,6 +351,8 @@ int Trick::IPPythonEvent::condition(int num, std::string str, std::string commen
             condition_list[num]->cond_type = 2;
         } else condition_list[num]->cond_type = 0;
         condition_list[num]->str = str;
+        /** @li Compile a condition string once here instead of parsing it every evaluation. */
+        compile_condition(condition_list[num]) ;
         // comment is for display in mtv, if not supplied create a comment containing up to 50 characters of cond string
         if (comment.empty()) {
             condition_list[num]->comment = str.substr(0,50);
@@ -435,6 +527,14 @@ int Trick::IPPythonEvent::action(int num, std::string str, std::string comment,
         action_list[num]->enabled = true;
         action_list[num]->ran = false;
         action_list[num]->str = str;
+        /** @li Compile a python action string of a user event once here instead of parsing it every run. */
+        if (ip != NULL) {
+            ip->release_code(action_list[num]->code) ;
+            action_list[num]->code = NULL ;
+            if (job == NULL && is_user_event) {
+                action_list[num]->code = ip->compile_action(str) ;
+            }
+        }
         // comment is for display in mtv, if not supplied create a comment containing up to 50 characters of act string
         if (comment.empty()) {
             action_list[num]->comment = str.substr(0,50);
@@ -543,6 +643,7 @@ bool Trick::IPPythonEvent::process_user_event( long long curr_time ) {
     int ii ;
     int return_val ;
     bool it_fired, it_ran;
+    double start_time = event_clock() ;
 
     fired = false ;
     ran = false ;
@@ -577,10 +678,19 @@ bool Trick::IPPythonEvent::process_user_event( long long curr_time ) {
                     condition_list[ii]->job->disabled = false;
                     return_val = condition_list[ii]->job->call();
                     condition_list[ii]->job->disabled = save_disabled_state;
+                } else if (condition_list[ii]->expr != NULL) {
+                // if it was compiled to native code, evaluate it without python
+                    int expr_ret = condition_list[ii]->expr->evaluate(return_val) ;
+                    if (expr_ret != 0) {
+                        message_publish(MSG_WARNING, "Event %s condition %d not evaluated: NULL pointer or division by zero.\n",
+                         name.c_str(), ii) ;
+                        if (terminate_sim_on_event_python_error) {
+                            exec_terminate_with_return( expr_ret , __FILE__ , __LINE__ , "Error in event condition processing" ) ;
+                        }
+                    }
                 } else {
                 // otherwise use python to evaluate string
-                    std::string full_in_string ;
-                    int python_ret = ip->parse_condition(condition_list[ii]->str, return_val) ;
+                    int python_ret = eval_python_condition(condition_list[ii], return_val) ;
                     if (python_ret != 0 && terminate_sim_on_event_python_error) {
                         exec_terminate_with_return( python_ret , __FILE__ , __LINE__ , "Python error in event condition processing" ) ;
                     }
@@ -649,9 +759,15 @@ bool Trick::IPPythonEvent::process_user_event( long long curr_time ) {
                         action_list[ii]->job->disabled = save_disabled_state;
                         break;
                 }
+            } else if (defer_actions && get_before_after() == Trick::EVENT_NOTARGET && exec_get_process_id() != 0) {
+                // a python action fired on a child thread is queued for the main thread.  Events before or after
+                // a job run their actions in place, the target job may depend on them.
+                pthread_mutex_lock(&deferred_mutex) ;
+                deferred_actions.push_back(action_list[ii]->str) ;
+                pthread_mutex_unlock(&deferred_mutex) ;
             } else {
                 // otherwise use python to evaluate string
-                int ret = ip->parse(action_list[ii]->str) ;
+                int ret = run_python_action(action_list[ii]) ;
                 if (ret != 0 && terminate_sim_on_event_python_error) {
                     exec_terminate_with_return( ret , __FILE__ , __LINE__ , "Python error in event action processing" ) ;
                 }
@@ -672,7 +788,79 @@ bool Trick::IPPythonEvent::process_user_event( long long curr_time ) {
         ran_time = curr_time ;
     }
 
+    /** @li Accumulate the wall clock time spent evaluating the event. */
+    eval_time = event_clock() - start_time ;
+    if ( eval_time > max_eval_time ) {
+        max_eval_time = eval_time ;
+    }
+    total_eval_time += eval_time ;
+    eval_count++ ;
+
     /** @li Return true if the event fired. */
     return(it_fired) ;
 }
 
+
+/**
+ @details
+-# Release the previous compiled code of the condition.
+-# Compile a condition string to native code if it only uses arithmetic and comparisons of simulation
+   variables and numbers.
+-# Otherwise compile it with python.  Without the input processor it is compiled the first time it is
+   evaluated.
+*/
+void Trick::IPPythonEvent::compile_condition( condition_t * cond ) {
+    if (ip != NULL) {
+        ip->release_code(cond->code) ;
+    }
+    cond->code = NULL ;
+    delete cond->expr ;
+    cond->expr = NULL ;
+    if (cond->cond_type != 0) {
+        return ;
+    }
+    if (compile_native_conditions) {
+        cond->expr = new Trick::ConditionExpression ;
+        if (cond->expr->compile(cond->str) == 0) {
+            return ;
+        }
+        delete cond->expr ;
+        cond->expr = NULL ;
+    }
+    if (ip != NULL) {
+        cond->code = ip->compile_condition(cond->str) ;
+    }
+}
+
+/**
+ @details
+-# Compile the condition string if it has not been compiled.  Conditions added before the input
+   processor was initialized or restored from a checkpoint are compiled here.
+-# Evaluate the compiled condition.  If the string does not compile, parse it as a string so the
+   python error is reported.
+*/
+int Trick::IPPythonEvent::eval_python_condition( condition_t * cond, int & return_val ) {
+    if ( cond->code == NULL ) {
+        cond->code = ip->compile_condition(cond->str) ;
+    }
+    if ( cond->code != NULL ) {
+        return ip->eval_condition(cond->code, return_val) ;
+    }
+    return ip->parse_condition(cond->str, return_val) ;
+}
+
+/**
+ @details
+-# Compile the action string if it has not been compiled.
+-# Run the compiled action.  If the string does not compile, parse it as a string so the
+   python error is reported.
+*/
+int Trick::IPPythonEvent::run_python_action( action_t * act ) {
+    if ( act->code == NULL ) {
+        act->code = ip->compile_action(act->str) ;
+    }
+    if ( act->code != NULL ) {
+        return ip->run_action(act->code) ;
+    }
+    return ip->parse(act->str) ;
+}
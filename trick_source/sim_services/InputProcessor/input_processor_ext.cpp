@@ -81,8 +81,8 @@ Command to create a new read event.
 This command is tied to "trick.add_read(thread_id, time, event_text)" in the input processor.
 
 -# Allocate space for the event.
--# Set the event's action to the incoming event string.
 -# Set the event as not a user event.
+-# Set the event's action to the incoming event string.
 -# Set the event cycle to 0
 -# Activate the event
 -# Set the event thread to the incoming thread_id
@@ -92,8 +92,9 @@ int ippython_add_read( unsigned int thread_id , double in_time , char * in_strin
 
     Trick::IPPythonEvent * event = ippython_new_event();
 
-    event->action(0, in_string) ;
+    // A read is run once, set it as a trick event first so its action is not compiled.
     event->is_user_event = false ;
+    event->action(0, in_string) ;
 
     event->set_cycle(0) ;
     event->activate() ;
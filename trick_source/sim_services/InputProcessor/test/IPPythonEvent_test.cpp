@@ -0,0 +1,112 @@
+
+#include <Python.h>
+#include <pthread.h>
+#include "gtest/gtest.h"
+
+#define protected public
+#include "trick/IPPythonEvent.hh"
+#include "trick/IPPython.hh"
+#include "trick/MemoryManager.hh"
+
+namespace Trick {
+
+/* There is no executive in the test.  exec_get_process_id() does not return 0 without one, so every event is
+   processed as if it fired on a child thread. */
+class IPPythonEventTest : public ::testing::Test {
+    protected:
+        Trick::MemoryManager * memmgr ;
+        Trick::IPPython ip ;
+
+        IPPythonEventTest() {}
+        ~IPPythonEventTest() {}
+        virtual void SetUp() {
+            pthread_mutexattr_t m_attr ;
+
+            memmgr = new Trick::MemoryManager ;
+            pthread_mutexattr_init(&m_attr) ;
+            pthread_mutexattr_settype(&m_attr, PTHREAD_MUTEX_RECURSIVE) ;
+            pthread_mutex_init(&ip.ip_mutex, &m_attr) ;
+            /* The interpreter is started once for all tests, the queue keeps the code it compiled. */
+            if ( ! Py_IsInitialized() ) {
+                Py_Initialize() ;
+            }
+            ip.main_dict = PyModule_GetDict(PyImport_AddModule("__main__")) ;
+            IPPythonEvent::set_python_processor(&ip) ;
+            ip.parse("count = 0") ;
+        }
+        virtual void TearDown() {
+            IPPythonEvent::defer_thread_event_actions(false) ;
+            delete memmgr ;
+        }
+
+        long count() {
+            return PyLong_AsLong(PyDict_GetItemString((PyObject *)ip.main_dict, "count")) ;
+        }
+} ;
+
+TEST_F(IPPythonEventTest , ActionsRunWhenFiredByDefault) {
+    IPPythonEvent event ;
+
+    event.action(0, "count += 1") ;
+    event.manual_fire() ;
+    EXPECT_EQ( count() , 1 ) ;
+    EXPECT_EQ( event.action_ran_count(0) , 1 ) ;
+}
+
+TEST_F(IPPythonEventTest , DeferredActionsRunInOrder) {
+    IPPythonEvent event ;
+
+    IPPythonEvent::defer_thread_event_actions(true) ;
+    event.action(0, "count += 1") ;
+    event.action(1, "count *= 10") ;
+    event.manual_fire() ;
+    event.manual_fire() ;
+
+    /* Nothing runs until the main thread takes the queue, the event counts the actions when they fired. */
+    EXPECT_EQ( count() , 0 ) ;
+    EXPECT_EQ( event.action_ran_count(0) , 2 ) ;
+    EXPECT_EQ( event.action_ran_count(1) , 2 ) ;
+
+    /* The queued strings run as they were when the event fired. */
+    event.action(0, "count += 1000") ;
+    EXPECT_EQ( IPPythonEvent::run_deferred_actions() , 0 ) ;
+    EXPECT_EQ( count() , 110 ) ;
+    EXPECT_EQ( IPPythonEvent::run_deferred_actions() , 0 ) ;
+    EXPECT_EQ( count() , 110 ) ;
+
+    /* A string queued again runs the code compiled the first time, a new one is compiled. */
+    event.manual_fire() ;
+    EXPECT_EQ( IPPythonEvent::run_deferred_actions() , 0 ) ;
+    EXPECT_EQ( count() , 11100 ) ;
+}
+
+TEST_F(IPPythonEventTest , DeferredActionThatDoesNotCompile) {
+    IPPythonEvent event ;
+
+    IPPythonEvent::defer_thread_event_actions(true) ;
+    event.action(0, "count +=") ;
+    event.action(1, "count += 1") ;
+    event.manual_fire() ;
+
+    /* The python error is reported and the following action still runs. */
+    EXPECT_EQ( IPPythonEvent::run_deferred_actions() , 0 ) ;
+    EXPECT_EQ( count() , 1 ) ;
+}
+
+TEST_F(IPPythonEventTest , BeforeAfterEventsAreNotDeferred) {
+    IPPythonEvent event ;
+
+    IPPythonEvent::defer_thread_event_actions(true) ;
+    event.set_before_after(Trick::EVENT_BEFORETARGET) ;
+    event.action(0, "count += 1") ;
+    event.manual_fire() ;
+    EXPECT_EQ( count() , 1 ) ;
+    EXPECT_EQ( IPPythonEvent::run_deferred_actions() , 0 ) ;
+    EXPECT_EQ( count() , 1 ) ;
+
+    event.set_before_after(Trick::EVENT_AFTERTARGET) ;
+    event.manual_fire() ;
+    EXPECT_EQ( count() , 2 ) ;
+}
+
+}
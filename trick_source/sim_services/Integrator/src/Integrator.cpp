@@ -3,6 +3,7 @@
 #include "trick/message_type.h"
 #include <cstdarg>
 #include <iostream>
+#include <string.h>
 
 /**
  */
@@ -25,6 +26,19 @@ Trick::Integrator::Integrator() {
    time = 0.0;
    time_0 = 0.0;
    verbosity = 0 ;
+   span_state = NULL;
+   span_deriv = NULL;
+   span_size = NULL;
+   num_spans = 0;
+   span_state_size = 0;
+}
+
+/**
+ */
+Trick::Integrator::~Integrator() {
+   if (span_state) INTEG_FREE(span_state);
+   if (span_deriv) INTEG_FREE(span_deriv);
+   if (span_size) INTEG_FREE(span_size);
 }
 
 /**
@@ -94,8 +108,16 @@ void Trick::Integrator::state_reset () {
     if (intermediate_step == 0) {
 
         if (verbosity) message_publish(MSG_DEBUG, "STATE RESET");
-        for (int i=0; i<num_state ; i++) {
-            *state_origin[i] = state[i];
+        if (num_spans > 0) {
+            unsigned int offset = 0;
+            for (unsigned int ii = 0; ii < num_spans; ++ii) {
+                memcpy (span_state[ii], &state[offset], span_size[ii] * sizeof(double));
+                offset += span_size[ii];
+            }
+        } else {
+            for (int i=0; i<num_state ; i++) {
+                *state_origin[i] = state[i];
+            }
         }
     }
 #endif
@@ -209,6 +231,71 @@ void Trick::Integrator::state_out (double* arg1, ...) {
     va_end(argp);
 }
 
+int Trick::Integrator::add_state_span (double* state_p, double* deriv_p, unsigned int size) {
+    if (is_2nd_order_ODE_technique) {
+        message_publish(MSG_ERROR,
+                        "Integrator ERROR: "
+                        "State spans need a 1st order technique.\n");
+        return 1;
+    }
+    if (span_state_size + size > (unsigned int)num_state) {
+        message_publish(MSG_ERROR,
+                        "Integrator ERROR: "
+                        "State spans exceed the %d states of the integrator.\n", num_state);
+        return 1;
+    }
+
+    if (size == 0) {
+        return 0;
+    }
+
+    // Every span holds at least one state, so there are at most num_state spans.
+    if (span_state == NULL) {
+        span_state = INTEG_ALLOC( double*, num_state);
+        span_deriv = INTEG_ALLOC( double*, num_state);
+        span_size = INTEG_ALLOC( unsigned int, num_state);
+    }
+    span_state[num_spans] = state_p;
+    span_deriv[num_spans] = deriv_p;
+    span_size[num_spans] = size;
+    num_spans++;
+    span_state_size += size;
+    return 0;
+}
+
+void Trick::Integrator::clear_state_spans () {
+    num_spans = 0;
+    span_state_size = 0;
+}
+
+int Trick::Integrator::integrate_state_spans () {
+    unsigned int offset;
+    bool load_state = (intermediate_step == 0);
+    double* deriv_p = deriv[intermediate_step];
+
+    if (verbosity) message_publish(MSG_DEBUG, "LOAD STATE SPANS: %u states\n", span_state_size);
+    offset = 0;
+    for (unsigned int ii = 0; ii < num_spans; ++ii) {
+        size_t num_bytes = span_size[ii] * sizeof(double);
+        if (load_state) {
+            memcpy (&state[offset], span_state[ii], num_bytes);
+        }
+        memcpy (&deriv_p[offset], span_deriv[ii], num_bytes);
+        offset += span_size[ii];
+    }
+
+    int ipass = integrate();
+
+    double* state_ws_p = state_ws[intermediate_step];
+    offset = 0;
+    for (unsigned int ii = 0; ii < num_spans; ++ii) {
+        memcpy (span_state[ii], &state_ws_p[offset], span_size[ii] * sizeof(double));
+        offset += span_size[ii];
+    }
+
+    return ipass;
+}
+
 bool Trick::Integrator::get_first_step_deriv() {
     return (first_step_deriv);
 }
@@ -0,0 +1,118 @@
+// Local includes
+#include "trick/IntegratorGroup.hh"
+
+// Trick includes
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+
+
+/**
+ Default constructor.
+ */
+Trick::IntegratorGroup::IntegratorGroup()
+:
+    integrator (NULL),
+    blocks (),
+    num_state (0)
+{
+}
+
+/**
+ Add a block of states.  The block is packed after the blocks added before it.
+ */
+int Trick::IntegratorGroup::add_state (
+    double * state, double * deriv, unsigned int size)
+{
+    if (integrator != NULL) {
+        message_publish (
+            MSG_ERROR,
+            "IntegratorGroup ERROR: "
+            "States cannot be added after the integrator is created.\n");
+        return 1;
+    }
+
+    StateBlock block;
+    block.state = state;
+    block.deriv = deriv;
+    block.size = size;
+    blocks.push_back (block);
+    num_state += size;
+
+    return 0;
+}
+
+/**
+ Create the integrator of all of the states.
+ The second order techniques interleave positions and velocities over the
+ whole state, which blocks of contiguous states do not fit.
+ */
+Trick::Integrator * Trick::IntegratorGroup::getIntegrator (
+    Integrator_type alg, double dt)
+{
+    if (integrator != NULL) {
+        message_publish (
+            MSG_ERROR,
+            "IntegratorGroup ERROR: The integrator was already created.\n");
+        return NULL;
+    }
+
+    if ((alg == Euler_Cromer) ||
+        (alg == Nystrom_Lear_2) ||
+        (alg == Modified_Midpoint_4)) {
+        message_publish (
+            MSG_ERROR,
+            "IntegratorGroup ERROR: "
+            "Only first order techniques can integrate a group.\n");
+        return NULL;
+    }
+
+    integrator = Trick::getIntegrator (alg, num_state, dt);
+
+    // The blocks are the state spans of the integrator.
+    if (integrator != NULL) {
+        add_state_spans ();
+    }
+
+    return integrator;
+}
+
+/**
+ Register the blocks on the integrator again.  After a checkpoint reload the
+ integrator is the one restored from the checkpoint.
+ */
+int Trick::IntegratorGroup::restart ()
+{
+    if (integrator != NULL) {
+        integrator->clear_state_spans ();
+        add_state_spans ();
+    }
+
+    return 0;
+}
+
+/**
+ Register the blocks as the state spans of the integrator, in the order they
+ were added.
+ */
+void Trick::IntegratorGroup::add_state_spans ()
+{
+    for (unsigned int ii = 0; ii < blocks.size(); ++ii) {
+        integrator->add_state_span (blocks[ii].state, blocks[ii].deriv, blocks[ii].size);
+    }
+}
+
+/**
+ Integrate the states through one intermediate step.
+ */
+int Trick::IntegratorGroup::integrate ()
+{
+    if (integrator == NULL) {
+        message_publish (
+            MSG_ERROR,
+            "IntegratorGroup ERROR: getIntegrator() has not been called.\n");
+        return 0;
+    }
+
+    // One pass of the technique over all of the states.
+    return integrator->integrate_state_spans();
+}
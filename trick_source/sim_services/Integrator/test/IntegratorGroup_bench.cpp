@@ -0,0 +1,225 @@
+/*
+   Microbenchmark comparing an IntegratorGroup with an integrator per object, and a state span
+   with loading a large state element by element.
+
+   Usage: IntegratorGroup_bench [num_bodies] [num_steps]
+
+   num_bodies damped oscillators with a three axis position and velocity are integrated for
+   num_steps steps of Runge_Kutta_4.  Per object, each body has its own integrator and integration
+   job that loads its states and derivatives through the variable argument list interface, the way
+   a sim with an integration job per sim object does.  Grouped, every body adds its states to one
+   IntegratorGroup and a single job integrates them all.  The passes run the same way
+   IntegLoopScheduler::integrate_dt() runs them.  The final states of both must match exactly.
+
+   The same states are then integrated as one large state vector, num_bodies * 6 states in one
+   array, loaded element by element through state_element_in() and the indexed derivatives and
+   states, and through a single state span registered with add_state_span().
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "trick/Integrator.hh"
+#include "trick/IntegratorGroup.hh"
+
+struct Body {
+    double pos[3] ;
+    double vel[3] ;
+    double acc[3] ;
+    double omega_sq ;
+    double damping ;
+} ;
+
+static double wall_time() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return tp.tv_sec + tp.tv_nsec / 1.0e9 ;
+}
+
+static void init_bodies( std::vector< Body > & bodies ) {
+    for ( unsigned int ii = 0 ; ii < bodies.size() ; ii++ ) {
+        Body & b = bodies[ii] ;
+        for ( int jj = 0 ; jj < 3 ; jj++ ) {
+            b.pos[jj] = 1.0 + 0.001 * ii + jj ;
+            b.vel[jj] = 0.0 ;
+            b.acc[jj] = 0.0 ;
+        }
+        b.omega_sq = 1.0 + 0.01 * ( ii % 100 ) ;
+        b.damping = 0.05 ;
+    }
+}
+
+static void derivatives( std::vector< Body > & bodies ) {
+    for ( unsigned int ii = 0 ; ii < bodies.size() ; ii++ ) {
+        Body & b = bodies[ii] ;
+        for ( int jj = 0 ; jj < 3 ; jj++ ) {
+            b.acc[jj] = -b.omega_sq * b.pos[jj] - b.damping * b.vel[jj] ;
+        }
+    }
+}
+
+// The derivatives of the bodies stored as num_bodies blocks of three positions and three velocities.
+static void derivatives( std::vector< double > & states , std::vector< double > & derivs , unsigned int num_bodies ) {
+    for ( unsigned int ii = 0 ; ii < num_bodies ; ii++ ) {
+        const double omega_sq = 1.0 + 0.01 * ( ii % 100 ) ;
+        for ( int jj = 0 ; jj < 3 ; jj++ ) {
+            derivs[6 * ii + jj] = states[6 * ii + 3 + jj] ;
+            derivs[6 * ii + 3 + jj] = -omega_sq * states[6 * ii + jj] - 0.05 * states[6 * ii + 3 + jj] ;
+        }
+    }
+}
+
+static int integ_body( Trick::Integrator * integ , Body & b ) {
+    integ->state_in( &b.pos[0] , &b.pos[1] , &b.pos[2] , &b.vel[0] , &b.vel[1] , &b.vel[2] , (double *)NULL ) ;
+    integ->deriv_in( &b.vel[0] , &b.vel[1] , &b.vel[2] , &b.acc[0] , &b.acc[1] , &b.acc[2] , (double *)NULL ) ;
+    int ipass = integ->integrate() ;
+    integ->state_out( &b.pos[0] , &b.pos[1] , &b.pos[2] , &b.vel[0] , &b.vel[1] , &b.vel[2] , (double *)NULL ) ;
+    return ipass ;
+}
+
+static double run_per_object( std::vector< Body > & bodies , unsigned int num_steps , double dt ) {
+    std::vector< Trick::Integrator * > integs ;
+    for ( unsigned int ii = 0 ; ii < bodies.size() ; ii++ ) {
+        integs.push_back( Trick::getIntegrator( Runge_Kutta_4 , 6 , dt ) ) ;
+    }
+
+    double start = wall_time() ;
+    for ( unsigned int step = 0 ; step < num_steps ; step++ ) {
+        int ipass ;
+        do {
+            derivatives( bodies ) ;
+            ipass = 0 ;
+            for ( unsigned int ii = 0 ; ii < bodies.size() ; ii++ ) {
+                ipass = integ_body( integs[ii] , bodies[ii] ) ;
+            }
+        } while ( ipass ) ;
+    }
+    return wall_time() - start ;
+}
+
+static double run_grouped( std::vector< Body > & bodies , unsigned int num_steps , double dt ) {
+    Trick::IntegratorGroup group ;
+    for ( unsigned int ii = 0 ; ii < bodies.size() ; ii++ ) {
+        // pos and vel are the states, vel and acc their derivatives
+        group.add_state( bodies[ii].pos , bodies[ii].vel , 6 ) ;
+    }
+    group.getIntegrator( Runge_Kutta_4 , dt ) ;
+
+    double start = wall_time() ;
+    for ( unsigned int step = 0 ; step < num_steps ; step++ ) {
+        int ipass ;
+        do {
+            derivatives( bodies ) ;
+            ipass = group.integrate() ;
+        } while ( ipass ) ;
+    }
+    return wall_time() - start ;
+}
+
+static double run_elements( std::vector< double > & states , std::vector< double > & derivs ,
+ unsigned int num_steps , double dt ) {
+    Trick::Integrator * integ = Trick::getIntegrator( Runge_Kutta_4 , states.size() , dt ) ;
+    unsigned int num_state = states.size() ;
+    unsigned int num_bodies = num_state / 6 ;
+
+    double start = wall_time() ;
+    for ( unsigned int step = 0 ; step < num_steps ; step++ ) {
+        int ipass ;
+        do {
+            derivatives( states , derivs , num_bodies ) ;
+            for ( unsigned int ii = 0 ; ii < num_state ; ii++ ) {
+                integ->state_element_in( ii , &states[ii] ) ;
+                integ->deriv[integ->intermediate_step][ii] = derivs[ii] ;
+            }
+            ipass = integ->integrate() ;
+            for ( unsigned int ii = 0 ; ii < num_state ; ii++ ) {
+                states[ii] = integ->state_ws[integ->intermediate_step][ii] ;
+            }
+        } while ( ipass ) ;
+    }
+    return wall_time() - start ;
+}
+
+static double run_span( std::vector< double > & states , std::vector< double > & derivs ,
+ unsigned int num_steps , double dt ) {
+    Trick::Integrator * integ = Trick::getIntegrator( Runge_Kutta_4 , states.size() , dt ) ;
+    unsigned int num_bodies = states.size() / 6 ;
+    integ->add_state_span( &states[0] , &derivs[0] , states.size() ) ;
+
+    double start = wall_time() ;
+    for ( unsigned int step = 0 ; step < num_steps ; step++ ) {
+        int ipass ;
+        do {
+            derivatives( states , derivs , num_bodies ) ;
+            ipass = integ->integrate_state_spans() ;
+        } while ( ipass ) ;
+    }
+    return wall_time() - start ;
+}
+
+static void print_times( const char * first , double first_time , const char * second , double second_time ,
+ double body_steps ) {
+    std::cout << std::fixed << std::setprecision(1) ;
+    std::cout << first << std::setw(8) << first_time * 1.0e9 / body_steps << " ns per body step" << std::endl ;
+    std::cout << second << std::setw(8) << second_time * 1.0e9 / body_steps << " ns per body step" << std::endl ;
+    std::cout << std::setprecision(2) << "  speedup    " << std::setw(8) << first_time / second_time << std::endl ;
+}
+
+int main( int argc , char * argv[] ) {
+
+    unsigned int num_bodies = 500 ;
+    unsigned int num_steps = 10000 ;
+    const double dt = 0.01 ;
+
+    if ( argc > 1 ) {
+        num_bodies = strtoul(argv[1], NULL, 0) ;
+    }
+    if ( argc > 2 ) {
+        num_steps = strtoul(argv[2], NULL, 0) ;
+    }
+
+    std::vector< Body > per_object( num_bodies ) , grouped( num_bodies ) ;
+    init_bodies( per_object ) ;
+    init_bodies( grouped ) ;
+
+    double per_object_time = run_per_object( per_object , num_steps , dt ) ;
+    double grouped_time = run_grouped( grouped , num_steps , dt ) ;
+
+    int ret = 0 ;
+    for ( unsigned int ii = 0 ; ii < num_bodies ; ii++ ) {
+        if ( memcmp( per_object[ii].pos , grouped[ii].pos , 6 * sizeof(double) ) ) {
+            std::cout << "body " << ii << " differs" << std::endl ;
+            ret = 1 ;
+            break ;
+        }
+    }
+
+    double body_steps = (double)num_bodies * num_steps ;
+    std::cout << num_bodies << " bodies, " << num_steps << " Runge_Kutta_4 steps" << std::endl ;
+    print_times( "  per object " , per_object_time , "  grouped    " , grouped_time , body_steps ) ;
+
+    std::vector< double > element_states( 6 * num_bodies ) , element_derivs( 6 * num_bodies ) ;
+    for ( unsigned int ii = 0 ; ii < num_bodies ; ii++ ) {
+        for ( int jj = 0 ; jj < 3 ; jj++ ) {
+            element_states[6 * ii + jj] = 1.0 + 0.001 * ii + jj ;
+            element_states[6 * ii + 3 + jj] = 0.0 ;
+        }
+    }
+    std::vector< double > span_states( element_states ) , span_derivs( element_derivs ) ;
+
+    double element_time = run_elements( element_states , element_derivs , num_steps , dt ) ;
+    double span_time = run_span( span_states , span_derivs , num_steps , dt ) ;
+
+    if ( element_states != span_states ) {
+        std::cout << "span states differ" << std::endl ;
+        ret = 1 ;
+    }
+
+    std::cout << "one state vector of " << 6 * num_bodies << " states" << std::endl ;
+    print_times( "  elements   " , element_time , "  span       " , span_time , body_steps ) ;
+    return ret ;
+}
@@ -6,6 +6,7 @@
 
 #include "trick/MemoryManager.hh"
 #include "trick/Integrator.hh"
+#include "trick/IntegratorGroup.hh"
 #include "trick/IntegLoopScheduler.hh"
 #include "trick/Executive.hh"
 #include "trick/exec_proto.h"
@@ -544,3 +545,137 @@ TEST_F(IntegratorTest, Ball_UserDefined) {
 
     EXPECT_EQ(integrator->get_Integrator_type(), 10);
 }
+
+TEST_F(IntegratorTest, Ball_Span_Runge_Kutta_4) {
+
+    BALL   ball;
+    long   tick = 0;
+    double sim_time;
+
+    Trick::Integrator *integrator = Trick::getIntegrator( Runge_Kutta_4, 4, 0.01);
+    ASSERT_TRUE( (void*)integrator != NULL);
+
+    init(&ball);
+    // pos and vel are the states, vel and acc their derivatives
+    EXPECT_EQ(integrator->add_state_span(ball.pos, ball.vel, 4), 0);
+    // No more than num_state states
+    EXPECT_EQ(integrator->add_state_span(ball.pos, ball.vel, 1), 1);
+
+    // Simulation Loop
+    do {
+        sim_time = tick * integrator->dt ;
+        // Integration Loop
+        do {
+            integrator->time = sim_time;
+            deriv( &ball);
+        } while ( integrator->integrate_state_spans());
+        tick++;
+    } while (ball.pos[0] >= 0.0);
+    verify_ball_sim_results(&ball, 0.0000000001, -0.087238729171133289, 220.75, -43.321029810778249, 25.000000) ;
+
+    integrator->clear_state_spans();
+    EXPECT_EQ(integrator->add_state_span(ball.pos, ball.vel, 4), 0);
+
+    memmgr->delete_var( integrator);
+}
+
+TEST_F(IntegratorTest, Ball_Group_Runge_Kutta_4) {
+
+    BALL balls[3];
+    Trick::IntegratorGroup group;
+    long   tick = 0;
+    double sim_time;
+
+    for (int ii = 0; ii < 3; ii++) {
+        init(&balls[ii]);
+        // pos and vel are the states, vel and acc their derivatives
+        EXPECT_EQ(group.add_state(balls[ii].pos, balls[ii].vel, 4), 0);
+    }
+    EXPECT_EQ(group.get_num_state(), 12u);
+
+    Trick::Integrator *integrator = group.getIntegrator( Runge_Kutta_4, 0.01);
+    ASSERT_TRUE( (void*)integrator != NULL);
+    EXPECT_EQ(integrator->num_state,12);
+    EXPECT_TRUE(group.integrator == integrator);
+
+    // Simulation Loop
+    do {
+        sim_time = tick * integrator->dt ;
+        // Integration Loop
+        do {
+            integrator->time = sim_time;
+            for (int ii = 0; ii < 3; ii++) {
+                deriv( &balls[ii]);
+            }
+        } while ( group.integrate());
+        tick++;
+    } while (balls[0].pos[0] >= 0.0);
+
+    // Every ball matches the ball integrated by its own integrator.
+    for (int ii = 0; ii < 3; ii++) {
+        verify_ball_sim_results(&balls[ii], 0.0000000001, -0.087238729171133289, 220.75, -43.321029810778249, 25.000000) ;
+    }
+
+    // States are added before the integrator is created, and only once.
+    double extra[2];
+    EXPECT_EQ(group.add_state(extra, extra, 2), 1);
+    EXPECT_TRUE(group.getIntegrator( Runge_Kutta_4, 0.01) == NULL);
+
+    memmgr->delete_var( integrator);
+}
+
+TEST_F(IntegratorTest, Group_Restart) {
+
+    BALL balls[2];
+    Trick::IntegratorGroup group;
+    long   tick = 0;
+    double sim_time;
+
+    for (int ii = 0; ii < 2; ii++) {
+        init(&balls[ii]);
+        group.add_state(balls[ii].pos, balls[ii].vel, 4);
+    }
+    EXPECT_EQ(group.restart(), 0);
+    Trick::Integrator *integrator = group.getIntegrator( Runge_Kutta_4, 0.01);
+    ASSERT_TRUE( (void*)integrator != NULL);
+
+    // Simulation Loop
+    do {
+        sim_time = tick * integrator->dt ;
+        // A checkpoint reload gives the group a new integrator without the spans.
+        if (tick == 400) {
+            memmgr->delete_var( integrator);
+            integrator = Trick::getIntegrator( Runge_Kutta_4, 8, 0.01);
+            group.integrator = integrator;
+            EXPECT_EQ(group.restart(), 0);
+            // Restarting again replaces the spans instead of adding to them.
+            EXPECT_EQ(group.restart(), 0);
+        }
+        // Integration Loop
+        do {
+            integrator->time = sim_time;
+            for (int ii = 0; ii < 2; ii++) {
+                deriv( &balls[ii]);
+            }
+        } while ( group.integrate());
+        tick++;
+    } while (balls[0].pos[0] >= 0.0 && tick < 2000);
+    EXPECT_GT(tick, 400);
+
+    for (int ii = 0; ii < 2; ii++) {
+        verify_ball_sim_results(&balls[ii], 0.0000000001, -0.087238729171133289, 220.75, -43.321029810778249, 25.000000) ;
+    }
+
+    memmgr->delete_var( integrator);
+}
+
+TEST_F(IntegratorTest, Group_Second_Order) {
+
+    BALL ball;
+    Trick::IntegratorGroup group;
+
+    group.add_state(ball.pos, ball.vel, 4);
+    EXPECT_TRUE(group.getIntegrator( Euler_Cromer, 0.01) == NULL);
+    EXPECT_TRUE(group.integrator == NULL);
+    EXPECT_EQ(group.integrate(), 0);
+}
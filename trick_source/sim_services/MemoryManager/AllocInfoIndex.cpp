@@ -0,0 +1,123 @@
+#include <algorithm>
+
+#include "trick/AllocInfoIndex.hh"
+
+namespace {
+    struct EntryStartLess {
+        template < class E > bool operator()( const E & entry, char * address ) const { return entry.start < address ; }
+        template < class E > bool operator()( char * address, const E & entry ) const { return address < entry.start ; }
+    } ;
+}
+
+long Trick::AllocInfoIndex::find_block( char * address ) const {
+    std::vector< char * >::const_iterator it = std::upper_bound(block_starts.begin(), block_starts.end(), address) ;
+    return (long)(it - block_starts.begin()) - 1 ;
+}
+
+/**
+@details
+-# If the index is empty, create the first block.
+-# Find the block holding the start address. An address below every block goes in the first block.
+-# If an entry with the same start address exists, replace it.  Otherwise insert the entry in start address
+   order and update the block start if the entry is now first.
+-# Split the block in half when it holds twice #block_size entries.
+*/
+void Trick::AllocInfoIndex::insert( ALLOC_INFO * alloc_info ) {
+
+    Entry entry ;
+    entry.start = (char *)alloc_info->start ;
+    entry.end = (char *)alloc_info->end ;
+    entry.alloc_info = alloc_info ;
+
+    if ( blocks.empty() ) {
+        blocks.push_back(std::vector< Entry >()) ;
+        blocks.back().reserve(block_size) ;
+        block_starts.push_back(entry.start) ;
+    }
+
+    long bb = std::max(find_block(entry.start), 0L) ;
+    std::vector< Entry > & block = blocks[bb] ;
+    std::vector< Entry >::iterator it = std::lower_bound(block.begin(), block.end(), entry.start, EntryStartLess()) ;
+
+    if ( it != block.end() && it->start == entry.start ) {
+        *it = entry ;
+        __atomic_add_fetch(&epoch, 1, __ATOMIC_RELEASE) ;
+        return ;
+    }
+    if ( it == block.begin() ) {
+        block_starts[bb] = entry.start ;
+    }
+    block.insert(it, entry) ;
+    num_entries++ ;
+
+    if ( block.size() >= 2 * block_size ) {
+        std::vector< Entry > upper(block.begin() + block_size, block.end()) ;
+        block.resize(block_size) ;
+        block_starts.insert(block_starts.begin() + bb + 1, upper.front().start) ;
+        blocks.insert(blocks.begin() + bb + 1, std::vector< Entry >()) ;
+        blocks[bb + 1].swap(upper) ;
+    }
+    __atomic_add_fetch(&epoch, 1, __ATOMIC_RELEASE) ;
+}
+
+/**
+@details
+-# Find the entry starting at address.  Return -1 if there is none.
+-# Remove the entry.  Remove the block if it is empty, otherwise update its start address.
+-# Merge the block with the next one when both together fit in #block_size entries so deletes do not
+   leave many small blocks behind.
+*/
+int Trick::AllocInfoIndex::erase( void * address ) {
+
+    long bb = find_block((char *)address) ;
+    if ( bb < 0 ) {
+        return -1 ;
+    }
+
+    std::vector< Entry > & block = blocks[bb] ;
+    std::vector< Entry >::iterator it = std::lower_bound(block.begin(), block.end(), (char *)address, EntryStartLess()) ;
+    if ( it == block.end() || it->start != (char *)address ) {
+        return -1 ;
+    }
+    block.erase(it) ;
+    num_entries-- ;
+    __atomic_add_fetch(&epoch, 1, __ATOMIC_RELEASE) ;
+
+    if ( block.empty() ) {
+        blocks.erase(blocks.begin() + bb) ;
+        block_starts.erase(block_starts.begin() + bb) ;
+        return 0 ;
+    }
+    block_starts[bb] = block.front().start ;
+
+    if ( (size_t)bb + 1 < blocks.size() && block.size() + blocks[bb + 1].size() <= block_size ) {
+        block.insert(block.end(), blocks[bb + 1].begin(), blocks[bb + 1].end()) ;
+        blocks.erase(blocks.begin() + bb + 1) ;
+        block_starts.erase(block_starts.begin() + bb + 1) ;
+    }
+    return 0 ;
+}
+
+ALLOC_INFO * Trick::AllocInfoIndex::find( void * address ) const {
+
+    long bb = find_block((char *)address) ;
+    if ( bb < 0 ) {
+        return NULL ;
+    }
+
+    // The block start is not above address, so the entry before upper_bound exists.
+    const std::vector< Entry > & block = blocks[bb] ;
+    std::vector< Entry >::const_iterator it = std::upper_bound(block.begin(), block.end(), (char *)address, EntryStartLess()) ;
+    --it ;
+    if ( (char *)address <= it->end ) {
+        return it->alloc_info ;
+    }
+    return NULL ;
+}
+
+void Trick::AllocInfoIndex::clear() {
+    blocks.clear() ;
+    block_starts.clear() ;
+    num_entries = 0 ;
+    __atomic_add_fetch(&epoch, 1, __ATOMIC_RELEASE) ;
+}
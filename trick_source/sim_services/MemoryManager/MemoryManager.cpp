@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include "trick/MemoryManager.hh"
 #include "trick/ClassicCheckPointAgent.hh"
+#include "trick/BinaryCheckPointAgent.hh"
 // Global pointer to the (singleton) MemoryManager for the C language interface.
 Trick::MemoryManager * trick_MM = NULL;
 
@@ -23,6 +24,7 @@ Trick::MemoryManager::MemoryManager()
     debug_level = 0;
     hexfloat_checkpoint = 0;
     reduced_checkpoint  = 1;
+    binary_checkpoint = 0;
     resetting_memory = false;
     expanded_arrays  = 0;
     // start counter at 100mil.  This (hopefully) ensures all alloc'ed ids are after external variables.
@@ -38,6 +40,9 @@ Trick::MemoryManager::MemoryManager()
 
     currentCheckPointAgent = defaultCheckPointAgent;
 
+    binaryCheckPointAgent = new BinaryCheckPointAgent( this);
+    binaryCheckPointAgent->set_debug_level( debug_level);
+
     dlhandles.push_back(dlopen( NULL, RTLD_LAZY)) ;
 
     local_anon_var_prefix = "trick_anon_local_";
@@ -79,6 +84,7 @@ Trick::MemoryManager::~MemoryManager() {
     }
 
     delete defaultCheckPointAgent ;
+    delete binaryCheckPointAgent ;
 
     for ( ait = alloc_info_map.begin() ; ait != alloc_info_map.end() ; ait++ ) {
         ALLOC_INFO * ai_ptr = (*ait).second ;
@@ -94,6 +100,7 @@ Trick::MemoryManager::~MemoryManager() {
         free(ai_ptr) ;
     }
     alloc_info_map.clear() ;
+    alloc_info_index.clear() ;
 }
 
 #include <sstream>
@@ -264,6 +264,18 @@ extern "C" void TMM_hexfloat_checkpoint(int yesno) {
     }
 }
 
+/**
+ @relates Trick::MemoryManager
+ This is the C Language version of Trick::MemoryManager::set_binary_checkpoint( yesno).
+ */
+extern "C" void TMM_binary_checkpoint(int yesno) {
+    if (trick_MM != NULL) {
+        trick_MM->set_binary_checkpoint( yesno!=0 );
+    } else {
+        Trick::MemoryManager::emitError("TMM_binary_checkpoint() called before MemoryManager instantiation.\n") ;
+    }
+}
+
 
 
 
@@ -562,6 +574,19 @@ extern "C" ALLOC_INFO* get_alloc_info_at(void * addr) {
     }
 }
 
+/**
+ @relates Trick::MemoryManager
+ This is the C Language version of Trick::MemoryManager::get_alloc_epoch().
+ */
+extern "C" unsigned long long get_alloc_epoch(void) {
+    if (trick_MM != NULL) {
+        return( trick_MM->get_alloc_epoch());
+    } else {
+        Trick::MemoryManager::emitError("get_alloc_epoch() called before MemoryManager instantiation.\n") ;
+        return ( 0);
+    }
+}
+
 extern "C" int set_alloc_name_at(void * addr, const char * name ) {
     if (trick_MM != NULL) {
         return( trick_MM->set_name_at(addr, name));
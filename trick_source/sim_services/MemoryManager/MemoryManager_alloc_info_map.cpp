@@ -3,15 +3,8 @@
 #include <string.h>
 
 ALLOC_INFO* Trick::MemoryManager::get_alloc_info_of( void* addr) {
-
-    ALLOC_INFO_MAP::iterator pos = alloc_info_map.lower_bound(addr);
-    if (pos != alloc_info_map.end()) {
-        ALLOC_INFO* alloc_info = pos->second;
-        if (( addr >= alloc_info->start) && ( addr <= alloc_info->end)) {
-            return(alloc_info);
-        }
-    }
-    return NULL;
+    // alloc_info_index holds the same allocations as alloc_info_map, sorted for a faster interval search.
+    return alloc_info_index.find(addr);
 }
 
 ALLOC_INFO* Trick::MemoryManager::get_alloc_info_at( void* addr) {
@@ -29,6 +29,7 @@ int Trick::MemoryManager::delete_var(void* address ) {
         // BEGIN PROTECTION of the alloc_info_map.
         pthread_mutex_lock(&mm_mutex);
         alloc_info_map.erase( address);
+        alloc_info_index.erase( address);
         // END PROTECTION of the alloc_info_map.
         pthread_mutex_unlock(&mm_mutex);
 
@@ -123,6 +123,7 @@ void* Trick::MemoryManager::
         /** @li Insert the <address, ALLOC_INFO> key-value pair into the alloc_info_map.*/
         pthread_mutex_lock(&mm_mutex);
         alloc_info_map[address] = new_alloc;
+        alloc_info_index.insert(new_alloc);
 
         /** @li Insert the <variable-name, ALLOC_INFO> key-value pair into the variable map. */
         if (new_alloc->name) {
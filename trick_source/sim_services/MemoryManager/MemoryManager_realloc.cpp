@@ -165,6 +165,7 @@ void* Trick::MemoryManager::resize_array( void *address, int n_cdims, int *cdims
 
     // Remove the old <address, ALLOC_INFO*> key-value pair from the alloc_info_map.
     alloc_info_map.erase( address);
+    alloc_info_index.erase( address);
 
     /** @li Update the ALLOC_INFO record with new start and end addresses, with
             new extents and with the new number of elements.*/
@@ -177,6 +178,7 @@ void* Trick::MemoryManager::resize_array( void *address, int n_cdims, int *cdims
 
     /** @li Insert the new <address, ALLOC_INFO> key-value pair into the alloc_info_map.*/
     alloc_info_map[alloc_info->start] = alloc_info;
+    alloc_info_index.insert( alloc_info);
     pthread_mutex_unlock(&mm_mutex);
 
     /** @li If debug is enabled, show what happened.*/
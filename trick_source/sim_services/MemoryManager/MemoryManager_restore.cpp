@@ -6,6 +6,7 @@
 
 #include "trick/MemoryManager.hh"
 #include "trick/ClassicCheckPointAgent.hh"
+#include "trick/BinaryCheckPointAgent.hh"
 
 int Trick::MemoryManager::set_restore_stls_default (bool on_off) {
     restore_stls_default = on_off;
@@ -22,7 +23,13 @@ int Trick::MemoryManager::read_checkpoint( std::istream *is, bool do_restore_stl
         std::cout.flush();
     }
 
-    if (currentCheckPointAgent->restore( is) !=0 ) {
+    // A binary checkpoint is restored by the binary agent, whichever agent is current.
+    CheckPointAgent* agent = currentCheckPointAgent;
+    if (BinaryCheckPointAgent::is_binary_checkpoint( is)) {
+        agent = binaryCheckPointAgent;
+    }
+
+    if (agent->restore( is) !=0 ) {
        emitError("Checkpoint restore failed.") ;
     }
 
@@ -69,7 +76,11 @@ int Trick::MemoryManager::read_checkpoint( const char* filename, bool restore_st
     // Create a stream from the named file.
     std::ifstream infile(filename , std::ios::in);
     if (infile.is_open()) {
-        return ( read_checkpoint( &infile, restore_stls )) ;
+        // The base of an incremental binary checkpoint may be next to it.
+        binaryCheckPointAgent->set_checkpoint_file( filename);
+        int ret = read_checkpoint( &infile, restore_stls ) ;
+        binaryCheckPointAgent->set_checkpoint_file( "");
+        return ret ;
     } else {
         std::stringstream message;
         message << "Couldn't open \"" << filename << "\"." ;
@@ -1,9 +1,11 @@
 #include "trick/MemoryManager.hh"
+#include "trick/BinaryCheckPointAgent.hh"
 
 void Trick::MemoryManager::set_debug_level(int level) {
     debug_level = level;
     currentCheckPointAgent->set_debug_level(level);
     defaultCheckPointAgent->set_debug_level(level);
+    binaryCheckPointAgent->set_debug_level(level);
     return;
 }
 
@@ -19,6 +21,14 @@ void Trick::MemoryManager::set_hexfloat_checkpoint(bool flag) {
     defaultCheckPointAgent->set_hexfloat_checkpoint(flag);
 }
 
+void Trick::MemoryManager::set_binary_checkpoint(bool flag) {
+    binary_checkpoint = flag;
+}
+
+void Trick::MemoryManager::set_checkpoint_base(std::string file_name) {
+    checkpoint_base = file_name;
+}
+
 void Trick::MemoryManager::set_expanded_arrays(bool flag) {
     expanded_arrays = flag;
 }
@@ -4,6 +4,7 @@
 #include <stdlib.h>  // free()
 #include <algorithm> // std::sort()
 #include "trick/MemoryManager.hh"
+#include "trick/BinaryCheckPointAgent.hh"
 
 // GreenHills stuff
 #if ( __ghs )
@@ -19,10 +20,6 @@ void Trick::MemoryManager::execute_checkpoint( std::ostream& out_s ) {
     int local_anon_var_number;
     int extern_anon_var_number;
 
-    // 1) Generate declaration statements for each the allocations that we are managing.
-    out_s << "// Variable Declarations." << std::endl;
-    out_s.flush();
-
     local_anon_var_number = 0;
     extern_anon_var_number = 0;
 
@@ -49,29 +46,41 @@ void Trick::MemoryManager::execute_checkpoint( std::ostream& out_s ) {
         get_stl_dependencies(alloc_info);
     }
 
-    // Write a declaration statement for all of the LOCAL variables,
     n_depends = dependencies.size();
-    for (int ii = 0 ; ii < n_depends ; ii ++) {
-        alloc_info = dependencies[ii];
-        if ( alloc_info->stcl == TRICK_LOCAL) {
-            currentCheckPointAgent->write_decl( out_s, alloc_info);
+
+    if (binary_checkpoint) {
+        // Write the declarations and the contents of all of the allocations as a binary image.
+        if (binaryCheckPointAgent->write_checkpoint( out_s, dependencies, checkpoint_base) != 0) {
+            emitError("write_checkpoint: Failed to write the binary checkpoint.") ;
         }
-    }
+    } else {
+        // 1) Generate declaration statements for each the allocations that we are managing.
+        out_s << "// Variable Declarations." << std::endl;
+        out_s.flush();
 
-    // Write a "clear_all_vars" command.
-    if (reduced_checkpoint) {
-        out_s << std::endl << std::endl << "// Clear all allocations to 0." << std::endl;
-        out_s << "clear_all_vars();" << std::endl;
-    }
+        // Write a declaration statement for all of the LOCAL variables,
+        for (int ii = 0 ; ii < n_depends ; ii ++) {
+            alloc_info = dependencies[ii];
+            if ( alloc_info->stcl == TRICK_LOCAL) {
+                currentCheckPointAgent->write_decl( out_s, alloc_info);
+            }
+        }
 
-    // 2) Dump the contents of each of the dynamic and mapped allocations.
-    out_s << std::endl << std::endl << "// Variable Assignments." << std::endl;
-    out_s.flush();
+        // Write a "clear_all_vars" command.
+        if (reduced_checkpoint) {
+            out_s << std::endl << std::endl << "// Clear all allocations to 0." << std::endl;
+            out_s << "clear_all_vars();" << std::endl;
+        }
 
-    for (int ii = 0 ; ii < n_depends ; ii ++) {
-        alloc_info = dependencies[ii];
-        write_var( out_s, alloc_info);
-        out_s << std::endl;
+        // 2) Dump the contents of each of the dynamic and mapped allocations.
+        out_s << std::endl << std::endl << "// Variable Assignments." << std::endl;
+        out_s.flush();
+
+        for (int ii = 0 ; ii < n_depends ; ii ++) {
+            alloc_info = dependencies[ii];
+            write_var( out_s, alloc_info);
+            out_s << std::endl;
+        }
     }
 
     // Free all of the temporary names that were created for the checkpoint.
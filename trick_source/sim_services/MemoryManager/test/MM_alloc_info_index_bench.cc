@@ -0,0 +1,124 @@
+/*
+   Microbenchmark comparing address lookups in the std::map alloc_info_map and the AllocInfoIndex.
+
+   Usage: MM_alloc_info_index_bench [num_lookups]
+
+   100k and 1M allocations of 8 to 256 bytes are laid out with gaps in one arena, inserted into both
+   containers in a shuffled order, and looked up with the same random addresses, a quarter of which
+   fall in a gap.  The results of both searches must match.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+
+#include "trick/MemoryManager.hh"
+#include "trick/AllocInfoIndex.hh"
+
+static double wall_time() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return tp.tv_sec + tp.tv_nsec / 1.0e9 ;
+}
+
+static ALLOC_INFO * map_find( Trick::ALLOC_INFO_MAP & map , void * addr ) {
+    Trick::ALLOC_INFO_MAP::iterator pos = map.lower_bound(addr) ;
+    if ( pos != map.end() ) {
+        ALLOC_INFO * alloc_info = pos->second ;
+        if (( addr >= alloc_info->start) && ( addr <= alloc_info->end)) {
+            return alloc_info ;
+        }
+    }
+    return NULL ;
+}
+
+static int compare( unsigned int num_allocs , unsigned int num_lookups ) {
+
+    std::vector< ALLOC_INFO > infos(num_allocs) ;
+    std::vector< size_t > offsets(num_allocs) ;
+    std::vector< ALLOC_INFO * > order(num_allocs) ;
+    std::vector< char * > addrs(num_lookups) ;
+    Trick::ALLOC_INFO_MAP map ;
+    Trick::AllocInfoIndex index ;
+    unsigned int ii ;
+    size_t arena_size = 0 ;
+
+    srand(num_allocs) ;
+    for ( ii = 0 ; ii < num_allocs ; ii++ ) {
+        offsets[ii] = arena_size ;
+        arena_size += 8 * (1 + rand() % 32) + 8 * (rand() % 4) ;
+    }
+    std::vector< char > arena(arena_size + 8) ;
+    for ( ii = 0 ; ii < num_allocs ; ii++ ) {
+        size_t next = ( ii + 1 < num_allocs ) ? offsets[ii + 1] : arena_size ;
+        infos[ii].start = &arena[offsets[ii]] ;
+        infos[ii].end = &arena[offsets[ii] + std::max((size_t)8, (next - offsets[ii]) * 3 / 4) - 1] ;
+        order[ii] = &infos[ii] ;
+    }
+    for ( ii = num_allocs - 1 ; ii > 0 ; ii-- ) {
+        std::swap(order[ii], order[rand() % (ii + 1)]) ;
+    }
+
+    double start = wall_time() ;
+    for ( ii = 0 ; ii < num_allocs ; ii++ ) {
+        map[order[ii]->start] = order[ii] ;
+    }
+    double map_insert_time = wall_time() - start ;
+
+    start = wall_time() ;
+    for ( ii = 0 ; ii < num_allocs ; ii++ ) {
+        index.insert(order[ii]) ;
+    }
+    double index_insert_time = wall_time() - start ;
+
+    for ( ii = 0 ; ii < num_lookups ; ii++ ) {
+        addrs[ii] = &arena[((size_t)rand() * RAND_MAX + rand()) % arena_size] ;
+    }
+
+    unsigned long long map_found = 0 , index_found = 0 ;
+    int mismatches = 0 ;
+
+    start = wall_time() ;
+    for ( ii = 0 ; ii < num_lookups ; ii++ ) {
+        map_found += ( map_find(map, addrs[ii]) != NULL ) ;
+    }
+    double map_time = wall_time() - start ;
+
+    start = wall_time() ;
+    for ( ii = 0 ; ii < num_lookups ; ii++ ) {
+        index_found += ( index.find(addrs[ii]) != NULL ) ;
+    }
+    double index_time = wall_time() - start ;
+
+    for ( ii = 0 ; ii < num_lookups ; ii++ ) {
+        mismatches += ( map_find(map, addrs[ii]) != index.find(addrs[ii]) ) ;
+    }
+
+    std::cout << std::fixed << std::setprecision(1) ;
+    std::cout << "allocations = " << num_allocs << " lookups = " << num_lookups << " found = " << index_found << std::endl ;
+    std::cout << "    map   : " << map_time * 1.0e9 / num_lookups << " ns/lookup "
+              << map_insert_time * 1.0e9 / num_allocs << " ns/insert" << std::endl ;
+    std::cout << "    index : " << index_time * 1.0e9 / num_lookups << " ns/lookup "
+              << index_insert_time * 1.0e9 / num_allocs << " ns/insert" << std::endl ;
+    std::cout << "    speedup : " << std::setprecision(2) << map_time / index_time << std::endl ;
+
+    return ( mismatches == 0 && map_found == index_found ) ? 0 : 1 ;
+}
+
+int main( int argc , char * argv[] ) {
+
+    unsigned int num_lookups = 2000000 ;
+    int ret = 0 ;
+
+    if ( argc > 1 ) {
+        num_lookups = (unsigned int)strtoul(argv[1], NULL, 10) ;
+    }
+
+    ret |= compare(100000, num_lookups) ;
+    ret |= compare(1000000, num_lookups) ;
+
+    return ret ;
+}
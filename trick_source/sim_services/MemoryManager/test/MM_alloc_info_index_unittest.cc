@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "trick/MemoryManager.hh"
+#include "trick/AllocInfoIndex.hh"
+#include <stdlib.h>
+#include <vector>
+
+/*
+ Test Fixture.
+ */
+class MM_alloc_info_index_unittest : public ::testing::Test {
+    protected:
+    Trick::MemoryManager *memmgr;
+    std::vector<char> arena;
+    std::vector<ALLOC_INFO> infos;
+    MM_alloc_info_index_unittest() { memmgr = new Trick::MemoryManager; }
+    ~MM_alloc_info_index_unittest() { delete memmgr; }
+    void SetUp() {}
+    void TearDown() {}
+
+    /* Make num ALLOC_INFO records of 16 bytes, each followed by a 16 byte gap. */
+    void make_infos( int num ) {
+        arena.resize(num * 32);
+        infos.resize(num);
+        for (int ii = 0 ; ii < num ; ii++) {
+            infos[ii].start = &arena[ii * 32];
+            infos[ii].end = &arena[ii * 32 + 15];
+        }
+    }
+
+    /* Same search as the std::map based get_alloc_info_of. */
+    static ALLOC_INFO* map_find( Trick::ALLOC_INFO_MAP & map, void* addr ) {
+        Trick::ALLOC_INFO_MAP::iterator pos = map.lower_bound(addr);
+        if (pos != map.end() && addr <= pos->second->end) {
+            return pos->second;
+        }
+        return NULL;
+    }
+};
+
+/* ================================================================================
+                                      Test Cases
+   ================================================================================
+*/
+
+TEST_F(MM_alloc_info_index_unittest, find) {
+
+    Trick::AllocInfoIndex index;
+    make_infos(3);
+
+    EXPECT_EQ((ALLOC_INFO*)NULL, index.find(&arena[0]));
+    index.insert(&infos[1]);
+    index.insert(&infos[0]);
+    EXPECT_EQ((size_t)2, index.size());
+
+    EXPECT_EQ(&infos[0], index.find(&arena[0]));
+    EXPECT_EQ(&infos[0], index.find(&arena[15]));
+    EXPECT_EQ((ALLOC_INFO*)NULL, index.find(&arena[16]));
+    EXPECT_EQ(&infos[1], index.find(&arena[40]));
+    EXPECT_EQ((ALLOC_INFO*)NULL, index.find(&arena[64]));
+
+    // Inserting the same start address replaces the allocation.
+    infos[2].start = infos[1].start;
+    infos[2].end = &arena[63];
+    index.insert(&infos[2]);
+    EXPECT_EQ((size_t)2, index.size());
+    EXPECT_EQ(&infos[2], index.find(&arena[63]));
+
+    EXPECT_EQ(0, index.erase(&arena[0]));
+    EXPECT_EQ(-1, index.erase(&arena[0]));
+    EXPECT_EQ((ALLOC_INFO*)NULL, index.find(&arena[0]));
+    EXPECT_EQ(&infos[2], index.find(&arena[32]));
+
+    index.clear();
+    EXPECT_EQ((size_t)0, index.size());
+    EXPECT_EQ((ALLOC_INFO*)NULL, index.find(&arena[32]));
+}
+
+TEST_F(MM_alloc_info_index_unittest, matches_map) {
+
+    // Enough allocations to split and merge many blocks.
+    const int num = 20000;
+    Trick::AllocInfoIndex index;
+    Trick::ALLOC_INFO_MAP map;
+    make_infos(num);
+    srand(1);
+
+    for (int pass = 0 ; pass < 4 ; pass++) {
+        for (int ii = 0 ; ii < num ; ii++) {
+            ALLOC_INFO* info = &infos[rand() % num];
+            if (rand() % 3 == 0 && pass < 3) {
+                map.erase(info->start);
+                index.erase(info->start);
+            } else {
+                map[info->start] = info;
+                index.insert(info);
+            }
+        }
+        ASSERT_EQ(map.size(), index.size());
+        for (int ii = 0 ; ii < num * 32 ; ii += 3) {
+            ASSERT_EQ(map_find(map, &arena[ii]), index.find(&arena[ii])) << "offset " << ii;
+        }
+    }
+
+    // Erase everything in a different order than it was inserted.
+    for (int ii = 0 ; ii < num ; ii++) {
+        index.erase(infos[(ii * 7919) % num].start);
+    }
+    EXPECT_EQ((size_t)0, index.size());
+    EXPECT_EQ((ALLOC_INFO*)NULL, index.find(&arena[0]));
+}
+
+TEST_F(MM_alloc_info_index_unittest, declare_resize_delete) {
+
+    double* dbl_p = (double*)memmgr->declare_var("double dbl_array[10]");
+    ALLOC_INFO* alloc_info = memmgr->get_alloc_info_of(&dbl_p[5]);
+    ASSERT_TRUE(alloc_info != NULL);
+    EXPECT_EQ((void*)dbl_p, alloc_info->start);
+
+    double external[4];
+    memmgr->declare_extern_var(external, "double external[4]");
+    EXPECT_EQ((void*)external, memmgr->get_alloc_info_of(&external[3])->start);
+
+    // The allocation moves when it is resized.
+    double* resized_p = (double*)memmgr->resize_array(dbl_p, 1000);
+    ASSERT_TRUE(resized_p != NULL);
+    alloc_info = memmgr->get_alloc_info_of(&resized_p[999]);
+    ASSERT_TRUE(alloc_info != NULL);
+    EXPECT_EQ((void*)resized_p, alloc_info->start);
+
+    memmgr->delete_var(resized_p);
+    EXPECT_EQ((ALLOC_INFO*)NULL, memmgr->get_alloc_info_of(&resized_p[5]));
+    memmgr->delete_var(external);
+    EXPECT_EQ((ALLOC_INFO*)NULL, memmgr->get_alloc_info_of(&external[3]));
+}
@@ -0,0 +1,266 @@
+
+#include <gtest/gtest.h>
+#include "trick/MemoryManager.hh"
+#include "trick/BinaryCheckPointAgent.hh"
+#include "MM_test.hh"
+#include "MM_write_checkpoint.hh"
+#include <iostream>
+#include <sstream>
+#include <string.h>
+
+/*
+ Test Fixture.
+ */
+class MM_binary_checkpoint : public ::testing::Test {
+	protected:
+	Trick::MemoryManager *memmgr;
+		MM_binary_checkpoint() { memmgr = new Trick::MemoryManager; memmgr->set_binary_checkpoint(true); }
+		~MM_binary_checkpoint() { delete memmgr;   }
+		void SetUp() {}
+		void TearDown() {}
+};
+
+// Address of a named allocation, which moves when it is restored.
+static void* named_address( Trick::MemoryManager* memmgr, const char* name) {
+    for ( Trick::VARIABLE_MAP_ITER it = memmgr->variable_map_begin() ; it != memmgr->variable_map_end() ; it++ ) {
+        if ( it->first == name ) {
+            return it->second->start;
+        }
+    }
+    return NULL;
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, is_binary) {
+
+    std::stringstream ss;
+
+    (void) memmgr->declare_var("double dbl");
+    memmgr->write_checkpoint( ss, "dbl");
+
+    EXPECT_TRUE( Trick::BinaryCheckPointAgent::is_binary_checkpoint(&ss));
+    EXPECT_EQ( 0, memcmp( ss.str().c_str(), Trick::BinaryCheckPointAgent::magic, sizeof(Trick::BinaryCheckPointAgent::magic)));
+    // Checking does not consume the stream.
+    EXPECT_EQ( 0, (int)ss.tellg());
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, text_still_available) {
+
+    std::stringstream ss;
+
+    double *dbl_p = (double*)memmgr->declare_var("double dbl");
+    *dbl_p = 2.5;
+
+    memmgr->set_binary_checkpoint(false);
+    memmgr->write_checkpoint( ss, "dbl");
+
+    EXPECT_FALSE( Trick::BinaryCheckPointAgent::is_binary_checkpoint(&ss));
+    EXPECT_NE( std::string::npos, ss.str().find("dbl = 2.5;"));
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, array_of_double) {
+
+    std::stringstream ss;
+    double* dbl_ptr;
+
+    (void) memmgr->declare_extern_var(&dbl_ptr, "double* dbl_ptr");
+    dbl_ptr = (double*)memmgr->declare_var("double", 1000);
+    for (int ii = 0 ; ii < 1000 ; ii++) {
+        dbl_ptr[ii] = ii * 0.5;
+    }
+
+    memmgr->write_checkpoint( ss);
+    dbl_ptr = NULL;
+
+    memmgr->init_from_checkpoint( &ss);
+
+    ASSERT_TRUE( dbl_ptr != NULL);
+    ALLOC_INFO *alloc_info = memmgr->get_alloc_info_at( dbl_ptr);
+    ASSERT_TRUE( alloc_info != NULL);
+    EXPECT_EQ( 1000, alloc_info->num);
+    // The temporary name of the anonymous allocation is removed after the restore.
+    EXPECT_TRUE( alloc_info->name == NULL);
+    EXPECT_EQ( 0.0, dbl_ptr[0]);
+    EXPECT_EQ( 499.5, dbl_ptr[999]);
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, udt_pointers) {
+
+    std::stringstream ss;
+    UDT1 root;
+
+    (void) memmgr->declare_extern_var(&root, "UDT1 root");
+    UDT1 *udt_p = (UDT1*)memmgr->declare_var("UDT1 udt2");
+    double *dbl_p = (double*)memmgr->declare_var("double dbls[4]");
+    MONTH *month_p = (MONTH*)memmgr->declare_var("MONTH month");
+
+    root.x = 3.1415;
+    root.udt_p = udt_p;
+    root.dbl_p = &dbl_p[2];
+    root.month_p = month_p;
+    udt_p->x = 2.0;
+    udt_p->udt_p = udt_p;
+    udt_p->dbl_p = NULL;
+    udt_p->month_p = NULL;
+    dbl_p[2] = 6.0;
+    *month_p = MARCH;
+
+    memmgr->write_checkpoint( ss);
+
+    root.x = 0.0;
+    root.udt_p = NULL;
+    root.dbl_p = NULL;
+    root.month_p = NULL;
+
+    memmgr->init_from_checkpoint( &ss);
+
+    EXPECT_EQ( 3.1415, root.x);
+    ASSERT_TRUE( root.udt_p != NULL);
+    EXPECT_EQ( 2.0, root.udt_p->x);
+    EXPECT_EQ( root.udt_p, root.udt_p->udt_p);
+    EXPECT_TRUE( root.udt_p->dbl_p == NULL);
+    ASSERT_TRUE( root.dbl_p != NULL);
+    EXPECT_EQ( 6.0, *root.dbl_p);
+    ALLOC_INFO *alloc_info = memmgr->get_alloc_info_of( root.dbl_p);
+    ASSERT_TRUE( alloc_info != NULL);
+    EXPECT_STREQ( "dbls", alloc_info->name);
+    EXPECT_EQ( (char*)alloc_info->start + 2 * sizeof(double), (char*)root.dbl_p);
+    ASSERT_TRUE( root.month_p != NULL);
+    EXPECT_EQ( MARCH, *root.month_p);
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, io_test) {
+
+    std::stringstream ss;
+    UDT5 udt5;
+
+    (void) memmgr->declare_extern_var(&udt5, "UDT5 udt5");
+    udt5.star_star    = 3.0;
+    udt5.star_aye     = 5.0;
+    udt5.star_eau     = 8.0;
+    udt5.star_aye_eau = 13.0;
+
+    memmgr->write_checkpoint( ss, "udt5");
+
+    udt5.star_star    = -1.0;
+    udt5.star_aye     = -1.0;
+    udt5.star_eau     = -1.0;
+    udt5.star_aye_eau = -1.0;
+
+    memmgr->read_checkpoint( &ss);
+
+    // Only the member allowed both checkpoint output and input is restored.
+    EXPECT_EQ( -1.0, udt5.star_star);
+    EXPECT_EQ( -1.0, udt5.star_aye);
+    EXPECT_EQ( -1.0, udt5.star_eau);
+    EXPECT_EQ( 13.0, udt5.star_aye_eau);
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, string) {
+
+    std::stringstream ss;
+    std::string *string_ptr;
+
+    (void) memmgr->declare_extern_var(&string_ptr, "std::string* string_ptr");
+    string_ptr = (std::string*)memmgr->declare_var("std::string", 2);
+    string_ptr[0] = "hello there!";
+
+    memmgr->write_checkpoint( ss);
+    string_ptr = NULL;
+
+    memmgr->init_from_checkpoint( &ss);
+
+    ASSERT_TRUE( string_ptr != NULL);
+    EXPECT_EQ( "hello there!", string_ptr[0]);
+    EXPECT_EQ( "", string_ptr[1]);
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, truncated) {
+
+    std::stringstream ss;
+    double *dbl_p = (double*)memmgr->declare_var("double dbls[100]");
+    dbl_p[99] = 1.0;
+
+    memmgr->write_checkpoint( ss, "dbls");
+
+    std::string truncated = ss.str().substr(0, ss.str().size() / 2);
+    std::stringstream ts(truncated);
+    dbl_p[99] = 2.0;
+
+    Trick::BinaryCheckPointAgent agent(memmgr);
+    EXPECT_EQ( 1, agent.restore( &ts));
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, incremental) {
+
+    double *big_p = (double*)memmgr->declare_var("double big[1000]");
+    double *small_p = (double*)memmgr->declare_var("double small[4]");
+    double *anon_p = (double*)memmgr->declare_var("double", 10);
+    double **ptr_p = (double**)memmgr->declare_var("double* ptr");
+    for (int ii = 0 ; ii < 1000 ; ii++) {
+        big_p[ii] = ii;
+    }
+    anon_p[5] = 5.5;
+    *ptr_p = &anon_p[5];
+
+    memmgr->write_checkpoint("MM_binary_checkpoint_base.ckpnt");
+    small_p[3] = 3.0;
+
+    std::stringstream full;
+    memmgr->write_checkpoint( full);
+
+    memmgr->set_checkpoint_base("MM_binary_checkpoint_base.ckpnt");
+    memmgr->write_checkpoint("MM_binary_checkpoint_delta.ckpnt");
+    std::stringstream delta;
+    memmgr->write_checkpoint( delta);
+    memmgr->set_checkpoint_base("");
+
+    // Only small changed since the base was written.
+    EXPECT_LT( delta.str().size() + 1000 * sizeof(double), full.str().size());
+
+    memmgr->init_from_checkpoint("MM_binary_checkpoint_delta.ckpnt");
+
+    big_p = (double*)named_address( memmgr, "big");
+    small_p = (double*)named_address( memmgr, "small");
+    ptr_p = (double**)named_address( memmgr, "ptr");
+    ASSERT_TRUE( big_p != NULL && small_p != NULL && ptr_p != NULL);
+    EXPECT_EQ( 999.0, big_p[999]);
+    EXPECT_EQ( 3.0, small_p[3]);
+    // The pointer was restored from the base, into the anonymous allocation declared by the delta.
+    ASSERT_TRUE( *ptr_p != NULL);
+    EXPECT_EQ( 5.5, **ptr_p);
+    ALLOC_INFO *alloc_info = memmgr->get_alloc_info_of( *ptr_p);
+    ASSERT_TRUE( alloc_info != NULL);
+    EXPECT_EQ( 10, alloc_info->num);
+
+    remove("MM_binary_checkpoint_base.ckpnt");
+    remove("MM_binary_checkpoint_delta.ckpnt");
+}
+
+// ================================================================================
+TEST_F(MM_binary_checkpoint, replaced_base) {
+
+    double *dbl_p = (double*)memmgr->declare_var("double dbl");
+    *dbl_p = 1.0;
+
+    memmgr->write_checkpoint("MM_binary_checkpoint_base.ckpnt");
+    memmgr->set_checkpoint_base("MM_binary_checkpoint_base.ckpnt");
+    std::stringstream delta;
+    memmgr->write_checkpoint( delta);
+    memmgr->set_checkpoint_base("");
+
+    // A later checkpoint written to the base's file is not mistaken for the base.
+    memmgr->write_checkpoint("MM_binary_checkpoint_base.ckpnt");
+
+    Trick::BinaryCheckPointAgent agent(memmgr);
+    EXPECT_EQ( 1, agent.restore( &delta));
+
+    remove("MM_binary_checkpoint_base.ckpnt");
+}
@@ -31,11 +31,16 @@ int Trick::MessageFile::set_file_name(std::string in_name) {
 
 /**
 @details
+-# Closes the file stream if it is open.  A Monte Carlo run forked after initialization opens the file again in
+   its own output directory.
 -# Deletes the current output file
 -# Opens a new file with the name "file_name"
 */
 int Trick::MessageFile::init() {
 
+    if ( out_stream.is_open() ) {
+        out_stream.close() ;
+    }
     unlink((std::string(command_line_args_get_output_dir()) + "/" + file_name).c_str()) ;
     out_stream.open((std::string(command_line_args_get_output_dir()) + "/" + file_name).c_str() , std::fstream::out | std::fstream::app ) ;
     return(0) ;
@@ -11,6 +11,13 @@ Trick::MonteCarlo::MonteCarlo() :
     timeout(120),
     max_tries(2),
     verbosity(MC_INFORMATIONAL),
+    fork_point(MC_FORK_PRE_INIT),
+    num_local_workers(0),
+    local_worker_first_cpu(-1),
+    local_read_fd(-1),
+    local_write_fd(-1),
+    local_results_read(0),
+    buffer_local_results(false),
     num_runs(0),
     actual_num_runs(0),
     num_results(0),
@@ -65,6 +65,45 @@ extern "C" int mc_get_custom_slave_dispatch(void) {
     return 0 ;
 }
 
+extern "C" void mc_set_fork_point(int fork_point) {
+    if ( the_mc != NULL ) {
+        the_mc->set_fork_point((Trick::MonteCarlo::ForkPoint)fork_point);
+    }
+}
+
+extern "C" int mc_get_fork_point(void) {
+    if ( the_mc != NULL ) {
+        return the_mc->get_fork_point();
+    }
+    return 0 ;
+}
+
+extern "C" void mc_set_local_workers(unsigned int num_workers) {
+    if ( the_mc != NULL ) {
+        the_mc->set_local_workers(num_workers);
+    }
+}
+
+extern "C" unsigned int mc_get_local_workers(void) {
+    if ( the_mc != NULL ) {
+        return the_mc->get_local_workers();
+    }
+    return 0 ;
+}
+
+extern "C" void mc_set_local_worker_first_cpu(int first_cpu) {
+    if ( the_mc != NULL ) {
+        the_mc->set_local_worker_first_cpu(first_cpu);
+    }
+}
+
+extern "C" int mc_get_local_worker_first_cpu(void) {
+    if ( the_mc != NULL ) {
+        return the_mc->get_local_worker_first_cpu();
+    }
+    return -1 ;
+}
+
 extern "C" void mc_set_timeout(double timeout) {
     if ( the_mc != NULL ) {
         the_mc->set_timeout(timeout);
@@ -15,36 +15,47 @@ void Trick::MonteCarlo::dispatch_run_to_slave(MonteRun *run, MonteSlave *slave)
             return;
         }
         slave->state = MonteSlave::MC_RUNNING;
-        connection_device.hostname = (char*)slave->machine_name.c_str();
-        connection_device.port = slave->port;
-        if (tc_connect(&connection_device) == TC_SUCCESS) {
-            std::stringstream buffer_stream;
-            buffer_stream << slave_output_directory << "/RUN_" << std::setw(5) << std::setfill('0') << run->id;
-            std::string buffer = "";
-            for (std::vector<std::string>::size_type j = 0; j < run->variables.size(); ++j) {
-                buffer += run->variables[j] + "\n";
-            }
-            buffer += std::string("trick.set_output_dir(\"") + buffer_stream.str() + std::string("\")\n");
-            buffer_stream.str("");
-            buffer_stream << run->id ;
-            buffer += std::string("trick.mc_set_current_run(") + buffer_stream.str() + std::string(")\n");
 
+        std::stringstream buffer_stream;
+        buffer_stream << slave_output_directory << "/RUN_" << std::setw(5) << std::setfill('0') << run->id;
+        std::string buffer = "";
+        for (std::vector<std::string>::size_type j = 0; j < run->variables.size(); ++j) {
+            buffer += run->variables[j] + "\n";
+        }
+        buffer += std::string("trick.set_output_dir(\"") + buffer_stream.str() + std::string("\")\n");
+        buffer_stream.str("");
+        buffer_stream << run->id ;
+        buffer += std::string("trick.mc_set_current_run(") + buffer_stream.str() + std::string(")\n");
+
+        /** A local worker reads the run from its pipe, other slaves are sent the run over a new connection. */
+        bool connected;
+        if (slave->local) {
+            local_write_fd = slave->dispatch_fd;
+            connected = (local_write_fd >= 0);
+        } else {
+            connection_device.hostname = (char*)slave->machine_name.c_str();
+            connection_device.port = slave->port;
+            connected = (tc_connect(&connection_device) == TC_SUCCESS);
+        }
+
+        if (connected) {
             if (verbosity >= MC_INFORMATIONAL) {
                 message_publish(MSG_INFO, "Monte [Master] Dispatching run %d to %s:%d.\n",
 		     run->id, slave->machine_name.c_str(), slave->id) ;
             }
 
             int command = htonl(MonteSlave::MC_PROCESS_RUN);
-            tc_write(&connection_device, (char *)&command, (int)sizeof(command));
+            write((char *)&command, (int)sizeof(command));
             int num_bytes = htonl(buffer.length());
-            tc_write(&connection_device, (char*)&num_bytes, (int)sizeof(num_bytes));
-            tc_write(&connection_device, (char*)buffer.c_str(), (int)buffer.length());
+            write((char*)&num_bytes, (int)sizeof(num_bytes));
+            write((char*)buffer.c_str(), (int)buffer.length());
 
             if (verbosity >= MC_ALL) {
                 message_publish(MSG_INFO, "Parameterization of run %d :\n%s\n", run->id, buffer.c_str()) ;
             }
 
-            tc_disconnect(&connection_device);
+            disconnect();
+            local_write_fd = -1;
 
             ++slave->num_dispatches;
             slave->current_run = run;
@@ -54,6 +65,7 @@ void Trick::MonteCarlo::dispatch_run_to_slave(MonteRun *run, MonteSlave *slave)
             run->start_time = time_val.tv_sec + (double)time_val.tv_usec / 1000000;
             ++run->num_tries;
         } else {
+            local_write_fd = -1;
             slave->state = Trick::MonteSlave::MC_DISCONNECTED;
             if (verbosity >= MC_ERROR) {
                 message_publish(MSG_ERROR, "Monte [Master] Failed to connect to %s:%d to dispatch run.\n",
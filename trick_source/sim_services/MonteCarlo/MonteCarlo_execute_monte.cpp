@@ -15,10 +15,24 @@ int Trick::MonteCarlo::execute_monte() {
                 exit(0);
             }
             master();
-        } else {
+        } else if (fork_point == MC_FORK_PRE_INIT) {
             slave_init();
             execute_as_slave();
         }
     }
     return(0);
 }
+
+/**
+@details
+-# A slave forking after initialization waits for runs here.  Every job before this one was executed once by the
+   slave, and each run's child process returns from execute_as_slave() to finish initialization.
+*/
+int Trick::MonteCarlo::execute_monte_post_init() {
+
+    if (enabled && !is_master() && fork_point == MC_FORK_POST_INIT) {
+        slave_init();
+        execute_as_slave();
+    }
+    return(0);
+}
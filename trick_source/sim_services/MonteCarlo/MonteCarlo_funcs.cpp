@@ -1,5 +1,8 @@
 
 #include <sys/time.h>
+#include <algorithm>
+#include <errno.h>
+#include <unistd.h>
 
 #include "trick/MonteCarlo.hh"
 #include "trick/memorymanager_c_intf.h"
@@ -57,6 +60,30 @@ bool Trick::MonteCarlo::get_custom_slave_dispatch() {
     return custom_slave_dispatch;
 }
 
+void Trick::MonteCarlo::set_fork_point(ForkPoint in_fork_point) {
+    this->fork_point = in_fork_point;
+}
+
+Trick::MonteCarlo::ForkPoint Trick::MonteCarlo::get_fork_point() {
+    return fork_point;
+}
+
+void Trick::MonteCarlo::set_local_workers(unsigned int in_num_workers) {
+    this->num_local_workers = in_num_workers;
+}
+
+unsigned int Trick::MonteCarlo::get_local_workers() {
+    return num_local_workers;
+}
+
+void Trick::MonteCarlo::set_local_worker_first_cpu(int in_first_cpu) {
+    this->local_worker_first_cpu = in_first_cpu;
+}
+
+int Trick::MonteCarlo::get_local_worker_first_cpu() {
+    return local_worker_first_cpu;
+}
+
 void Trick::MonteCarlo::set_timeout(double in_timeout) {
     this->timeout = in_timeout;
 }
@@ -294,19 +321,27 @@ int Trick::MonteCarlo::process_sim_args() {
 int Trick::MonteCarlo::shutdown() {
     /** <ul><li> If this is a slave, run the shutdown jobs. */
     if (enabled && is_slave()) {
-        connection_device.port = master_port;
-        if (tc_connect(&connection_device) == TC_SUCCESS) {
+        if (connect_to_master() == 0) {
             int exit_status = the_exec->get_except_return() ? MonteRun::MC_RUN_FAILED : MonteRun::MC_RUN_COMPLETE;
             if (verbosity >= MC_ALL) {
                 message_publish(MSG_INFO, "Monte [%s:%d] Sending run exit status to master: %d\n",
                                 machine_name.c_str(), slave_id, exit_status) ;
             }
-            int id = htonl(slave_id);
-            tc_write(&connection_device, (char*)&id, (int)sizeof(id));
-            exit_status = htonl(exit_status);
-            tc_write(&connection_device, (char*)&exit_status, (int)sizeof(exit_status));
-            run_queue(&slave_post_queue, "in slave_post queue");
-            tc_disconnect(&connection_device);
+            if (local_write_fd >= 0) {
+                /** <ul><li> A local worker sends the data of the slave post jobs after the exit status. */
+                buffer_local_results = true;
+                run_queue(&slave_post_queue, "in slave_post queue");
+                buffer_local_results = false;
+                write_local_results(exit_status);
+            } else {
+                /** <li> Other slaves write the data of the slave post jobs to the socket directly. </ul> */
+                int id = htonl(slave_id);
+                write((char*)&id, (int)sizeof(id));
+                exit_status = htonl(exit_status);
+                write((char*)&exit_status, (int)sizeof(exit_status));
+                run_queue(&slave_post_queue, "in slave_post queue");
+            }
+            disconnect();
         } else {
             if (verbosity >= MC_ERROR)
                 message_publish(
@@ -622,9 +657,43 @@ int Trick::MonteCarlo::write_s_job_execution(FILE *fp) {
 }
 
 int Trick::MonteCarlo::write(char* data, int size) {
+    if (buffer_local_results) {
+        local_results.append(data, size);
+        return size;
+    }
+    if (local_write_fd >= 0) {
+        int num_written = 0;
+        while (num_written < size) {
+            ssize_t ret = ::write(local_write_fd, data + num_written, size - num_written);
+            if (ret <= 0) {
+                if (ret == -1 && errno == EINTR) continue;
+                return ret;
+            }
+            num_written += ret;
+        }
+        return num_written;
+    }
     return tc_write(&connection_device, data, size);
 }
 
 int Trick::MonteCarlo::read(char* data, int size) {
+    if (buffer_local_results) {
+        int num_read = std::min((std::string::size_type)size, local_results.size() - local_results_read);
+        local_results.copy(data, num_read, local_results_read);
+        local_results_read += num_read;
+        return num_read;
+    }
+    if (local_read_fd >= 0) {
+        int num_read = 0;
+        while (num_read < size) {
+            ssize_t ret = ::read(local_read_fd, data + num_read, size - num_read);
+            if (ret <= 0) {
+                if (ret == -1 && errno == EINTR) continue;
+                return num_read ? num_read : ret;
+            }
+            num_read += ret;
+        }
+        return num_read;
+    }
     return tc_read(&connection_device, data, size);
 }
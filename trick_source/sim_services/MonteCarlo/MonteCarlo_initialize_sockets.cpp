@@ -24,6 +24,13 @@ int Trick::MonteCarlo::initialize_sockets() {
     }
     tc_blockio(&listen_device, TC_COMM_NOBLOCKIO);
 
+    /** <li> Add the local workers. */
+    for (unsigned int i = 0; i < num_local_workers; ++i) {
+        MonteSlave * worker = new MonteSlave();
+        worker->local = true;
+        add_slave(worker);
+    }
+
     /** <li> If no slaves were specified, add one on localhost. */
     if (slaves.empty()) {
         if (verbosity >= MC_ALL) {
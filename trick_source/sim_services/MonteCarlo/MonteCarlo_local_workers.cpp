@@ -0,0 +1,240 @@
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <vector>
+
+#include "trick/MonteCarlo.hh"
+#include "trick/Executive.hh"
+#include "trick/Threads.hh"
+#include "trick/message_proto.h"
+#include "trick/message_type.h"
+#include "trick/tc_proto.h"
+
+extern Trick::Executive * the_exec ;
+
+/**
+ * @par Detailed Design:
+ * A local worker is a slave forked from the master.  It shares the master's initialized state, so it starts without a
+ * remote shell, a new S_main process, or processing the input file again, and it exchanges runs and results with the
+ * master over two pipes instead of a socket connection per run.
+ */
+void Trick::MonteCarlo::spawn_local_worker(Trick::MonteSlave* slave_to_init) {
+    int dispatch_pipe[2];
+    int result_pipe[2];
+
+    /** <ul><li> Create the dispatch and result pipes. */
+    if (pipe(dispatch_pipe) == -1) {
+        dispatch_pipe[0] = dispatch_pipe[1] = -1;
+    }
+    if (dispatch_pipe[0] == -1 || pipe(result_pipe) == -1) {
+        if (verbosity >= MC_ERROR) {
+            message_publish(MSG_ERROR, "Monte [Master] Unable to create pipes for local worker %d: %s\n",
+                            slave_to_init->id, strerror(errno)) ;
+        }
+        if (dispatch_pipe[0] != -1) {
+            close(dispatch_pipe[0]);
+            close(dispatch_pipe[1]);
+        }
+        slave_to_init->state = MonteSlave::MC_DISCONNECTED;
+        return;
+    }
+
+    /** <li> The worker's index among the local workers selects its CPU. */
+    unsigned int worker_index = 0;
+    for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size() && slaves[i] != slave_to_init; ++i) {
+        if (slaves[i]->local) {
+            ++worker_index;
+        }
+    }
+
+    if (verbosity >= MC_INFORMATIONAL) {
+        message_publish(MSG_INFO, "Monte: Forking local worker %d\n", slave_to_init->id) ;
+    }
+
+    /** <li> Flush the standard streams so the worker does not write the master's buffered output again. */
+    fflush(NULL);
+    pid_t pid = fork();
+
+    if (pid == -1) {
+        if (verbosity >= MC_ERROR) {
+            message_publish(MSG_ERROR, "Monte [Master] Unable to fork local worker %d: %s\n",
+                            slave_to_init->id, strerror(errno)) ;
+        }
+        close(dispatch_pipe[0]);
+        close(dispatch_pipe[1]);
+        close(result_pipe[0]);
+        close(result_pipe[1]);
+        slave_to_init->state = MonteSlave::MC_DISCONNECTED;
+        return;
+    }
+
+    /**
+     * <li> Master: keep the dispatch write end and the result read end.  The worker needs no handshake.  A worker
+     * that died is detected by the end of its result pipe, so writing to its dispatch pipe must not raise SIGPIPE.
+     */
+    if (pid != 0) {
+        signal(SIGPIPE, SIG_IGN);
+        close(dispatch_pipe[0]);
+        close(result_pipe[1]);
+        slave_to_init->dispatch_fd = dispatch_pipe[1];
+        slave_to_init->result_fd = result_pipe[0];
+        slave_to_init->pid = pid;
+        slave_to_init->port = 0;
+        slave_to_init->state = MonteSlave::MC_READY;
+        return;
+    }
+
+    /**
+     * <li> Worker: close the master's ends and the pipes of the workers forked before this one, so a worker sees
+     * the end of its dispatch pipe when the master exits.
+     */
+    close(dispatch_pipe[1]);
+    close(result_pipe[0]);
+    for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size(); ++i) {
+        if (slaves[i]->dispatch_fd >= 0) {
+            close(slaves[i]->dispatch_fd);
+            slaves[i]->dispatch_fd = -1;
+        }
+        if (slaves[i]->result_fd >= 0) {
+            close(slaves[i]->result_fd);
+            slaves[i]->result_fd = -1;
+        }
+    }
+    tc_disconnect(&listen_device);
+
+    local_read_fd = dispatch_pipe[0];
+    local_write_fd = result_pipe[1];
+    slave_id = slave_to_init->id;
+
+    if (local_worker_first_cpu >= 0) {
+        pin_local_worker(local_worker_first_cpu + worker_index);
+    }
+
+    /**
+     * <li> Run as a slave.  execute_as_slave() returns only in the child process of a run, which returns through
+     * master() and finishes initialization.  With MC_FORK_POST_INIT the worker itself returns through master(),
+     * executes the initialization jobs, and waits for runs in execute_monte_post_init(). </ul>
+     */
+    if (fork_point == MC_FORK_PRE_INIT) {
+        slave_init();
+        execute_as_slave();
+    }
+}
+
+/**
+ * @par Detailed Design:
+ * The worker's main thread is pinned through its Trick::ThreadBase CPU set, so the runs forked from the worker keep
+ * the pinning when the executive applies the main thread's affinity.
+ */
+void Trick::MonteCarlo::pin_local_worker(unsigned int cpu) {
+    Trick::Threads * main_thread = the_exec->get_thread(0) ;
+    if (main_thread == NULL) {
+        return;
+    }
+    long num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+    for (long ii = 0; ii < num_cpus; ++ii) {
+        main_thread->cpu_clr((unsigned int)ii) ;
+    }
+    main_thread->cpu_set(cpu) ;
+    main_thread->set_pid() ;
+    main_thread->execute_cpu_affinity() ;
+}
+
+/**
+ * @par Detailed Design:
+ * This function polls the result pipes of the local workers without blocking.
+ */
+void Trick::MonteCarlo::receive_local_results() {
+    std::vector<struct pollfd> fds;
+    std::vector<MonteSlave *> polled;
+
+    for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size(); ++i) {
+        if (slaves[i]->result_fd >= 0) {
+            struct pollfd fd = { slaves[i]->result_fd, POLLIN, 0 };
+            fds.push_back(fd);
+            polled.push_back(slaves[i]);
+        }
+    }
+    if (fds.empty() || poll(&fds[0], fds.size(), 0) <= 0) {
+        return;
+    }
+
+    for (std::vector<struct pollfd>::size_type i = 0; i < fds.size(); ++i) {
+        if (fds[i].revents == 0) {
+            continue;
+        }
+        MonteSlave& slave = *polled[i];
+        local_read_fd = slave.result_fd;
+        local_write_fd = slave.dispatch_fd;
+
+        /** <ul><li> Read the slave id, the end of the pipe means the worker exited. */
+        int id;
+        if (read((char*)&id, (int)sizeof(id)) != (int)sizeof(id) || (unsigned int)ntohl(id) != slave.id) {
+            set_disconnected_state(slave);
+            waitpid(slave.pid, NULL, WNOHANG);
+        /** <li> Otherwise, it's sending us run data. </ul> */
+        } else {
+            handle_run_data(slave);
+        }
+        local_read_fd = -1;
+        local_write_fd = -1;
+    }
+}
+
+/**
+ * @par Detailed Design:
+ * A local worker's pipe stays open between runs, so the master must know where the results of a run end even when
+ * it discards them.  The data of the slave post jobs is sent after the exit status with its length.
+ */
+void Trick::MonteCarlo::write_local_results(int exit_status) {
+    int id = htonl(slave_id);
+    write((char*)&id, (int)sizeof(id));
+    exit_status = htonl(exit_status);
+    write((char*)&exit_status, (int)sizeof(exit_status));
+    int size = htonl((int)local_results.size());
+    write((char*)&size, (int)sizeof(size));
+    write((char*)local_results.data(), (int)local_results.size());
+    local_results.clear();
+}
+
+/** @par Detailed Design: */
+int Trick::MonteCarlo::read_local_results() {
+    local_results.clear();
+    local_results_read = 0;
+    int size;
+    if (read((char*)&size, (int)sizeof(size)) != (int)sizeof(size) || (size = ntohl(size)) < 0) {
+        return -1;
+    }
+    local_results.resize(size);
+    if (size > 0 && read(&local_results[0], size) != size) {
+        local_results.clear();
+        return -1;
+    }
+    return 0;
+}
+
+/** @par Detailed Design: */
+int Trick::MonteCarlo::connect_to_master() {
+    /** <ul><li> A local worker is always connected to the master through its pipes. */
+    if (local_write_fd >= 0) {
+        return 0;
+    }
+    /** <li> Otherwise, connect to the master's socket. </ul> */
+    connection_device.port = master_port;
+    return (tc_connect(&connection_device) == TC_SUCCESS) ? 0 : -1;
+}
+
+/**
+ * @par Detailed Design:
+ * Closes the current socket connection.  The pipes of local workers stay open between runs.  In the master, a
+ * local worker's pipes are closed by set_disconnected_state().
+ */
+void Trick::MonteCarlo::disconnect() {
+    if (local_read_fd < 0 && local_write_fd < 0) {
+        tc_disconnect(&connection_device);
+    }
+}
@@ -25,6 +25,13 @@ int Trick::MonteCarlo::master() {
              */
             spawn_slaves();
 
+            /**
+             * <li> Return in the child process of a local worker's run, it continues the simulation.
+             */
+            if (is_slave()) {
+                return 0;
+            }
+
             /** <li> Receive any finished runs. */
             receive_results();
 
@@ -1,4 +1,5 @@
 #include <sys/time.h>
+#include <unistd.h>
 
 #include "trick/MonteCarlo.hh"
 #include "trick/command_line_protos.h"
@@ -52,6 +53,18 @@ void Trick::MonteCarlo::shutdown_slaves() {
 
     for (std::vector<MonteSlave *>::size_type i = 0; i < slaves.size() ; ++i) {
         slaves[i]->state = MonteSlave::MC_FINISHED;
+        /** A local worker exits when it reads the shutdown command or the end of its pipe. */
+        if (slaves[i]->local) {
+            if (slaves[i]->dispatch_fd >= 0) {
+                int command = htonl(MonteSlave::MC_SHUTDOWN);
+                ::write(slaves[i]->dispatch_fd, (char*)&command, sizeof(command));
+                close(slaves[i]->dispatch_fd);
+                close(slaves[i]->result_fd);
+                slaves[i]->dispatch_fd = -1;
+                slaves[i]->result_fd = -1;
+            }
+            continue;
+        }
         connection_device.hostname = (char*)slaves[i]->machine_name.c_str();
         connection_device.port = slaves[i]->port;
         if (tc_connect(&connection_device) == TC_SUCCESS) {
@@ -95,6 +108,7 @@ void Trick::MonteCarlo::print_statistics(FILE** fp) {
     fprintf(*fp, "Effective average time per unit (total time / number of runs): %.2lf\n", effective_time);
     fprintf(*fp, "Speedup (sum of CPU time / total time): %.2lf\n", speed_up);
     fprintf(*fp, "Efficency (speedup / num slaves): %.2lf%%\n", efficency);
+    fprintf(*fp, "Throughput (runs / total time): %.2lf runs/s\n", monte_time > 0 ? num_results / monte_time : 0);
 
     if (failed_runs.size()) {
         fprintf(*fp, "\nThe following runs completed with a non-zero process exit status:\n");
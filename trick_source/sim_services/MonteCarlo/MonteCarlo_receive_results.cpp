@@ -1,3 +1,5 @@
+#include <unistd.h>
+
 #include "trick/MonteCarlo.hh"
 #include "trick/message_proto.h"
 #include "trick/message_type.h"
@@ -9,6 +11,9 @@
  */
 void Trick::MonteCarlo::receive_results() {
 
+    /** <ul><li> Receive the results of the local workers. */
+    receive_local_results();
+
     /** <li> While there are pending connections: */
     while (tc_accept(&listen_device, &connection_device) == TC_SUCCESS) {
 
@@ -103,22 +108,41 @@ void Trick::MonteCarlo::handle_run_data(Trick::MonteSlave& slave) {
               "Monte [Master] Run %d has already been resolved. Discarding results.\n",
               slave.current_run->id) ;
         }
+        // A local worker's pipe stays open, so its exit status and slave post data are read even though they are
+        // discarded.
+        if (slave.local) {
+            int discarded;
+            if (read((char*)&discarded, (int)sizeof(discarded)) != (int)sizeof(discarded) ||
+             read_local_results() != 0) {
+                set_disconnected_state(slave) ;
+                return;
+            }
+        }
     } else {
         /** <li> Otherwise, check the exit status: */
         int exit_status;
         int size = sizeof(exit_status);
-        if (tc_read(&connection_device, (char*)&exit_status, size) != size) {
+        if (read((char*)&exit_status, size) != size) {
             set_disconnected_state(slave) ;
             return;
         }
         exit_status = ntohl(exit_status);
 
+        /** <li> A local worker follows the exit status with the data of its slave post jobs. */
+        if (slave.local && read_local_results() != 0) {
+            set_disconnected_state(slave) ;
+            return;
+        }
+
         switch (exit_status) {
 
             case MonteRun::MC_RUN_COMPLETE:
             case MonteRun::MC_RUN_FAILED:
                 resolve_run(slave, static_cast<MonteRun::ExitStatus>(exit_status));
+                /** <li> The master post jobs of a local worker's run read the data received with it. */
+                buffer_local_results = slave.local;
                 run_queue(&master_post_queue, "in master_post queue") ;
+                buffer_local_results = false;
                 break;
 
             case MonteRun::MC_PROBLEM_PARSING_INPUT:
@@ -172,8 +196,9 @@ void Trick::MonteCarlo::handle_run_data(Trick::MonteSlave& slave) {
                 break;
         }
     }
-    
-    tc_disconnect(&connection_device);
+    local_results.clear();
+
+    disconnect();
 
     /** <li> Update the slave's state. */
     if (slave.state == MonteSlave::MC_RUNNING || slave.state == MonteSlave::MC_UNRESPONSIVE_RUNNING) {
@@ -189,5 +214,14 @@ void Trick::MonteCarlo::set_disconnected_state(Trick::MonteSlave& slave) {
         message_publish(MSG_ERROR, "Monte [Master] Lost connection to %s:%d.\n",
                         slave.machine_name.c_str(), slave.id) ;
     }
-    tc_disconnect(&connection_device);
+    if (slave.local) {
+        close(slave.dispatch_fd);
+        close(slave.result_fd);
+        slave.dispatch_fd = -1;
+        slave.result_fd = -1;
+        local_read_fd = -1;
+        local_write_fd = -1;
+    } else {
+        tc_disconnect(&connection_device);
+    }
 }
@@ -13,8 +13,11 @@ int Trick::MonteCarlo::execute_as_slave() {
             message_publish(MSG_INFO, "Monte [%s:%d] Waiting for new run.\n",
                             machine_name.c_str(), slave_id) ;
         }
-        /** <ul><li> On a blocking read, wait for a MonteSlave::Command from the master. */
-        if (tc_accept(&listen_device, &connection_device) != TC_SUCCESS) {
+        /**
+         * <ul><li> On a blocking read, wait for a MonteSlave::Command from the master.  A local worker reads it
+         * from its dispatch pipe, other slaves accept a connection from the master first.
+         */
+        if (local_read_fd < 0 && tc_accept(&listen_device, &connection_device) != TC_SUCCESS) {
             if (verbosity >= MC_ERROR) {
                 message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master. Shutting down.\n",
                                 machine_name.c_str(), slave_id) ;
@@ -22,7 +25,7 @@ int Trick::MonteCarlo::execute_as_slave() {
             slave_shutdown();
         }
         int command;
-        if (tc_read(&connection_device, (char *)&command, (int)sizeof(command)) != (int)sizeof(command)) {
+        if (read((char *)&command, (int)sizeof(command)) != (int)sizeof(command)) {
             if (verbosity >= MC_ERROR) {
                 message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master while receiving instructions. Shutting down.\n",
                                 machine_name.c_str(), slave_id) ;
@@ -26,6 +26,11 @@ int Trick::MonteCarlo::slave_init() {
     /** <li> Run the slave initialization jobs. */
     run_queue(&slave_init_queue, "in slave_init queue") ;
 
+    /** <li> A local worker is connected to the master through its pipes already. */
+    if (local_read_fd >= 0) {
+        return 0;
+    }
+
     /** <li> Initialize the sockets. */
     tc_error(&listen_device, 0);
     tc_error(&connection_device, 0);
@@ -15,7 +15,7 @@
 int Trick::MonteCarlo::slave_process_run() {
     int size;
     /** <ul><li> Read the length of the incoming message. */
-    if (tc_read(&connection_device, (char *)&size, (int)sizeof(size)) != (int)sizeof(size) || (size = ntohl(size)) < 0) {
+    if (read((char *)&size, (int)sizeof(size)) != (int)sizeof(size) || (size = ntohl(size)) < 0) {
         if (verbosity >= MC_ERROR) {
             message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master while receiving new run.\nShutting down.\n",
                             machine_name.c_str(), slave_id) ;
@@ -24,14 +24,14 @@ int Trick::MonteCarlo::slave_process_run() {
     }
     char *input = new char[size + 1];
     /** <li> Read the incoming message. */
-    if (tc_read(&connection_device, input, size) != size) {
+    if (read(input, size) != size) {
         if (verbosity >= MC_ERROR) {
             message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master while receiving new run.\nShutting down.\n",
                             machine_name.c_str(), slave_id) ;
         }
         slave_shutdown();
     }
-    tc_disconnect(&connection_device);
+    disconnect();
 
     /**
      * <li> fork() a child process to execute the simulation.
@@ -75,8 +75,7 @@ int Trick::MonteCarlo::slave_process_run() {
             message_publish(MSG_ERROR, "Monte [%s:%d] Run killed by signal %d: %s\n",
                             machine_name.c_str(), slave_id, signal, strsignal(signal)) ;
         }
-        connection_device.port = master_port;
-        if (tc_connect(&connection_device) != TC_SUCCESS) {
+        if (connect_to_master() != 0) {
             if (verbosity >= MC_ERROR) {
                 message_publish(MSG_ERROR, "Monte [%s:%d] Lost connection to Master before results could be returned.\nShutting down.\n",
                                 machine_name.c_str(), slave_id) ;
@@ -87,13 +86,19 @@ int Trick::MonteCarlo::slave_process_run() {
             message_publish(MSG_INFO, "Monte [%s:%d] Sending run exit status to master %d.\n",
                             machine_name.c_str(), slave_id, exit_status) ;
         }
-        /** <li> Write the slaves id to the master. </ul> */
-        int id = htonl(slave_id);
-        tc_write(&connection_device, (char *)&id, (int)sizeof(id));
-        /** <li> Write the child's exit status to the master. </ul> */
-        return_value = htonl(exit_status);
-        tc_write(&connection_device, (char *)&return_value, (int)sizeof(return_value));
-        tc_disconnect(&connection_device);
+        if (local_write_fd >= 0) {
+            /** <li> A local worker writes its id, the child's exit status, and no slave post data. */
+            local_results.clear();
+            write_local_results(exit_status);
+        } else {
+            /** <li> Write the slaves id to the master. </ul> */
+            int id = htonl(slave_id);
+            write((char *)&id, (int)sizeof(id));
+            /** <li> Write the child's exit status to the master. </ul> */
+            return_value = htonl(exit_status);
+            write((char *)&return_value, (int)sizeof(return_value));
+        }
+        disconnect();
         return 0;
     /** <li> Child process: */
     } else {
@@ -20,7 +20,16 @@ void Trick::MonteCarlo::spawn_slaves() {
           * set up the command string for starting the slave.
           */
         if (slaves[i]->state == MonteSlave::MC_UNINITIALIZED) {
-            initialize_slave(slaves[i]) ;
+            /** <li> Local workers are forked instead. */
+            if (slaves[i]->local) {
+                spawn_local_worker(slaves[i]) ;
+                /** <li> Return in the worker, it is a slave now. </ul> */
+                if (is_slave()) {
+                    return;
+                }
+            } else {
+                initialize_slave(slaves[i]) ;
+            }
         }
     }
 }
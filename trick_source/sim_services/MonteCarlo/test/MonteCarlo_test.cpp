@@ -7,6 +7,8 @@
 #include <string>
 #include <sstream>
 #include <cmath>
+#include <poll.h>
+#include <unistd.h>
 
 #include "gtest/gtest.h"
 #include "trick/ExecutiveException.hh"
@@ -77,6 +79,24 @@ int testSimObject::call_function( __attribute__((unused)) Trick::JobData * curr_
     return trick_ret ;
 } ;
 
+/* Reads the slave post data of each run in a master post job */
+class resultsSimObject : public Trick::SimObject {
+    public:
+        double received ;
+        int num_master_post ;
+
+        resultsSimObject() : received(0.0), num_master_post(0) {
+            add_job(0, 0, "monte_master_post", NULL, 1, "master_post", "TRK") ;
+        }
+
+        virtual int call_function( __attribute__((unused)) Trick::JobData * curr_job ) {
+            num_master_post++ ;
+            mc_read((char *)&received, (int)sizeof(received)) ;
+            return 0 ;
+        }
+        virtual double call_function_double( Trick::JobData * curr_job ) { (void)curr_job ; return 0.0 ; } ;
+} ;
+
 class MonteCarloTest : public ::testing::Test {
 
     protected:
@@ -318,6 +338,77 @@ TEST_F(MonteCarloTest, TestSlaves) {
     EXPECT_EQ(slave1.machine_name, "WonderWoman") ;
 }
 
+TEST_F(MonteCarloTest, LocalWorkerResults) {
+    resultsSimObject so ;
+    Trick::MonteSlave worker("localhost") ;
+    Trick::MonteRun resolved(0), completed(1), dumped(2) ;
+    double stale = 1.5 , fresh = 2.5 , unread[2] = { 3.5 , 4.5 } ;
+    int fds[2] ;
+    struct pollfd fd ;
+
+    exec_add_sim_object(&so , "so") ;
+    exec.verbosity = Trick::MonteCarlo::MC_NONE ;
+    exec.add_slave(&worker) ;
+    ASSERT_EQ(pipe(fds), 0) ;
+
+    /* The worker side: three runs with 1, 0 and 2 doubles written by the slave post jobs */
+    exec.slave_id = worker.id ;
+    exec.local_write_fd = fds[1] ;
+    exec.buffer_local_results = true ;
+    exec.write((char *)&stale, (int)sizeof(stale)) ;
+    exec.buffer_local_results = false ;
+    exec.write_local_results(Trick::MonteRun::MC_RUN_COMPLETE) ;
+    exec.buffer_local_results = true ;
+    exec.write((char *)&fresh, (int)sizeof(fresh)) ;
+    exec.write((char *)unread, (int)sizeof(unread)) ;
+    exec.buffer_local_results = false ;
+    exec.write_local_results(Trick::MonteRun::MC_RUN_COMPLETE) ;
+    exec.write_local_results(Trick::MonteRun::MC_RUN_DUMPED_CORE) ;
+    exec.local_write_fd = -1 ;
+
+    /* The master side */
+    exec.slave_id = 0 ;
+    worker.local = true ;
+    worker.result_fd = fds[0] ;
+
+    /* Another slave resolved the first run.  Its data is discarded and the worker is ready for the next run. */
+    resolved.exit_status = Trick::MonteRun::MC_RUN_TIMED_OUT ;
+    worker.current_run = &resolved ;
+    worker.state = Trick::MonteSlave::MC_RUNNING ;
+    exec.receive_local_results() ;
+    EXPECT_EQ(worker.state, Trick::MonteSlave::MC_READY) ;
+    EXPECT_EQ(resolved.exit_status, Trick::MonteRun::MC_RUN_TIMED_OUT) ;
+    EXPECT_EQ(so.num_master_post, 0) ;
+
+    /* The master post job reads only part of the data, the rest is discarded */
+    worker.current_run = &completed ;
+    worker.state = Trick::MonteSlave::MC_RUNNING ;
+    exec.receive_local_results() ;
+    EXPECT_EQ(worker.state, Trick::MonteSlave::MC_READY) ;
+    EXPECT_EQ(completed.exit_status, Trick::MonteRun::MC_RUN_COMPLETE) ;
+    EXPECT_EQ(so.num_master_post, 1) ;
+    EXPECT_EQ(so.received, 2.5) ;
+
+    /* The slave's report of a run that dumped core has no data */
+    worker.current_run = &dumped ;
+    worker.state = Trick::MonteSlave::MC_RUNNING ;
+    exec.receive_local_results() ;
+    EXPECT_EQ(worker.state, Trick::MonteSlave::MC_READY) ;
+    EXPECT_EQ(dumped.exit_status, Trick::MonteRun::MC_RUN_DUMPED_CORE) ;
+    EXPECT_EQ(so.num_master_post, 1) ;
+    EXPECT_EQ(exec.num_results, 2u) ;
+
+    /* Every message was read whole */
+    fd.fd = fds[0] ;
+    fd.events = POLLIN ;
+    fd.revents = 0 ;
+    EXPECT_EQ(poll(&fd, 1, 0), 0) ;
+
+    close(fds[0]) ;
+    close(fds[1]) ;
+    worker.result_fd = -1 ;
+}
+
 TEST_F(MonteCarloTest, MonteVarFile) {
     //req.add_requirement("3932595803");
 
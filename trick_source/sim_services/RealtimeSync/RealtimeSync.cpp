@@ -73,12 +73,17 @@ int Trick::RealtimeSync::disable() {
 /**
 @details
 -# Sets the real_time clock to the incoming class [@ref disable]
+-# Recalculate the sim time to clock tic ratio.  Clocks report their own tics per second, which
+   may not be known until clock_init calibrates the clock.
 */
 int Trick::RealtimeSync::change_clock(Trick::Clock * in_clock) {
     int ret ;
     ret = in_clock->clock_init() ;
     if ( ret == 0 ) {
         rt_clock = in_clock ;
+        if ( exec_get_time_tic_value() > 0 ) {
+            rt_clock->calc_sim_time_ratio(exec_get_time_tic_value()) ;
+        }
     }
     return ret ;
 }
@@ -329,14 +334,14 @@ int Trick::RealtimeSync::rt_monitor(long long sim_time_tics) {
                     "total overrun time/allowed time: %f/%g\n"
                     "Entering Freeze-Shutdown Mode\n" ,
                     frame_overrun_cnt, rt_max_overrun_cnt,
-                    (double)(frame_overrun_time/tics_per_sec), rt_max_overrun_time);
+                    frame_overrun_time/(double)tics_per_sec, rt_max_overrun_time);
                 exec_freeze() ;
             } else {
                 snprintf(buf, sizeof(buf), "\nMaximum overrun condition exceeded:\n"
                     "consecutive overruns/allowed overruns: %d/%d\n"
                     "total overrun time/allowed time: %f/%g\n",
                     frame_overrun_cnt, rt_max_overrun_cnt,
-                    (double)(frame_overrun_time/tics_per_sec), rt_max_overrun_time);
+                    frame_overrun_time/(double)tics_per_sec, rt_max_overrun_time);
                 exec_terminate_with_return(-1 , __FILE__ , __LINE__ , buf);
             }
         }
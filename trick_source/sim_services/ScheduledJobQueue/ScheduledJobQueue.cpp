@@ -3,6 +3,8 @@
 #include <sstream>
 #include <stdlib.h>
 #include <stdio.h>
+#include <algorithm>
+#include <iterator>
 
 #include "trick/ScheduledJobQueue.hh"
 #include "trick/ScheduledJobQueueInstrument.hh"
@@ -11,16 +13,25 @@
 /**
 @design
 -# Set #list to NULL
--# Set #list_list to 0
+-# Set #list_list and #list_capacity to 0
 -# Set #curr_index to 0
 -# Set #next_job_time to TRICK_MAX_LONG_LONG
+-# Set #indexed to false
 */
 Trick::ScheduledJobQueue::ScheduledJobQueue( ) {
 
     list = NULL ;
     list_size = 0 ;
+    list_capacity = 0 ;
     curr_index = 0 ;
     next_job_time = TRICK_MAX_LONG_LONG ;
+    indexed = false ;
+    index_dirty = true ;
+    index_epoch = 0 ;
+    index_time = 0 ;
+    index_pass_open = false ;
+    due_index = 0 ;
+    system_index = 0 ;
 
 }
 
@@ -36,81 +47,91 @@ Trick::ScheduledJobQueue::~ScheduledJobQueue( ) {
 
 /**
 @design
--# Allocate additional memory for the incoming job
+-# Returns true if job_a is ordered before job_b by comparing the job_class, the phase,
+   the sim_object id, and the job_id in that order.
+*/
+static bool job_ordered_before( Trick::JobData * job_a , Trick::JobData * job_b ) {
+    if ( job_a->job_class != job_b->job_class ) {
+        return job_a->job_class < job_b->job_class ;
+    }
+    if ( job_a->phase != job_b->phase ) {
+        return job_a->phase < job_b->phase ;
+    }
+    if ( job_a->sim_object_id != job_b->sim_object_id ) {
+        return job_a->sim_object_id < job_b->sim_object_id ;
+    }
+    return job_a->id < job_b->id ;
+}
+
+/**
+@design
+-# Find the first job in the queue that is ordered after the incoming job.  The queue is kept
+   sorted so a binary search is used.  Jobs with identical ordering fields keep their insertion order.
+*/
+unsigned int Trick::ScheduledJobQueue::insertion_index( JobData * new_job ) {
+    return std::upper_bound(list, list + list_size, new_job, job_ordered_before) - list ;
+}
+
+/**
+@design
+-# Double the capacity of the queue when it is full.  The queue is allocated outside of the memory
+   manager and only grows; removing jobs does not shrink it.
+*/
+int Trick::ScheduledJobQueue::reserve( unsigned int min_capacity ) {
+
+    if ( min_capacity > list_capacity ) {
+        unsigned int new_capacity = ( list_capacity == 0 ) ? 16 : list_capacity ;
+        while ( new_capacity < min_capacity ) {
+            new_capacity *= 2 ;
+        }
+        JobData ** new_list = (JobData **)realloc( list , new_capacity * sizeof(JobData *)) ;
+        if ( new_list == NULL ) {
+            return -1 ;
+        }
+        list = new_list ;
+        list_capacity = new_capacity ;
+    }
+    return 0 ;
+}
+
+/**
+@design
+-# Grow the queue if it is full.
 -# Find the insertion point in the queue based on the job_class, the phase,
-   the sim_object id, and the job_id
--# While searching for the correct insertion spot, copy all jobs that precede
-   the incoming job to the newly allocated queue space followed by the new job.
--# Copy jobs that are ordered after the incoming job to the new queue
+   the sim_object id, and the job_id with a binary search.
+-# Shift jobs that are ordered after the incoming job down one slot and insert the new job.
+-# Increment #curr_index if the job was inserted before it.
 -# Increment the size of the queue.
 */
 int Trick::ScheduledJobQueue::push( JobData * new_job ) {
 
-    unsigned int ii , jj ;
+    unsigned int ii ;
 
-    /* Allocate additional memory for the additional job in the queue */
-    JobData ** new_list = (JobData **)calloc( list_size + 1 , sizeof(JobData *)) ;
+    /* Make room for the additional job in the queue */
+    if ( reserve(list_size + 1) != 0 ) {
+        return -1 ;
+    }
 
     new_job->set_handled(true) ;
 
     /* Find the correct insertion spot in the queue by comparing
        the job_class, the phase, the sim_object id, and the job_id in that order. */
-    /* While searching for the correct insertion spot, copy all jobs that precede
-       the incoming job to the newly allocated queue space. */
-    for ( ii = jj = 0 ; ii < list_size ; ii++ ) {
-        if ( list[ii]->job_class == new_job->job_class ) {
-            if ( list[ii]->phase == new_job->phase ) {
-                if ( list[ii]->sim_object_id ==  new_job->sim_object_id ) {
-                    if ( list[ii]->id <= new_job->id ) {
-                        new_list[jj++] = list[ii] ;
-                    } else {
-                        new_list[jj++] = new_job ;
-                        break ;
-                    }
-                } else if ( list[ii]->sim_object_id < new_job->sim_object_id ) {
-                    new_list[jj++] = list[ii] ;
-                } else {
-                    new_list[jj++] = new_job ;
-                    break ;
-                }
-            } else if ( list[ii]->phase < new_job->phase ) {
-                new_list[jj++] = list[ii] ;
-            } else {
-                new_list[jj++] = new_job ;
-                break ;
-            }
-        } else if ( list[ii]->job_class < new_job->job_class ) {
-            new_list[jj++] = list[ii] ;
-        } else {
-            new_list[jj++] = new_job ;
-            break ;
-        }
-    }
+    ii = insertion_index(new_job) ;
 
-    /* Copy remaining jobs that execute after the incoming job to the new queue space. */
-    if ( ii == list_size ) {
-        /* ii == list_size means the incoming job is the last job */
-        new_list[list_size] = new_job ;
-    } else {
-        /* Inserted new job before the current job. Increment curr_index to point to the correct job */
-        if ( ii < curr_index ) {
-            curr_index++ ;
-        }
-        for ( ; ii < list_size ; ii++ ) {
-            new_list[jj++] = list[ii] ;
-        }
+    /* Move jobs that execute after the incoming job down one slot. */
+    std::copy_backward(list + ii, list + list_size, list + list_size + 1) ;
+    list[ii] = new_job ;
+
+    /* Inserted new job before the current job. Increment curr_index to point to the correct job */
+    if ( ii < list_size and ii < curr_index ) {
+        curr_index++ ;
     }
 
     /* Increment the size of the queue */
     list_size++ ;
 
-    /* Free the old queue space */
-    if ( list ) {
-        free(list) ;
-    }
-
-    /* Assign the queue pointer to the new space */
-    list = new_list ;
+    /* List positions have changed, the time index must be rebuilt */
+    index_dirty = true ;
 
     return(0) ;
 
@@ -140,45 +161,39 @@ int Trick::ScheduledJobQueue::push_ignore_sim_object( JobData * new_job ) {
 
 /**
 @design
--# Traverse the list of jobs looking for the job to delete.
+-# Look for the job to delete starting with a binary search on its ordering fields.  If the job is not
+   where it would be inserted, fall back to a search of the whole list.
  -# If the job to delete is found
-  -# Allocate a new list that holds 1 less job than the current list
-  -# Copy all of the jobs that precede the deleted job to the new list
-  -# Copy all of the jobs that are after the delete job to the new list
+  -# Shift all of the jobs that are after the deleted job up one slot
   -# Decrement the size of the list
-  -# Free the memory associated with the current list
-  -# Point the current list to the newly allocated list
 */
 int Trick::ScheduledJobQueue::remove( JobData * delete_job ) {
 
-    unsigned int ii , jj ;
+    unsigned int ii ;
+    JobData ** found ;
+    JobData ** lower = std::lower_bound(list, list + list_size, delete_job, job_ordered_before) ;
+    JobData ** upper = std::upper_bound(lower, list + list_size, delete_job, job_ordered_before) ;
 
     /* Find the job to delete in the queue. */
-    for ( ii = 0 ; ii < list_size ; ii++ ) {
-        if ( list[ii] == delete_job ) {
-            /* allocate a new list that holds one less element than the current list. */
-            JobData ** new_list = (JobData **)calloc( list_size - 1 , sizeof(JobData *)) ;
-            /* copy all of the jobs that are before the deleted job to the new list */
-            for ( jj = 0 ; jj < ii ; jj++ ) {
-                new_list[jj] = list[jj] ;
-            }
-            /* copy all of the jobs that are after the deleted job to the new list */
-            for ( jj = ii + 1 ; jj < list_size ; jj++ ) {
-                new_list[jj-1] = list[jj] ;
-            }
-            if ( ii <= curr_index ) {
-                curr_index-- ;
-            }
-            /* Decrement the size of the queue */
-            list_size-- ;
-            /* Free the old queue space */
-            free(list) ;
-            /* Assign the queue pointer to the new space */
-            list = new_list ;
-            return 0 ;
+    found = std::find(lower, upper, delete_job) ;
+    if ( found == upper ) {
+        found = std::find(list, list + list_size, delete_job) ;
+        if ( found == list + list_size ) {
+            return -1 ;
         }
     }
-    return -1 ;
+    ii = found - list ;
+
+    /* move all of the jobs that are after the deleted job up one slot */
+    std::copy(list + ii + 1, list + list_size, list + ii) ;
+    if ( ii <= curr_index ) {
+        curr_index-- ;
+    }
+    /* Decrement the size of the queue */
+    list_size-- ;
+    /* List positions have changed, the time index must be rebuilt */
+    index_dirty = true ;
+    return 0 ;
 }
 
 /**
@@ -244,8 +259,10 @@ int Trick::ScheduledJobQueue::clear() {
     /* set all list variables to initial cleared values */
     list = NULL ;
     list_size = 0 ;
+    list_capacity = 0 ;
     curr_index = 0 ;
     next_job_time = TRICK_MAX_LONG_LONG ;
+    index_dirty = true ;
     return(0) ;
 }
 
@@ -295,14 +312,40 @@ Trick::JobData * Trick::ScheduledJobQueue::get_next_job() {
 
 /**
 @design
+-# If the job class is not a system class job, calculate the next
+   time it will be called by current time + job cycle.
+-# Set the next job call time to TRICK_MAX_LONG_LONG if the next job call time
+   is greater than the stop time.
+-# If the job's next job call time is lower than the overall next job call time
+   set the overall job call time to the current job's next job call time.
+*/
+void Trick::ScheduledJobQueue::reschedule_job( JobData * curr_job ) {
+
+    long long next_call ;
+
+    /* If the job does not reschedule itself (system_job_classes), calculate the next time it will be called. */
+    if ( ! curr_job->system_job_class ) {
+        // calculate the next job call time
+        next_call = curr_job->next_tics + curr_job->cycle_tics ;
+        /* If the next time does not exceed the stop time, set the next call time for the module */
+        if (next_call > curr_job->stop_tics) {
+            curr_job->next_tics = TRICK_MAX_LONG_LONG ;
+        } else {
+            curr_job->next_tics = next_call;
+        }
+        /* Track next lowest job call time after the current time for jobs that match the current time. */
+        if ( curr_job->next_tics <  next_job_time ) {
+            next_job_time = curr_job->next_tics ;
+        }
+    }
+}
+
+/**
+@design
+-# If #indexed is set call Trick::ScheduledJobQueue::find_next_indexed_job(long long)
 -# While the list #curr_list is less than the list size
     -# If the current queue job next call matches the incoming simulation time
-        -# If the job class is not a system class job, calculate the next
-           time it will be called by current time + job cycle.
-        -# Set the next job call time to TRICK_MAX_LONG_LONG if the next job call time
-           is greater than the stop time.
-        -# If the job's next job call time is lower than the overall next job call time
-           set the overall job call time to the current job's next job call time.
+        -# Reschedule the job by calling Trick::ScheduledJobQueue::reschedule_job(JobData *)
         -# Increment the #curr_index.
         -# Return the current job if the job is enabled.
     -# Else
@@ -314,7 +357,10 @@ Trick::JobData * Trick::ScheduledJobQueue::get_next_job() {
 Trick::JobData * Trick::ScheduledJobQueue::find_next_job(long long time_tics ) {
 
     JobData * curr_job ;
-    long long next_call ;
+
+    if ( indexed ) {
+        return find_next_indexed_job(time_tics) ;
+    }
 
     /* Search through the rest of the queue starting at curr_index looking for
        the next job with it's next execution time is equal to the current simulation time. */
@@ -323,22 +369,7 @@ Trick::JobData * Trick::ScheduledJobQueue::find_next_job(long long time_tics ) {
         curr_job = list[curr_index] ;
 
         if ( curr_job->next_tics == time_tics ) {
-
-            /* If the job does not reschedule itself (system_job_classes), calculate the next time it will be called. */
-            if ( ! curr_job->system_job_class ) {
-                // calculate the next job call time
-                next_call = curr_job->next_tics + curr_job->cycle_tics ;
-                /* If the next time does not exceed the stop time, set the next call time for the module */
-                if (next_call > curr_job->stop_tics) {
-                    curr_job->next_tics = TRICK_MAX_LONG_LONG ;
-                } else {
-                    curr_job->next_tics = next_call;
-                }
-                /* Track next lowest job call time after the current time for jobs that match the current time. */
-                if ( curr_job->next_tics <  next_job_time ) {
-                    next_job_time = curr_job->next_tics ;
-                }
-            }
+            reschedule_job(curr_job) ;
             curr_index++ ;
             if ( !curr_job->disabled ) {
                 return(curr_job) ;
@@ -354,6 +385,304 @@ Trick::JobData * Trick::ScheduledJobQueue::find_next_job(long long time_tics ) {
     return(NULL) ;
 }
 
+/**
+@design
+-# Rebuild the index if jobs were added or removed, or a job's call time was changed outside of the queue.
+-# Else start a new pass if #curr_index was reset or the time has changed.
+-# Merge the due list and the system jobs in list order starting at #curr_index
+    -# System jobs are tested against the incoming time as they are reached, just like the linear search.
+    -# Due jobs are rescheduled by calling Trick::ScheduledJobQueue::reschedule_job(JobData *)
+    -# Set #curr_index to one past the returned job.
+    -# Return the job if it is enabled.
+-# At the end of the pass move the due groups to their next call time, fold the earliest calendar
+   time into the overall next job call time, set #curr_index to the list size and return NULL.
+*/
+Trick::JobData * Trick::ScheduledJobQueue::find_next_indexed_job(long long time_tics ) {
+
+    JobData * curr_job ;
+    unsigned int ii ;
+    unsigned int next_due ;
+    unsigned int next_system ;
+
+    if ( index_dirty or index_epoch != __atomic_load_n(&Trick::JobData::schedule_epoch, __ATOMIC_ACQUIRE) ) {
+        build_index() ;
+        begin_index_pass(time_tics) ;
+    } else if ( ! index_pass_open or curr_index == 0 or time_tics != index_time ) {
+        finish_index_pass() ;
+        begin_index_pass(time_tics) ;
+    }
+
+    while ( true ) {
+        next_due = ( due_index < due_list.size() ) ? due_list[due_index] : list_size ;
+        next_system = ( system_index < system_list.size() ) ? system_list[system_index] : list_size ;
+
+        if ( next_system < next_due ) {
+            system_index++ ;
+            curr_job = list[next_system] ;
+            curr_index = next_system + 1 ;
+            if ( curr_job->next_tics == time_tics ) {
+                if ( !curr_job->disabled ) {
+                    return(curr_job) ;
+                }
+            } else if ( curr_job->next_tics > time_tics && curr_job->next_tics < next_job_time ) {
+                next_job_time = curr_job->next_tics ;
+            }
+        } else if ( next_due < list_size ) {
+            due_index++ ;
+            curr_job = list[next_due] ;
+            curr_index = next_due + 1 ;
+            /* Jobs moved outside of the queue are placed back into the calendar by finish_index_pass() */
+            if ( curr_job->next_tics == time_tics ) {
+                reschedule_job(curr_job) ;
+                if ( !curr_job->disabled ) {
+                    return(curr_job) ;
+                }
+            }
+        } else {
+            break ;
+        }
+    }
+
+    finish_index_pass() ;
+
+    /* Discard calendar groups at the top whose jobs were moved outside of the queue. */
+    while ( ! index_calendar.empty() ) {
+        std::map< std::pair< long long , long long > , unsigned int >::iterator it = index_calendar.begin() ;
+        std::vector< unsigned int > & positions = index_groups[it->second] ;
+        bool stale = false ;
+        for ( ii = 0 ; ii < positions.size() and ! stale ; ii++ ) {
+            stale = ( list[positions[ii]]->next_tics != it->first.first or
+                      list[positions[ii]]->cycle_tics != it->first.second ) ;
+        }
+        if ( ! stale ) {
+            if ( it->first.first > time_tics and it->first.first < next_job_time ) {
+                next_job_time = it->first.first ;
+            }
+            break ;
+        }
+        std::vector< unsigned int > moved ;
+        unindex_group(it, moved) ;
+        for ( ii = 0 ; ii < moved.size() ; ii++ ) {
+            index_job(moved[ii], time_tics + 1) ;
+        }
+    }
+
+    curr_index = list_size ;
+    return(NULL) ;
+}
+
+/**
+@design
+-# Record the current JobData::schedule_epoch before reading the call times, so a change made while
+   the index is built marks it stale.
+-# Clear the calendar, the system, and parked lists.
+-# Place system class jobs in the system list and all other jobs in the calendar keyed by their
+   next call time and cycle.
+*/
+void Trick::ScheduledJobQueue::build_index() {
+
+    unsigned int ii ;
+
+    index_epoch = __atomic_load_n(&Trick::JobData::schedule_epoch, __ATOMIC_ACQUIRE) ;
+    index_calendar.clear() ;
+    index_groups.clear() ;
+    free_groups.clear() ;
+    due_keys.clear() ;
+    due_list.clear() ;
+    due_index = 0 ;
+    system_list.clear() ;
+    parked_list.clear() ;
+    system_index = 0 ;
+    index_pass_open = false ;
+
+    /* Positions are added in increasing order so every group stays sorted. */
+    for ( ii = 0 ; ii < list_size ; ii++ ) {
+        if ( list[ii]->system_job_class ) {
+            system_list.push_back(ii) ;
+        } else {
+            index_job(ii, -TRICK_MAX_LONG_LONG) ;
+        }
+    }
+
+    index_dirty = false ;
+}
+
+/**
+@design
+-# Move parked jobs that have been pushed forward in time back into the calendar.
+-# Remove calendar groups earlier than the incoming time.  Their jobs were moved outside of
+   the queue, place each job again by its current call time.
+-# Merge the groups due at the incoming time into the due list starting at #curr_index.
+-# Start the system job list at #curr_index.
+*/
+void Trick::ScheduledJobQueue::begin_index_pass(long long time_tics) {
+
+    unsigned int ii ;
+    std::vector< unsigned int > still_parked ;
+    std::vector< unsigned int > moved ;
+    std::map< std::pair< long long , long long > , unsigned int >::iterator it ;
+
+    index_time = time_tics ;
+
+    parked_list.swap(still_parked) ;
+    for ( ii = 0 ; ii < still_parked.size() ; ii++ ) {
+        index_job(still_parked[ii], time_tics) ;
+    }
+
+    while ( ! index_calendar.empty() and index_calendar.begin()->first.first < time_tics ) {
+        unindex_group(index_calendar.begin(), moved) ;
+    }
+    for ( ii = 0 ; ii < moved.size() ; ii++ ) {
+        index_job(moved[ii], time_tics) ;
+    }
+
+    /* Merge the due groups, one per cycle rate due now, into a single list in list order. */
+    due_keys.clear() ;
+    due_list.clear() ;
+    due_index = 0 ;
+    for ( it = index_calendar.begin() ; it != index_calendar.end() and it->first.first == time_tics ; it++ ) {
+        std::vector< unsigned int > & positions = index_groups[it->second] ;
+        unsigned int middle = due_list.size() ;
+        due_keys.push_back(it->first) ;
+        due_list.insert(due_list.end(),
+         std::lower_bound(positions.begin(), positions.end(), curr_index), positions.end()) ;
+        std::inplace_merge(due_list.begin(), due_list.begin() + middle, due_list.end()) ;
+    }
+
+    system_index = std::lower_bound(system_list.begin(), system_list.end(), curr_index) - system_list.begin() ;
+    index_pass_open = true ;
+}
+
+/**
+@design
+-# For each group due in the last pass
+    -# If all of the jobs moved to the same next call time, move the group as a whole.
+    -# Else place each job by its current call time.
+*/
+void Trick::ScheduledJobQueue::finish_index_pass() {
+
+    unsigned int ii , jj ;
+
+    if ( ! index_pass_open ) {
+        return ;
+    }
+
+    for ( ii = 0 ; ii < due_keys.size() ; ii++ ) {
+        std::map< std::pair< long long , long long > , unsigned int >::iterator it = index_calendar.find(due_keys[ii]) ;
+        if ( it == index_calendar.end() ) {
+            continue ;
+        }
+        std::vector< unsigned int > positions ;
+        unindex_group(it, positions) ;
+        if ( positions.empty() ) {
+            continue ;
+        }
+
+        long long group_tics = list[positions[0]]->next_tics ;
+        long long group_cycle = list[positions[0]]->cycle_tics ;
+        bool together = ( group_tics > index_time ) ;
+        for ( jj = 1 ; jj < positions.size() and together ; jj++ ) {
+            together = ( list[positions[jj]]->next_tics == group_tics and
+                         list[positions[jj]]->cycle_tics == group_cycle ) ;
+        }
+
+        if ( together ) {
+            index_group(std::pair< long long , long long >(group_tics, group_cycle), positions) ;
+        } else {
+            for ( jj = 0 ; jj < positions.size() ; jj++ ) {
+                index_job(positions[jj], index_time + 1) ;
+            }
+        }
+    }
+
+    due_keys.clear() ;
+    due_list.clear() ;
+    due_index = 0 ;
+    index_pass_open = false ;
+}
+
+/**
+@design
+-# If the job's next call time is earlier than min_tics park it.
+-# Else add the job to the calendar group keyed by its next call time and cycle.
+*/
+void Trick::ScheduledJobQueue::index_job(unsigned int position, long long min_tics) {
+
+    if ( list[position]->next_tics < min_tics ) {
+        parked_list.push_back(position) ;
+    } else {
+        std::vector< unsigned int > positions(1, position) ;
+        index_group(std::pair< long long , long long >(list[position]->next_tics, list[position]->cycle_tics), positions) ;
+    }
+}
+
+/**
+@design
+-# If a group already exists for key merge the incoming positions into it keeping list order.
+-# Else take a free group, or create one, and add it to the calendar under key.
+*/
+void Trick::ScheduledJobQueue::index_group(std::pair< long long , long long > key, std::vector< unsigned int > & positions) {
+
+    std::map< std::pair< long long , long long > , unsigned int >::iterator it = index_calendar.find(key) ;
+
+    if ( it != index_calendar.end() ) {
+        std::vector< unsigned int > & group = index_groups[it->second] ;
+        if ( group.empty() or group.back() < positions.front() ) {
+            group.insert(group.end(), positions.begin(), positions.end()) ;
+        } else {
+            std::vector< unsigned int > merged ;
+            merged.reserve(group.size() + positions.size()) ;
+            std::merge(group.begin(), group.end(), positions.begin(), positions.end(), std::back_inserter(merged)) ;
+            group.swap(merged) ;
+        }
+    } else {
+        unsigned int group_num ;
+        if ( free_groups.empty() ) {
+            group_num = index_groups.size() ;
+            index_groups.push_back(std::vector< unsigned int >()) ;
+        } else {
+            group_num = free_groups.back() ;
+            free_groups.pop_back() ;
+        }
+        index_groups[group_num].swap(positions) ;
+        index_calendar[key] = group_num ;
+    }
+}
+
+/**
+@design
+-# Append the group's positions to the outgoing list, return the group to the free list, and remove
+   it from the calendar.
+*/
+void Trick::ScheduledJobQueue::unindex_group(std::map< std::pair< long long , long long > , unsigned int >::iterator it,
+ std::vector< unsigned int > & positions) {
+
+    std::vector< unsigned int > & group = index_groups[it->second] ;
+    if ( positions.empty() ) {
+        positions.swap(group) ;
+    } else {
+        positions.insert(positions.end(), group.begin(), group.end()) ;
+    }
+    group.clear() ;
+    free_groups.push_back(it->second) ;
+    index_calendar.erase(it) ;
+}
+
+int Trick::ScheduledJobQueue::set_indexed(bool yes_no) {
+    indexed = yes_no ;
+    index_dirty = true ;
+    return(0) ;
+}
+
+bool Trick::ScheduledJobQueue::get_indexed() {
+    return(indexed) ;
+}
+
+int Trick::ScheduledJobQueue::rebuild_index() {
+    index_dirty = true ;
+    return(0) ;
+}
+
 /**
 @design
 -# While the list #curr_list is less than the list size
@@ -0,0 +1,121 @@
+
+/*
+   Microbenchmark comparing the linear and the time indexed ScheduledJobQueue::find_next_job.
+
+   Usage: ScheduledJobQueue_bench [num_jobs] [sim_seconds]
+
+   A queue of num_jobs jobs spread over a dozen cycle rates is stepped through sim_seconds of
+   simulation time the same way Executive::loop_single_thread() does.  Two job mixes are run:
+   every rate equally populated, and a sparse mix where 1% of the jobs run at the 1 ms frame and
+   the rest are spread over the slower rates.  The number of jobs called by both searches must match.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+
+#include "trick/ScheduledJobQueue.hh"
+#include "trick/TrickConstant.hh"
+
+static double wall_time() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return tp.tv_sec + tp.tv_nsec / 1.0e9 ;
+}
+
+static void build_queue( Trick::ScheduledJobQueue & queue , std::vector< Trick::JobData * > & jobs ,
+ unsigned int num_jobs , bool sparse ) {
+    static const double cycles[] = { 0.001 , 0.002 , 0.005 , 0.01 , 0.02 , 0.025 , 0.05 , 0.1 , 0.2 , 0.25 , 0.5 , 1.0 } ;
+    unsigned int ii ;
+    double cycle ;
+
+    for ( ii = 0 ; ii < num_jobs ; ii++ ) {
+        std::ostringstream oss ;
+        oss << "job_" << ii ;
+        if ( sparse ) {
+            cycle = ( ii % 100 == 0 ) ? cycles[0] : cycles[5 + (ii % 7)] ;
+        } else {
+            cycle = cycles[ii % 12] ;
+        }
+        Trick::JobData * job = new Trick::JobData(0, ii % 100 , "scheduled", NULL, cycle , oss.str()) ;
+        job->sim_object_id = ii / 100 ;
+        job->job_class = 1000 ;
+        job->cycle_tics = (long long)(job->cycle * 1000000 + 0.5) ;
+        job->stop_tics = TRICK_MAX_LONG_LONG ;
+        job->next_tics = 0 ;
+        queue.push(job) ;
+        jobs.push_back(job) ;
+    }
+}
+
+static double run_queue( Trick::ScheduledJobQueue & queue , long long stop_tics , unsigned long long & num_called ) {
+    long long time_tics = 0 ;
+    double start = wall_time() ;
+
+    num_called = 0 ;
+    while ( time_tics <= stop_tics ) {
+        queue.reset_curr_index() ;
+        queue.set_next_job_call_time(TRICK_MAX_LONG_LONG) ;
+        while ( queue.find_next_job(time_tics) != NULL ) {
+            num_called++ ;
+        }
+        time_tics = queue.get_next_job_call_time() ;
+    }
+    return wall_time() - start ;
+}
+
+static void delete_jobs( std::vector< Trick::JobData * > & jobs ) {
+    while ( ! jobs.empty() ) {
+        delete jobs.back() ;
+        jobs.pop_back() ;
+    }
+}
+
+static int compare( const char * mix , unsigned int num_jobs , double sim_seconds , bool sparse ) {
+
+    unsigned long long linear_called , indexed_called ;
+    std::vector< Trick::JobData * > linear_jobs , indexed_jobs ;
+    Trick::ScheduledJobQueue linear_queue ;
+    Trick::ScheduledJobQueue indexed_queue ;
+
+    build_queue(linear_queue, linear_jobs, num_jobs, sparse) ;
+    build_queue(indexed_queue, indexed_jobs, num_jobs, sparse) ;
+    indexed_queue.set_indexed(true) ;
+
+    long long stop_tics = (long long)(sim_seconds * 1000000) ;
+    double linear_time = run_queue(linear_queue, stop_tics, linear_called) ;
+    double indexed_time = run_queue(indexed_queue, stop_tics, indexed_called) ;
+
+    std::cout << std::fixed << std::setprecision(6) ;
+    std::cout << mix << " mix: jobs = " << num_jobs << " sim_seconds = " << sim_seconds << std::endl ;
+    std::cout << "    linear  : " << linear_time << " s " << linear_called << " jobs called" << std::endl ;
+    std::cout << "    indexed : " << indexed_time << " s " << indexed_called << " jobs called" << std::endl ;
+    std::cout << "    speedup : " << std::setprecision(2) << linear_time / indexed_time << std::endl ;
+
+    delete_jobs(linear_jobs) ;
+    delete_jobs(indexed_jobs) ;
+
+    return ( linear_called == indexed_called ) ? 0 : 1 ;
+}
+
+int main( int argc , char * argv[] ) {
+
+    unsigned int num_jobs = 5000 ;
+    double sim_seconds = 2.0 ;
+    int ret = 0 ;
+
+    if ( argc > 1 ) {
+        num_jobs = (unsigned int)strtoul(argv[1], NULL, 10) ;
+    }
+    if ( argc > 2 ) {
+        sim_seconds = strtod(argv[2], NULL) ;
+    }
+
+    ret |= compare("uniform", num_jobs, sim_seconds, false) ;
+    ret |= compare("sparse", num_jobs, sim_seconds, true) ;
+
+    return ret ;
+}
@@ -1,5 +1,7 @@
 
 #include <iostream>
+#include <sstream>
+#include <vector>
 #include <sys/types.h>
 #include <signal.h>
 
@@ -242,6 +244,53 @@ TEST_F( ScheduledJobQueueTest , PushJobsIgnoreSimObject ) {
 
 }
 
+TEST_F( ScheduledJobQueueTest , PushRemoveManyJobs ) {
+
+    Trick::JobData * job_ptr ;
+    Trick::JobData * prev_ptr ;
+    std::vector< Trick::JobData * > jobs ;
+    unsigned int ii ;
+
+    // Push jobs in a scrambled order so every insertion point is exercised.
+    for ( ii = 0 ; ii < 1000 ; ii++ ) {
+        unsigned int key = (ii * 7919) % 1000 ;
+        std::ostringstream oss ;
+        oss << "job_" << key ;
+        job_ptr = new Trick::JobData(0, key % 10 , "class_100", NULL, 1.0 , oss.str(), "", key % 3) ;
+        job_ptr->sim_object_id = (key / 10) % 7 ;
+        job_ptr->job_class = 100 + (key / 100) ;
+        EXPECT_EQ( sjq.push(job_ptr) , 0 ) ;
+        jobs.push_back(job_ptr) ;
+    }
+    EXPECT_EQ( sjq.size() , (unsigned int)1000) ;
+
+    // Remove every third job
+    for ( ii = 0 ; ii < jobs.size() ; ii += 3 ) {
+        EXPECT_EQ( sjq.remove(jobs[ii]) , 0 ) ;
+    }
+    EXPECT_EQ( sjq.size() , (unsigned int)666) ;
+    EXPECT_EQ( sjq.remove(jobs[0]) , -1 ) ;
+
+    // The remaining jobs are in job_class, phase, sim_object, id order.
+    sjq.reset_curr_index() ;
+    prev_ptr = sjq.get_next_job() ;
+    while ( (job_ptr = sjq.get_next_job()) != NULL ) {
+        bool ordered =
+         ( prev_ptr->job_class < job_ptr->job_class ) or
+         ( prev_ptr->job_class == job_ptr->job_class and prev_ptr->phase < job_ptr->phase ) or
+         ( prev_ptr->job_class == job_ptr->job_class and prev_ptr->phase == job_ptr->phase and
+           prev_ptr->sim_object_id < job_ptr->sim_object_id ) or
+         ( prev_ptr->job_class == job_ptr->job_class and prev_ptr->phase == job_ptr->phase and
+           prev_ptr->sim_object_id == job_ptr->sim_object_id and prev_ptr->id <= job_ptr->id ) ;
+        EXPECT_TRUE( ordered ) ;
+        prev_ptr = job_ptr ;
+    }
+
+    for ( ii = 0 ; ii < jobs.size() ; ii++ ) {
+        delete jobs[ii] ;
+    }
+}
+
 TEST_F( ScheduledJobQueueTest , TopJob ) {
 	//req.add_requirement("");
 
@@ -516,6 +565,118 @@ TEST_F( ScheduledJobQueueTest , TestNextJob ) {
     EXPECT_TRUE( job_ptr == NULL ) ;
 }
 
+TEST_F( ScheduledJobQueueTest , FindNextJobIndexed ) {
+
+    Trick::JobData * job_ptr ;
+    Trick::JobData * indexed_job_ptr ;
+    Trick::ScheduledJobQueue indexed_sjq ;
+    long long curr_time ;
+    long long indexed_time ;
+    double cycles[] = { 0.01 , 0.1 , 0.05 , 1.0 , 0.02 , 0.1 , 0.5 , 0.01 } ;
+    unsigned int ii , step , num_jobs ;
+
+    indexed_sjq.set_indexed(true) ;
+    EXPECT_TRUE( indexed_sjq.get_indexed() ) ;
+
+    // Build the same set of jobs in a linear queue and an indexed queue.
+    for ( ii = 0 ; ii < 40 ; ii++ ) {
+        std::ostringstream oss ;
+        oss << "job_" << ii ;
+        job_ptr = new Trick::JobData(0, ii , "class_100", NULL, cycles[ii % 8] , oss.str(), "", ii % 3) ;
+        job_ptr->sim_object_id = ii % 5 ;
+        job_ptr->job_class = 100 + (ii % 2) ;
+        job_ptr->cycle_tics = (long long)(job_ptr->cycle * 1000000) ;
+        job_ptr->stop_tics = 1000000000 ;
+        job_ptr->next_tics = (ii % 4) * 10000 ;
+        job_ptr->disabled = (ii == 7) ;
+        job_ptr->system_job_class = (ii == 13) ;
+        indexed_job_ptr = new Trick::JobData(*job_ptr) ;
+        sjq.push(job_ptr) ;
+        indexed_sjq.push(indexed_job_ptr) ;
+    }
+
+    curr_time = indexed_time = 0 ;
+    for ( step = 0 ; step < 500 ; step++ ) {
+        sjq.reset_curr_index() ;
+        sjq.set_next_job_call_time(1000000000) ;
+        indexed_sjq.reset_curr_index() ;
+        indexed_sjq.set_next_job_call_time(1000000000) ;
+
+        num_jobs = 0 ;
+        while ( (job_ptr = sjq.find_next_job(curr_time)) != NULL ) {
+            indexed_job_ptr = indexed_sjq.find_next_job(indexed_time) ;
+            ASSERT_TRUE( indexed_job_ptr != NULL ) ;
+            EXPECT_EQ( job_ptr->name , indexed_job_ptr->name ) ;
+            // The system job schedules itself every 0.03 seconds.
+            if ( job_ptr->system_job_class ) {
+                job_ptr->next_tics += 30000 ;
+                indexed_job_ptr->next_tics += 30000 ;
+                sjq.test_next_job_call_time(job_ptr , curr_time) ;
+                indexed_sjq.test_next_job_call_time(indexed_job_ptr , indexed_time) ;
+            }
+            num_jobs++ ;
+        }
+        EXPECT_TRUE( indexed_sjq.find_next_job(indexed_time) == NULL ) ;
+        EXPECT_GT( num_jobs , (unsigned int)0 ) ;
+
+        curr_time = sjq.get_next_job_call_time() ;
+        indexed_time = indexed_sjq.get_next_job_call_time() ;
+        EXPECT_EQ( curr_time , indexed_time ) ;
+    }
+}
+
+TEST_F( ScheduledJobQueueTest , FindNextJobIndexedReschedule ) {
+
+    Trick::JobData * job_ptr ;
+    Trick::JobData * job_1 ;
+
+    sjq.set_indexed(true) ;
+
+    job_1 = new Trick::JobData(0, 1 , "class_100", NULL, 1.0 , "job_1") ;
+    job_1->sim_object_id = 1 ;
+    job_1->job_class = 100 ;
+    job_1->cycle_tics = 1000000 ;
+    job_1->stop_tics = 1000000000 ;
+    job_1->next_tics = 0 ;
+    sjq.push(job_1) ;
+
+    job_ptr = new Trick::JobData(0, 2 , "class_100", NULL, 0.5 , "job_2") ;
+    job_ptr->sim_object_id = 1 ;
+    job_ptr->job_class = 100 ;
+    job_ptr->cycle_tics = 500000 ;
+    job_ptr->stop_tics = 1000000000 ;
+    job_ptr->next_tics = 0 ;
+    sjq.push(job_ptr) ;
+
+    // Time = 0.0
+    sjq.reset_curr_index() ;
+    sjq.set_next_job_call_time(1000000000) ;
+    EXPECT_STREQ( sjq.find_next_job(0)->name.c_str() , "job_1") ;
+    EXPECT_STREQ( sjq.find_next_job(0)->name.c_str() , "job_2") ;
+    EXPECT_TRUE( sjq.find_next_job(0) == NULL ) ;
+    EXPECT_EQ( sjq.get_next_job_call_time() , 500000 ) ;
+
+    // Move job_1 earlier through the JobData interface.  The index must see it.
+    Trick::JobData::set_time_tic_value(1000000) ;
+    job_1->set_cycle(0.25) ;
+    job_1->set_next_call_time(200000) ;
+    EXPECT_EQ( job_1->next_tics , 250000 ) ;
+
+    sjq.reset_curr_index() ;
+    sjq.set_next_job_call_time(1000000000) ;
+    EXPECT_STREQ( sjq.find_next_job(250000)->name.c_str() , "job_1") ;
+    EXPECT_TRUE( sjq.find_next_job(250000) == NULL ) ;
+    EXPECT_EQ( sjq.get_next_job_call_time() , 500000 ) ;
+
+    // Remove job_1 and make sure the index follows the list.
+    sjq.remove(job_1) ;
+    sjq.reset_curr_index() ;
+    sjq.set_next_job_call_time(1000000000) ;
+    EXPECT_STREQ( sjq.find_next_job(500000)->name.c_str() , "job_2") ;
+    EXPECT_TRUE( sjq.find_next_job(500000) == NULL ) ;
+    EXPECT_EQ( sjq.get_next_job_call_time() , 1000000 ) ;
+}
+
 TEST_F( ScheduledJobQueueTest , InstrumentBeforeAll ) {
 	//req.add_requirement("3990429752");
 
@@ -5,6 +5,7 @@
 #include "trick/SimObject.hh"
 
 long long Trick::JobData::time_tic_value = 0 ;
+unsigned long long Trick::JobData::schedule_epoch = 0 ;
 
 Trick::JobData::JobData() {
 
@@ -86,6 +87,8 @@ int Trick::JobData::set_handled(bool yes_no) {
 
 int Trick::JobData::set_time_tic_value(long long in_time_tic_value) {
     time_tic_value = in_time_tic_value ;
+    /* All job call times are recalculated after a time tic change */
+    __atomic_add_fetch(&schedule_epoch, 1, __ATOMIC_RELEASE) ;
     return 0 ;
 }
 
@@ -106,6 +109,8 @@ int Trick::JobData::set_next_call_time(long long time_tics) {
     } else {
         next_tics = time_tics ;
     }
+    /* Tell time indexed queues this job may have moved earlier */
+    __atomic_add_fetch(&schedule_epoch, 1, __ATOMIC_RELEASE) ;
     return 0 ;
 }
 
@@ -0,0 +1,78 @@
+
+#include <map>
+#include <utility>
+
+#include "trick/AddressPathCache.hh"
+#include "trick/dllist.h"
+
+/**
+@details
+-# Walk each address path, folding consecutive offsets into one.  An AO_ADDRESS node starts the path over at
+   a fixed address.
+-# At each AO_DEREFERENCE look up the hop for the current parent and offset, adding it if it is new.  Parents
+   are always added before their children so resolve() can read the hops in order.
+-# The remaining offset after the last hop is the final offset of the reference.
+*/
+void Trick::AddressPathCache::compile( const std::vector< REF2 * > & refs ) {
+
+    std::map< std::pair< long , ptrdiff_t > , long > hop_map ;
+
+    hops.clear() ;
+    paths.clear() ;
+
+    for ( size_t ii = 0 ; ii < refs.size() ; ii++ ) {
+        Path path ;
+        path.ref = refs[ii] ;
+        path.hop = -2 ;
+        path.offset = 0 ;
+
+        if ( refs[ii] != NULL && refs[ii]->pointer_present == 1 && refs[ii]->address_path != NULL ) {
+            DLLPOS list_pos = DLL_GetHeadPosition(refs[ii]->address_path) ;
+            path.hop = -1 ;
+            while ( list_pos != NULL ) {
+                ADDRESS_NODE * address_node = (ADDRESS_NODE *)DLL_GetNext(&list_pos, refs[ii]->address_path) ;
+                switch ( address_node->operator_ ) {
+                    case AO_ADDRESS:
+                        path.hop = -1 ;
+                        path.offset = (ptrdiff_t)address_node->operand.address ;
+                        break ;
+                    case AO_OFFSET:
+                        path.offset += address_node->operand.offset ;
+                        break ;
+                    case AO_DEREFERENCE: {
+                        std::pair< long , ptrdiff_t > key(path.hop, path.offset) ;
+                        std::map< std::pair< long , ptrdiff_t > , long >::iterator it = hop_map.find(key) ;
+                        if ( it == hop_map.end() ) {
+                            Hop hop ;
+                            hop.parent = path.hop ;
+                            hop.offset = path.offset ;
+                            hops.push_back(hop) ;
+                            it = hop_map.insert(std::make_pair(key, (long)hops.size() - 1)).first ;
+                        }
+                        path.hop = it->second ;
+                        path.offset = 0 ;
+                        break ;
+                    }
+                }
+            }
+        }
+        paths.push_back(path) ;
+    }
+
+    hop_values.assign(hops.size(), (char *)NULL) ;
+    valid = true ;
+}
+
+void Trick::AddressPathCache::resolve() {
+
+    for ( size_t ii = 0 ; ii < hops.size() ; ii++ ) {
+        const Hop & hop = hops[ii] ;
+        if ( hop.parent < 0 ) {
+            hop_values[ii] = hop.offset ? *(char **)hop.offset : NULL ;
+        } else if ( hop_values[hop.parent] != NULL ) {
+            hop_values[ii] = *(char **)(hop_values[hop.parent] + hop.offset) ;
+        } else {
+            hop_values[ii] = NULL ;
+        }
+    }
+}
@@ -1,5 +1,7 @@
 
 #include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
 #include <iostream>
 #include <udunits2.h>
 #include "trick/VariableServer.hh"
@@ -24,6 +26,12 @@ Trick::VariableReference::VariableReference(REF2 * in_ref ) {
     // so we need to keep track that they are really string and wstring
     string_type = ref->attr->type ;
     need_deref = false ;
+    validated_address = NULL ;
+    validated_epoch = 0 ;
+    shared = NULL ;
+    share_tried = false ;
+    buffer_sent = NULL ;
+    size_sent = -1 ;
 
     if ( ref->num_index == ref->attr->num_index ) {
         // single value
@@ -57,12 +65,59 @@ Trick::VariableReference::VariableReference(REF2 * in_ref ) {
         size = MAX_ARRAY_LENGTH ;
     }
 
+    buffer_size = size ;
     buffer_in  = calloc( size, 1 ) ;
     buffer_out = calloc( size, 1 ) ;
 
 
 }
 
+void Trick::VariableReference::copy_value() {
+
+    // if this variable is a string we need to get the raw character string out of it.
+    if (( string_type == TRICK_STRING ) && !need_deref) {
+        std::string * str_ptr = (std::string *)ref->address ;
+        address = (void *)(str_ptr->c_str()) ;
+    }
+
+    // if this variable itself is a pointer, dereference it
+    if ( need_deref) {
+        address = *(void**)ref->address ;
+    }
+
+    // handle c++ string and char*
+    if ( string_type == TRICK_STRING ) {
+        if (address == NULL) {
+            size = 0 ;
+        } else {
+            size = strlen((char*)address) + 1 ;
+        }
+    }
+    // handle c++ wstring and wchar_t*
+    if ( string_type == TRICK_WSTRING ) {
+        if (address == NULL) {
+            size = 0 ;
+        } else {
+            size = wcslen((wchar_t *)address) * sizeof(wchar_t);
+        }
+    }
+    if(address != NULL) {
+        memcpy( buffer_in , address , size ) ;
+    }
+}
+
+bool Trick::VariableReference::value_changed() const {
+    return size != size_sent or memcmp(buffer_out, buffer_sent, size) != 0 ;
+}
+
+void Trick::VariableReference::mark_sent() {
+    if ( buffer_sent == NULL ) {
+        buffer_sent = calloc( buffer_size, 1 ) ;
+    }
+    memcpy( buffer_sent , buffer_out , size ) ;
+    size_sent = size ;
+}
+
 std::ostream& Trick::operator<< (std::ostream& s, const Trick::VariableReference& vref) {
 
     if (vref.ref->reference != NULL) {
@@ -77,4 +132,5 @@ Trick::VariableReference::~VariableReference() {
     free(ref) ;
     free(buffer_in) ;
     free(buffer_out) ;
+    free(buffer_sent) ;
 }
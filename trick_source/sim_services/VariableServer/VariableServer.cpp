@@ -88,6 +88,10 @@ Trick::VariableServerListenThread & Trick::VariableServer::get_listen_thread() {
     return listen_thread ;
 }
 
+Trick::VariableServerSnapshot & Trick::VariableServer::get_snapshot() {
+    return snapshot ;
+}
+
 void Trick::VariableServer::add_vst(pthread_t in_thread_id, VariableServerThread * in_vst) {
     pthread_mutex_lock(&map_mutex) ;
     var_server_threads[in_thread_id] = in_vst ;
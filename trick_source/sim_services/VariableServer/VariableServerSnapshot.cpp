@@ -0,0 +1,152 @@
+
+#include <stdlib.h>
+#include "trick/VariableServerSnapshot.hh"
+#include "trick/memorymanager_c_intf.h"
+
+Trick::VariableServerSnapshot::VariableServerSnapshot() :
+ stale(true) ,
+ num_copies(0) {
+    pthread_mutex_init(&mutex, NULL);
+}
+
+Trick::VariableServerSnapshot::~VariableServerSnapshot() {
+    for ( unsigned int ii = 0 ; ii < entry_list.size() ; ii++ ) {
+        delete entry_list[ii]->var ;
+        delete entry_list[ii] ;
+    }
+    pthread_mutex_destroy(&mutex);
+}
+
+/**
+@details
+-# Find the entry with the name of the client variable.
+-# If there is none, resolve the name again so the entry owns its reference and create the entry.
+-# The client shares the entry only if both copy the same number of bytes the same way.  A dynamic array
+   resized between the two var_adds, for instance, is not shared.
+-# Count the clients that validate addresses.  The entry is validated in copy() while any of them shares it.
+*/
+Trick::SharedVariable * Trick::VariableServerSnapshot::subscribe( VariableReference * var , bool validate ) {
+
+    SharedVariable * entry ;
+    std::map< std::string , SharedVariable * >::iterator it = entries.find(var->ref->reference) ;
+
+    if ( it == entries.end() ) {
+        REF2 * new_ref = ref_attributes(var->ref->reference) ;
+        if ( new_ref == NULL ) {
+            return NULL ;
+        }
+        entry = new SharedVariable ;
+        entry->name = var->ref->reference ;
+        entry->var = new VariableReference(new_ref) ;
+        entry->ref_count = 0 ;
+        entry->num_validating = 0 ;
+        entry->resolved = false ;
+        entry->valid = false ;
+        entries[entry->name] = entry ;
+        entry_list.push_back(entry) ;
+        address_paths.invalidate() ;
+        // Copy the new entry with the others the next time.
+        stale = true ;
+    } else {
+        entry = it->second ;
+    }
+
+    if ( entry->var->size != var->size or
+         entry->var->string_type != var->string_type or
+         entry->var->need_deref != var->need_deref ) {
+        if ( entry->ref_count == 0 ) {
+            unsubscribe(entry) ;
+        }
+        return NULL ;
+    }
+
+    entry->ref_count++ ;
+    if ( validate ) {
+        entry->num_validating++ ;
+    }
+    return entry ;
+}
+
+void Trick::VariableServerSnapshot::unsubscribe( SharedVariable * entry , bool validate ) {
+
+    if ( validate ) {
+        entry->num_validating-- ;
+    }
+    if ( --entry->ref_count > 0 ) {
+        return ;
+    }
+
+    entries.erase(entry->name) ;
+    for ( unsigned int ii = 0 ; ii < entry_list.size() ; ii++ ) {
+        if ( entry_list[ii] == entry ) {
+            entry_list.erase(entry_list.begin() + ii) ;
+            break ;
+        }
+    }
+    address_paths.invalidate() ;
+    delete entry->var ;
+    delete entry ;
+}
+
+/**
+@details
+-# Return if the entries were copied since the last expire().
+-# Compile the entry address paths if entries were added or removed, and read every pointer on the paths once.
+-# Copy each entry whose address path resolves into its buffer_in.  An entry with a NULL pointer on its path
+   keeps its last value and is marked unresolved so the clients sharing it can turn it into a bad reference.
+-# If a client sharing the entry validates addresses, check the address is in a memory manager allocation before
+   reading it.  An entry that fails is not copied and is marked unresolved the same way.
+*/
+void Trick::VariableServerSnapshot::copy() {
+
+    if ( ! stale ) {
+        return ;
+    }
+
+    if ( ! address_paths.is_valid() or address_paths.size() != entry_list.size() ) {
+        std::vector<REF2 *> refs ;
+        for ( unsigned int ii = 0 ; ii < entry_list.size() ; ii++ ) {
+            refs.push_back(entry_list[ii]->var->ref) ;
+        }
+        address_paths.compile(refs) ;
+    }
+    address_paths.resolve() ;
+
+    for ( unsigned int ii = 0 ; ii < entry_list.size() ; ii++ ) {
+        VariableReference * var = entry_list[ii]->var ;
+
+        entry_list[ii]->resolved = true ;
+        if ( var->ref->pointer_present == 1 ) {
+            var->address = address_paths.get_address(ii) ;
+            if ( var->address == NULL ) {
+                entry_list[ii]->resolved = false ;
+                continue ;
+            }
+            var->ref->address = var->address ;
+            if ( entry_list[ii]->num_validating > 0 and
+                 var->string_type != TRICK_STRING and
+                 var->string_type != TRICK_WSTRING and
+                 ! validate(entry_list[ii]) ) {
+                entry_list[ii]->resolved = false ;
+                continue ;
+            }
+        }
+        var->copy_value() ;
+    }
+
+    stale = false ;
+    num_copies++ ;
+}
+
+bool Trick::VariableServerSnapshot::validate( SharedVariable * entry ) {
+
+    VariableReference * var = entry->var ;
+    unsigned long long alloc_epoch = get_alloc_epoch() ;
+
+    if ( var->ref->address != var->validated_address or alloc_epoch != var->validated_epoch ) {
+        entry->valid = ( get_alloc_info_of(var->ref->address) != NULL ) ;
+        var->validated_address = var->ref->address ;
+        var->validated_epoch = alloc_epoch ;
+    }
+    return entry->valid ;
+}
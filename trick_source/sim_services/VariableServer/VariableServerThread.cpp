@@ -23,6 +23,9 @@ Trick::VariableServerThread::VariableServerThread(TCDevice * in_listen_dev) :
     freeze_frame_multiple = 1 ;
     freeze_frame_offset = 0 ;
     binary_data = false;
+    keyframe_interval = 0 ;
+    messages_since_keyframe = 0 ;
+    keyframe_needed = true ;
     multicast = false;
     byteswap = false ;
 
@@ -59,6 +62,9 @@ Trick::VariableServerThread::VariableServerThread(TCDevice * in_listen_dev) :
 }
 
 Trick::VariableServerThread::~VariableServerThread() {
+    for ( unsigned int ii = 0 ; ii < vars.size() ; ii++ ) {
+        release_shared_var(vars[ii]) ;
+    }
     free( incoming_msg ) ;
     free( stripped_msg ) ;
 }
@@ -86,9 +86,21 @@ Trick::VariableReference* Trick::VariableServerThread::create_var_reference(std:
     return new VariableReference(new_ref) ;
 }
 
+void Trick::VariableServerThread::release_shared_var(VariableReference * var) {
+    if ( var->shared != NULL ) {
+        vs->get_snapshot().lock() ;
+        vs->get_snapshot().unsubscribe(var->shared, validate_address) ;
+        var->shared = NULL ;
+        vs->get_snapshot().unlock() ;
+    }
+}
+
 int Trick::VariableServerThread::var_add(std::string in_name) {
     VariableReference * new_var = create_var_reference(in_name);
     vars.push_back(new_var) ;
+    address_paths.invalidate() ;
+    // Clients only know the indices of the variables sent in the last full message.
+    keyframe_needed = true ;
 
     return(0) ;
 }
@@ -135,8 +147,12 @@ int Trick::VariableServerThread::var_remove(std::string in_name) {
     for ( ii = 0 ; ii < vars.size() ; ii++ ) {
         std::string var_name = vars[ii]->ref->reference;
         if ( ! var_name.compare(in_name) ) {
+            release_shared_var(vars[ii]);
             delete vars[ii];
             vars.erase(vars.begin() + ii) ;
+            address_paths.invalidate() ;
+            // The indices of the following variables changed.
+            keyframe_needed = true ;
             break ;
         }
     }
@@ -207,6 +223,8 @@ int Trick::VariableServerThread::var_units(std::string var_name, std::string uni
             free(variable->ref->units);
             variable->ref->units = strdup(new_units.c_str());
         }
+        // Send the value in its new units even if it did not change.
+        variable->clear_sent() ;
     }
     return(0) ;
 }
@@ -248,14 +266,18 @@ int Trick::VariableServerThread::var_exists(std::string in_name) {
 
 int Trick::VariableServerThread::var_clear() {
     while( !vars.empty() ) {
+        release_shared_var(vars.back());
         delete vars.back();
         vars.pop_back();
     }
+    address_paths.invalidate() ;
+    keyframe_needed = true ;
     return(0) ;
 }
 
 
 int Trick::VariableServerThread::var_send() {
+    keyframe_needed = true ;
     copy_sim_data();
     write_data();
     return(0) ;
@@ -281,6 +303,15 @@ int Trick::VariableServerThread::var_exit() {
 }
 
 int Trick::VariableServerThread::var_validate_address(bool on_off) {
+    if ( on_off != validate_address ) {
+        // The snapshot counts the clients that validate each shared variable.  Share the variables again
+        // with the new setting the next time they are copied.
+        for ( unsigned int ii = 0 ; ii < vars.size() ; ii++ ) {
+            release_shared_var(vars[ii]) ;
+            vars[ii]->share_tried = false ;
+        }
+        address_paths.invalidate() ;
+    }
     validate_address = on_off ;
     return(0) ;
 }
@@ -292,17 +323,27 @@ int Trick::VariableServerThread::var_debug(int level) {
 
 int Trick::VariableServerThread::var_ascii() {
     binary_data = 0 ;
+    keyframe_needed = true ;
     return(0) ;
 }
 
 int Trick::VariableServerThread::var_binary() {
     binary_data = 1 ;
+    keyframe_needed = true ;
     return(0) ;
 }
 
 int Trick::VariableServerThread::var_binary_nonames() {
     binary_data = 1 ;
     binary_data_nonames = 1 ;
+    keyframe_needed = true ;
+    return(0) ;
+}
+
+int Trick::VariableServerThread::var_send_on_change(unsigned int in_keyframe_interval) {
+    keyframe_interval = in_keyframe_interval ;
+    messages_since_keyframe = 0 ;
+    keyframe_needed = true ;
     return(0) ;
 }
 
@@ -18,28 +18,89 @@ int Trick::VariableServerThread::copy_sim_data(std::vector<VariableReference *>
 
     if ( pthread_mutex_trylock(&copy_mutex) == 0 ) {
 
+        // Variables copied by the simulation jobs are staged from the snapshot shared by all of the clients,
+        // which copies each variable from simulation memory once per copy job.  Copies made on this client's
+        // own thread (async copies and var_send) read simulation memory directly.
+        VariableServerSnapshot * snapshot = NULL ;
+        if ( cyclical and ! pthread_equal(pthread_self(), get_pthread_id()) and vs->get_snapshot().trylock() == 0 ) {
+            snapshot = &vs->get_snapshot() ;
+            for (auto curr_var : given_vars ) {
+                if ( ! curr_var->share_tried ) {
+                    curr_var->share_tried = true ;
+                    if ( (curr_var->ref->address != &bad_ref_int) and
+                         (curr_var->ref->address != &do_not_resolve_bad_ref_int) and
+                         (curr_var->ref->address != (char *)&time) ) {
+                        curr_var->shared = snapshot->subscribe(curr_var, validate_address) ;
+                        address_paths.invalidate() ;
+                    }
+                }
+            }
+            snapshot->copy() ;
+        }
+
         // Get the simulation time we start this copy
         if (cyclical) {
             time = (double)exec_get_time_tics() / exec_get_time_tic_value() ;
+
+            // Compile the address paths of the variables not staged from the snapshot the first time they are
+            // copied, then read each pointer on the paths once for all of the variables.
+            if ( ! address_paths.is_valid() or address_paths.size() != given_vars.size() ) {
+                std::vector<REF2 *> refs ;
+                for (auto curr_var : given_vars ) {
+                    refs.push_back(curr_var->shared ? NULL : curr_var->ref) ;
+                }
+                address_paths.compile(refs) ;
+            }
+            address_paths.resolve() ;
         }
 
-        for (auto curr_var : given_vars ) {
+        // Addresses validated since the memory manager allocations last changed are still valid.
+        unsigned long long alloc_epoch = validate_address ? get_alloc_epoch() : 0 ;
+
+        for (unsigned int ii = 0 ; ii < given_vars.size() ; ii++ ) {
+            VariableReference * curr_var = given_vars[ii] ;
+
+            if ( snapshot != NULL and curr_var->shared != NULL ) {
+                SharedVariable * shared = curr_var->shared ;
+                // The snapshot resolved the address once for all of the clients, and validated it before
+                // reading it if this client validates addresses.
+                if ( (curr_var->ref->pointer_present != 1) or shared->resolved ) {
+                    curr_var->ref->address = shared->var->ref->address ;
+                    curr_var->address = shared->var->address ;
+                    curr_var->size = shared->var->size ;
+                    if ( curr_var->address != NULL ) {
+                        memcpy( curr_var->buffer_in , shared->var->buffer_in , curr_var->size ) ;
+                    }
+                    continue ;
+                }
+                // Stop sharing the variable and let the checks below turn it into a bad reference.
+                snapshot->unsubscribe(shared, validate_address) ;
+                curr_var->shared = NULL ;
+                address_paths.invalidate() ;
+            }
 
             if (curr_var->ref->address == &bad_ref_int) {
                 REF2 *new_ref = ref_attributes(curr_var->ref->reference);
                 if (new_ref != NULL) {
                     curr_var->ref = new_ref;
+                    curr_var->share_tried = false ;
+                    address_paths.invalidate() ;
                 }
             }
 
             // if there's a pointer somewhere in the address path, follow it in case pointer changed
             if ( curr_var->ref->pointer_present == 1 ) {
-                curr_var->address = follow_address_path(curr_var->ref) ;
+                if ( cyclical and address_paths.is_compiled(ii, curr_var->ref) ) {
+                    curr_var->address = address_paths.get_address(ii) ;
+                } else {
+                    curr_var->address = follow_address_path(curr_var->ref) ;
+                }
                 if (curr_var->address == NULL) {
                     std::string save_name(curr_var->ref->reference) ;
                     free(curr_var->ref) ;
                     curr_var->ref = make_error_ref(save_name) ;
                     curr_var->address = curr_var->ref->address ;
+                    address_paths.invalidate() ;
                 } else if ( validate_address ) {
                     // The address is not NULL.
                     // If validate_address is on, check the memory manager if the address falls into
@@ -48,11 +109,18 @@ int Trick::VariableServerThread::copy_sim_data(std::vector<VariableReference *>
                     if ( (curr_var->string_type != TRICK_STRING) and
                             (curr_var->string_type != TRICK_WSTRING) and
                             (curr_var->ref->address != &bad_ref_int) and
-                            (get_alloc_info_of(curr_var->address) == NULL) ) {
-                        std::string save_name(curr_var->ref->reference) ;
-                        free(curr_var->ref) ;
-                        curr_var->ref = make_error_ref(save_name) ;
-                        curr_var->address = curr_var->ref->address ;
+                            ((curr_var->address != curr_var->validated_address) or
+                             (alloc_epoch != curr_var->validated_epoch)) ) {
+                        if (get_alloc_info_of(curr_var->address) == NULL) {
+                            std::string save_name(curr_var->ref->reference) ;
+                            free(curr_var->ref) ;
+                            curr_var->ref = make_error_ref(save_name) ;
+                            curr_var->address = curr_var->ref->address ;
+                            address_paths.invalidate() ;
+                        } else {
+                            curr_var->validated_address = curr_var->address ;
+                            curr_var->validated_epoch = alloc_epoch ;
+                        }
                     }
                 } else {
                     curr_var->ref->address = curr_var->address ;
@@ -60,36 +128,7 @@ int Trick::VariableServerThread::copy_sim_data(std::vector<VariableReference *>
 
             }
 
-            // if this variable is a string we need to get the raw character string out of it.
-            if (( curr_var->string_type == TRICK_STRING ) && !curr_var->need_deref) {
-                std::string * str_ptr = (std::string *)curr_var->ref->address ;
-                curr_var->address = (void *)(str_ptr->c_str()) ;
-            }
-
-            // if this variable itself is a pointer, dereference it
-            if ( curr_var->need_deref) {
-                curr_var->address = *(void**)curr_var->ref->address ;
-            }
-
-            // handle c++ string and char*
-            if ( curr_var->string_type == TRICK_STRING ) {
-                if (curr_var->address == NULL) {
-                    curr_var->size = 0 ;
-                } else {
-                    curr_var->size = strlen((char*)curr_var->address) + 1 ;
-                }
-            }
-            // handle c++ wstring and wchar_t*
-            if ( curr_var->string_type == TRICK_WSTRING ) {
-                if (curr_var->address == NULL) {
-                    curr_var->size = 0 ;
-                } else {
-                    curr_var->size = wcslen((wchar_t *)curr_var->address) * sizeof(wchar_t);
-                }
-            }
-            if(curr_var->address != NULL) {
-                memcpy( curr_var->buffer_in , curr_var->address , curr_var->size ) ;
-            }
+            curr_var->copy_value() ;
         }
 
         // Indicate that sim data has been written and is now ready in the buffer_in's of the vars variable list.
@@ -98,6 +137,9 @@ int Trick::VariableServerThread::copy_sim_data(std::vector<VariableReference *>
             packets_copied++ ;
         }
 
+        if ( snapshot != NULL ) {
+            snapshot->unlock() ;
+        }
         pthread_mutex_unlock(&copy_mutex) ;
     }
 
@@ -21,6 +21,7 @@ void Trick::VariableServerThread::preload_checkpoint() {
     // by tagging each as a "bad reference".
     std::vector <VariableReference *>::iterator it ;
     for (it = vars.begin(); it != vars.end() ; it++) {
+        release_shared_var(*it) ;
         (*it)->ref->address = (char*)&bad_ref_int;
         (*it)->ref->attr = new ATTRIBUTES() ;
         (*it)->ref->attr->type = TRICK_NUMBER_OF_TYPES ;
@@ -37,6 +38,9 @@ void Trick::VariableServerThread::restart() {
     // Set the pause state of this thread back to its "pre-checkpoint reload" state.
     pause_cmd = saved_pause_cmd ;
 
+    // The variables are resolved again, send all of them in the next message.
+    keyframe_needed = true ;
+
     // Restart the variable server processing.
     pthread_mutex_unlock(&restart_pause);
 
@@ -12,6 +12,7 @@ PROGRAMMERS: (((Alex Lin) (NASA) (8/06) (--)))
 #include "trick/tc_proto.h"
 #include "trick/message_proto.h"
 #include "trick/message_type.h"
+#include "trick/formatNumber.hh"
 
 
 extern "C" {
@@ -21,7 +22,8 @@ extern "C" {
 #define MAX_MSG_LEN    8192
 
 
-int Trick::VariableServerThread::write_binary_data( int Start, char *buf1, const std::vector<VariableReference *>& given_vars, VS_MESSAGE_TYPE message_type) {
+int Trick::VariableServerThread::write_binary_data( int Start, char *buf1, const std::vector<VariableReference *>& given_vars, VS_MESSAGE_TYPE message_type,
+ const std::vector<unsigned int> * indices ) {
     int i;
     int ret ;
     int HeaderSize, MessageSize;
@@ -61,6 +63,10 @@ int Trick::VariableServerThread::write_binary_data( int Start, char *buf1, const
         } else {
             MessageSize = sizeof(len) + len + sizeof(int) + sizeof(size) + size ;
         }
+        // var_send_on_change messages put the index of the variable first
+        if (indices != NULL) {
+            MessageSize += sizeof(unsigned int) ;
+        }
 
         /* make sure this message will fit in a packet by itself */
         if ( (HeaderSize + MessageSize) > MAX_MSG_LEN ) {
@@ -72,6 +78,15 @@ int Trick::VariableServerThread::write_binary_data( int Start, char *buf1, const
         }
 
         if ( (offset + MessageSize) < MAX_MSG_LEN ) {
+            if (indices != NULL) {
+                unsigned int index = (*indices)[i] ;
+                if (byteswap) {
+                    index = trick_byteswap_int((int)index) ;
+                }
+                memcpy(&buf1[offset] , &index , sizeof(index)) ;
+                offset += sizeof(index) ;
+            }
+
             if (byteswap) {
                 if (!binary_data_nonames) {
                     swap_int = trick_byteswap_int((int)len) ;
@@ -177,58 +192,67 @@ int Trick::VariableServerThread::write_binary_data( int Start, char *buf1, const
     return i;
 }
 
-int Trick::VariableServerThread::write_ascii_data(char * dest_buf, size_t dest_buf_size, const std::vector<VariableReference *>& given_vars, VS_MESSAGE_TYPE message_type ) {
+int Trick::VariableServerThread::write_ascii_data(char * dest_buf, size_t dest_buf_size, const std::vector<VariableReference *>& given_vars, VS_MESSAGE_TYPE message_type,
+ const std::vector<unsigned int> * indices ) {
 
-    snprintf(dest_buf, dest_buf_size, "%d\t", message_type) ;
+    // The message length is tracked instead of searched for, each value is copied into dest_buf once.
+    int len = snprintf(dest_buf, dest_buf_size, "%d\t", message_type) ;
 
     for (unsigned long i = 0; i < given_vars.size(); i++) {
         char curr_buf[MAX_MSG_LEN];
-        int ret = vs_format_ascii( given_vars[i] , curr_buf, sizeof(curr_buf));
+        size_t index_len = 0 ;
+
+        // var_send_on_change messages put the index of the variable before its value
+        if (indices != NULL) {
+            index_len = Trick::format_unsigned_long_long((*indices)[i], curr_buf) ;
+            curr_buf[index_len++] = '\t' ;
+        }
+        int ret = vs_format_ascii( given_vars[i] , curr_buf + index_len, sizeof(curr_buf) - index_len);
 
         if (ret < 0) {
             message_publish(MSG_WARNING, "%p Variable Server string buffer[%d] too small for symbol %s, TRUNCATED IT.\n",
                             &connection, MAX_MSG_LEN, given_vars[i]->ref->reference );
         }
 
+        size_t curr_len = strlen( curr_buf ) ;
+
         /* make sure this message will fit in a packet by itself */
-        if( strlen( curr_buf ) + 2 > MAX_MSG_LEN ) {
+        if( curr_len + 2 > MAX_MSG_LEN ) {
             message_publish(MSG_WARNING, "%p Variable Server buffer[%d] too small for symbol %s, TRUNCATED IT.\n",
                             &connection, MAX_MSG_LEN, given_vars[i]->ref->reference );
-            curr_buf[MAX_MSG_LEN - 1] = '\0';
+            curr_len = MAX_MSG_LEN - 2 ;
         }
 
-        int len = strlen(dest_buf) ;
-
         /* make sure there is space for the next tab or next newline and null */
-        if( len + strlen( curr_buf ) + 2 > MAX_MSG_LEN ) {
+        if( len + curr_len + 2 > MAX_MSG_LEN ) {
             // If there isn't, send incomplete message
             if (debug >= 2) {
                 message_publish(MSG_DEBUG, "%p tag=<%s> var_server sending %d ascii bytes:\n%s\n",
-                                &connection, connection.client_tag, (int)strlen(dest_buf), dest_buf) ;
+                                &connection, connection.client_tag, len, dest_buf) ;
             }
 
             ret = tc_write(&connection, (char *) dest_buf, len);
             if ( ret != len ) {
                 return(-1) ;
             }
-            dest_buf[0] = '\0';
+            len = 0 ;
         }
 
-        strcat(dest_buf, curr_buf);
-        strcat(dest_buf, "\t");
+        memcpy(dest_buf + len, curr_buf, curr_len) ;
+        len += curr_len ;
+        dest_buf[len++] = '\t' ;
+        dest_buf[len] = '\0' ;
     }
 
-    int len = strlen(dest_buf) ;
-
     if ( len > 0 ) {
-        dest_buf[ strlen(dest_buf) - 1 ] = '\n';
+        dest_buf[ len - 1 ] = '\n';
 
         if (debug >= 2) {
             message_publish(MSG_DEBUG, "%p tag=<%s> var_server sending %d ascii bytes:\n%s\n",
-                            &connection, connection.client_tag, (int)strlen(dest_buf), dest_buf) ;
+                            &connection, connection.client_tag, len, dest_buf) ;
         }
-        int ret = tc_write(&connection, (char *) dest_buf, (int)strlen(dest_buf));
-        if ( ret != (int)strlen(dest_buf) ) {
+        int ret = tc_write(&connection, (char *) dest_buf, len);
+        if ( ret != len ) {
             return(-1) ;
         }
     }
@@ -236,6 +260,37 @@ int Trick::VariableServerThread::write_ascii_data(char * dest_buf, size_t dest_b
     return 0;
 }
 
+/**
+@details
+-# If the variable list or format changed, or keyframe_interval messages of changes were sent since the last full
+   message, mark every variable sent and return false to send a full message.
+-# Otherwise collect the variables whose buffer_out differs from the value last sent, and their indices in vars.
+*/
+bool Trick::VariableServerThread::select_changed_vars() {
+
+    unsigned int ii ;
+
+    if ( keyframe_needed or ++messages_since_keyframe >= keyframe_interval ) {
+        for ( ii = 0 ; ii < vars.size() ; ii++ ) {
+            vars[ii]->mark_sent() ;
+        }
+        keyframe_needed = false ;
+        messages_since_keyframe = 0 ;
+        return false ;
+    }
+
+    changed_vars.clear() ;
+    changed_indices.clear() ;
+    for ( ii = 0 ; ii < vars.size() ; ii++ ) {
+        if ( vars[ii]->value_changed() ) {
+            vars[ii]->mark_sent() ;
+            changed_vars.push_back(vars[ii]) ;
+            changed_indices.push_back(ii) ;
+        }
+    }
+    return true ;
+}
+
 int Trick::VariableServerThread::write_data() {
 
     int ret;
@@ -263,22 +318,35 @@ int Trick::VariableServerThread::write_data() {
         /* Relinquish sole access to vars[ii]->buffer_in. */
         pthread_mutex_unlock(&copy_mutex) ;
 
+        const std::vector<VariableReference *> * send_vars = &vars ;
+        const std::vector<unsigned int> * indices = NULL ;
+        VS_MESSAGE_TYPE message_type = VS_VAR_LIST ;
+
+        if ( keyframe_interval > 0 and select_changed_vars() ) {
+            if ( changed_vars.empty() ) {
+                return 0 ;
+            }
+            send_vars = &changed_vars ;
+            indices = &changed_indices ;
+            message_type = VS_VAR_CHANGES ;
+        }
+
         if (binary_data) {
             int index = 0;            
 
             do {
-                ret = write_binary_data( index, buf1, vars, VS_VAR_LIST );
+                ret = write_binary_data( index, buf1, *send_vars, message_type, indices );
                 if ( ret >= 0 ) {
                     index = ret ;
                 } else {
                     return(-1) ;
                 }
-            } while( index < (int)vars.size() );
+            } while( index < (int)send_vars->size() );
 
             return 0;
 
         } else { /* ascii mode */
-            return write_ascii_data(buf1, sizeof(buf1), vars, VS_VAR_LIST );
+            return write_ascii_data(buf1, sizeof(buf1), *send_vars, message_type, indices );
         }
     }
 }
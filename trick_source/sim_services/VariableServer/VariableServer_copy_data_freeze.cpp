@@ -8,6 +8,9 @@ int Trick::VariableServer::copy_data_freeze() {
 
     std::map < pthread_t , VariableServerThread * >::iterator it ;
 
+    // Copy the variables shared by the clients again for this job.
+    snapshot.expire() ;
+
     pthread_mutex_lock(&map_mutex) ;
     for ( it = var_server_threads.begin() ; it != var_server_threads.end() ; it++ ) {
         (*it).second->copy_data_freeze() ;
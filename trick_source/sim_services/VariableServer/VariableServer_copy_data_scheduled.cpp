@@ -13,6 +13,9 @@ int Trick::VariableServer::copy_data_scheduled() {
 
     next_call_tics = TRICK_MAX_LONG_LONG ;
 
+    // Copy the variables shared by the clients again for this job.
+    snapshot.expire() ;
+
     pthread_mutex_lock(&map_mutex) ;
     for ( it = var_server_threads.begin() ; it != var_server_threads.end() ; it++ ) {
         vst = (*it).second ;
@@ -0,0 +1,131 @@
+
+#include <string.h>
+#include "gtest/gtest.h"
+
+#define protected public
+#include "trick/VariableServerSnapshot.hh"
+#include "trick/MemoryManager.hh"
+#include "trick/memorymanager_c_intf.h"
+
+namespace Trick {
+
+/* The snapshot reads the watched variables through values_ptr, which points into an allocation of the memory
+   manager. */
+double * values_ptr ;
+
+class VariableServerSnapshotTest : public ::testing::Test {
+    protected:
+        Trick::MemoryManager * memmgr ;
+        double * values ;
+
+        VariableServerSnapshotTest() {}
+        ~VariableServerSnapshotTest() {}
+        virtual void SetUp() {
+            memmgr = new Trick::MemoryManager ;
+            memmgr->declare_extern_var(&values_ptr, "double * values_ptr") ;
+            values = new_values(1.0) ;
+        }
+        virtual void TearDown() {
+            delete memmgr ;
+        }
+
+        /* Allocate three values from the memory manager starting at first and point values_ptr at them */
+        double * new_values( double first ) {
+            double * new_vals = (double *)memmgr->declare_var("double values[3]") ;
+            new_vals[0] = first ;
+            new_vals[1] = first + 1.0 ;
+            new_vals[2] = first + 2.0 ;
+            values_ptr = new_vals ;
+            return new_vals ;
+        }
+
+        static double copied( SharedVariable * entry ) {
+            return *(double *)entry->var->buffer_in ;
+        }
+} ;
+
+TEST_F(VariableServerSnapshotTest , CopiesThroughPointer) {
+    VariableServerSnapshot snapshot ;
+    VariableReference client(ref_attributes("values_ptr[1]")) ;
+    SharedVariable * entry ;
+
+    ASSERT_EQ( client.ref->pointer_present , 1 ) ;
+    entry = snapshot.subscribe(&client) ;
+    ASSERT_TRUE( entry != NULL ) ;
+    EXPECT_EQ( entry->num_validating , 0 ) ;
+
+    snapshot.copy() ;
+    EXPECT_TRUE( entry->resolved ) ;
+    EXPECT_EQ( copied(entry) , 2.0 ) ;
+
+    /* Nothing is copied again until the snapshot expires */
+    values[1] = 20.0 ;
+    snapshot.copy() ;
+    EXPECT_EQ( copied(entry) , 2.0 ) ;
+    snapshot.expire() ;
+    snapshot.copy() ;
+    EXPECT_EQ( copied(entry) , 20.0 ) ;
+    EXPECT_EQ( snapshot.get_num_copies() , 2u ) ;
+
+    /* A NULL pointer on the path leaves the entry unresolved with its last value */
+    values_ptr = NULL ;
+    snapshot.expire() ;
+    snapshot.copy() ;
+    EXPECT_FALSE( entry->resolved ) ;
+    EXPECT_EQ( copied(entry) , 20.0 ) ;
+
+    snapshot.unsubscribe(entry) ;
+    EXPECT_EQ( snapshot.size() , 0u ) ;
+}
+
+TEST_F(VariableServerSnapshotTest , CountsValidatingClients) {
+    VariableServerSnapshot snapshot ;
+    VariableReference client1(ref_attributes("values_ptr[1]")) ;
+    VariableReference client2(ref_attributes("values_ptr[1]")) ;
+    SharedVariable * entry ;
+
+    entry = snapshot.subscribe(&client1, true) ;
+    ASSERT_TRUE( entry != NULL ) ;
+    EXPECT_EQ( snapshot.subscribe(&client2, false) , entry ) ;
+    EXPECT_EQ( entry->ref_count , 2 ) ;
+    EXPECT_EQ( entry->num_validating , 1 ) ;
+    snapshot.unsubscribe(entry, true) ;
+    EXPECT_EQ( entry->ref_count , 1 ) ;
+    EXPECT_EQ( entry->num_validating , 0 ) ;
+    snapshot.unsubscribe(entry, false) ;
+    EXPECT_EQ( snapshot.size() , 0u ) ;
+}
+
+TEST_F(VariableServerSnapshotTest , FreedAllocationIsNotCopied) {
+    VariableServerSnapshot snapshot ;
+    VariableReference client(ref_attributes("values_ptr[1]")) ;
+    SharedVariable * entry ;
+
+    entry = snapshot.subscribe(&client, true) ;
+    ASSERT_TRUE( entry != NULL ) ;
+    snapshot.copy() ;
+    EXPECT_TRUE( entry->resolved ) ;
+    EXPECT_EQ( copied(entry) , 2.0 ) ;
+
+    /* values_ptr still points at the values after they are freed.  The address is checked before it is read,
+       the entry keeps its last value and is unresolved so the client turns it into a bad reference. */
+    memmgr->delete_var(values) ;
+    ASSERT_TRUE( get_alloc_info_of(values_ptr + 1) == NULL ) ;
+    snapshot.expire() ;
+    snapshot.copy() ;
+    EXPECT_FALSE( entry->resolved ) ;
+    EXPECT_FALSE( entry->valid ) ;
+    EXPECT_EQ( copied(entry) , 2.0 ) ;
+
+    /* Pointed at a new allocation the entry is copied again */
+    values = new_values(4.0) ;
+    snapshot.expire() ;
+    snapshot.copy() ;
+    EXPECT_TRUE( entry->resolved ) ;
+    EXPECT_TRUE( entry->valid ) ;
+    EXPECT_EQ( copied(entry) , 5.0 ) ;
+
+    snapshot.unsubscribe(entry, true) ;
+}
+
+}
@@ -184,6 +184,15 @@ int var_binary_nonames() {
     return(0) ;
 }
 
+int var_send_on_change(unsigned int keyframe_interval) {
+    Trick::VariableServerThread * vst ;
+    vst = get_vst() ;
+    if (vst != NULL ) {
+        vst->var_send_on_change(keyframe_interval) ;
+    }
+    return(0) ;
+}
+
 int var_set_copy_mode(int mode) {
     Trick::VariableServerThread * vst ;
     vst = get_vst() ;
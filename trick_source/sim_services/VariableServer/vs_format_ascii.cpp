@@ -9,7 +9,6 @@ PROGRAMMERS: (((Keith Vetter) (LinCom) (September 2001) (--)))
 #include <ctype.h>
 #include <limits>
 #include <udunits2.h>
-#include <sstream>
 
 #include "trick/parameter_types.h"
 #include "trick/attributes.h"
@@ -17,6 +16,7 @@ PROGRAMMERS: (((Keith Vetter) (LinCom) (September 2001) (--)))
 #include "trick/wcs_ext.h"
 #include "trick/VariableServer.hh"
 #include "trick/TrickConstant.hh"
+#include "trick/formatNumber.hh"
 
 /* PROTO */
 size_t escape_str(const char *in_s, char *out_s);
@@ -32,6 +32,7 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
 
     // handle returning an array
     int size = 0 ;
+    size_t value_len = 0 ;
     value[0] = '\0' ;
 
     // data to send was copied to buffer in copy_sim_data
@@ -44,7 +45,7 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
 
         case TRICK_CHARACTER:
             if (ref->attr->num_index == ref->num_index) {
-                snprintf(temp_buf, value_size, "%d",(char)cv_convert_double(var->conversion_factor, *(char *)buf_ptr));
+                Trick::format_long_long((char)cv_convert_double(var->conversion_factor, *(char *)buf_ptr), temp_buf);
             } else {
                 /* All but last dim specified, leaves a char array */
                 escape_str((char *) buf_ptr, temp_buf);
@@ -53,7 +54,7 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
             break;
         case TRICK_UNSIGNED_CHARACTER:
             if (ref->attr->num_index == ref->num_index) {
-                snprintf(temp_buf, value_size, "%u",(unsigned char)cv_convert_double(var->conversion_factor,*(unsigned char *)buf_ptr));
+                Trick::format_unsigned_long_long((unsigned char)cv_convert_double(var->conversion_factor,*(unsigned char *)buf_ptr), temp_buf);
             } else {
                 /* All but last dim specified, leaves a char array */
                 escape_str((char *) buf_ptr, temp_buf);
@@ -63,7 +64,7 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
 
         case TRICK_WCHAR:{
                 if (ref->attr->num_index == ref->num_index) {
-                    snprintf(temp_buf, value_size, "%d",*(wchar_t *) buf_ptr);
+                    Trick::format_long_long(*(wchar_t *) buf_ptr, temp_buf);
                 } else {
                     // convert wide char string char string
                     size_t len = wcs_to_ncs_len((wchar_t *)buf_ptr) + 1 ;
@@ -101,16 +102,16 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
 
 #if ( __linux | __sgi )
         case TRICK_BOOLEAN:
-            snprintf(temp_buf, value_size, "%d",(unsigned char)cv_convert_double(var->conversion_factor,*(unsigned char *)buf_ptr));
+            Trick::format_long_long((unsigned char)cv_convert_double(var->conversion_factor,*(unsigned char *)buf_ptr), temp_buf);
             break;
 #endif
 
         case TRICK_SHORT:
-            snprintf(temp_buf, value_size, "%d", (short)cv_convert_double(var->conversion_factor,*(short *)buf_ptr));
+            Trick::format_long_long((short)cv_convert_double(var->conversion_factor,*(short *)buf_ptr), temp_buf);
             break;
 
         case TRICK_UNSIGNED_SHORT:
-            snprintf(temp_buf, value_size, "%u",(unsigned short)cv_convert_double(var->conversion_factor,*(unsigned short *)buf_ptr));
+            Trick::format_unsigned_long_long((unsigned short)cv_convert_double(var->conversion_factor,*(unsigned short *)buf_ptr), temp_buf);
             break;
 
         case TRICK_INTEGER:
@@ -118,18 +119,18 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
 #if ( __sun | __APPLE__ )
         case TRICK_BOOLEAN:
 #endif
-            snprintf(temp_buf, value_size, "%d", (int)cv_convert_double(var->conversion_factor,*(int *)buf_ptr));
+            Trick::format_long_long((int)cv_convert_double(var->conversion_factor,*(int *)buf_ptr), temp_buf);
             break;
 
         case TRICK_BITFIELD:
-            snprintf(temp_buf, value_size, "%d", GET_BITFIELD(buf_ptr, ref->attr->size, ref->attr->index[0].start, ref->attr->index[0].size));
+            Trick::format_long_long(GET_BITFIELD(buf_ptr, ref->attr->size, ref->attr->index[0].start, ref->attr->index[0].size), temp_buf);
             break;
 
         case TRICK_UNSIGNED_BITFIELD:
-            snprintf(temp_buf, value_size, "%u", GET_UNSIGNED_BITFIELD(buf_ptr, ref->attr->size, ref->attr->index[0].start, ref->attr->index[0].size));
+            Trick::format_unsigned_long_long(GET_UNSIGNED_BITFIELD(buf_ptr, ref->attr->size, ref->attr->index[0].start, ref->attr->index[0].size), temp_buf);
             break;
         case TRICK_UNSIGNED_INTEGER:
-            snprintf(temp_buf, value_size, "%u", (unsigned int)cv_convert_double(var->conversion_factor,*(unsigned int *)buf_ptr));
+            Trick::format_unsigned_long_long((unsigned int)cv_convert_double(var->conversion_factor,*(unsigned int *)buf_ptr), temp_buf);
             break;
 
         case TRICK_LONG: {
@@ -137,7 +138,7 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
             if (var->conversion_factor != cv_get_trivial()) {
                 l = (long)cv_convert_double(var->conversion_factor, l);
             }
-            snprintf(temp_buf, value_size, "%ld", l);
+            Trick::format_long_long(l, temp_buf);
             break;
         }
 
@@ -146,16 +147,16 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
             if (var->conversion_factor != cv_get_trivial()) {
                 ul = (unsigned long)cv_convert_double(var->conversion_factor, ul);
             }
-            snprintf(temp_buf, value_size, "%lu", ul);
+            Trick::format_unsigned_long_long(ul, temp_buf);
             break;
         }
 
         case TRICK_FLOAT:
-            snprintf(temp_buf, value_size, "%.8g", cv_convert_float(var->conversion_factor,*(float *)buf_ptr));
+            Trick::format_float(cv_convert_float(var->conversion_factor,*(float *)buf_ptr), temp_buf);
             break;
 
         case TRICK_DOUBLE:
-            snprintf(temp_buf, value_size, "%.16g", cv_convert_double(var->conversion_factor,*(double *)buf_ptr));
+            Trick::format_double(cv_convert_double(var->conversion_factor,*(double *)buf_ptr), temp_buf);
             break;
 
         case TRICK_LONG_LONG: {
@@ -163,7 +164,7 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
             if (var->conversion_factor != cv_get_trivial()) {
                 ll = (long long)cv_convert_double(var->conversion_factor, ll);
             }
-            snprintf(temp_buf, value_size, "%lld", ll);
+            Trick::format_long_long(ll, temp_buf);
             break;
         }
 
@@ -172,12 +173,12 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
             if (var->conversion_factor != cv_get_trivial()) {
                 ull = (unsigned long long)cv_convert_double(var->conversion_factor, ull);
             }
-            snprintf(temp_buf, value_size, "%llu", ull);
+            Trick::format_unsigned_long_long(ull, temp_buf);
             break;
         }
 
         case TRICK_NUMBER_OF_TYPES:
-            snprintf(temp_buf, value_size, "BAD_REF" );
+            strcpy(temp_buf, "BAD_REF");
             break;
 
         default:{
@@ -185,24 +186,23 @@ int vs_format_ascii(Trick::VariableReference * var, char *value, size_t value_si
             }
         } // end switch
 
+        // append the value, and a comma if returning an array, within value_size
+        size_t temp_len = strlen(temp_buf) ;
         if (size < var->size) {
-        // if returning an array, continue array as comma separated values
-            strcat(temp_buf, ",") ;
+            temp_buf[temp_len++] = ',' ;
             buf_ptr = (void*) ((long)buf_ptr + var->ref->attr->size) ;
         }
-        strncat(value, temp_buf, value_size - strlen(value) - 1);
+        if (temp_len > value_size - value_len - 1) {
+            temp_len = value_size - value_len - 1 ;
+        }
+        memcpy(value + value_len, temp_buf, temp_len) ;
+        value_len += temp_len ;
+        value[value_len] = '\0' ;
     } //end while
 
     if (ref->units) {
-        std::stringstream unit_str;
-        if ( ref->attr->mods & TRICK_MODS_UNITSDASHDASH ) {
-            unit_str << " {--}";
-        } else {
-            unit_str << " {" << ref->units << "}";
-
-        }
-        size_t max_copy_size = value_size - strlen(value) - 1;
-        strncat(value, unit_str.str().c_str(), max_copy_size);
+        const char * units = ( ref->attr->mods & TRICK_MODS_UNITSDASHDASH ) ? "--" : ref->units ;
+        snprintf(value + value_len, value_size - value_len, " {%s}", units) ;
     }
 
     return (0);
@@ -40,11 +40,14 @@
 #include "trick/units_conv.h"
 
 #include "trick/GetTimeOfDayClock.hh"
+#include "trick/NanosecondClock.hh"
+#include "trick/TSCClock.hh"
 #include "trick/clock_proto.h"
 #include "trick/CommandLineArguments.hh"
 #include "trick/command_line_protos.h"
 #include "trick/DRAscii.hh"
 #include "trick/DRBinary.hh"
+#include "trick/DRCompressed.hh"
 #ifdef HDF5
 #include "trick/DRHDF5.hh"
 #endif
@@ -0,0 +1,316 @@
+#include <stdint.h>
+#include <string.h>
+#include "trick/formatNumber.hh"
+#include "formatNumber_tables.hh"
+
+/*
+   format_double and format_float find the shortest decimal that converts back to the same binary value with
+   the Ryu algorithm (Ulf Adams, "Ryu: fast float-to-string conversion", PLDI 2018).  The float is decoded
+   into its binary mantissa and exponent, scaled to a decimal exponent with one 64 x 128 bit multiply per
+   bound, and digits are removed while the number stays between the halfway points to its neighbors.  A
+   float goes through the same code with its own mantissa and exponent sizes, the double tables are precise
+   enough for it.
+*/
+
+namespace {
+
+/* ceil(log2(5^e)) for e > 0, 1 for e == 0 */
+inline int32_t pow5bits( int32_t e ) {
+    return (int32_t)((((uint32_t)e) * 1217359) >> 19) + 1 ;
+}
+
+/* floor(log10(2^e)) */
+inline int32_t log10_pow2( int32_t e ) {
+    return (int32_t)((((uint32_t)e) * 78913) >> 18) ;
+}
+
+/* floor(log10(5^e)) */
+inline int32_t log10_pow5( int32_t e ) {
+    return (int32_t)((((uint32_t)e) * 732923) >> 20) ;
+}
+
+inline bool multiple_of_pow5( uint64_t value , int32_t p ) {
+    int32_t count = 0 ;
+    while ( value != 0 && value % 5 == 0 ) {
+        value /= 5 ;
+        count++ ;
+    }
+    return count >= p ;
+}
+
+inline bool multiple_of_pow2( uint64_t value , int32_t p ) {
+    return (value & ((1ull << p) - 1)) == 0 ;
+}
+
+/* (m * mul) >> j where mul is a 128 bit table entry, j >= 64 */
+inline uint64_t mul_shift( uint64_t m , const uint64_t * mul , int32_t j ) {
+    unsigned __int128 b0 = (unsigned __int128)m * mul[0] ;
+    unsigned __int128 b2 = (unsigned __int128)m * mul[1] ;
+    return (uint64_t)(((b0 >> 64) + b2) >> (j - 64)) ;
+}
+
+/*
+   Shortest decimal mantissa * 10^exponent of the positive float with the given IEEE fields.
+*/
+void shortest_decimal( uint64_t ieee_mantissa , uint32_t ieee_exponent , int mantissa_bits , int bias ,
+ uint64_t & output , int32_t & exponent ) {
+
+    int32_t e2 ;
+    uint64_t m2 ;
+    if ( ieee_exponent == 0 ) {
+        e2 = 1 - bias - mantissa_bits - 2 ;
+        m2 = ieee_mantissa ;
+    } else {
+        e2 = (int32_t)ieee_exponent - bias - mantissa_bits - 2 ;
+        m2 = (1ull << mantissa_bits) | ieee_mantissa ;
+    }
+    const bool accept_bounds = (m2 & 1) == 0 ;
+
+    // The value and the halfway points to its neighbors, times 4.  The lower neighbor is closer at a power of 2.
+    const uint64_t mv = 4 * m2 ;
+    const uint32_t mm_shift = ( ieee_mantissa != 0 || ieee_exponent <= 1 ) ? 1 : 0 ;
+
+    // Scale the three to decimal.  vr is the value, vp and vm the upper and lower bounds.
+    uint64_t vr , vp , vm ;
+    int32_t e10 ;
+    bool vm_trailing_zeros = false ;
+    bool vr_trailing_zeros = false ;
+    if ( e2 >= 0 ) {
+        const int32_t q = log10_pow2(e2) - (e2 > 3) ;
+        e10 = q ;
+        const int32_t k = 125 + pow5bits(q) - 1 ;
+        const int32_t i = -e2 + q + k ;
+        vr = mul_shift(4 * m2, DOUBLE_POW5_INV_SPLIT[q], i) ;
+        vp = mul_shift(4 * m2 + 2, DOUBLE_POW5_INV_SPLIT[q], i) ;
+        vm = mul_shift(4 * m2 - 1 - mm_shift, DOUBLE_POW5_INV_SPLIT[q], i) ;
+        if ( q <= 21 ) {
+            // Only mv below 2^55 can be a multiple of 5^q for q up to 21.
+            if ( mv % 5 == 0 ) {
+                vr_trailing_zeros = multiple_of_pow5(mv, q) ;
+            } else if ( accept_bounds ) {
+                vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q) ;
+            } else {
+                vp -= multiple_of_pow5(mv + 2, q) ;
+            }
+        }
+    } else {
+        const int32_t q = log10_pow5(-e2) - (-e2 > 1) ;
+        e10 = q + e2 ;
+        const int32_t i = -e2 - q ;
+        const int32_t k = pow5bits(i) - 125 ;
+        const int32_t j = q - k ;
+        vr = mul_shift(4 * m2, DOUBLE_POW5_SPLIT[i], j) ;
+        vp = mul_shift(4 * m2 + 2, DOUBLE_POW5_SPLIT[i], j) ;
+        vm = mul_shift(4 * m2 - 1 - mm_shift, DOUBLE_POW5_SPLIT[i], j) ;
+        if ( q <= 1 ) {
+            vr_trailing_zeros = true ;
+            if ( accept_bounds ) {
+                vm_trailing_zeros = mm_shift == 1 ;
+            } else {
+                --vp ;
+            }
+        } else if ( q < 63 ) {
+            vr_trailing_zeros = multiple_of_pow2(mv, q) ;
+        }
+    }
+
+    // Remove digits while the bounds still differ, rounding vr with the last digit removed.
+    int32_t removed = 0 ;
+    uint8_t last_removed_digit = 0 ;
+    if ( vm_trailing_zeros || vr_trailing_zeros ) {
+        // Exact ties are possible, track whether all the removed digits were zeros.
+        while ( vp / 10 > vm / 10 ) {
+            vm_trailing_zeros &= vm % 10 == 0 ;
+            vr_trailing_zeros &= last_removed_digit == 0 ;
+            last_removed_digit = (uint8_t)(vr % 10) ;
+            vr /= 10 ;
+            vp /= 10 ;
+            vm /= 10 ;
+            ++removed ;
+        }
+        if ( vm_trailing_zeros ) {
+            while ( vm % 10 == 0 ) {
+                vr_trailing_zeros &= last_removed_digit == 0 ;
+                last_removed_digit = (uint8_t)(vr % 10) ;
+                vr /= 10 ;
+                vp /= 10 ;
+                vm /= 10 ;
+                ++removed ;
+            }
+        }
+        if ( vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0 ) {
+            // Round an exact half to even.
+            last_removed_digit = 4 ;
+        }
+        output = vr + (( vr == vm && ( ! accept_bounds || ! vm_trailing_zeros )) || last_removed_digit >= 5 ) ;
+    } else {
+        bool round_up = false ;
+        while ( vp / 10 > vm / 10 ) {
+            round_up = vr % 10 >= 5 ;
+            vr /= 10 ;
+            vp /= 10 ;
+            vm /= 10 ;
+            ++removed ;
+        }
+        output = vr + ( vr == vm || round_up ) ;
+    }
+    exponent = e10 + removed ;
+}
+
+const char digit_pairs[201] =
+ "00010203040506070809"
+ "10111213141516171819"
+ "20212223242526272829"
+ "30313233343536373839"
+ "40414243444546474849"
+ "50515253545556575859"
+ "60616263646566676869"
+ "70717273747576777879"
+ "80818283848586878889"
+ "90919293949596979899" ;
+
+/* Writes the digits of value ending just before end, returns a pointer to the first digit. */
+inline char * write_digits_backward( uint64_t value , char * end ) {
+    while ( value >= 100 ) {
+        const uint64_t pair = (value % 100) * 2 ;
+        value /= 100 ;
+        *--end = digit_pairs[pair + 1] ;
+        *--end = digit_pairs[pair] ;
+    }
+    if ( value >= 10 ) {
+        *--end = digit_pairs[value * 2 + 1] ;
+        *--end = digit_pairs[value * 2] ;
+    } else {
+        *--end = (char)('0' + value) ;
+    }
+    return end ;
+}
+
+/*
+   Writes digits * 10^exponent the way printf "%.<precision>g" writes it: scientific notation when the decimal
+   exponent is below -4 or at least precision, trailing zeros after the decimal point removed.
+*/
+size_t write_decimal( bool sign , uint64_t digits , int32_t exponent , int32_t precision , char * buf ) {
+
+    char digit_buf[24] ;
+    char * first = write_digits_backward(digits, digit_buf + sizeof(digit_buf)) ;
+    const int32_t length = (int32_t)(digit_buf + sizeof(digit_buf) - first) ;
+    const int32_t decimal_exponent = exponent + length - 1 ;
+    char * out = buf ;
+
+    if ( sign ) {
+        *out++ = '-' ;
+    }
+    if ( decimal_exponent < -4 || decimal_exponent >= precision ) {
+        *out++ = first[0] ;
+        if ( length > 1 ) {
+            *out++ = '.' ;
+            memcpy(out, first + 1, length - 1) ;
+            out += length - 1 ;
+        }
+        *out++ = 'e' ;
+        int32_t abs_exponent = decimal_exponent ;
+        if ( decimal_exponent < 0 ) {
+            *out++ = '-' ;
+            abs_exponent = -decimal_exponent ;
+        } else {
+            *out++ = '+' ;
+        }
+        if ( abs_exponent >= 100 ) {
+            *out++ = (char)('0' + abs_exponent / 100) ;
+            abs_exponent %= 100 ;
+        }
+        *out++ = digit_pairs[abs_exponent * 2] ;
+        *out++ = digit_pairs[abs_exponent * 2 + 1] ;
+    } else if ( exponent >= 0 ) {
+        memcpy(out, first, length) ;
+        out += length ;
+        memset(out, '0', exponent) ;
+        out += exponent ;
+    } else if ( decimal_exponent >= 0 ) {
+        memcpy(out, first, decimal_exponent + 1) ;
+        out += decimal_exponent + 1 ;
+        *out++ = '.' ;
+        memcpy(out, first + decimal_exponent + 1, length - decimal_exponent - 1) ;
+        out += length - decimal_exponent - 1 ;
+    } else {
+        *out++ = '0' ;
+        *out++ = '.' ;
+        memset(out, '0', -decimal_exponent - 1) ;
+        out += -decimal_exponent - 1 ;
+        memcpy(out, first, length) ;
+        out += length ;
+    }
+    *out = '\0' ;
+    return out - buf ;
+}
+
+/* NaN, infinity, and zero, which printf writes as "nan", "inf", "-inf", "0", "-0". */
+size_t write_special( bool sign , bool is_nan_or_inf , bool is_nan , char * buf ) {
+    char * out = buf ;
+    if ( sign && ! is_nan ) {
+        *out++ = '-' ;
+    }
+    const char * text = is_nan ? "nan" : ( is_nan_or_inf ? "inf" : "0" ) ;
+    size_t len = strlen(text) ;
+    memcpy(out, text, len + 1) ;
+    return out + len - buf ;
+}
+
+}
+
+size_t Trick::format_double( double value , char * buf ) {
+
+    uint64_t bits ;
+    memcpy(&bits, &value, sizeof(bits)) ;
+
+    const bool sign = (bits >> 63) != 0 ;
+    const uint64_t ieee_mantissa = bits & ((1ull << 52) - 1) ;
+    const uint32_t ieee_exponent = (uint32_t)((bits >> 52) & 0x7ff) ;
+
+    if ( ieee_exponent == 0x7ff || ( ieee_exponent == 0 && ieee_mantissa == 0 )) {
+        return write_special(sign, ieee_exponent == 0x7ff, ieee_exponent == 0x7ff && ieee_mantissa != 0, buf) ;
+    }
+
+    uint64_t output ;
+    int32_t exponent ;
+    shortest_decimal(ieee_mantissa, ieee_exponent, 52, 1023, output, exponent) ;
+    return write_decimal(sign, output, exponent, 16, buf) ;
+}
+
+size_t Trick::format_float( float value , char * buf ) {
+
+    uint32_t bits ;
+    memcpy(&bits, &value, sizeof(bits)) ;
+
+    const bool sign = (bits >> 31) != 0 ;
+    const uint32_t ieee_mantissa = bits & ((1u << 23) - 1) ;
+    const uint32_t ieee_exponent = (bits >> 23) & 0xff ;
+
+    if ( ieee_exponent == 0xff || ( ieee_exponent == 0 && ieee_mantissa == 0 )) {
+        return write_special(sign, ieee_exponent == 0xff, ieee_exponent == 0xff && ieee_mantissa != 0, buf) ;
+    }
+
+    uint64_t output ;
+    int32_t exponent ;
+    shortest_decimal(ieee_mantissa, ieee_exponent, 23, 127, output, exponent) ;
+    return write_decimal(sign, output, exponent, 8, buf) ;
+}
+
+size_t Trick::format_unsigned_long_long( unsigned long long value , char * buf ) {
+    char digit_buf[24] ;
+    char * first = write_digits_backward(value, digit_buf + sizeof(digit_buf)) ;
+    size_t length = digit_buf + sizeof(digit_buf) - first ;
+    memcpy(buf, first, length) ;
+    buf[length] = '\0' ;
+    return length ;
+}
+
+size_t Trick::format_long_long( long long value , char * buf ) {
+    if ( value < 0 ) {
+        buf[0] = '-' ;
+        // Negate as unsigned so the most negative value does not overflow.
+        return 1 + format_unsigned_long_long(0ull - (unsigned long long)value, buf + 1) ;
+    }
+    return format_unsigned_long_long((unsigned long long)value, buf) ;
+}
@@ -0,0 +1,172 @@
+/*
+   Benchmark of the variable server value formatting, in messages per second for one client.
+
+   Usage: formatNumber_bench [num_values] [seconds]
+
+   A message of num_values doubles (default 2000, a mix of state-like values) is formatted repeatedly
+   the way the variable servers write their messages:
+
+   ascii: tab separated values in a fixed message buffer, as VariableServerThread::write_ascii_data writes.
+          Before: snprintf("%.16g") and strcat.  After: Trick::format_double appended at a tracked length.
+   json:  a websocket "values" message, as VariableServerSession::sendMessage writes.
+          Before: a new std::stringstream with std::setprecision(16).  After: Trick::format_double appended
+          to a reused std::string.
+
+   The "after" values are shortest round trip, so they can differ in the last digit from "%.16g".
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "trick/formatNumber.hh"
+
+#define MAX_MSG_LEN 8192
+
+static double wall_time() {
+    struct timespec tp ;
+    clock_gettime(CLOCK_MONOTONIC, &tp) ;
+    return tp.tv_sec + tp.tv_nsec / 1.0e9 ;
+}
+
+/* Keeps the compiler from removing the formatting. */
+static volatile size_t sink ;
+
+static size_t ascii_snprintf( const std::vector< double > & values , char * msg ) {
+    size_t sent = 0 ;
+    snprintf(msg, MAX_MSG_LEN, "%d\t", 0) ;
+    for ( size_t ii = 0 ; ii < values.size() ; ii++ ) {
+        char curr_buf[MAX_MSG_LEN] ;
+        snprintf(curr_buf, sizeof(curr_buf), "%.16g", values[ii]) ;
+        if ( strlen(msg) + strlen(curr_buf) + 2 > MAX_MSG_LEN ) {
+            sent += strlen(msg) ;
+            msg[0] = '\0' ;
+        }
+        strcat(msg, curr_buf) ;
+        strcat(msg, "\t") ;
+    }
+    return sent + strlen(msg) ;
+}
+
+static size_t ascii_format( const std::vector< double > & values , char * msg ) {
+    size_t sent = 0 ;
+    size_t len = Trick::format_long_long(0, msg) ;
+    msg[len++] = '\t' ;
+    for ( size_t ii = 0 ; ii < values.size() ; ii++ ) {
+        char curr_buf[FORMAT_NUMBER_BUF_SIZE] ;
+        size_t curr_len = Trick::format_double(values[ii], curr_buf) ;
+        if ( len + curr_len + 2 > MAX_MSG_LEN ) {
+            sent += len ;
+            len = 0 ;
+        }
+        memcpy(msg + len, curr_buf, curr_len) ;
+        len += curr_len ;
+        msg[len++] = '\t' ;
+    }
+    msg[len] = '\0' ;
+    return sent + len ;
+}
+
+static size_t json_stringstream( const std::vector< double > & values ) {
+    std::stringstream ss ;
+    ss << "{ \"msg_type\" : \"values\",\n" ;
+    ss << "  \"time\" : " << std::setprecision(16) << 1.25 << ",\n" ;
+    ss << "  \"values\" : [\n" ;
+    for ( size_t ii = 0 ; ii < values.size() ; ii++ ) {
+        if ( ii != 0 ) ss << ",\n" ;
+        ss << std::setprecision(16) << values[ii] ;
+    }
+    ss << "]}" << std::endl ;
+    std::string tmp = ss.str() ;
+    return strlen(tmp.c_str()) ;
+}
+
+static size_t json_format( const std::vector< double > & values , std::string & msg ) {
+    char buf[FORMAT_NUMBER_BUF_SIZE] ;
+    msg.clear() ;
+    msg.append("{ \"msg_type\" : \"values\",\n  \"time\" : ") ;
+    msg.append(buf, Trick::format_double(1.25, buf)) ;
+    msg.append(",\n  \"values\" : [\n") ;
+    for ( size_t ii = 0 ; ii < values.size() ; ii++ ) {
+        if ( ii != 0 ) msg.append(",\n") ;
+        msg.append(buf, Trick::format_double(values[ii], buf)) ;
+    }
+    msg.append("]}\n") ;
+    return msg.size() ;
+}
+
+/* Runs one formatter for about seconds, returns messages per second. */
+template < class F >
+static double messages_per_second( F format , double seconds ) {
+    unsigned long long count = 0 ;
+    double start = wall_time() ;
+    double elapsed ;
+    do {
+        for ( int ii = 0 ; ii < 16 ; ii++ ) {
+            sink = format() ;
+        }
+        count += 16 ;
+        elapsed = wall_time() - start ;
+    } while ( elapsed < seconds ) ;
+    return count / elapsed ;
+}
+
+struct AsciiSnprintf {
+    const std::vector< double > & values ; char * msg ;
+    size_t operator()() { return ascii_snprintf(values, msg) ; }
+} ;
+struct AsciiFormat {
+    const std::vector< double > & values ; char * msg ;
+    size_t operator()() { return ascii_format(values, msg) ; }
+} ;
+struct JsonStringstream {
+    const std::vector< double > & values ;
+    size_t operator()() { return json_stringstream(values) ; }
+} ;
+struct JsonFormat {
+    const std::vector< double > & values ; std::string & msg ;
+    size_t operator()() { return json_format(values, msg) ; }
+} ;
+
+static void compare( const char * path , double before , double after , unsigned int num_values ) {
+    std::cout << std::setw(6) << path << std::fixed << std::setprecision(0)
+              << "  before " << std::setw(9) << before << " msg/s"
+              << "  after " << std::setw(9) << after << " msg/s"
+              << std::setprecision(2) << "  speedup " << after / before
+              << std::setprecision(1) << "  (" << after * num_values / 1.0e6 << " M values/s)" << std::endl ;
+}
+
+int main( int argc , char * argv[] ) {
+
+    unsigned int num_values = ( argc > 1 ) ? atoi(argv[1]) : 2000 ;
+    double seconds = ( argc > 2 ) ? atof(argv[2]) : 1.0 ;
+    std::vector< double > values ;
+    char msg[MAX_MSG_LEN] ;
+    std::string json_msg ;
+
+    srand48(1) ;
+    for ( unsigned int ii = 0 ; ii < num_values ; ii++ ) {
+        switch ( ii % 4 ) {
+            case 0: values.push_back(drand48() * 1.0e7 - 5.0e6) ; break ;        // positions
+            case 1: values.push_back(drand48() * 2.0 - 1.0) ; break ;            // unit vectors
+            case 2: values.push_back((double)(lrand48() % 1000) * 0.01) ; break ; // short decimals
+            default: values.push_back(drand48() * 1.0e-6) ; break ;              // small rates
+        }
+    }
+
+    std::cout << num_values << " doubles per message" << std::endl ;
+    AsciiSnprintf as = { values , msg } ;
+    AsciiFormat af = { values , msg } ;
+    compare("ascii", messages_per_second(as, seconds), messages_per_second(af, seconds), num_values) ;
+    JsonStringstream js = { values } ;
+    JsonFormat jf = { values , json_msg } ;
+    compare("json", messages_per_second(js, seconds), messages_per_second(jf, seconds), num_values) ;
+
+    return 0 ;
+}
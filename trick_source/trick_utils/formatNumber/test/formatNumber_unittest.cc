@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+#include "trick/formatNumber.hh"
+
+static std::string fmt_double( double value ) {
+    char buf[FORMAT_NUMBER_BUF_SIZE] ;
+    size_t len = Trick::format_double(value, buf) ;
+    EXPECT_EQ(strlen(buf), len) ;
+    return std::string(buf) ;
+}
+
+static std::string fmt_float( float value ) {
+    char buf[FORMAT_NUMBER_BUF_SIZE] ;
+    size_t len = Trick::format_float(value, buf) ;
+    EXPECT_EQ(strlen(buf), len) ;
+    return std::string(buf) ;
+}
+
+/* The shortest "%.*e" that converts back to value. */
+static void shortest_printf( double value , char * out ) {
+    int digits ;
+    for ( digits = 1 ; digits < 17 ; digits++ ) {
+        snprintf(out, 64, "%.*e", digits - 1, value) ;
+        if ( strtod(out, NULL) == value ) {
+            break ;
+        }
+    }
+    snprintf(out, 64, "%.*e", digits - 1, value) ;
+}
+
+TEST(formatNumber_unittest, double_matches_printf) {
+    EXPECT_EQ(fmt_double(0.1), "0.1") ;
+    EXPECT_EQ(fmt_double(-2.5), "-2.5") ;
+    EXPECT_EQ(fmt_double(100.0), "100") ;
+    EXPECT_EQ(fmt_double(123456.0), "123456") ;
+    EXPECT_EQ(fmt_double(0.0001), "0.0001") ;
+    EXPECT_EQ(fmt_double(0.000123), "0.000123") ;
+    EXPECT_EQ(fmt_double(1.0e-5), "1e-05") ;
+    EXPECT_EQ(fmt_double(1.0e15), "1000000000000000") ;
+    EXPECT_EQ(fmt_double(1.0e16), "1e+16") ;
+    EXPECT_EQ(fmt_double(1.0 / 3.0), "0.3333333333333333") ;
+}
+
+TEST(formatNumber_unittest, double_shortest_round_trip) {
+    // %.16g is not enough digits for these, and too many for 1e23.
+    EXPECT_EQ(fmt_double(DBL_MAX), "1.7976931348623157e+308") ;
+    EXPECT_EQ(fmt_double(DBL_MIN), "2.2250738585072014e-308") ;
+    EXPECT_EQ(fmt_double(5e-324), "5e-324") ;
+    EXPECT_EQ(fmt_double(1.0e23), "1e+23") ;
+    EXPECT_EQ(fmt_double(0.1 + 0.2), "0.30000000000000004") ;
+}
+
+TEST(formatNumber_unittest, double_special) {
+    EXPECT_EQ(fmt_double(0.0), "0") ;
+    EXPECT_EQ(fmt_double(-0.0), "-0") ;
+    EXPECT_EQ(fmt_double(NAN), "nan") ;
+    EXPECT_EQ(fmt_double(INFINITY), "inf") ;
+    EXPECT_EQ(fmt_double(-INFINITY), "-inf") ;
+}
+
+TEST(formatNumber_unittest, double_random) {
+    char expected[64] ;
+    srand48(1) ;
+    for ( int ii = 0 ; ii < 100000 ; ii++ ) {
+        unsigned long long bits = ((unsigned long long)lrand48() << 33) ^ ((unsigned long long)lrand48() << 2) ^ lrand48() ;
+        double value ;
+        memcpy(&value, &bits, sizeof(value)) ;
+        if ( ! isfinite(value) ) {
+            continue ;
+        }
+        std::string str = fmt_double(value) ;
+        ASSERT_EQ(strtod(str.c_str(), NULL), value) << str ;
+        // Same digits as the correctly rounded printf with the fewest digits that round trips.
+        shortest_printf(value, expected) ;
+        ASSERT_EQ(strtod(expected, NULL), strtod(str.c_str(), NULL)) << str << " " << expected ;
+    }
+}
+
+TEST(formatNumber_unittest, float_shortest_round_trip) {
+    EXPECT_EQ(fmt_float(0.1f), "0.1") ;
+    EXPECT_EQ(fmt_float(1.0f / 3.0f), "0.33333334") ;
+    EXPECT_EQ(fmt_float(1.0e7f), "10000000") ;
+    EXPECT_EQ(fmt_float(1.0e8f), "1e+08") ;
+    EXPECT_EQ(fmt_float(FLT_MAX), "3.4028235e+38") ;
+    EXPECT_EQ(fmt_float(1.0e-45f), "1e-45") ;
+    EXPECT_EQ(fmt_float(-0.0f), "-0") ;
+
+    srand48(2) ;
+    for ( int ii = 0 ; ii < 100000 ; ii++ ) {
+        unsigned int bits = (unsigned int)(lrand48() << 1) ^ (unsigned int)lrand48() ;
+        float value ;
+        memcpy(&value, &bits, sizeof(value)) ;
+        if ( ! isfinite(value) ) {
+            continue ;
+        }
+        std::string str = fmt_float(value) ;
+        ASSERT_EQ(strtof(str.c_str(), NULL), value) << str ;
+    }
+}
+
+TEST(formatNumber_unittest, integers) {
+    char buf[FORMAT_NUMBER_BUF_SIZE] ;
+    EXPECT_EQ(Trick::format_long_long(0, buf), 1u) ;
+    EXPECT_STREQ(buf, "0") ;
+    Trick::format_long_long(-1234, buf) ;
+    EXPECT_STREQ(buf, "-1234") ;
+    Trick::format_long_long(LLONG_MIN, buf) ;
+    EXPECT_STREQ(buf, "-9223372036854775808") ;
+    Trick::format_unsigned_long_long(ULLONG_MAX, buf) ;
+    EXPECT_STREQ(buf, "18446744073709551615") ;
+    Trick::format_unsigned_long_long(10, buf) ;
+    EXPECT_STREQ(buf, "10") ;
+}
@@ -23,6 +23,10 @@ void Var::setName(size_t name_size, const std::vector<unsigned char>& name_data)
 }
 
 
+void Var::setIndex(int index) {
+    _index = index;
+}
+
 void Var::setValue(const std::vector<unsigned char>& bytes, size_t size, TRICK_TYPE type, bool byteswap) {
     _trick_type = type;
     _var_size = size;
@@ -59,6 +63,10 @@ TRICK_TYPE Var::getType() const {
     return _trick_type;
 }
 
+int Var::getIndex() const {
+    return _index;
+}
+
 std::vector<unsigned char> Var::getRawBytes() const {
     return value_bytes;
 }
@@ -267,6 +275,7 @@ class MessageIterator {
 const size_t ParsedBinaryMessage::header_size = 12;
 const size_t ParsedBinaryMessage::message_indicator_size = 4;
 const size_t ParsedBinaryMessage::variable_num_size = 4;
+const size_t ParsedBinaryMessage::variable_index_size = 4;
 const size_t ParsedBinaryMessage::message_size_size = 4;
 const size_t ParsedBinaryMessage::variable_name_length_size = 4;
 const size_t ParsedBinaryMessage::variable_type_size = 4;
@@ -322,6 +331,12 @@ int ParsedBinaryMessage::parse (const std::vector<unsigned char>& bytes) {
     for (unsigned int i = 0; i < _num_vars; i++) {
         Var variable;
 
+        // Messages of changes put the index of each variable first
+        if (_message_type == VS_VAR_CHANGES) {
+            variable.setIndex(bytesToInt(messageIterator.slice(variable_index_size), _byteswap));
+            messageIterator += variable_index_size;
+        }
+
         if (!_nonames) {
             // Get the name
             size_t name_length = bytesToInt(messageIterator.slice(variable_name_length_size), _byteswap);
@@ -363,6 +378,19 @@ void ParsedBinaryMessage::combine (const ParsedBinaryMessage& other) {
     // Other error checking - duplicate variables?
 }
 
+void ParsedBinaryMessage::applyChanges (const ParsedBinaryMessage& changes) {
+    if (changes._message_type != VS_VAR_CHANGES) {
+        throw IncorrectUsageException("Changes must come from a message of type " + std::to_string(VS_VAR_CHANGES) + ", not " + std::to_string(changes._message_type));
+    }
+
+    for (const Var& variable : changes.variables) {
+        if (variable.getIndex() < 0 || (size_t)variable.getIndex() >= variables.size()) {
+            throw MalformedMessageException("Changed variable index " + std::to_string(variable.getIndex()) + " does not exist in this message.");
+        }
+        variables[variable.getIndex()] = variable;
+    }
+}
+
 Var ParsedBinaryMessage::getVariable(const std::string& name) {
     if (_nonames) 
         throw IncorrectUsageException("Cannot fetch variables by name in noname message");
@@ -445,6 +445,161 @@ TEST (BinaryParserTest, CombineMessagesIncorrectType) {
     }
 }
 
+TEST (BinaryParserTest, ParseChanges) {
+    ParsedBinaryMessage message;
+    // VS_VAR_CHANGES, 1 variable, index 2 before the variable
+    std::vector<unsigned char> bytes = {0x06, 0x00, 0x00, 0x00};
+    bytes.push_back(12 + test_var_1.size());
+    bytes.insert(bytes.end(), {0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00});
+    bytes.insert(bytes.end(), test_var_1.begin(), test_var_1.end());
+
+    try {
+        message.parse(bytes);
+    } catch (const std::exception& ex) {
+        FAIL() << "Exception thrown: " << ex.what();
+    }
+
+    EXPECT_EQ(message.getMessageType(), 6);
+    ASSERT_EQ(message.variables.size(), 1);
+    EXPECT_EQ(message.variables[0].getIndex(), 2);
+    EXPECT_EQ(message.variables[0].getName(), "hi");
+    EXPECT_EQ(message.variables[0].getValue<int>(), 161);
+}
+
+TEST (BinaryParserTest, ParseChangesNonameByteswap) {
+    ParsedBinaryMessage message(true, true);
+    std::vector<unsigned char> bytes = {0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00};
+    bytes.push_back(12 + 12);
+    bytes.insert(bytes.end(), {0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00});
+    std::vector<unsigned char> var = {0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xa1};
+    bytes.insert(bytes.end(), var.begin(), var.end());
+
+    try {
+        message.parse(bytes);
+    } catch (const std::exception& ex) {
+        FAIL() << "Exception thrown: " << ex.what();
+    }
+
+    ASSERT_EQ(message.variables.size(), 1);
+    EXPECT_EQ(message.variables[0].getIndex(), 256);
+    EXPECT_EQ(message.variables[0].getValue<int>(), 161);
+}
+
+TEST (BinaryParserTest, ApplyChanges) {
+    ParsedBinaryMessage full;
+    ParsedBinaryMessage changes;
+
+    // Full message: hi = 161, my_string = "99 red balloons"
+    std::vector<unsigned char> full_bytes = {0x00, 0x00, 0x00, 0x00};
+    full_bytes.push_back(8 + test_var_1.size() + test_var_2.size());
+    full_bytes.insert(full_bytes.end(), {0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00});
+    full_bytes.insert(full_bytes.end(), test_var_1.begin(), test_var_1.end());
+    full_bytes.insert(full_bytes.end(), test_var_2.begin(), test_var_2.end());
+
+    // Changes: index 0, hi = 162
+    std::vector<unsigned char> change_bytes = {0x06, 0x00, 0x00, 0x00};
+    change_bytes.push_back(12 + test_var_1.size());
+    change_bytes.insert(change_bytes.end(), {0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+    change_bytes.insert(change_bytes.end(), test_var_1.begin(), test_var_1.end());
+    change_bytes.back() = 0x00;
+    change_bytes[change_bytes.size() - 4] = 0xa2;
+
+    try {
+        full.parse(full_bytes);
+        changes.parse(change_bytes);
+        full.applyChanges(changes);
+    } catch (const std::exception& ex) {
+        FAIL() << "Exception thrown: " << ex.what();
+    }
+
+    ASSERT_EQ(full.variables.size(), 2);
+    EXPECT_EQ(full.getVariable("hi").getValue<int>(), 162);
+    EXPECT_EQ(full.getVariable("my_string").getValue<std::string>(), "99 red balloons");
+}
+
+TEST (BinaryParserTest, ApplyChangesBadIndex) {
+    ParsedBinaryMessage full;
+    ParsedBinaryMessage changes;
+
+    std::vector<unsigned char> full_bytes = {0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    std::vector<unsigned char> change_bytes = {0x06, 0x00, 0x00, 0x00};
+    change_bytes.push_back(12 + test_var_1.size());
+    change_bytes.insert(change_bytes.end(), {0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00});
+    change_bytes.insert(change_bytes.end(), test_var_1.begin(), test_var_1.end());
+
+    full.parse(full_bytes);
+    changes.parse(change_bytes);
+    try {
+        full.applyChanges(changes);
+        FAIL() << "Expected exception thrown";
+    } catch (const MalformedMessageException& ex) {
+        EXPECT_STREQ(ex.what(), "Changed variable index 3 does not exist in this message.");
+    } catch (...) {
+        FAIL() << "Incorrect exception thrown";
+    }
+
+    try {
+        full.applyChanges(full);
+        FAIL() << "Expected exception thrown";
+    } catch (const IncorrectUsageException& ex) {
+        EXPECT_STREQ(ex.what(), "Changes must come from a message of type 6, not 0");
+    } catch (...) {
+        FAIL() << "Incorrect exception thrown";
+    }
+}
+
+TEST (BinaryParserTest, ApplyChangesAfterAdd) {
+    ParsedBinaryMessage state;
+    ParsedBinaryMessage changes;
+    ParsedBinaryMessage keyframe;
+
+    // Subscribed to hi = 161
+    std::vector<unsigned char> first_bytes = {0x00, 0x00, 0x00, 0x00};
+    first_bytes.push_back(8 + test_var_1.size());
+    first_bytes.insert(first_bytes.end(), {0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00});
+    first_bytes.insert(first_bytes.end(), test_var_1.begin(), test_var_1.end());
+
+    // var_add my_string, then a change to it at index 1: my_string = "99 red balloonz"
+    std::vector<unsigned char> change_bytes = {0x06, 0x00, 0x00, 0x00};
+    change_bytes.push_back(12 + test_var_2.size());
+    change_bytes.insert(change_bytes.end(), {0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00});
+    change_bytes.insert(change_bytes.end(), test_var_2.begin(), test_var_2.end());
+    change_bytes.back() = 0x7a;
+
+    // The full message the server sends after the var_add: hi = 161, my_string = "99 red balloons"
+    std::vector<unsigned char> keyframe_bytes = {0x00, 0x00, 0x00, 0x00};
+    keyframe_bytes.push_back(8 + test_var_1.size() + test_var_2.size());
+    keyframe_bytes.insert(keyframe_bytes.end(), {0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00});
+    keyframe_bytes.insert(keyframe_bytes.end(), test_var_1.begin(), test_var_1.end());
+    keyframe_bytes.insert(keyframe_bytes.end(), test_var_2.begin(), test_var_2.end());
+
+    state.parse(first_bytes);
+    changes.parse(change_bytes);
+
+    // Without the full message the new index is unknown
+    try {
+        state.applyChanges(changes);
+        FAIL() << "Expected exception thrown";
+    } catch (const MalformedMessageException& ex) {
+        EXPECT_STREQ(ex.what(), "Changed variable index 1 does not exist in this message.");
+    } catch (...) {
+        FAIL() << "Incorrect exception thrown";
+    }
+
+    // The full message replaces the state and the change applies to it
+    try {
+        keyframe.parse(keyframe_bytes);
+        state = keyframe;
+        state.applyChanges(changes);
+    } catch (const std::exception& ex) {
+        FAIL() << "Exception thrown: " << ex.what();
+    }
+
+    ASSERT_EQ(state.variables.size(), 2);
+    EXPECT_EQ(state.getVariable("hi").getValue<int>(), 161);
+    EXPECT_EQ(state.getVariable("my_string").getValue<std::string>(), "99 red balloonz");
+}
+
 TEST (BinaryParserTest, GetVarByName) {
     ParsedBinaryMessage message;
 
@@ -24,6 +24,8 @@ class VariableServerSession : public WebSocketSession {
         int  handleMessage(const std::string&);          /* -- base */
 
         void setTimeInterval(unsigned int milliseconds);
+        void setSendOnChange(unsigned int keyframe);
+        void setBinary(bool enable, unsigned int batch);
         void addVariable(char* vname);
         void stageValues();
         void pause();
@@ -40,6 +42,24 @@ class VariableServerSession : public WebSocketSession {
         REF2* make_error_ref(const char* in_name);
         double stageTime;
         bool dataStaged;
+        std::string message;   // values message, reused so its buffer is only allocated once
+        std::string changedValues;  // values of a changes message, reused like message
+        void writeValuesMessage();
+        bool writeChangesMessage();
+
+        void sendBinaryMessage(bool flush);
+        void sendBinaryHeader();
+        void sendBinaryBatch();
+
+        bool binaryEnabled;                  // send binary frames instead of JSON "values" messages
+        bool binaryHeaderNeeded;             // send the header frame before the next values frame
+        unsigned int batchSize;              // cycles sent together in one binary values frame
+        unsigned int batchCount;             // cycles in binaryBatch
+        std::string binaryBatch;             // binary values frame being filled
+
+        unsigned int keyframeInterval;       // messages between full "values" messages, 0 sends every value every time
+        unsigned int messagesSinceKeyframe;
+        bool keyframeNeeded;                 // send a full "values" message next because the variable list changed
 
         std::vector<VariableServerVariable*> sessionVariables;
         bool cyclicSendEnabled;
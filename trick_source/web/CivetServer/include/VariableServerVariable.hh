@@ -13,7 +13,7 @@ LIBRARY DEPENDENCIES:
 #include "CivetServer.h"
 #endif
 
-#include <iostream>
+#include <string>
 #include <trick/reference.h>
 
 #define MAX_ARRAY_LENGTH 4096
@@ -26,7 +26,12 @@ class VariableServerVariable {
         const char* getName();
         const char* getUnits();
         void stageValue();
-        void writeValue( std::ostream& chkpnt_os );
+        void writeValue( std::string& outs );
+        int  getType();
+        unsigned int getBinarySize();     // bytes written by writeBinaryValue, 0 for a length prefixed string
+        void writeBinaryValue( std::string& outs );
+        bool valueChanged() const;   // staged value differs from the value last marked sent
+        void markSent();
 
     private:
         VariableServerVariable() {}
@@ -35,5 +40,10 @@ class VariableServerVariable {
         int   size;
         void *stageBuffer;
         bool  deref;
+        void *sentBuffer;
+        int   sentSize;    // -1 until a value is marked sent
     };
+
+// Appends count values of elemSize bytes each to outs in little-endian byte order.
+void appendLittleEndian( std::string& outs, const void* values, size_t elemSize, size_t count );
 #endif
@@ -8,7 +8,6 @@ LIBRARY DEPENDENCIES:
 #include <string>
 #include <iostream>
 #include <sstream>
-#include <iomanip> // for setprecision
 #include <fstream>
 #include <algorithm>
 #include <cstring>
@@ -16,6 +15,7 @@ LIBRARY DEPENDENCIES:
 #include "trick/memorymanager_c_intf.h"
 #include "trick/input_processor_proto.h"
 #include "trick/exec_proto.h"
+#include "trick/formatNumber.hh"
 #include "VariableServerSession.hh"
 #include "simpleJSON.hh"
 
@@ -24,6 +24,13 @@ VariableServerSession::VariableServerSession( struct mg_connection *nc ) : WebSo
     intervalTimeTics = exec_get_time_tic_value(); // Default time interval is one second.
     nextTime = 0;
     cyclicSendEnabled = false;
+    keyframeInterval = 0;
+    messagesSinceKeyframe = 0;
+    keyframeNeeded = true;
+    binaryEnabled = false;
+    binaryHeaderNeeded = true;
+    batchSize = 1;
+    batchCount = 0;
 }
 
 // DESTRUCTOR
@@ -50,25 +57,150 @@ void VariableServerSession::marshallData() {
 
 /* Base class virtual function: sendMessage
    if data is staged/marshalled, then compose and send a message containing that data.
+   With var_send_on_change, a "changes" message holds only the values that changed since they were
+   last sent, every keyframeInterval-th message is a full "values" message, and nothing is sent if
+   no value changed.
  */
 void VariableServerSession::sendMessage() {
+    if (dataStaged && binaryEnabled) {
+        sendBinaryMessage(false);
+    } else if (dataStaged) {
+        // message keeps its capacity between calls, so a message is composed without allocating.
+        message.clear();
+        if (keyframeInterval == 0 || keyframeNeeded || ++messagesSinceKeyframe >= keyframeInterval) {
+            writeValuesMessage();
+            keyframeNeeded = false;
+            messagesSinceKeyframe = 0;
+        } else if (!writeChangesMessage()) {
+            dataStaged = false;
+            return;
+        }
+        mg_websocket_write(connection, MG_WEBSOCKET_OPCODE_TEXT, message.c_str(), message.size());
+        dataStaged = false;
+    }
+}
+
+void VariableServerSession::writeValuesMessage() {
     std::vector<VariableServerVariable*>::iterator it;
-    std::stringstream ss;
+    char buf[FORMAT_NUMBER_BUF_SIZE];
 
-    if (dataStaged) {
-        ss << "{ \"msg_type\" : \"values\",\n";
-        ss << "  \"time\" : " << std::setprecision(16) << stageTime << ",\n";
-        ss << "  \"values\" : [\n";
+    message += "{ \"msg_type\" : \"values\",\n";
+    message += "  \"time\" : ";
+    message.append(buf, Trick::format_double(stageTime, buf));
+    message += ",\n";
+    message += "  \"values\" : [\n";
 
-        for (it = sessionVariables.begin(); it != sessionVariables.end(); it++ ) {
-            if (it != sessionVariables.begin()) ss << ",\n";
-            (*it)->writeValue(ss);
-         }
-         ss << "]}" << std::endl;
-        std::string tmp = ss.str();
-        const char * message = tmp.c_str();
-        mg_websocket_write(connection, MG_WEBSOCKET_OPCODE_TEXT, message, strlen(message));
-        dataStaged = false;
+    for (it = sessionVariables.begin(); it != sessionVariables.end(); it++ ) {
+        if (it != sessionVariables.begin()) message += ",\n";
+        (*it)->writeValue(message);
+        if (keyframeInterval > 0) (*it)->markSent();
+    }
+    message += "]}\n";
+}
+
+// Returns false, with nothing written, if no value changed.
+bool VariableServerSession::writeChangesMessage() {
+    char buf[FORMAT_NUMBER_BUF_SIZE];
+    bool changed = false;
+
+    changedValues.clear();
+
+    message += "{ \"msg_type\" : \"changes\",\n";
+    message += "  \"time\" : ";
+    message.append(buf, Trick::format_double(stageTime, buf));
+    message += ",\n";
+    message += "  \"indices\" : [";
+
+    for (unsigned int ii = 0; ii < sessionVariables.size(); ii++ ) {
+        if (sessionVariables[ii]->valueChanged()) {
+            if (changed) {
+                message += ",";
+                changedValues += ",\n";
+            }
+            message.append(buf, Trick::format_unsigned_long_long(ii, buf));
+            sessionVariables[ii]->writeValue(changedValues);
+            sessionVariables[ii]->markSent();
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return false;
+    }
+    message += "],\n";
+    message += "  \"values\" : [\n";
+    message += changedValues;
+    message += "]}\n";
+    return true;
+}
+
+/* Binary websocket protocol. All of the fields are little-endian.
+   The header frame lists each variable once, when the binary protocol is enabled and when the
+   variable list changes:
+       uint32 BINARY_HEADER, uint32 number of variables,
+       then per variable: uint32 index, uint32 Trick type, uint32 value size (0 for a string)
+   A values frame holds one or more cycles, each with the values packed in var_add order:
+       uint32 BINARY_VALUES, uint32 number of cycles,
+       then per cycle: double time, then per variable the value size bytes,
+       or for a string a uint32 length and its characters.
+*/
+enum { BINARY_HEADER = 1, BINARY_VALUES = 2 };
+
+void VariableServerSession::sendBinaryHeader() {
+    unsigned int field;
+
+    message.clear();
+    field = BINARY_HEADER;
+    appendLittleEndian(message, &field, sizeof(field), 1);
+    field = sessionVariables.size();
+    appendLittleEndian(message, &field, sizeof(field), 1);
+    for (unsigned int ii = 0; ii < sessionVariables.size(); ii++ ) {
+        appendLittleEndian(message, &ii, sizeof(ii), 1);
+        field = sessionVariables[ii]->getType();
+        appendLittleEndian(message, &field, sizeof(field), 1);
+        field = sessionVariables[ii]->getBinarySize();
+        appendLittleEndian(message, &field, sizeof(field), 1);
+    }
+    mg_websocket_write(connection, MG_WEBSOCKET_OPCODE_BINARY, message.data(), message.size());
+}
+
+/* Adds the staged cycle to binaryBatch and sends it once it holds batchSize cycles, or right away if flush is set.
+   A partly filled batch is sent before a new header, since its values follow the previous variable list. */
+void VariableServerSession::sendBinaryMessage(bool flush) {
+    unsigned int field;
+
+    if (binaryHeaderNeeded) {
+        sendBinaryBatch();
+        sendBinaryHeader();
+        binaryHeaderNeeded = false;
+    }
+
+    if (batchCount == 0) {
+        binaryBatch.clear();
+        field = BINARY_VALUES;
+        appendLittleEndian(binaryBatch, &field, sizeof(field), 1);
+        appendLittleEndian(binaryBatch, &batchCount, sizeof(batchCount), 1);
+    }
+    appendLittleEndian(binaryBatch, &stageTime, sizeof(stageTime), 1);
+    for (unsigned int ii = 0; ii < sessionVariables.size(); ii++ ) {
+        sessionVariables[ii]->writeBinaryValue(binaryBatch);
+    }
+    batchCount++;
+    dataStaged = false;
+
+    if (flush || batchCount >= batchSize) {
+        sendBinaryBatch();
+    }
+}
+
+// Sends the cycles in binaryBatch, if any.
+void VariableServerSession::sendBinaryBatch() {
+    if (batchCount > 0) {
+        // Fill in the number of cycles now that it is known.
+        std::string count;
+        appendLittleEndian(count, &batchCount, sizeof(batchCount), 1);
+        binaryBatch.replace(sizeof(unsigned int), count.size(), count);
+        mg_websocket_write(connection, MG_WEBSOCKET_OPCODE_BINARY, binaryBatch.data(), binaryBatch.size());
+        batchCount = 0;
     }
 }
 
@@ -82,6 +214,8 @@ int VariableServerSession::handleMessage(const std::string& client_msg) {
      std::string var_name;
      std::string pycode;
      int period;
+     unsigned int keyframe = 0;
+     unsigned int batch = 1;
 
      for (it = members.begin(); it != members.end(); it++ ) {
          if (strcmp((*it)->key, "cmd") == 0) {
@@ -92,6 +226,10 @@ int VariableServerSession::handleMessage(const std::string& client_msg) {
              period = atoi((*it)->valText);
          } else if (strcmp((*it)->key, "pycode") == 0) {
              pycode = (*it)->valText;
+         } else if (strcmp((*it)->key, "keyframe") == 0) {
+             keyframe = atoi((*it)->valText);
+         } else if (strcmp((*it)->key, "batch") == 0) {
+             batch = atoi((*it)->valText);
          }
      }
 
@@ -102,6 +240,12 @@ int VariableServerSession::handleMessage(const std::string& client_msg) {
          addVariable( strdup( var_name.c_str()));
      } else if (cmd == "var_cycle") {
          setTimeInterval(period);
+     } else if (cmd == "var_send_on_change") {
+         setSendOnChange(keyframe);
+     } else if (cmd == "var_binary") {
+         setBinary(true, batch);
+     } else if (cmd == "var_json") {
+         setBinary(false, 1);
      } else if (cmd == "var_pause") {
          pause();
      } else if (cmd == "var_unpause") {
@@ -109,7 +253,12 @@ int VariableServerSession::handleMessage(const std::string& client_msg) {
      } else if (cmd == "var_send") {
          // var_send responses are not guarenteed to be time-consistent.
          stageValues();
-         sendMessage();
+         keyframeNeeded = true;
+         if (binaryEnabled) {
+             sendBinaryMessage(true);
+         } else {
+             sendMessage();
+         }
      } else if (cmd == "var_clear") {
          clear();
      } else if (cmd == "var_exit") {
@@ -138,6 +287,19 @@ void VariableServerSession::setTimeInterval(unsigned int milliseconds) {
     intervalTimeTics = exec_get_time_tic_value() * milliseconds / 1000;
 }
 
+void VariableServerSession::setSendOnChange(unsigned int keyframe) {
+    keyframeInterval = keyframe;
+    messagesSinceKeyframe = 0;
+    keyframeNeeded = true;
+}
+
+void VariableServerSession::setBinary(bool enable, unsigned int batch) {
+    sendBinaryBatch();
+    binaryEnabled = enable;
+    batchSize = (batch > 0) ? batch : 1;
+    binaryHeaderNeeded = true;
+}
+
 void VariableServerSession::addVariable(char* vname){
     REF2 * new_ref ;
     new_ref = ref_attributes(vname);
@@ -166,6 +328,8 @@ void VariableServerSession::addVariable(char* vname){
         // the right and responsibility to free() it in its destructor.
         VariableServerVariable *sessionVariable = new VariableServerVariable( new_ref ) ;
         sessionVariables.push_back( sessionVariable ) ;
+        keyframeNeeded = true;
+        binaryHeaderNeeded = true;
     }
 }
 
@@ -189,6 +353,8 @@ void VariableServerSession::clear() {
             delete *it;
             it = sessionVariables.erase(it);
         }
+        keyframeNeeded = true;
+        binaryHeaderNeeded = true;
 }
 
 void VariableServerSession::exit() {}
@@ -1,8 +1,9 @@
 #include "trick/memorymanager_c_intf.h" // for get_size.
 #include "VariableServerVariable.hh"
+#include "trick/formatNumber.hh"
 #include <math.h> // for fpclassify
-#include <iomanip> // for setprecision
 #include <stdarg.h>
+#include <stdio.h>
 #include <cstring>
 
 
@@ -42,10 +43,13 @@ VariableServerVariable::VariableServerVariable(REF2 * ref ) {
         size = MAX_ARRAY_LENGTH ;
     }
     stageBuffer = calloc(size, 1) ;
+    sentBuffer = calloc(size, 1) ;
+    sentSize = -1 ;
 }
 
 VariableServerVariable::~VariableServerVariable() {
     if (varInfo != NULL) free( varInfo );
+    free( sentBuffer );
 }
 
 
@@ -57,20 +61,20 @@ const char* VariableServerVariable::getUnits() {
     return varInfo->attr->units;
 }
 
-static void write_quoted_str( std::ostream& os, const char* s) {
+static void write_quoted_str( std::string& outs, const char* s) {
     int ii;
     int len = strlen(s);
-    os << "\"" ;
+    outs += '"' ;
     for (ii=0 ; ii<len ; ii++) {
         switch ((s)[ii]) {
-        case '\n': os << "\\n"; break;
-        case '\t': os << "\\t"; break;
-        case '\b': os << "\\b"; break;
-        case '\"': os << "\\\""; break;
-        default  : os << s[ii] ; break;
+        case '\n': outs += "\\n"; break;
+        case '\t': outs += "\\t"; break;
+        case '\b': outs += "\\b"; break;
+        case '\"': outs += "\\\""; break;
+        default  : outs += s[ii] ; break;
         }
     }
-    os << "\"" ;
+    outs += '"' ;
 }
 
 void VariableServerVariable::stageValue() {
@@ -89,63 +93,119 @@ void VariableServerVariable::stageValue() {
     }
 }
 
-void VariableServerVariable::writeValue( std::ostream& outs ) {
+void appendLittleEndian( std::string& outs, const void* values, size_t elemSize, size_t count ) {
+    static const unsigned short one = 1;
+    const char* bytes = (const char*)values;
+
+    if ( *(const char*)&one == 1 || elemSize <= 1 ) {
+        outs.append(bytes, elemSize * count);
+        return;
+    }
+    for (size_t ii = 0; ii < count; ii++ ) {
+        for (size_t jj = elemSize; jj > 0; jj-- ) {
+            outs += bytes[ii * elemSize + jj - 1];
+        }
+    }
+}
+
+int VariableServerVariable::getType() {
+    return varInfo->attr->type;
+}
+
+unsigned int VariableServerVariable::getBinarySize() {
+    if ( varInfo->attr->type == TRICK_STRING ) {
+        return 0;
+    }
+    return size;
+}
+
+/* Appends the staged value to outs for the binary websocket protocol: the staged bytes, each element
+   in little-endian byte order, or for a string a 4 byte length followed by its characters. */
+void VariableServerVariable::writeBinaryValue( std::string& outs ) {
+    if ( varInfo->attr->type == TRICK_STRING ) {
+        const std::string& str = *(std::string*)stageBuffer;
+        unsigned int len = str.size();
+        appendLittleEndian(outs, &len, sizeof(len), 1);
+        outs.append(str);
+    } else {
+        size_t elemSize = varInfo->attr->size > 0 ? varInfo->attr->size : size;
+        appendLittleEndian(outs, stageBuffer, elemSize, size / elemSize);
+    }
+}
+
+bool VariableServerVariable::valueChanged() const {
+    return ( size != sentSize ) || ( memcmp(stageBuffer, sentBuffer, size) != 0 );
+}
+
+void VariableServerVariable::markSent() {
+    memcpy(sentBuffer, stageBuffer, size);
+    sentSize = size;
+}
+
+/* Appends the staged value to outs.  Numbers are written with Trick::format_* into a stack buffer, so
+   nothing is allocated once outs has grown to the message size. */
+void VariableServerVariable::writeValue( std::string& outs ) {
+
+    char buf[FORMAT_NUMBER_BUF_SIZE];
 
     switch(varInfo->attr->type) {
         case TRICK_UNSIGNED_CHARACTER:
-            outs << std::dec << (int)*(unsigned char*)stageBuffer ;
+            outs.append(buf, Trick::format_long_long(*(unsigned char*)stageBuffer, buf));
         break;
         case TRICK_BOOLEAN:
             if (*(bool*)stageBuffer) {
-                outs << "\"true\"" ;
+                outs += "\"true\"" ;
             } else {
-                outs << "\"false\"" ;
+                outs += "\"false\"" ;
             }
         break;
         case TRICK_CHARACTER:
             if (isprint( *(char*)stageBuffer) ) {
-                outs << "'" << *(char*)stageBuffer << "'" ;
+                outs += '\'' ;
+                outs += *(char*)stageBuffer ;
+                outs += '\'' ;
             } else {
                 unsigned int ch = *(unsigned char*)stageBuffer;
-                  outs << "'\\x" << std::hex << ch << "'" ;
+                snprintf(buf, sizeof(buf), "'\\x%x'", ch);
+                outs += buf ;
             }
         break;
         case TRICK_WCHAR:
-            outs << std::dec << *(wchar_t*)stageBuffer;
+            outs.append(buf, Trick::format_long_long(*(wchar_t*)stageBuffer, buf));
             break;
         case TRICK_SHORT:
-            outs << std::dec << *(short*)stageBuffer;
+            outs.append(buf, Trick::format_long_long(*(short*)stageBuffer, buf));
             break;
         case TRICK_UNSIGNED_SHORT:
-            outs << std::dec << *(unsigned short*)stageBuffer;
+            outs.append(buf, Trick::format_unsigned_long_long(*(unsigned short*)stageBuffer, buf));
             break;
         case TRICK_ENUMERATED:
-            outs << std::dec << *(int*)stageBuffer;
+            outs.append(buf, Trick::format_long_long(*(int*)stageBuffer, buf));
             break;
         case TRICK_INTEGER:
-            outs << std::dec << *(int*)stageBuffer;
+            outs.append(buf, Trick::format_long_long(*(int*)stageBuffer, buf));
             break;
         case TRICK_UNSIGNED_INTEGER:
-            outs << std::dec << *(unsigned int*)stageBuffer;
+            outs.append(buf, Trick::format_unsigned_long_long(*(unsigned int*)stageBuffer, buf));
             break;
         case TRICK_LONG:
-            outs << std::dec << *(long*)stageBuffer;
+            outs.append(buf, Trick::format_long_long(*(long*)stageBuffer, buf));
             break;
         case TRICK_UNSIGNED_LONG:
-            outs << std::dec << *(unsigned long*)stageBuffer;
+            outs.append(buf, Trick::format_unsigned_long_long(*(unsigned long*)stageBuffer, buf));
             break;
         case TRICK_FLOAT:
             if (fpclassify( *(float*)stageBuffer) != FP_NAN) {
-                outs << std::setprecision(8) << *(float*)stageBuffer;
+                outs.append(buf, Trick::format_float(*(float*)stageBuffer, buf));
             } else {
-                outs << "NAN";
+                outs += "NAN";
             }
             break;
         case TRICK_DOUBLE:
             if (fpclassify( *(double*)stageBuffer) != FP_NAN) {
-                outs << std::setprecision(16) << *(double*)stageBuffer;
+                outs.append(buf, Trick::format_double(*(double*)stageBuffer, buf));
             } else {
-                outs << "NAN";
+                outs += "NAN";
             }
             break;
 //        case TRICK_BITFIELD: {
@@ -179,16 +239,16 @@ void VariableServerVariable::writeValue( std::ostream& outs ) {
 //                outs << std::dec << bf;
 //            } break;
         case TRICK_LONG_LONG:
-            outs << std::dec << *(long long*)stageBuffer;
+            outs.append(buf, Trick::format_long_long(*(long long*)stageBuffer, buf));
             break;
         case TRICK_UNSIGNED_LONG_LONG:
-            outs << std::dec << *(unsigned long long*)stageBuffer;
+            outs.append(buf, Trick::format_unsigned_long_long(*(unsigned long long*)stageBuffer, buf));
             break;
         case TRICK_STRING:
             write_quoted_str(outs, (*(std::string*)stageBuffer).c_str());
             break;
         default:
-            outs << "\"Error\""; // ERROR
+            outs += "\"Error\""; // ERROR
             break;
     }
 }